@@ -536,11 +536,40 @@ void Agent::executeScript() {
         }
 
         setIsAvatar(false); // will stop timers for sending identity packets
+
+        if (_botFarm) {
+            delete _botFarm;
+            _botFarm = nullptr;
+        }
     }
 
     setFinished(true);
 }
 
+QUuid Agent::addBot(const QString& clipURL, const QVariantMap& options) {
+    // bots are played from the agent's thread, which is also the script's
+    if (!_botFarm) {
+        _botFarm = new BotFarm(this);
+    }
+    return _botFarm->addBot(clipURL, options);
+}
+
+void Agent::removeBot(const QUuid& botID) {
+    if (_botFarm) {
+        _botFarm->removeBot(botID);
+    }
+}
+
+void Agent::removeAllBots() {
+    if (_botFarm) {
+        _botFarm->removeAllBots();
+    }
+}
+
+int Agent::getNumBots() const {
+    return _botFarm ? _botFarm->getNumBots() : 0;
+}
+
 QUuid Agent::getSessionUUID() const {
     return DependencyManager::get<NodeList>()->getSessionUUID();
 }
@@ -710,7 +739,8 @@ void Agent::processAgentAvatarAudio() {
         int16_t numAvailableSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
         const int16_t* nextSoundOutput = NULL;
 
-        if (_avatarSound && _avatarSound->isReady()) {
+        // the sound is sent at its own pace, so wait for all of it to be decoded
+        if (_avatarSound && _avatarSound->isReady() && _avatarSound->getAudioData()->isComplete()) {
             if (isPlayingRecording && !_shouldMuteRecordingAudio) {
                 _shouldMuteRecordingAudio = true;
             }
@@ -830,6 +860,12 @@ void Agent::processAgentAvatarAudio() {
 }
 
 void Agent::aboutToFinish() {
+    // bots hold on to clips from the ClipCache destroyed below
+    if (_botFarm) {
+        delete _botFarm;
+        _botFarm = nullptr;
+    }
+
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
     DependencyManager::get<EntityScriptingInterface>()->setEntityTree(nullptr);
 
@@ -32,6 +32,7 @@
 #include "MixedAudioStream.h"
 #include "entities/EntityTreeHeadlessViewer.h"
 #include "avatars/ScriptableAvatar.h"
+#include "BotFarm.h"
 
 class Agent : public ThreadedAssignment {
     Q_OBJECT
@@ -69,6 +70,11 @@ public slots:
 
     Q_INVOKABLE virtual void stop() override;
 
+    QUuid addBot(const QString& clipURL, const QVariantMap& options);
+    void removeBot(const QUuid& botID);
+    void removeAllBots();
+    int getNumBots() const;
+
 private slots:
     void requestScript();
     void scriptRequestFinished();
@@ -120,6 +126,8 @@ private:
     Encoder* _encoder { nullptr };
     QTimer _avatarAudioTimer;
     bool _flushEncoder { false };
+
+    BotFarm* _botFarm { nullptr };
 };
 
 #endif // hifi_Agent_h
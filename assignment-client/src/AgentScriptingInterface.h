@@ -37,6 +37,7 @@
  * @property {number} lastReceivedAudioLoudness - The current loudness of the audio input. Nominal range [<code>0.0</code> (no 
  *     sound) &ndash; <code>1.0</code> (the onset of clipping)]. <em>Read-only.</em>
  * @property {Uuid} sessionUUID - The unique ID associated with the agent's current session in the domain. <em>Read-only.</em>
+ * @property {number} numBots - The number of recordings being played back as bots. <em>Read-only.</em>
  */
 class AgentScriptingInterface : public QObject {
     Q_OBJECT
@@ -46,6 +47,7 @@ class AgentScriptingInterface : public QObject {
     Q_PROPERTY(bool isNoiseGateEnabled READ isNoiseGateEnabled WRITE setIsNoiseGateEnabled)
     Q_PROPERTY(float lastReceivedAudioLoudness READ getLastReceivedAudioLoudness)
     Q_PROPERTY(QUuid sessionUUID READ getSessionUUID)
+    Q_PROPERTY(int numBots READ getNumBots)
 
 public:
     AgentScriptingInterface(Agent* agent);
@@ -60,6 +62,7 @@ public:
 
     float getLastReceivedAudioLoudness() const { return _agent->getLastReceivedAudioLoudness(); }
     QUuid getSessionUUID() const { return _agent->getSessionUUID(); }
+    int getNumBots() const { return _agent->getNumBots(); }
 
 public slots:
     /**jsdoc
@@ -103,6 +106,50 @@ public slots:
      */
     void playAvatarSound(SharedSoundPointer avatarSound) const { _agent->playAvatarSound(avatarSound); }
 
+    /**jsdoc
+     * Plays back a recording as a bot: an avatar of its own in the domain, sent by this assignment client without a
+     * script, deck or connection of its own. Recordings are downloaded once and shared by all the bots playing them, so
+     * hundreds of bots can be played from one assignment client. Requires rez permission in the domain.
+     * @function Agent.addBot
+     * @param {string} clipURL - The URL of the recording (".hfr" file).
+     * @param {object} [options] - Playback options.
+     * @param {Vec3} [options.position] - The position the recording is played back relative to. If not set, the recording
+     *     is played back where it was recorded.
+     * @param {Quat} [options.orientation] - The orientation the recording is played back relative to, if
+     *     <code>position</code> is set.
+     * @param {boolean} [options.loop=true] - <code>true</code> to play the recording repeatedly, <code>false</code> to
+     *     hold the bot on the last frame.
+     * @param {number} [options.startTime=0] - The time into the recording to start at, in seconds. A negative value holds
+     *     the bot on the recording's first frame for that long.
+     * @returns {Uuid} The ID of the bot's avatar, or <code>null</code> if the recording can't be loaded.
+     * @example <caption>Populate a plaza with a crowd playing the same recording out of step.</caption>
+     * (function () {
+     *     var CLIP_URL = "atp:/recordings/walk.hfr";
+     *     for (var i = 0; i < 100; i++) {
+     *         Agent.addBot(CLIP_URL, {
+     *             position: { x: (i % 10) * 2, y: 0, z: Math.floor(i / 10) * 2 },
+     *             startTime: Math.random() * 10
+     *         });
+     *     }
+     * }());
+     */
+    QUuid addBot(const QString& clipURL, const QVariantMap& options = QVariantMap()) const {
+        return _agent->addBot(clipURL, options);
+    }
+
+    /**jsdoc
+     * Stops playing a bot and removes its avatar from the domain.
+     * @function Agent.removeBot
+     * @param {Uuid} botID - The ID of the bot, as returned by {@link Agent.addBot|addBot}.
+     */
+    void removeBot(const QUuid& botID) const { _agent->removeBot(botID); }
+
+    /**jsdoc
+     * Stops playing all bots and removes their avatars from the domain.
+     * @function Agent.removeAllBots
+     */
+    void removeAllBots() const { _agent->removeAllBots(); }
+
 private:
     Agent* _agent;
 
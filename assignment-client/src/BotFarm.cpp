@@ -0,0 +1,343 @@
+//
+//  BotFarm.cpp
+//  assignment-client/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BotFarm.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonDocument>
+
+#include <AvatarHashMap.h>
+#include <NLPacketList.h>
+#include <NodeList.h>
+#include <RegisteredMetaTypes.h>
+#include <SharedUtil.h>
+#include <Transform.h>
+#include <UUID.h>
+#include <udt/PacketHeaders.h>
+
+#include <recording/Frame.h>
+
+using namespace recording;
+
+static const int BOT_FARM_UPDATE_INTERVAL_MSECS = (int)(MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS / USECS_PER_MSEC);
+
+static const QString BOT_POSITION_OPTION = "position";
+static const QString BOT_ORIENTATION_OPTION = "orientation";
+static const QString BOT_LOOP_OPTION = "loop";
+static const QString BOT_START_TIME_OPTION = "startTime";
+
+static FrameType getAvatarFrameType() {
+    static const FrameType AVATAR_FRAME_TYPE = Frame::registerFrameType(AvatarData::FRAME_NAME);
+    return AVATAR_FRAME_TYPE;
+}
+
+QByteArray BotFarm::BotAvatar::toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) {
+    _globalPosition = getWorldPosition();
+    return AvatarData::toByteArrayStateful(dataDetail, dropFaceTracking);
+}
+
+BotFarm::BotFarm(QObject* parent) :
+    QObject(parent),
+    _updateTimer(this)
+{
+    connect(&_updateTimer, &QTimer::timeout, this, &BotFarm::update);
+    _updateTimer.setInterval(BOT_FARM_UPDATE_INTERVAL_MSECS);
+    _updateTimer.setTimerType(Qt::PreciseTimer);
+
+    // a new avatar mixer knows nothing about our bots
+    connect(DependencyManager::get<NodeList>().data(), &LimitedNodeList::nodeActivated, this, &BotFarm::nodeActivated);
+}
+
+BotFarm::~BotFarm() {
+    removeAllBots();
+}
+
+QUuid BotFarm::addBot(const QString& clipURL, const QVariantMap& options) {
+    auto clipLoader = DependencyManager::get<ClipCache>()->getClipLoader(QUrl(clipURL));
+    if (!clipLoader) {
+        qWarning() << "Unable to load bot recording" << clipURL;
+        return QUuid();
+    }
+
+    auto bot = std::unique_ptr<Bot>(new Bot());
+    bot->id = QUuid::createUuid();
+    bot->clipLoader = clipLoader;
+    bot->loop = options.value(BOT_LOOP_OPTION, true).toBool();
+
+    // a negative start time holds the bot on its first frame for that long
+    float startTime = options.value(BOT_START_TIME_OPTION, 0.0f).toFloat();
+    bot->clipStartUsecs = (quint64)((qint64)usecTimestampNow() - (qint64)(startTime * USECS_PER_SECOND));
+
+    bot->avatar = std::make_shared<BotAvatar>();
+    bot->avatar->setSessionUUID(bot->id);
+    // force lazy initialization of the head data, which the recorded frames fill in
+    bot->avatar->getHeadOrientation();
+
+    // without a position the bot plays back where it was recorded
+    if (options.contains(BOT_POSITION_OPTION)) {
+        auto basis = std::make_shared<Transform>();
+        basis->setTranslation(vec3FromVariant(options[BOT_POSITION_OPTION]));
+        if (options.contains(BOT_ORIENTATION_OPTION)) {
+            basis->setRotation(quatFromVariant(options[BOT_ORIENTATION_OPTION]));
+        }
+        bot->avatar->setRecordingBasis(basis);
+    }
+
+    QUuid botID = bot->id;
+    _bots.push_back(std::move(bot));
+
+    if (!_updateTimer.isActive()) {
+        _updateTimer.start();
+    }
+
+    return botID;
+}
+
+void BotFarm::removeBot(const QUuid& botID) {
+    auto it = std::find_if(_bots.begin(), _bots.end(), [&botID](const std::unique_ptr<Bot>& bot) {
+        return bot->id == botID;
+    });
+    if (it == _bots.end()) {
+        return;
+    }
+
+    _bots.erase(it);
+    sendKill({ botID });
+
+    if (_bots.empty()) {
+        _updateTimer.stop();
+    }
+}
+
+void BotFarm::removeAllBots() {
+    std::vector<QUuid> botIDs;
+    botIDs.reserve(_bots.size());
+    for (const auto& bot : _bots) {
+        botIDs.push_back(bot->id);
+    }
+
+    _bots.clear();
+    _updateTimer.stop();
+    sendKill(botIDs);
+}
+
+void BotFarm::nodeActivated(SharedNodePointer node) {
+    if (node->getType() == NodeType::AvatarMixer) {
+        for (auto& bot : _bots) {
+            bot->needsIdentity = true;
+        }
+    }
+}
+
+void BotFarm::update() {
+    auto now = usecTimestampNow();
+
+    std::vector<std::pair<Bot*, size_t>> botFrames;
+    botFrames.reserve(_bots.size());
+
+    std::vector<QUuid> failedBots;
+
+    for (auto& bot : _bots) {
+        if (!bot->clip) {
+            if (!bot->clipLoader->completed()) {
+                continue;
+            }
+
+            bot->clip = std::dynamic_pointer_cast<PointerClip>(bot->clipLoader->getClip());
+            if (bot->clipLoader->isFailed() || !bot->clip || bot->clip->frameCount() == 0) {
+                qWarning() << "Unable to play bot recording" << bot->clipLoader->getURL();
+                failedBots.push_back(bot->id);
+                continue;
+            }
+        }
+
+        size_t frameIndex;
+        if (advanceBot(*bot, now, frameIndex)) {
+            botFrames.emplace_back(bot.get(), frameIndex);
+        }
+    }
+
+    for (const auto& botID : failedBots) {
+        removeBot(botID);
+    }
+
+    applyFrames(botFrames);
+
+    auto avatarMixer = DependencyManager::get<NodeList>()->soloNodeOfType(NodeType::AvatarMixer);
+    if (avatarMixer && avatarMixer->getActiveSocket()) {
+        sendBots(avatarMixer);
+    }
+}
+
+bool BotFarm::advanceBot(Bot& bot, quint64 now, size_t& avatarFrameIndex) {
+    const auto& clip = *bot.clip;
+
+    if (now < bot.clipStartUsecs) {
+        return false;
+    }
+
+    Frame::Time lastFrameTime = clip.frameTimeAt(clip.frameCount() - 1);
+    quint64 clipTime = (now - bot.clipStartUsecs) / USECS_PER_MSEC;
+
+    if (clipTime > lastFrameTime) {
+        if (bot.loop) {
+            // wrap by whole clip lengths so a late update doesn't shift the bot's phase
+            quint64 clipLengthUsecs = ((quint64)lastFrameTime + 1) * USECS_PER_MSEC;
+            bot.clipStartUsecs += ((now - bot.clipStartUsecs) / clipLengthUsecs) * clipLengthUsecs;
+            clipTime = (now - bot.clipStartUsecs) / USECS_PER_MSEC;
+            bot.nextFrameIndex = 0;
+        } else {
+            clipTime = lastFrameTime;
+        }
+    }
+
+    // only the newest avatar frame since the last update matters, the ones in between are never decoded
+    size_t endIndex = clip.frameIndexForTime((Frame::Time)clipTime + 1);
+    bool hasFrame = false;
+    for (size_t index = endIndex; index > bot.nextFrameIndex; --index) {
+        if (clip.frameTypeAt(index - 1) == getAvatarFrameType()) {
+            avatarFrameIndex = index - 1;
+            hasFrame = true;
+            break;
+        }
+    }
+    bot.nextFrameIndex = endIndex;
+
+    return hasFrame;
+}
+
+void BotFarm::applyFrames(std::vector<std::pair<Bot*, size_t>>& botFrames) {
+    // bots on the same frame of the same clip share one decompress and parse of it
+    std::sort(botFrames.begin(), botFrames.end(), [](const std::pair<Bot*, size_t>& a, const std::pair<Bot*, size_t>& b) {
+        auto clipA = a.first->clip.get();
+        auto clipB = b.first->clip.get();
+        return clipA != clipB ? std::less<PointerClip*>()(clipA, clipB) : a.second < b.second;
+    });
+
+    const PointerClip* decodedClip = nullptr;
+    size_t decodedIndex = 0;
+    QJsonObject frameJson;
+
+    for (auto& botFrame : botFrames) {
+        Bot& bot = *botFrame.first;
+        if (bot.clip.get() != decodedClip || botFrame.second != decodedIndex) {
+            decodedClip = bot.clip.get();
+            decodedIndex = botFrame.second;
+
+            auto frame = bot.clip->frameAt(decodedIndex);
+            frameJson = frame ? QJsonDocument::fromBinaryData(frame->data).object() : QJsonObject();
+        }
+
+        if (!frameJson.isEmpty()) {
+            bot.avatar->fromJson(frameJson);
+        }
+    }
+}
+
+static void writeBotEntry(NLPacketList& packetList, const QUuid& botID, PacketType packetType, const QByteArray& payload) {
+    packetList.startSegment();
+    packetList.write(botID.toRfc4122());
+    packetList.writePrimitive(packetType);
+    packetList.writePrimitive((quint16)payload.size());
+    packetList.write(payload);
+    packetList.endSegment();
+}
+
+void BotFarm::sendBots(const SharedNodePointer& avatarMixer) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // identities and traits must arrive, avatar data is superseded by the next update like any other avatar's
+    auto reliablePacketList = NLPacketList::create(PacketType::BotAvatarData, QByteArray(), true, true);
+    auto dataPacketList = NLPacketList::create(PacketType::BotAvatarData);
+
+    const int entryHeaderSize = NUM_BYTES_RFC4122_UUID + sizeof(PacketType) + sizeof(quint16);
+    const int maxAvatarByteArraySize = (int)dataPacketList->getMaxSegmentSize() - entryHeaderSize -
+        (int)sizeof(AvatarDataSequenceNumber);
+
+    for (auto& bot : _bots) {
+        if (!bot->clip) {
+            continue;
+        }
+        auto& avatar = *bot->avatar;
+
+        if (bot->needsIdentity || avatar.getDisplayName() != bot->sentDisplayName) {
+            avatar.pushIdentitySequenceNumber();
+            writeBotEntry(*reliablePacketList, bot->id, PacketType::AvatarIdentity, avatar.identityByteArray());
+            bot->sentDisplayName = avatar.getDisplayName();
+        }
+
+        if (bot->needsIdentity || avatar.getSkeletonModelURL() != bot->sentSkeletonModelURL) {
+            // the same layout as a SetAvatarTraits packet carrying only the skeleton
+            QByteArray skeletonModelURL = avatar.packTrait(AvatarTraits::SkeletonModelURL);
+            AvatarTraits::TraitVersion traitVersion = ++bot->traitVersion;
+            AvatarTraits::TraitType traitType = AvatarTraits::SkeletonModelURL;
+            AvatarTraits::TraitWireSize traitSize = (AvatarTraits::TraitWireSize)skeletonModelURL.size();
+
+            QByteArray traits;
+            traits.append(reinterpret_cast<const char*>(&traitVersion), sizeof(traitVersion));
+            traits.append(reinterpret_cast<const char*>(&traitType), sizeof(traitType));
+            traits.append(reinterpret_cast<const char*>(&traitSize), sizeof(traitSize));
+            traits.append(skeletonModelURL);
+            writeBotEntry(*reliablePacketList, bot->id, PacketType::SetAvatarTraits, traits);
+
+            bot->sentSkeletonModelURL = avatar.getSkeletonModelURL();
+        }
+
+        bot->needsIdentity = false;
+
+        // occasionally send everything, guarding against a lost packet freezing a joint, as AvatarData does
+        bool sendAll = randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO;
+        auto dataDetail = sendAll ? AvatarData::SendAllData : AvatarData::CullSmallData;
+
+        QByteArray avatarByteArray = avatar.toByteArrayStateful(dataDetail);
+        if (avatarByteArray.size() > maxAvatarByteArraySize) {
+            avatarByteArray = avatar.toByteArrayStateful(dataDetail, true);
+            if (avatarByteArray.size() > maxAvatarByteArraySize) {
+                avatarByteArray = avatar.toByteArrayStateful(AvatarData::MinimumData, true);
+                if (avatarByteArray.size() > maxAvatarByteArraySize) {
+                    qWarning() << "Bot avatar data too large for" << bot->id << "-" << avatarByteArray.size() << "bytes";
+                    continue;
+                }
+            }
+        }
+        avatar.doneEncoding(!sendAll);
+
+        AvatarDataSequenceNumber sequenceNumber = bot->sequenceNumber++;
+        avatarByteArray.prepend(reinterpret_cast<const char*>(&sequenceNumber), sizeof(sequenceNumber));
+        writeBotEntry(*dataPacketList, bot->id, PacketType::AvatarData, avatarByteArray);
+    }
+
+    if (reliablePacketList->getNumPackets() > 0) {
+        nodeList->sendPacketList(std::move(reliablePacketList), *avatarMixer);
+    }
+    if (dataPacketList->getNumPackets() > 0) {
+        nodeList->sendPacketList(std::move(dataPacketList), *avatarMixer);
+    }
+}
+
+void BotFarm::sendKill(const std::vector<QUuid>& botIDs) {
+    if (botIDs.empty()) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (!avatarMixer || !avatarMixer->getActiveSocket()) {
+        // the mixer times the bots out by itself
+        return;
+    }
+
+    auto killPacketList = NLPacketList::create(PacketType::BotKillAvatar, QByteArray(), true, true);
+    for (const auto& botID : botIDs) {
+        killPacketList->write(botID.toRfc4122());
+    }
+    nodeList->sendPacketList(std::move(killPacketList), *avatarMixer);
+}
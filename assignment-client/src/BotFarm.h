@@ -0,0 +1,81 @@
+//
+//  BotFarm.h
+//  assignment-client/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BotFarm_h
+#define hifi_BotFarm_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtCore/QUuid>
+#include <QtCore/QVariantMap>
+
+#include <AvatarData.h>
+#include <Node.h>
+#include <recording/ClipCache.h>
+
+class NLPacketList;
+
+// Plays back many recordings as separate avatars from a single agent. Clips are shared through the ClipCache,
+// each bot only keeps its own play head and a bare AvatarData, and all bots are sent to the avatar mixer
+// in bulk BotAvatarData packets rather than through a node, script engine and deck of their own.
+class BotFarm : public QObject {
+    Q_OBJECT
+
+public:
+    BotFarm(QObject* parent = nullptr);
+    ~BotFarm();
+
+    QUuid addBot(const QString& clipURL, const QVariantMap& options);
+    void removeBot(const QUuid& botID);
+    void removeAllBots();
+
+    int getNumBots() const { return (int)_bots.size(); }
+
+private slots:
+    void update();
+    void nodeActivated(SharedNodePointer node);
+
+private:
+    class BotAvatar : public AvatarData {
+    public:
+        // AvatarData encodes the global position it was last told about, bots move without being told
+        QByteArray toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking = false) override;
+    };
+
+    struct Bot {
+        QUuid id;
+        recording::NetworkClipLoaderPointer clipLoader;
+        std::shared_ptr<recording::PointerClip> clip;
+        std::shared_ptr<BotAvatar> avatar;
+
+        bool loop { true };
+        quint64 clipStartUsecs { 0 };  // wall clock time of the clip's first frame
+        size_t nextFrameIndex { 0 };
+
+        AvatarDataSequenceNumber sequenceNumber { 0 };
+        AvatarTraits::TraitVersion traitVersion { AvatarTraits::DEFAULT_TRAIT_VERSION };
+        QString sentDisplayName;
+        QUrl sentSkeletonModelURL;
+        bool needsIdentity { true };
+    };
+
+    bool advanceBot(Bot& bot, quint64 now, size_t& avatarFrameIndex);
+    void applyFrames(std::vector<std::pair<Bot*, size_t>>& botFrames);
+    void sendBots(const SharedNodePointer& avatarMixer);
+    void sendKill(const std::vector<QUuid>& botIDs);
+
+    std::vector<std::unique_ptr<Bot>> _bots;
+    QTimer _updateTimer;
+};
+
+#endif // hifi_BotFarm_h
@@ -29,6 +29,7 @@
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <StDev.h>
+#include <Trace.h>
 #include <UUID.h>
 #include <CPUDetect.h>
 
@@ -291,6 +292,8 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
+    statsObject["encodes_per_frame"] = (float)_stats.encodes / (float)_numStatFrames;
+
     // timing stats
     QJsonObject timingStats;
 
@@ -343,8 +346,17 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["mix_stats"] = mixStats;
 
+    // tails of the per-frame timings, in microseconds
+    QJsonObject latencyStats;
+    latencyStats["frame_us"] = _frameTimes.toJson();
+    latencyStats["listener_mix_us"] = _stats.listenerMixTimes.toJson();
+    latencyStats["send_latency_us"] = _stats.sendLatencies.toJson();
+    latencyStats["packet_processing_us"] = _stats.packetProcessingTimes.toJson();
+    statsObject["latency_histograms"] = latencyStats;
+
     _numStatFrames = _numSilentPackets = 0;
     _stats.reset();
+    _frameTimes.reset();
 
     // add stats for each listerner
     auto nodeList = DependencyManager::get<NodeList>();
@@ -357,6 +369,9 @@ void AudioMixer::sendStatsPacket() {
             QString uuidString = uuidStringWithoutCurlyBraces(node->getUUID());
 
             nodeStats["outbound_kbps"] = node->getOutboundKbps();
+            nodeStats["encoder_bitrate"] = clientData->getEncoderBitrate();
+            nodeStats["encoder_complexity"] = clientData->getEncoderComplexity();
+            nodeStats["encoder_fec"] = clientData->getEncoderUsesFEC();
             nodeStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuidString;
 
             nodeStats["jitter"] = clientData->getAudioStreamStats();
@@ -424,8 +439,11 @@ void AudioMixer::start() {
         } else {
             auto timer = _checkTimeTiming.timer();
             auto frameDuration = timeFrame();
+            tracing::reportFrameTime(frameDuration.count());
+            _frameTimes.record(frameDuration.count());
             throttle(frameDuration, frame);
         }
+        _workerSharedData.frameStart = _idealFrameTimestamp;
 
         auto frameTimer = _frameTiming.timer();
 
@@ -458,6 +476,7 @@ void AudioMixer::start() {
         if (_throttlingRatio > EPSILON) {
             numToRetain = nodeList->size() * (1.0f - _throttlingRatio);
         }
+
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // mix across slave threads
             auto mixTimer = _mixTiming.timer();
@@ -138,6 +138,8 @@ private:
     Timer _eventsTiming;
     Timer _packetsTiming;
 
+    LatencyHistogram _frameTimes;
+
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
     static float _attenuationPerDoublingInDistance;
@@ -27,6 +27,18 @@
 #include "AudioHelpers.h"
 #include "AudioMixer.h"
 
+// outbound mix bitrates, stepped down as the listener's connection degrades
+static const int ENCODER_BITRATES[] = { 128000, 96000, 64000, 48000, 32000 };
+static const int NUM_ENCODER_BITRATES = sizeof(ENCODER_BITRATES) / sizeof(ENCODER_BITRATES[0]);
+static const float ENCODER_LOSS_THRESHOLDS[] = { 1.0f, 3.0f, 6.0f, 12.0f }; // percent
+static const int ENCODER_HIGH_PING_MS = 250;
+static const float ENCODER_FEC_MIN_LOSS = 1.0f; // percent
+static const int ENCODER_FEC_MAX_EXPECTED_LOSS = 30; // percent
+// outbound mix complexities, stepped down as the listener's loudest source gets quieter or further away
+static const int ENCODER_COMPLEXITIES[] = { 10, 8, 6, 4 };
+static const int NUM_ENCODER_COMPLEXITIES = sizeof(ENCODER_COMPLEXITIES) / sizeof(ENCODER_COMPLEXITIES[0]);
+static const float ENCODER_SOURCE_GAIN_THRESHOLDS[] = { 0.25f, 0.0625f }; // -12dB, -24dB
+
 AudioMixerClientData::AudioMixerClientData(const QUuid& nodeID, Node::LocalID nodeLocalID) :
     NodeData(nodeID, nodeLocalID),
     audioLimiter(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO),
@@ -757,10 +769,71 @@ void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
     _shouldFlushEncoder = false;
 }
 
+void AudioMixerClientData::updateEncoderSettings(const Node& listener, bool isThrottling) {
+    // the loudest source heard since the last update
+    float loudestSourceGain = _loudestSourceGain;
+    _loudestSourceGain = 0.0f;
+
+    if (!_encoder || !_encoder->isTunable()) {
+        return;
+    }
+
+    // the listener reports the loss it sees on the mixed stream with its downstream stats
+    float lossPercentage = _downstreamAudioStreamStats._packetStreamWindowStats.getLostRate() * 100.0f;
+
+    // step down one bitrate for every loss threshold crossed, and one more on a long round trip
+    int bitrateIndex = 0;
+    for (float lossThreshold : ENCODER_LOSS_THRESHOLDS) {
+        if (lossPercentage >= lossThreshold) {
+            ++bitrateIndex;
+        }
+    }
+    if (listener.getPingMs() > ENCODER_HIGH_PING_MS) {
+        ++bitrateIndex;
+    }
+    int bitrate = ENCODER_BITRATES[std::min(bitrateIndex, NUM_ENCODER_BITRATES - 1)];
+
+    // a listener whose sources are all distant or quiet hears an attenuated mix, where the encoder's
+    // extra effort is least audible, so it is encoded with less; one step less again while the mixer is throttling
+    int complexityIndex = 0;
+    for (float gainThreshold : ENCODER_SOURCE_GAIN_THRESHOLDS) {
+        if (loudestSourceGain < gainThreshold) {
+            ++complexityIndex;
+        }
+    }
+    if (isThrottling) {
+        ++complexityIndex;
+    }
+    int complexity = ENCODER_COMPLEXITIES[std::min(complexityIndex, NUM_ENCODER_COMPLEXITIES - 1)];
+
+    // in-band FEC costs bitrate, only spend it once the listener is actually losing packets
+    int expectedLoss = 0;
+    if (lossPercentage >= ENCODER_FEC_MIN_LOSS) {
+        expectedLoss = std::min((int)ceilf(lossPercentage), ENCODER_FEC_MAX_EXPECTED_LOSS);
+    }
+
+    if (bitrate != _encoderBitrate.load(std::memory_order_relaxed)) {
+        _encoder->setBitrate(bitrate);
+        _encoderBitrate.store(bitrate, std::memory_order_relaxed);
+    }
+    if (complexity != _encoderComplexity.load(std::memory_order_relaxed)) {
+        _encoder->setComplexity(complexity);
+        _encoderComplexity.store(complexity, std::memory_order_relaxed);
+    }
+    if (expectedLoss != _encoderExpectedLoss.load(std::memory_order_relaxed)) {
+        _encoder->setInbandFEC(expectedLoss > 0 ? 1 : 0);
+        _encoder->setExpectedPacketLossPercentage(expectedLoss);
+        _encoderExpectedLoss.store(expectedLoss, std::memory_order_relaxed);
+    }
+}
+
 void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& codecName) {
     cleanupCodec(); // cleanup any previously allocated coders first
     _codec = codec;
     _selectedCodecName = codecName;
+    _encoderBitrate.store(-1, std::memory_order_relaxed);
+    _encoderComplexity.store(-1, std::memory_order_relaxed);
+    _encoderExpectedLoss.store(-1, std::memory_order_relaxed);
     if (codec) {
         _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
@@ -12,6 +12,8 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
+#include <algorithm>
+#include <atomic>
 #include <queue>
 
 #include <tbb/concurrent_vector.h>
@@ -103,6 +105,16 @@ public:
     void encodeFrameOfZeros(QByteArray& encodedZeros);
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
 
+    // adapts the outbound encoder to the loss the listener reports, its ping and how loud its sources are,
+    // called about once a second by the slave mixing for this listener
+    void updateEncoderSettings(const Node& listener, bool isThrottling);
+    // the gain of the loudest source in a mix, called by the slave for each mix
+    void noteLoudestSourceGain(float gain) { _loudestSourceGain = std::max(_loudestSourceGain, gain); }
+    // read by the stats thread while a slave may be tuning the encoder
+    int getEncoderBitrate() const { return _encoderBitrate.load(std::memory_order_relaxed); }
+    int getEncoderComplexity() const { return _encoderComplexity.load(std::memory_order_relaxed); }
+    bool getEncoderUsesFEC() const { return _encoderExpectedLoss.load(std::memory_order_relaxed) > 0; }
+
     QString getCodecName() { return _selectedCodecName; }
 
     bool shouldMuteClient() { return _shouldMuteClient; }
@@ -200,6 +212,13 @@ private:
 
     bool _shouldFlushEncoder { false };
 
+    // current settings of a tunable _encoder, -1 until first applied
+    std::atomic<int> _encoderBitrate { -1 };
+    std::atomic<int> _encoderComplexity { -1 };
+    std::atomic<int> _encoderExpectedLoss { -1 };
+    // the highest gain of any source mixed since the encoder was last tuned
+    float _loudestSourceGain { 0.0f };
+
     bool _shouldMuteClient { false };
     bool _requestsDomainListData { false };
 
@@ -12,6 +12,7 @@
 #include "AudioMixerSlave.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -58,8 +59,13 @@ inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
+        auto start = p_high_resolution_clock::now();
+
         // process packets and collect the number of streams available for this frame
         stats.sumStreams += data->processPackets(_sharedData.addedStreams);
+
+        auto end = p_high_resolution_clock::now();
+        stats.packetProcessingTimes.record(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
     }
 }
 
@@ -95,28 +101,36 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
     // send audio packets, if necessary
     if (node->getType() == NodeType::Agent && node->getActiveSocket()) {
         ++stats.sumListeners;
+        auto mixStart = p_high_resolution_clock::now();
 
         // mix the audio
         bool mixHasAudio = prepareMix(node);
 
         // send audio packet
         if (mixHasAudio || data->shouldFlushEncoder()) {
-            QByteArray encodedBuffer;
             if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
+                // encode the audio, straight from the mix buffer into the reused encode buffer
+                QByteArray decodedBuffer = QByteArray::fromRawData(reinterpret_cast<char*>(_bufferSamples),
+                                                                   AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+                data->encode(decodedBuffer, _encodedBuffer);
+                ++stats.encodes;
             } else {
                 // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
+                data->encodeFrameOfZeros(_encodedBuffer);
             }
 
-            sendMixPacket(node, *data, encodedBuffer);
+            sendMixPacket(node, *data, _encodedBuffer);
         } else {
+            // silent frames carry no audio, so silent listeners never cost an encode
             ++stats.sumListenersSilent;
             sendSilentPacket(node, *data);
         }
 
+        auto mixEnd = p_high_resolution_clock::now();
+        stats.listenerMixTimes.record(std::chrono::duration_cast<std::chrono::microseconds>(mixEnd - mixStart).count());
+        auto sendLatency = std::chrono::duration_cast<std::chrono::microseconds>(mixEnd - _sharedData.frameStart).count();
+        stats.sendLatencies.record(std::max(sendLatency, (decltype(sendLatency))0));
+
         // send environment packet
         sendEnvironmentPacket(node, *data);
 
@@ -124,11 +138,14 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         const unsigned int NUM_FRAMES_PER_SEC = (int)ceil(AudioConstants::NETWORK_FRAMES_PER_SEC);
         if (data->shouldSendStats(_frame % NUM_FRAMES_PER_SEC)) {
             data->sendAudioStreamStatsPackets(node);
+
+            // and retune the listener's encoder at the same rate
+            bool isThrottling = _numToRetain != -1;
+            data->updateEncoderSettings(*node, isThrottling);
         }
     }
 }
 
-
 template <class Container, class Predicate>
 void erase_if(Container& cont, Predicate&& pred) {
     auto it = remove_if(begin(cont), end(cont), std::forward<Predicate>(pred));
@@ -312,6 +329,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     // zero out the mix for this listener
     memset(_mixSamples, 0, sizeof(_mixSamples));
+    _loudestSourceGain = 0.0f;
 
     bool isThrottling = _numToRetain != -1;
     bool isSoloing = !listenerData->getSoloedNodes().empty();
@@ -460,6 +478,8 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         });
     }
 
+    listenerData->noteLoudestSourceGain(_loudestSourceGain);
+
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
@@ -546,6 +566,11 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         }
     }
 
+    // how loud the closest source is sets how hard the listener's encoder works
+    if (!isEcho) {
+        _loudestSourceGain = std::max(_loudestSourceGain, gain);
+    }
+
     // grab the stream from the ring buffer
     AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd->getLastPopOutput();
 
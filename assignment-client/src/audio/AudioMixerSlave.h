@@ -20,6 +20,7 @@
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 #include <NodeList.h>
+#include <PortableHighResolutionClock.h>
 #include <PositionalAudioStream.h>
 
 #include "AudioMixerClientData.h"
@@ -31,11 +32,12 @@ class AudioHRTF;
 class AudioMixerSlave {
 public:
     using ConstIter = NodeList::const_iterator;
-    
+
     struct SharedData {
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        p_high_resolution_clock::time_point frameStart; // when the current frame was scheduled to start
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -71,6 +73,8 @@ private:
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    QByteArray _encodedBuffer { AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0 }; // reused across frames and listeners
+    float _loudestSourceGain { 0.0f }; // of the mix being prepared
 
     // frame state
     ConstIter _begin;
@@ -16,6 +16,8 @@ void AudioMixerStats::reset() {
     sumListeners = 0;
     sumListenersSilent = 0;
 
+    encodes = 0;
+
     totalMixes = 0;
 
     hrtfRenders = 0;
@@ -36,6 +38,10 @@ void AudioMixerStats::reset() {
     inactive = 0;
     active = 0;
 
+    listenerMixTimes.reset();
+    sendLatencies.reset();
+    packetProcessingTimes.reset();
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
 #endif
@@ -46,6 +52,8 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     sumListeners += otherStats.sumListeners;
     sumListenersSilent += otherStats.sumListenersSilent;
 
+    encodes += otherStats.encodes;
+
     totalMixes += otherStats.totalMixes;
 
     hrtfRenders += otherStats.hrtfRenders;
@@ -66,6 +74,10 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     inactive += otherStats.inactive;
     active += otherStats.active;
 
+    listenerMixTimes.merge(otherStats.listenerMixTimes);
+    sendLatencies.merge(otherStats.sendLatencies);
+    packetProcessingTimes.merge(otherStats.packetProcessingTimes);
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
 #endif
@@ -12,15 +12,17 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
+
+#include <LatencyHistogram.h>
 
 struct AudioMixerStats {
     int sumStreams { 0 };
     int sumListeners { 0 };
     int sumListenersSilent { 0 };
 
+    int encodes { 0 };
+
     int totalMixes { 0 };
 
     int hrtfRenders { 0 };
@@ -41,6 +43,13 @@ struct AudioMixerStats {
     int inactive { 0 };
     int active { 0 };
 
+    // per listener: from the start of its mix to its packets being sent
+    LatencyHistogram listenerMixTimes;
+    // per listener: from when the frame was scheduled to start to its mix being sent
+    LatencyHistogram sendLatencies;
+    // per node: processing its queued packets
+    LatencyHistogram packetProcessingTimes;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
 #endif
@@ -11,6 +11,7 @@
 
 #include "AvatarMixer.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <chrono>
 #include <memory>
@@ -69,6 +70,7 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     DependencyManager::set<ResourceManager>();
     // make sure we hear about node kills so we can tell the other nodes
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &AvatarMixer::handleAvatarKilled);
+    connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &AvatarMixer::handleBotNodeKilled);
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::AvatarData, this, "queueIncomingPacket");
@@ -92,11 +94,23 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
 
     packetReceiver.registerListener(PacketType::ReplicatedBulkAvatarData, this, "handleReplicatedBulkAvatarPacket");
 
+    packetReceiver.registerListener(PacketType::BotAvatarData, this, "handleBotAvatarPacket");
+    packetReceiver.registerListener(PacketType::BotKillAvatar, this, "handleBotKillAvatarPacket");
+
     auto nodeList = DependencyManager::get<NodeList>();
     connect(nodeList.data(), &NodeList::packetVersionMismatch, this, &AvatarMixer::handlePacketVersionMismatch);
     connect(nodeList.data(), &NodeList::nodeAdded, this, [this](const SharedNodePointer& node) {
         if (node->getType() == NodeType::DownstreamAvatarMixer) {
             getOrCreateClientData(node);
+        } else if (!node->isReplicated()) {
+            // the domain handed out a local ID a bot borrowed while it was free, so drop the bot
+            // and it comes back with a fresh ID on its next update
+            for (auto it = _bots.cbegin(); it != _bots.cend(); ++it) {
+                if (it->localID == node->getLocalID()) {
+                    DependencyManager::get<NodeList>()->killNodeWithUUID(it.key());
+                    break;
+                }
+            }
         }
     });
 }
@@ -168,6 +182,154 @@ void AvatarMixer::handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessag
     }
 }
 
+static const int MAX_BOTS_PER_AGENT = 1000;
+
+Node::LocalID AvatarMixer::allocateBotLocalID() {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // count down from the top of the range, skipping IDs held by real nodes or other bots
+    const int NUM_LOCAL_IDS = std::numeric_limits<Node::LocalID>::max();
+    for (int i = 0; i < NUM_LOCAL_IDS; ++i) {
+        Node::LocalID localID = _nextBotLocalID--;
+        if (_nextBotLocalID == Node::NULL_LOCAL_ID) {
+            _nextBotLocalID = std::numeric_limits<Node::LocalID>::max();
+        }
+
+        if (nodeList->nodeWithLocalID(localID)) {
+            continue;
+        }
+        bool isTaken = std::any_of(_bots.cbegin(), _bots.cend(), [localID](const BotInfo& bot) {
+            return bot.localID == localID;
+        });
+        if (!isTaken) {
+            return localID;
+        }
+    }
+    return Node::NULL_LOCAL_ID;
+}
+
+SharedNodePointer AvatarMixer::addOrUpdateBotNode(const QUuid& botID, const SharedNodePointer& ownerNode,
+                                                  const HifiSockAddr& senderSockAddr) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    auto botIt = _bots.find(botID);
+    if (botIt == _bots.end()) {
+        if (botID.isNull() || nodeList->nodeWithUUID(botID)) {
+            // a bot can never take over an existing node
+            return SharedNodePointer();
+        }
+
+        int& numOwnedBots = _botCountByOwner[ownerNode->getUUID()];
+        if (numOwnedBots >= MAX_BOTS_PER_AGENT) {
+            return SharedNodePointer();
+        }
+
+        auto localID = allocateBotLocalID();
+        if (localID == Node::NULL_LOCAL_ID) {
+            return SharedNodePointer();
+        }
+
+        ++numOwnedBots;
+        botIt = _bots.insert(botID, { ownerNode->getUUID(), localID });
+    } else if (botIt->ownerID != ownerNode->getUUID()) {
+        return SharedNodePointer();
+    }
+
+    // bots are relayed like replicated avatars: the mixer never sends to them and they share their owner's socket
+    auto botNode = nodeList->addOrUpdateNode(botID, NodeType::Agent, senderSockAddr, senderSockAddr,
+                                             botIt->localID, true, true);
+    botNode->setLastHeardMicrostamp(usecTimestampNow());
+
+    return botNode;
+}
+
+void AvatarMixer::handleBotAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    // playing back bots is limited to agents trusted to create content in the domain
+    if (!senderNode->getCanRez()) {
+        qCDebug(avatars) << "Refusing bot avatar data from" << senderNode->getUUID() << "without rez permission";
+        return;
+    }
+
+    static const int BOT_ENTRY_HEADER_SIZE = NUM_BYTES_RFC4122_UUID + sizeof(PacketType) + sizeof(quint16);
+
+    while (message->getBytesLeftToRead() >= BOT_ENTRY_HEADER_SIZE) {
+        // each entry is the bot ID, the type of the packet the bot would have sent and that packet's payload
+        auto botID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+        PacketType botPacketType;
+        message->readPrimitive(&botPacketType);
+
+        quint16 botPayloadSize;
+        message->readPrimitive(&botPayloadSize);
+
+        if (message->getBytesLeftToRead() < botPayloadSize) {
+            qCDebug(avatars) << "Refusing truncated bot avatar data from" << senderNode->getUUID();
+            return;
+        }
+        auto botPayload = message->read(botPayloadSize);
+
+        if (botPacketType != PacketType::AvatarData && botPacketType != PacketType::AvatarIdentity
+            && botPacketType != PacketType::SetAvatarTraits) {
+            continue;
+        }
+
+        auto botNode = addOrUpdateBotNode(botID, senderNode, message->getSenderSockAddr());
+        if (!botNode) {
+            continue;
+        }
+
+        auto botMessage = QSharedPointer<ReceivedMessage>::create(botPayload, botPacketType,
+                                                                  versionForPacketType(botPacketType),
+                                                                  message->getSenderSockAddr(), Node::NULL_LOCAL_ID);
+
+        if (botPacketType == PacketType::AvatarIdentity) {
+            handleAvatarIdentityPacket(botMessage, botNode);
+        } else {
+            queueIncomingPacket(botMessage, botNode);
+        }
+    }
+}
+
+void AvatarMixer::handleBotKillAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    while (message->getBytesLeftToRead() >= NUM_BYTES_RFC4122_UUID) {
+        auto botID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+        auto botIt = _bots.find(botID);
+        if (botIt != _bots.end() && botIt->ownerID == senderNode->getUUID()) {
+            nodeList->killNodeWithUUID(botID);
+        }
+    }
+}
+
+void AvatarMixer::handleBotNodeKilled(SharedNodePointer killedNode) {
+    auto botIt = _bots.find(killedNode->getUUID());
+    if (botIt != _bots.end()) {
+        auto ownerIt = _botCountByOwner.find(botIt->ownerID);
+        if (ownerIt != _botCountByOwner.end() && --ownerIt.value() <= 0) {
+            _botCountByOwner.erase(ownerIt);
+        }
+        _bots.erase(botIt);
+        return;
+    }
+
+    if (_botCountByOwner.contains(killedNode->getUUID())) {
+        // the agent playing these bots is gone, so are its bots
+        QVector<QUuid> ownedBots;
+        for (auto it = _bots.cbegin(); it != _bots.cend(); ++it) {
+            if (it->ownerID == killedNode->getUUID()) {
+                ownedBots.push_back(it.key());
+            }
+        }
+
+        auto nodeList = DependencyManager::get<NodeList>();
+        for (const auto& botID : ownedBots) {
+            nodeList->killNodeWithUUID(botID);
+        }
+    }
+}
+
 void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node& node) {
     // first, make sure that this is a packet from a node we are supposed to replicate
     if (node.isReplicated()) {
@@ -251,7 +413,9 @@ void AvatarMixer::start() {
     while (!_isFinished) {
 
         auto frameDuration = timeFrame(frameTimestamp); // calculates last frame duration and sleeps remainder of target amount
+        _frameTimes.record(frameDuration.count());
         throttle(frameDuration, frame); // determines _throttlingRatio for upcoming mix frame
+        _slaveSharedData.frameStart = frameTimestamp;
 
         int lockWait, nodeTransform, functor;
 
@@ -755,6 +919,7 @@ void AvatarMixer::sendStatsPacket() {
     statsObject["threads"] = _slavePool.numThreads();
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
+    statsObject["bots"] = _bots.size();
 
 #ifdef DEBUG_EVENT_QUEUE
     QJsonObject qtStats;
@@ -848,6 +1013,15 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["slaves_aggregate (per frame)"] = slavesAggregatObject;
 
+    // tails of the per-frame timings, in microseconds
+    QJsonObject latencyStats;
+    latencyStats["frame_us"] = _frameTimes.toJson();
+    latencyStats["listener_broadcast_us"] = aggregateStats.listenerBroadcastTimes.toJson();
+    latencyStats["send_latency_us"] = aggregateStats.sendLatencies.toJson();
+    latencyStats["packet_processing_us"] = aggregateStats.packetProcessingTimes.toJson();
+    statsObject["latency_histograms"] = latencyStats;
+    _frameTimes.reset();
+
     _handleViewFrustumPacketElapsedTime = 0;
     _handleAvatarIdentityPacketElapsedTime = 0;
     _handleKillAvatarPacketElapsedTime = 0;
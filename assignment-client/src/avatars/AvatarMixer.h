@@ -15,6 +15,7 @@
 #ifndef hifi_AvatarMixer_h
 #define hifi_AvatarMixer_h
 
+#include <limits>
 #include <set>
 #include <shared/RateCounter.h>
 #include <PortableHighResolutionClock.h>
@@ -62,6 +63,9 @@ private slots:
     void handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleReplicatedPacket(QSharedPointer<ReceivedMessage> message);
     void handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessage> message);
+    void handleBotAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleBotKillAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleBotNodeKilled(SharedNodePointer killedNode);
     void domainSettingsRequestComplete();
     void handlePacketVersionMismatch(PacketType type, const HifiSockAddr& senderSockAddr, const QUuid& senderUUID);
     void handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
@@ -79,6 +83,10 @@ private:
 
     void optionallyReplicatePacket(ReceivedMessage& message, const Node& node);
 
+    SharedNodePointer addOrUpdateBotNode(const QUuid& botID, const SharedNodePointer& ownerNode,
+                                         const HifiSockAddr& senderSockAddr);
+    Node::LocalID allocateBotLocalID();
+
     void setupEntityQuery();
 
     p_high_resolution_clock::time_point _lastFrameTimestamp;
@@ -122,6 +130,16 @@ private:
 
     std::set<SessionDisplayName> _sessionDisplayNames;
 
+    // Avatars played back by bot-farm agents. They are replicated nodes owned by the agent that sends them,
+    // with local IDs handed out here since the domain server never sees them.
+    struct BotInfo {
+        QUuid ownerID;
+        Node::LocalID localID;
+    };
+    QHash<QUuid, BotInfo> _bots;
+    QHash<QUuid, int> _botCountByOwner;
+    Node::LocalID _nextBotLocalID { std::numeric_limits<Node::LocalID>::max() };
+
     quint64 _displayNameManagementElapsedTime { 0 }; // total time spent in broadcastAvatarData/display name management... since last stats window
     quint64 _ignoreCalculationElapsedTime { 0 };
     quint64 _avatarDataPackingElapsedTime { 0 };
@@ -133,6 +151,8 @@ private:
     quint64 _broadcastAvatarDataNodeTransform { 0 };
     quint64 _broadcastAvatarDataNodeFunctor { 0 };
 
+    LatencyHistogram _frameTimes;
+
     quint64 _handleAdjustAvatarSortingElapsedTime { 0 };
     quint64 _handleViewFrustumPacketElapsedTime { 0 };
     quint64 _handleAvatarIdentityPacketElapsedTime { 0 };
@@ -68,6 +68,9 @@ void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
     }
     auto end = usecTimestampNow();
     _stats.processIncomingPacketsElapsedTime += (end - start);
+    if (nodeData) {
+        _stats.packetProcessingTimes.record(end - start);
+    }
 }
 
 int AvatarMixerSlave::sendIdentityPacket(NLPacketList& packetList, const AvatarMixerClientData* nodeData, const Node& destinationNode) {
@@ -267,6 +270,10 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
 
     if ((node->getType() == NodeType::Agent || node->getType() == NodeType::EntityScriptServer) && node->getLinkedData() && node->getActiveSocket() && !node->isUpstream()) {
         broadcastAvatarDataToAgent(node);
+
+        _stats.listenerBroadcastTimes.record(usecTimestampNow() - start);
+        auto sendLatency = chrono::duration_cast<chrono::microseconds>(p_high_resolution_clock::now() - _sharedData->frameStart).count();
+        _stats.sendLatencies.record(std::max(sendLatency, (decltype(sendLatency))0));
     } else if (node->getType() == NodeType::DownstreamAvatarMixer) {
         broadcastAvatarDataToDownstreamMixer(node);
     }
@@ -12,6 +12,7 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <LatencyHistogram.h>
 #include <NodeList.h>
 
 class AvatarMixerClientData;
@@ -40,6 +41,13 @@ public:
     quint64 toByteArrayElapsedTime { 0 };
     quint64 jobElapsedTime { 0 };
 
+    // per node: processing its queued packets
+    LatencyHistogram packetProcessingTimes;
+    // per listener: building and sending its avatar data
+    LatencyHistogram listenerBroadcastTimes;
+    // per listener: from when the frame was scheduled to start to its avatar data being sent
+    LatencyHistogram sendLatencies;
+
     void reset() {
         // receiving job stats
         nodesProcessed = 0;
@@ -65,6 +73,10 @@ public:
         packetSendingElapsedTime = 0;
         toByteArrayElapsedTime = 0;
         jobElapsedTime = 0;
+
+        packetProcessingTimes.reset();
+        listenerBroadcastTimes.reset();
+        sendLatencies.reset();
     }
 
     AvatarMixerSlaveStats& operator+=(const AvatarMixerSlaveStats& rhs) {
@@ -89,6 +101,10 @@ public:
         packetSendingElapsedTime += rhs.packetSendingElapsedTime;
         toByteArrayElapsedTime += rhs.toByteArrayElapsedTime;
         jobElapsedTime += rhs.jobElapsedTime;
+
+        packetProcessingTimes.merge(rhs.packetProcessingTimes);
+        listenerBroadcastTimes.merge(rhs.listenerBroadcastTimes);
+        sendLatencies.merge(rhs.sendLatencies);
         return *this;
     }
 };
@@ -100,6 +116,7 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+    p_high_resolution_clock::time_point frameStart; // when the current frame was scheduled to start
 };
 
 class AvatarMixerSlave {
@@ -14,6 +14,8 @@ $(document).ready(function(){
 
       delete json.node_type;
 
+      showLatencyHistograms(json.latency_histograms);
+
       var stats = JsonHuman.format(json);
 
       $('#stats-container').html(stats);
@@ -45,6 +47,34 @@ $(document).ready(function(){
     });
   }
 
+  // summarize the mixer's latency histograms, which are in microseconds, as a table in milliseconds
+  function showLatencyHistograms(histograms) {
+    if (!histograms) {
+      $('#latency-container').empty();
+      return;
+    }
+
+    var columns = ['p50', 'p95', 'p99', 'max'];
+    var html = "<table class='table table-condensed'><thead><tr><th>Latency (ms)</th>";
+    columns.forEach(function(column) {
+      html += "<th>" + column + "</th>";
+    });
+    html += "<th>count</th></tr></thead><tbody>";
+
+    Object.keys(histograms).sort().forEach(function(name) {
+      var histogram = histograms[name];
+      html += "<tr><td>" + name + "</td>";
+      columns.forEach(function(column) {
+        html += "<td><span class='graphable-stat' data-keypath='latency_histograms." + name + "." + column + "'>"
+          + (histogram[column] / 1000).toFixed(2) + "</span></td>";
+      });
+      html += "<td>" + histogram.count + "</td></tr>";
+    });
+    html += "</tbody></table>";
+
+    $('#latency-container').html(html);
+  }
+
   // do the first GET on page load
   getNodeStats();
   // grab the new assignments JSON every second
@@ -101,7 +131,7 @@ $(document).ready(function(){
   }
 
   // handle clicks on numerical values - this lets the user show a line graph in a modal
-  $('#stats-container').on('click', '.graphable-stat', function(){
+  $('#stats-container, #latency-container').on('click', '.graphable-stat', function(){
     graphKeypath = $(this).data('keypath');
 
     // setup the new graph modal
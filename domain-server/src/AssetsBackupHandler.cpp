@@ -394,9 +394,15 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
         return;
     }
 
+    // several paths can map to the same asset, which only needs to be in the zip once
+    set<AssetUtils::AssetHash> hashes;
     for (const auto& mapping : it->mappings) {
-        const auto& hash = mapping.second;
+        hashes.insert(mapping.second);
+    }
 
+    static const qint64 COPY_BLOCK_SIZE = 1024 * 1024;
+    QByteArray block;
+    for (const auto& hash : hashes) {
         QDir assetsDir { _assetsDirectory };
         QFile file { assetsDir.filePath(hash) };
         if (!file.open(QFile::ReadOnly)) {
@@ -409,7 +415,14 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
             qCDebug(asset_backup) << "Could not open zip file:" << zipFile.getZipError();
             continue;
         }
-        zipFile.write(file.readAll());
+        // copy a block at a time so that large assets are never held in memory whole
+        while (!file.atEnd()) {
+            block = file.read(COPY_BLOCK_SIZE);
+            if (block.isEmpty() || zipFile.write(block) != block.size()) {
+                qCCritical(asset_backup) << "Could not copy asset file" << file.fileName() << "to zip";
+                break;
+            }
+        }
         zipFile.close();
         if (zipFile.getZipError() != UNZ_OK) {
             qCDebug(asset_backup) << "Could not close zip file: " << zipFile.getZipError();
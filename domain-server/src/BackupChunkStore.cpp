@@ -0,0 +1,108 @@
+//
+//  BackupChunkStore.cpp
+//  domain-server/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BackupChunkStore.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+
+#include <AssetUtils.h>
+#include <Gzip.h>
+
+static const QString TEMPORARY_CHUNK_EXTENSION { ".part" };
+
+BackupChunkStore::BackupChunkStore(const QString& directory) :
+    _directory(directory)
+{
+    QDir(_directory).mkpath(".");
+
+    QDirIterator it(_directory, QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        auto fileName = it.fileName();
+        if (AssetUtils::isValidHash(fileName)) {
+            _chunks.insert(fileName);
+        } else if (fileName.endsWith(TEMPORARY_CHUNK_EXTENSION)) {
+            // left over from a write that was interrupted
+            QFile::remove(it.filePath());
+        }
+    }
+}
+
+QString BackupChunkStore::pathForHash(const Hash& hash) const {
+    // spread the chunks over subdirectories so that no directory grows too large
+    return _directory + "/" + hash.left(2) + "/" + hash;
+}
+
+BackupChunkStore::Hash BackupChunkStore::store(const QByteArray& data) {
+    Hash hash = AssetUtils::hashData(data).toHex();
+    if (contains(hash)) {
+        return hash;
+    }
+
+    QByteArray compressed;
+    if (!gzip(data, compressed)) {
+        qCritical() << "Failed to compress backup chunk" << hash;
+        return Hash();
+    }
+
+    auto path = pathForHash(hash);
+    QDir(_directory).mkpath(hash.left(2));
+
+    // write under a temporary name so that a chunk on disk is always complete
+    QFile file { path + TEMPORARY_CHUNK_EXTENSION };
+    if (!file.open(QIODevice::WriteOnly) || file.write(compressed) != compressed.size()) {
+        qCritical() << "Failed to write backup chunk" << file.fileName() << file.errorString();
+        file.remove();
+        return Hash();
+    }
+    file.close();
+
+    if (!file.rename(path)) {
+        qCritical() << "Failed to rename backup chunk" << file.fileName() << file.errorString();
+        file.remove();
+        return Hash();
+    }
+
+    _chunks.insert(hash);
+    return hash;
+}
+
+bool BackupChunkStore::load(const Hash& hash, QByteArray& data) const {
+    if (!contains(hash)) {
+        return false;
+    }
+
+    QFile file { pathForHash(hash) };
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open backup chunk" << file.fileName() << file.errorString();
+        return false;
+    }
+    return gunzip(file.readAll(), data);
+}
+
+int BackupChunkStore::removeUnreferenced(const std::set<Hash>& referenced) {
+    int removed = 0;
+    auto it = _chunks.begin();
+    while (it != _chunks.end()) {
+        if (referenced.find(*it) != referenced.end()) {
+            ++it;
+        } else if (QFile::remove(pathForHash(*it))) {
+            it = _chunks.erase(it);
+            ++removed;
+        } else {
+            qWarning() << "Could not delete backup chunk:" << *it;
+            ++it;
+        }
+    }
+    return removed;
+}
@@ -0,0 +1,44 @@
+//
+//  BackupChunkStore.h
+//  domain-server/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BackupChunkStore_h
+#define hifi_BackupChunkStore_h
+
+#include <set>
+
+#include <QByteArray>
+#include <QString>
+
+// Keeps pieces of backup content on disk, gzipped and named by the SHA-256 of their data, so content that
+// doesn't change between backups is only written once no matter how many backups refer to it.
+class BackupChunkStore {
+public:
+    using Hash = QString;
+
+    BackupChunkStore(const QString& directory);
+
+    // Returns the hash of the chunk, writing it only if it isn't stored yet.  Empty if it couldn't be written.
+    Hash store(const QByteArray& data);
+    bool contains(const Hash& hash) const { return _chunks.find(hash) != _chunks.end(); }
+    bool load(const Hash& hash, QByteArray& data) const;
+
+    // Deletes every stored chunk that isn't referenced, returns how many were deleted
+    int removeUnreferenced(const std::set<Hash>& referenced);
+
+    size_t getNumChunks() const { return _chunks.size(); }
+
+private:
+    QString pathForHash(const Hash& hash) const;
+
+    QString _directory;
+    std::set<Hash> _chunks;
+};
+
+#endif // hifi_BackupChunkStore_h
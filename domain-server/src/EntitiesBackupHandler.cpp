@@ -12,6 +12,8 @@
 #include "EntitiesBackupHandler.h"
 
 #include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
 
 #if !defined(__clang__) && defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -25,40 +27,233 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <AssetUtils.h>
+#include <Gzip.h>
 #include <OctreeDataUtils.h>
 
-EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath) :
+EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath,
+                                             const QString& backupDirectory) :
     _entitiesFilePath(entitiesFilePath),
-    _entitiesReplacementFilePath(entitiesReplacementFilePath)
+    _entitiesReplacementFilePath(entitiesReplacementFilePath),
+    _chunkStore(backupDirectory + "/entities")
 {
 }
 
 static const QString ENTITIES_BACKUP_FILENAME = "models.json.gz";
+static const QString ENTITIES_MANIFEST_FILENAME = "models.manifest.json";
+
+static const QString MANIFEST_DATA_VERSION = "DataVersion";
+static const QString MANIFEST_ID = "Id";
+static const QString MANIFEST_VERSION = "Version";
+static const QString MANIFEST_CHUNKS = "Chunks";
+static const QString MANIFEST_SOURCE_HASH = "SourceHash";
+
+// A chunk ends after an entity whose ID is a multiple of this, so about this many entities go in each chunk
+static const int ENTITIES_PER_CHUNK_TARGET = 64;
+static const int MAX_ENTITIES_PER_CHUNK = 4 * ENTITIES_PER_CHUNK_TARGET;
+
+static bool readManifest(QuaZip& zip, QJsonObject& manifest) {
+    if (!zip.setCurrentFile(ENTITIES_MANIFEST_FILENAME)) {
+        return false;
+    }
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open" << ENTITIES_MANIFEST_FILENAME << "in backup";
+        return false;
+    }
+    auto document = QJsonDocument::fromJson(zipFile.readAll());
+    zipFile.close();
+    if (!document.isObject() || !document.object()[MANIFEST_CHUNKS].isArray()) {
+        qCritical() << "Failed to parse" << ENTITIES_MANIFEST_FILENAME << "in backup";
+        return false;
+    }
+    manifest = document.object();
+    return true;
+}
+
+void EntitiesBackupHandler::loadBackup(const QString& backupName, QuaZip& zip) {
+    // backups made before entities were chunked hold the full entities file, there is nothing to track for those
+    if (!zip.setCurrentFile(ENTITIES_MANIFEST_FILENAME)) {
+        return;
+    }
+
+    QJsonObject manifest;
+    if (!readManifest(zip, manifest) || !hasAllChunks(manifest)) {
+        qCritical() << "Entities backup" << backupName << "is corrupted";
+        _corruptedBackups.insert(backupName);
+        return;
+    }
+    _manifests[backupName] = manifest;
+}
+
+void EntitiesBackupHandler::loadingComplete() {
+    removeUnreferencedChunks();
+}
+
+bool EntitiesBackupHandler::hasAllChunks(const QJsonObject& manifest) const {
+    for (const auto& chunk : manifest[MANIFEST_CHUNKS].toArray()) {
+        if (!_chunkStore.contains(chunk.toString())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QJsonObject EntitiesBackupHandler::storeEntityChunks(const QByteArray& entityData) {
+    OctreeUtils::RawEntityData data;
+    if (!data.readOctreeDataInfoFromData(entityData)) {
+        qCritical() << "Unable to parse octree data for backup";
+        return QJsonObject();
+    }
+
+    // Chunks hold entities exactly as RawEntityData writes them, so joining them with commas rebuilds the file
+    QJsonArray chunks;
+    QByteArray chunk;
+    int entitiesInChunk = 0;
+    auto storeChunk = [&]() {
+        auto hash = _chunkStore.store(chunk);
+        chunk.clear();
+        entitiesInChunk = 0;
+        if (hash.isEmpty()) {
+            return false;
+        }
+        chunks.append(hash);
+        return true;
+    };
+
+    for (const auto& entity : data.variantEntityData) {
+        auto entityObject = entity.toJsonObject();
+        if (entitiesInChunk > 0) {
+            chunk += ",";
+        }
+        chunk += "\n    ";
+        // Convert to string and remove trailing LF.
+        chunk += QJsonDocument(entityObject).toJson().chopped(1);
+        ++entitiesInChunk;
+
+        // splitting on entity IDs rather than counts keeps adding or removing an entity from shifting every later chunk
+        QUuid entityID { entityObject.value("id").toString() };
+        bool isBoundary = !entityID.isNull() && (entityID.data1 % (uint)ENTITIES_PER_CHUNK_TARGET) == 0;
+        if ((isBoundary || entitiesInChunk >= MAX_ENTITIES_PER_CHUNK) && !storeChunk()) {
+            return QJsonObject();
+        }
+    }
+    if (entitiesInChunk > 0 && !storeChunk()) {
+        return QJsonObject();
+    }
+
+    QJsonObject manifest;
+    manifest[MANIFEST_DATA_VERSION] = (qint64)data.dataVersion;
+    manifest[MANIFEST_ID] = data.id.toString();
+    manifest[MANIFEST_VERSION] = (qint64)data.version;
+    manifest[MANIFEST_CHUNKS] = chunks;
+    return manifest;
+}
+
+bool EntitiesBackupHandler::writeEntities(const QJsonObject& manifest, QIODevice& device, bool resetIdAndVersion) const {
+    auto dataVersion = (OctreeUtils::Version)manifest[MANIFEST_DATA_VERSION].toDouble();
+    auto version = (OctreeUtils::Version)manifest[MANIFEST_VERSION].toDouble();
+    QUuid id { manifest[MANIFEST_ID].toString() };
+    if (resetIdAndVersion) {
+        id = QUuid::createUuid();
+        dataVersion = OctreeUtils::INITIAL_VERSION;
+    }
+
+    // the same layout as RawOctreeData::toByteArray, one chunk in memory at a time
+    GzipWriter writer { device };
+    bool success = writer.write(QString("{\n  \"DataVersion\": %1,\n").arg(dataVersion).toUtf8());
+    success = success && writer.write("  \"Entities\": [");
+
+    auto chunks = manifest[MANIFEST_CHUNKS].toArray();
+    for (int i = 0; success && i < chunks.size(); ++i) {
+        QByteArray chunk;
+        if (!_chunkStore.load(chunks[i].toString(), chunk)) {
+            qCritical() << "Missing entities backup chunk" << chunks[i].toString();
+            return false;
+        }
+        if (i > 0) {
+            success = writer.write(",");
+        }
+        success = success && writer.write(chunk);
+    }
+
+    success = success && writer.write("]");
+    success = success && writer.write(QString(",\n  \"Id\": \"%1\",\n  \"Version\": %2\n}").arg(id.toString()).arg(version).toUtf8());
+    return success && writer.finish();
+}
+
+void EntitiesBackupHandler::removeUnreferencedChunks() {
+    if (!_corruptedBackups.empty()) {
+        qWarning() << "Some entities backups did not load properly, not deleting unused chunks for safety.";
+        return;
+    }
+
+    std::set<BackupChunkStore::Hash> referenced;
+    for (const auto& manifest : _manifests) {
+        for (const auto& chunk : manifest.second[MANIFEST_CHUNKS].toArray()) {
+            referenced.insert(chunk.toString());
+        }
+    }
+    auto removed = _chunkStore.removeUnreferenced(referenced);
+    if (removed > 0) {
+        qDebug() << "Deleted" << removed << "unused entities backup chunks," << _chunkStore.getNumChunks() << "remaining";
+    }
+}
 
 void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
     QFile entitiesFile { _entitiesFilePath };
 
     if (entitiesFile.open(QIODevice::ReadOnly)) {
+        auto entityData = entitiesFile.readAll();
+        QString sourceHash = AssetUtils::hashData(entityData).toHex();
+
+        QJsonObject manifest;
+        if (sourceHash == _lastManifest.value(MANIFEST_SOURCE_HASH).toString() && hasAllChunks(_lastManifest)) {
+            manifest = _lastManifest;
+        } else {
+            manifest = storeEntityChunks(entityData);
+            if (manifest.isEmpty()) {
+                qCritical() << "Failed to store entities for backup" << backupName;
+                return;
+            }
+            manifest[MANIFEST_SOURCE_HASH] = sourceHash;
+            _lastManifest = manifest;
+        }
+
         QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath))) {
-            qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
+        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_MANIFEST_FILENAME, _entitiesFilePath))) {
+            qCritical().nospace() << "Failed to open " << ENTITIES_MANIFEST_FILENAME << " for writing in zip";
             return;
         }
-        auto entityData = entitiesFile.readAll();
-        if (zipFile.write(entityData) != entityData.size()) {
-            qCritical() << "Failed to write entities file to backup";
+        auto manifestData = QJsonDocument(manifest).toJson(QJsonDocument::Compact);
+        if (zipFile.write(manifestData) != manifestData.size()) {
+            qCritical() << "Failed to write entities manifest to backup";
             zipFile.close();
             return;
         }
         zipFile.close();
         if (zipFile.getZipError() != UNZ_OK) {
-            qCritical().nospace() << "Failed to zip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
+            qCritical().nospace() << "Failed to zip " << ENTITIES_MANIFEST_FILENAME << ": " << zipFile.getZipError();
+            return;
         }
+        _manifests[backupName] = manifest;
     }
 }
 
 std::pair<bool, QString> EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) {
     if (!zip.setCurrentFile(ENTITIES_BACKUP_FILENAME)) {
+        QJsonObject manifest;
+        if (readManifest(zip, manifest)) {
+            QFile entitiesFile { _entitiesReplacementFilePath };
+            if (entitiesFile.open(QIODevice::WriteOnly) && !writeEntities(manifest, entitiesFile, true)) {
+                entitiesFile.remove();
+                QString errorStr("Failed to rebuild entities from backup " + backupName);
+                qCritical() << errorStr;
+                return { false, errorStr };
+            }
+            return { true, QString() };
+        }
+
         QString errorStr("Failed to find " + ENTITIES_BACKUP_FILENAME + " while recovering backup");
         qWarning() << errorStr;
         return { false, errorStr };
@@ -95,3 +290,35 @@ std::pair<bool, QString> EntitiesBackupHandler::recoverBackup(const QString& bac
     }
     return { true, QString() };
 }
+
+void EntitiesBackupHandler::deleteBackup(const QString& backupName) {
+    auto wasCorrupted = _corruptedBackups.erase(backupName) > 0;
+    if (_manifests.erase(backupName) > 0 || wasCorrupted) {
+        removeUnreferencedChunks();
+    }
+}
+
+void EntitiesBackupHandler::consolidateBackup(const QString& backupName, QuaZip& zip) {
+    auto it = _manifests.find(backupName);
+    if (it == _manifests.end()) {
+        // either a full backup already, or one we can't rebuild
+        return;
+    }
+
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME))) {
+        qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
+        return;
+    }
+    if (!writeEntities(it->second, zipFile, false)) {
+        qCritical() << "Failed to write entities to consolidated backup" << backupName;
+    }
+    zipFile.close();
+    if (zipFile.getZipError() != UNZ_OK) {
+        qCritical().nospace() << "Failed to zip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
+    }
+}
+
+bool EntitiesBackupHandler::isCorruptedBackup(const QString& backupName) {
+    return _corruptedBackups.find(backupName) != _corruptedBackups.end();
+}
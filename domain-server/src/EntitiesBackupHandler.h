@@ -12,36 +12,59 @@
 #ifndef hifi_EntitiesBackupHandler_h
 #define hifi_EntitiesBackupHandler_h
 
+#include <map>
+#include <set>
+
+#include <QJsonObject>
+
+#include "BackupChunkStore.h"
 #include "BackupHandler.h"
 
+class QIODevice;
+
+// Backs up entities incrementally: the entity list is split into chunks at boundaries picked by entity ID, so an
+// edit only changes the chunk holding that entity, and each backup zip only holds a manifest of chunk hashes.
+// Full models.json.gz files are only produced when a backup is consolidated for download.
 class EntitiesBackupHandler : public BackupHandlerInterface {
 public:
-    EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath);
+    EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath, const QString& backupDirectory);
 
     std::pair<bool, float> isAvailable(const QString& backupName) override { return { true, 1.0f }; }
     std::pair<bool, float> getRecoveryStatus() override { return { false, 1.0f }; }
 
-    void loadBackup(const QString& backupName, QuaZip& zip) override {}
+    void loadBackup(const QString& backupName, QuaZip& zip) override;
 
-    void loadingComplete() override {}
+    void loadingComplete() override;
 
     // Create a skeleton backup
     void createBackup(const QString& backupName, QuaZip& zip) override;
 
-    // Recover from a full backup
+    // Recover from a full or a skeleton backup
     std::pair<bool, QString> recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) override;
 
     // Delete a skeleton backup
-    void deleteBackup(const QString& backupName) override {}
+    void deleteBackup(const QString& backupName) override;
 
     // Create a full backup
-    void consolidateBackup(const QString& backupName, QuaZip& zip) override {}
+    void consolidateBackup(const QString& backupName, QuaZip& zip) override;
 
-    bool isCorruptedBackup(const QString& backupName) override { return false; }
+    bool isCorruptedBackup(const QString& backupName) override;
 
 private:
+    QJsonObject storeEntityChunks(const QByteArray& entityData);
+    bool hasAllChunks(const QJsonObject& manifest) const;
+    bool writeEntities(const QJsonObject& manifest, QIODevice& device, bool resetIdAndVersion) const;
+    void removeUnreferencedChunks();
+
     QString _entitiesFilePath;
     QString _entitiesReplacementFilePath;
+
+    BackupChunkStore _chunkStore;
+    std::map<QString, QJsonObject> _manifests;
+    std::set<QString> _corruptedBackups;
+
+    // the entity server only rewrites its file when entities change, so most backups reuse the last manifest
+    QJsonObject _lastManifest;
 };
 
 #endif /* hifi_EntitiesBackupHandler_h */
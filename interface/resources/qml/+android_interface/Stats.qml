@@ -65,6 +65,10 @@ Item {
                         visible: root.expanded
                         text: root.gameUpdateStats
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: root.entityUpdateStats
+                    }
                     StatText {
                         text: "Render Rate: " + root.renderrate.toFixed(2);
                     }
@@ -301,6 +305,10 @@ Item {
                     StatText {
                         text: "       " + root.gpuTextureResourceMemory + " / " + root.gpuTextureResourcePopulatedMemory + " / " + root.texturePendingTransfers + " MB";
                     }
+                    StatText {
+                        visible: root.expanded;
+                        text: "  KTX Loaded / Sampled: " + root.ktxLoadedMemory + " / " + root.ktxSampledMemory + " MB";
+                    }
                     StatText {
                         visible: root.expanded;
                         text: "  Resident Memory: " + root.gpuTextureResidentMemory + " MB";
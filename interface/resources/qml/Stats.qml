@@ -75,6 +75,10 @@ Item {
                         visible: root.expanded
                         text: root.gameUpdateStats
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: root.entityUpdateStats
+                    }
                     StatText {
                         text: "Render Rate: " + root.renderrate.toFixed(2);
                     }
@@ -131,6 +135,15 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Anim LOD Full/Reduced/Minimal: " + root.fullAnimLODAvatarCount + "/" +
+                            root.reducedAnimLODAvatarCount + "/" + root.minimalAnimLODAvatarCount
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar Anim Time: " + root.avatarAnimationTime.toFixed(2) + " ms"
+                    }
                     StatText {
                         visible: root.expanded
                         text: "Total picks:\n    " +
@@ -381,6 +394,10 @@ Item {
                         property bool showIdeal: (root.gpuTextureResourceIdealMemory != root.gpuTextureResourceMemory);
                         text: "       " + root.gpuTextureResourceMemory + (showIdeal ? ("(" +  root.gpuTextureResourceIdealMemory + ")") : "") + " / " + root.gpuTextureResourcePopulatedMemory + " / " + root.texturePendingTransfers + " MB";
                     }
+                    StatText {
+                        visible: root.expanded;
+                        text: "  KTX Loaded / Sampled: " + root.ktxLoadedMemory + " / " + root.ktxSampledMemory + " MB";
+                    }
                     StatText {
                         visible: root.expanded;
                         text: "  Resident Memory: " + root.gpuTextureResidentMemory + " MB";
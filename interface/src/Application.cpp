@@ -5204,6 +5204,7 @@ void Application::idle() {
 
     float secondsSinceLastUpdate = (float)_lastTimeUpdated.nsecsElapsed() / NSECS_PER_MSEC / MSECS_PER_SECOND;
     _lastTimeUpdated.start();
+    tracing::reportFrameTime((uint64_t)(secondsSinceLastUpdate * USECS_PER_SECOND));
 
 #if !defined(DISABLE_QML)
     // If the offscreen Ui has something active that is NOT the root, then assume it has keyboard focus.
@@ -35,6 +35,7 @@
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <TBBHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
@@ -292,10 +293,34 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     int numHerosUpdated = 0;
     int numAvatarsUpdated = 0;
     int numAvatarsNotUpdated = 0;
+    int numAvatarsAtAnimationLOD[(int)Rig::AnimationLOD::NumLODs] = { 0, 0, 0 };
+    uint64_t animationTime = 0;
 
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
 
+    auto finishAvatarUpdate = [&](const std::shared_ptr<OtherAvatar>& avatar) {
+        if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
+            _myAvatar->addAvatarHandsToFlow(avatar);
+        }
+        if (_drawOtherAvatarSkeletons) {
+            avatar->debugJointData();
+        }
+        avatar->setEnableMeshVisible(!_drawOtherAvatarSkeletons);
+        avatar->updateRenderItem(renderTransaction);
+        avatar->updateSpaceProxy(workloadTransaction);
+        avatar->setLastRenderUpdateTime(startTime);
+    };
+
+    // avatars whose animation and skinning run across the worker threads once both passes are done,
+    // which keeps that cost out of the per-pass time budget
+    struct ConcurrentSimulation {
+        std::shared_ptr<OtherAvatar> avatar;
+        bool inView;
+    };
+    std::vector<ConcurrentSimulation> concurrentSimulations;
+    concurrentSimulations.reserve(avatarMap.size());
+
     for (int p = kHero; p < NumVariants; p++) {
         auto& priorityQueue = avatarPriorityQueues[p];
         // Sorting the current queue HERE as part of the measured timing.
@@ -340,17 +365,17 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     avatar->_transit.reset();
                     avatar->setIsNewAvatar(false);
                 }
-                avatar->simulate(deltaTime, inView);
-                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
-                    _myAvatar->addAvatarHandsToFlow(avatar);
-                }
-                if (_drawOtherAvatarSkeletons) {
-                    avatar->debugJointData();
+                avatar->updateAnimationLOD(views);
+                numAvatarsAtAnimationLOD[(int)avatar->getAnimationLOD()]++;
+                if (avatar->canSimulateJointsConcurrently()) {
+                    avatar->beginSimulate(inView);
+                    concurrentSimulations.push_back({ avatar, inView });
+                } else {
+                    uint64_t simulateStart = usecTimestampNow();
+                    avatar->simulate(deltaTime, inView);
+                    animationTime += usecTimestampNow() - simulateStart;
+                    finishAvatarUpdate(avatar);
                 }
-                avatar->setEnableMeshVisible(!_drawOtherAvatarSkeletons);
-                avatar->updateRenderItem(renderTransaction);
-                avatar->updateSpaceProxy(workloadTransaction);
-                avatar->setLastRenderUpdateTime(startTime);
 
             } else {
                 // we've spent our time budget for this priority bucket
@@ -386,6 +411,22 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         }
     }
 
+    {
+        PROFILE_RANGE(simulation, "concurrentSimulate");
+        uint64_t concurrentStart = usecTimestampNow();
+        tbb::parallel_for(size_t(0), concurrentSimulations.size(), [&](size_t i) {
+            const auto& simulation = concurrentSimulations[i];
+            simulation.avatar->simulateJoints(deltaTime, simulation.inView);
+        });
+        animationTime += usecTimestampNow() - concurrentStart;
+    }
+
+    // back on the main thread, in priority order
+    for (const auto& simulation : concurrentSimulations) {
+        simulation.avatar->endSimulate(deltaTime, simulation.inView);
+        finishAvatarUpdate(simulation.avatar);
+    }
+
     if (_shouldRender) {
         qApp->getMain3DScene()->enqueueTransaction(renderTransaction);
     }
@@ -395,6 +436,10 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAvatarsNotUpdated;
     _numHeroAvatarsUpdated = numHerosUpdated;
+    for (int i = 0; i < (int)Rig::AnimationLOD::NumLODs; i++) {
+        _numAvatarsAtAnimationLOD[i] = numAvatarsAtAnimationLOD[i];
+    }
+    _avatarAnimationTime = (float)animationTime / (float)USECS_PER_MSEC;
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
 }
@@ -118,6 +118,8 @@ public:
     int getNumHeroAvatars() const { return _numHeroAvatars; }
     int getNumHeroAvatarsUpdated() const { return _numHeroAvatarsUpdated; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
+    int getNumAvatarsAtAnimationLOD(Rig::AnimationLOD lod) const { return _numAvatarsAtAnimationLOD[(int)lod]; }
+    float getAvatarAnimationTime() const { return _avatarAnimationTime; }
 
     void updateMyAvatar(float deltaTime);
     void updateOtherAvatars(float deltaTime);
@@ -305,6 +307,8 @@ private:
     int _numHeroAvatars{ 0 };
     int _numHeroAvatarsUpdated{ 0 };
     float _avatarSimulationTime { 0.0f };
+    int _numAvatarsAtAnimationLOD[(int)Rig::AnimationLOD::NumLODs] { 0, 0, 0 };
+    float _avatarAnimationTime { 0.0f }; // msecs spent simulating joints, which is most of _avatarSimulationTime
     bool _shouldRender { true };
     bool _myAvatarDataPacketsPaused { false };
 
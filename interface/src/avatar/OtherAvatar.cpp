@@ -216,6 +216,41 @@ void OtherAvatar::computeShapeLOD() {
     }
 }
 
+void OtherAvatar::updateAnimationLOD(const ConicalViewFrustums& views) {
+    // angular sizes in radians
+    const float FULL_LOD_MIN_ANGULAR_SIZE = 0.2f;
+    const float REDUCED_LOD_MIN_ANGULAR_SIZE = 0.05f;
+
+    Rig::AnimationLOD lod;
+    switch (_workloadRegion) {
+    case workload::Region::R1:
+        lod = Rig::AnimationLOD::Full;
+        break;
+    case workload::Region::R2:
+        lod = Rig::AnimationLOD::Reduced;
+        break;
+    default:
+        lod = Rig::AnimationLOD::Minimal;
+        break;
+    }
+
+    if (lod != Rig::AnimationLOD::Full) {
+        glm::vec3 position = getWorldPosition();
+        float radius = getBoundingRadius();
+        float angularSize = 0.0f;
+        for (const auto& view : views) {
+            float distance = glm::distance(view.getPosition(), position);
+            angularSize = std::max(angularSize, view.getAngularSize(distance, radius));
+        }
+        if (angularSize > FULL_LOD_MIN_ANGULAR_SIZE) {
+            lod = Rig::AnimationLOD::Full;
+        } else if (angularSize > REDUCED_LOD_MIN_ANGULAR_SIZE) {
+            lod = Rig::AnimationLOD::Reduced;
+        }
+    }
+    _skeletonModel->getRig().setAnimationLOD(lod);
+}
+
 bool OtherAvatar::isInPhysicsSimulation() const {
     return _motionState && _motionState->getRigidBody();
 }
@@ -246,6 +281,19 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
 
+    beginSimulate(inView);
+
+    PerformanceTimer perfTimer("simulate");
+    simulateJoints(deltaTime, inView);
+    endSimulate(deltaTime, inView);
+}
+
+bool OtherAvatar::canSimulateJointsConcurrently() const {
+    // the first simulation of a freshly loaded model builds its joint states and emits rigReady, keep that on the main thread
+    return _skeletonModel->isLoaded() && !_skeletonModel->getRig().jointStatesEmpty();
+}
+
+void OtherAvatar::beginSimulate(bool inView) {
     _globalPosition = _transit.isActive() ? _transit.getCurrentPosition() : _serverPosition;
     if (!hasParent()) {
         setLocalPosition(_globalPosition);
@@ -255,40 +303,63 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     if (inView) {
         _simulationInViewRate.increment();
     }
+}
 
-    PerformanceTimer perfTimer("simulate");
-    {
-        PROFILE_RANGE(simulation, "updateJoints");
-        if (inView) {
-            Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
-                _jointDataSimulationRate.increment();
-
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, true);
-
-                locationChanged(); // joints changed, so if there are any children, update them.
-                _hasNewJointData = false;
-
-                glm::vec3 headPosition = getWorldPosition();
-                if (!_skeletonModel->getHeadPosition(headPosition)) {
-                    headPosition = getWorldPosition();
-                }
-                head->setPosition(headPosition);
-            } else {
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, false);
+void OtherAvatar::simulateJoints(float deltaTime, bool inView) {
+    PROFILE_RANGE(simulation, "updateJoints");
+    _jointsChangedInSimulation = false;
+    if (inView) {
+        Head* head = getHead();
+        Rig& rig = _skeletonModel->getRig();
+        // at reduced animation LODs only some of the updates with new joint data copy it, and the joints are
+        // interpolated towards each copy over the frames in between
+        bool jointsCopied = false;
+        if ((_hasNewJointData || _transit.isActive()) && rig.shouldUpdateAtAnimationLOD()) {
+            rig.copyJointsFromJointData(_jointData);
+            _jointDataSimulationRate.increment();
+            _hasNewJointData = false;
+            jointsCopied = true;
+        }
+        bool jointsInterpolated = rig.updateAnimationLODInterpolation(deltaTime);
+        if (jointsCopied || jointsInterpolated) {
+            glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+            rig.computeExternalPoses(rootTransform);
+
+            head->simulate(deltaTime);
+            _skeletonModel->simulate(deltaTime, true);
+
+            _jointsChangedInSimulation = true;
+
+            glm::vec3 headPosition = getWorldPosition();
+            if (!_skeletonModel->getHeadPosition(headPosition)) {
+                headPosition = getWorldPosition();
             }
-            head->setScale(getModelScale());
-            relayJointDataToChildren();
+            head->setPosition(headPosition);
         } else {
-            // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+            head->simulate(deltaTime);
             _skeletonModel->simulate(deltaTime, false);
         }
-        _skeletonModelSimulationRate.increment();
+        head->setScale(getModelScale());
+    } else {
+        // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+        _skeletonModel->simulate(deltaTime, false);
+    }
+    _skeletonModelSimulationRate.increment();
+
+    // skin now rather than lazily in the model's post update lambda, which would otherwise do it on the main thread,
+    // but leave any blend it needs for endSimulate() to post
+    _skeletonModel->setDeferBlendRequests(true);
+    _skeletonModel->updateClusterMatrices();
+    _skeletonModel->setDeferBlendRequests(false);
+}
+
+void OtherAvatar::endSimulate(float deltaTime, bool inView) {
+    _skeletonModel->postDeferredBlendRequest();
+    if (_jointsChangedInSimulation) {
+        locationChanged(); // joints changed, so if there are any children, update them.
+    }
+    if (inView) {
+        relayJointDataToChildren();
     }
 
     // update animation for display name fade in/out
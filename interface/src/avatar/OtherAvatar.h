@@ -13,6 +13,7 @@
 #include <vector>
 
 #include <avatars-renderer/Avatar.h>
+#include <shared/ConicalViewFrustum.h>
 #include <workload/Space.h>
 
 #include "InterfaceLogging.h"
@@ -58,6 +59,10 @@ public:
     BodyLOD getBodyLOD() { return _bodyLOD; }
     void computeShapeLOD();
 
+    // lowers the rig's animation LOD with distance (workload region), but keeps avatars that are large on screen at full
+    void updateAnimationLOD(const ConicalViewFrustums& views);
+    Rig::AnimationLOD getAnimationLOD() const { return _skeletonModel->getRig().getAnimationLOD(); }
+
     void updateCollisionGroup(bool myAvatarCollide);
     bool getCollideWithOtherAvatars() const { return _collideWithOtherAvatars; } 
 
@@ -65,6 +70,14 @@ public:
 
     void simulate(float deltaTime, bool inView) override;
     void debugJointData() const;
+
+    // simulate() in three stages, so that AvatarManager can run the animation and skinning of many avatars
+    // concurrently: beginSimulate and endSimulate touch children, entities and grabs and must run on the
+    // main thread, simulateJoints only touches this avatar's head and skeleton model
+    bool canSimulateJointsConcurrently() const;
+    void beginSimulate(bool inView);
+    void simulateJoints(float deltaTime, bool inView);
+    void endSimulate(float deltaTime, bool inView);
     friend AvatarManager;
 
 protected:
@@ -91,6 +104,7 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+    bool _jointsChangedInSimulation { false };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
@@ -288,6 +288,8 @@ void GraphicsEngine::render_performFrame() {
     }
 
     auto frame = getGPUContext()->endFrame();
+    // the recordings on workers have finished, so their stats can be counted
+    renderArgs.mergeAsyncDetails();
     frame->frameIndex = _renderFrameCount;
     frame->framebuffer = finalFramebuffer;
     frame->framebufferRecycler = [](const gpu::FramebufferPointer& framebuffer) {
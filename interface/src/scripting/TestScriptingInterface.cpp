@@ -105,6 +105,23 @@ bool TestScriptingInterface::stopTracing(QString filename) {
     return true;
 }
 
+bool TestScriptingInterface::startTraceFlightRecorder(float seconds, float spikeMsecs) {
+    if (!DependencyManager::isSet<tracing::Tracer>()) {
+        return false;
+    }
+
+    DependencyManager::get<tracing::Tracer>()->startFlightRecorder(seconds, spikeMsecs);
+    return true;
+}
+
+bool TestScriptingInterface::dumpTraceFlightRecorder(QString filename) {
+    if (!DependencyManager::isSet<tracing::Tracer>()) {
+        return false;
+    }
+
+    return DependencyManager::get<tracing::Tracer>()->dumpFlightRecorder(filename);
+}
+
 void TestScriptingInterface::clear() {
     qApp->postLambdaEvent([] {
         qApp->getEntities()->clear();
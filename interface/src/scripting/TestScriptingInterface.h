@@ -99,6 +99,24 @@ public slots:
     */
     bool stopTracing(QString filename);
 
+    /**jsdoc
+    * Keep only the most recent tracing events in memory, to be saved with dumpTraceFlightRecorder
+    * @function Test.startTraceFlightRecorder
+    * @param {number} seconds - How many seconds of events to keep
+    * @param {number} spikeMsecs [defaultValue=0] - Save the events automatically when a frame takes longer than this
+    * @returns {bool} True if successful.
+    */
+    bool startTraceFlightRecorder(float seconds, float spikeMsecs = 0.0f);
+
+    /**jsdoc
+    * Save the events kept by the trace flight recorder to a file, which keeps recording
+    * Using a filename with a .trace extension saves the compact binary format instead of Chrome JSON
+    * @function Test.dumpTraceFlightRecorder
+    * @param {string} filename - Name of file to save to
+    * @returns {bool} True if successful.
+    */
+    bool dumpTraceFlightRecorder(QString filename);
+
     /**jsdoc
     * Starts a specific trace event
     * @function Test.startTraceEvent
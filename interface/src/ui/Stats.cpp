@@ -22,6 +22,7 @@
 #include <Application.h>
 #include <AudioClient.h>
 #include <GeometryCache.h>
+#include <material-networking/TextureCache.h>
 #include <LODManager.h>
 #include <OffscreenUi.h>
 #include <PerfStat.h>
@@ -130,6 +131,9 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
+    STAT_UPDATE(fullAnimLODAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(Rig::AnimationLOD::Full));
+    STAT_UPDATE(reducedAnimLODAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(Rig::AnimationLOD::Reduced));
+    STAT_UPDATE(minimalAnimLODAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(Rig::AnimationLOD::Minimal));
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE_FLOAT(renderrate, qApp->getRenderLoopRate(), 0.1f);
     RefreshRateManager& refreshRateManager = qApp->getRefreshRateManager();
@@ -387,6 +391,7 @@ void Stats::updateStats(bool force) {
     auto config = qApp->getRenderEngine()->getConfiguration().get();
     STAT_UPDATE(engineFrameTime, (float) config->getCPURunTime());
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
+    STAT_UPDATE(avatarAnimationTime, (float)avatarManager->getAvatarAnimationTime());
 
     if (_expanded) {
         STAT_UPDATE(gpuBuffers, (int)gpu::Context::getBufferGPUCount());
@@ -410,6 +415,21 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(gpuFreeMemory, (int)BYTES_TO_MB(gpu::Context::getFreeGPUMemSize()));
         STAT_UPDATE(rectifiedTextureCount, (int)RECTIFIED_TEXTURE_COUNT.load());
         STAT_UPDATE(decimatedTextureCount, (int)DECIMATED_TEXTURE_COUNT.load());
+        auto textureCache = DependencyManager::get<TextureCache>();
+        STAT_UPDATE(ktxLoadedMemory, (int)BYTES_TO_MB(textureCache->getKTXBytesLoaded()));
+        STAT_UPDATE(ktxSampledMemory, (int)BYTES_TO_MB(textureCache->getKTXBytesSampled()));
+
+        std::vector<EntityTreeRenderer::RenderableUpdateStat> renderableUpdateStats;
+        qApp->getEntities()->getRenderableUpdateStats(renderableUpdateStats);
+        float entityUpdateUsecs = 0.0f;
+        QString entityUpdateTypes;
+        for (const auto& stat : renderableUpdateStats) {
+            entityUpdateUsecs += stat.usecs;
+            entityUpdateTypes += QString("\n    %1: %2 updates, %3 ms").arg(EntityTypes::getEntityTypeName(stat.type))
+                .arg(stat.count, 0, 'f', 1).arg(stat.usecs / (float)USECS_PER_MSEC, 0, 'f', 2);
+        }
+        STAT_UPDATE(entityUpdateStats, QString("Entity updates: %1 ms").arg(entityUpdateUsecs / (float)USECS_PER_MSEC, 0, 'f', 2) +
+                    entityUpdateTypes);
     }
 
     gpu::ContextStats gpuFrameStats;
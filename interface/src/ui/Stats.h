@@ -55,6 +55,9 @@ private: \
  * @property {number} updatedAvatarCount - <em>Read-only.</em>
  * @property {number} updatedHeroAvatarCount - <em>Read-only.</em>
  * @property {number} notUpdatedAvatarCount - <em>Read-only.</em>
+ * @property {number} fullAnimLODAvatarCount - <em>Read-only.</em>
+ * @property {number} reducedAnimLODAvatarCount - <em>Read-only.</em>
+ * @property {number} minimalAnimLODAvatarCount - <em>Read-only.</em>
  * @property {number} packetInCount - <em>Read-only.</em>
  * @property {number} packetOutCount - <em>Read-only.</em>
  * @property {number} mbpsIn - <em>Read-only.</em>
@@ -114,6 +117,7 @@ private: \
  * @property {string} lodStatus - <em>Read-only.</em>
  * @property {string} timingStats - <em>Read-only.</em>
  * @property {string} gameUpdateStats - <em>Read-only.</em>
+ * @property {string} entityUpdateStats - <em>Read-only.</em>
  * @property {number} serverElements - <em>Read-only.</em>
  * @property {number} serverInternal - <em>Read-only.</em>
  * @property {number} serverLeaves - <em>Read-only.</em>
@@ -122,6 +126,10 @@ private: \
  * @property {number} localLeaves - <em>Read-only.</em>
  * @property {number} rectifiedTextureCount - <em>Read-only.</em>
  * @property {number} decimatedTextureCount - <em>Read-only.</em>
+ * @property {number} ktxLoadedMemory - The size, in MB, of the KTX mips loaded for network textures in use.
+ *     <em>Read-only.</em>
+ * @property {number} ktxSampledMemory - The size, in MB, of the loaded KTX mips at or below the resolution each texture is
+ *     drawn at. <em>Read-only.</em>
  * @property {number} gpuBuffers - <em>Read-only.</em>
  * @property {number} gpuBufferMemory - <em>Read-only.</em>
  * @property {number} gpuTextures - <em>Read-only.</em>
@@ -141,6 +149,7 @@ private: \
  * @property {number} batchFrameTime - <em>Read-only.</em>
  * @property {number} engineFrameTime - <em>Read-only.</em>
  * @property {number} avatarSimulationTime - <em>Read-only.</em>
+ * @property {number} avatarAnimationTime - <em>Read-only.</em>
  *
  *
  * @property {number} x
@@ -219,6 +228,9 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
+    STATS_PROPERTY(int, fullAnimLODAvatarCount, 0)
+    STATS_PROPERTY(int, reducedAnimLODAvatarCount, 0)
+    STATS_PROPERTY(int, minimalAnimLODAvatarCount, 0)
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -279,6 +291,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, lodStatus, QString())
     STATS_PROPERTY(QString, timingStats, QString())
     STATS_PROPERTY(QString, gameUpdateStats, QString())
+    STATS_PROPERTY(QString, entityUpdateStats, QString())
     STATS_PROPERTY(int, serverElements, 0)
     STATS_PROPERTY(int, serverInternal, 0)
     STATS_PROPERTY(int, serverLeaves, 0)
@@ -287,6 +300,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, localLeaves, 0)
     STATS_PROPERTY(int, rectifiedTextureCount, 0)
     STATS_PROPERTY(int, decimatedTextureCount, 0)
+    STATS_PROPERTY(int, ktxLoadedMemory, 0)
+    STATS_PROPERTY(int, ktxSampledMemory, 0)
     STATS_PROPERTY(int, gpuBuffers, 0)
     STATS_PROPERTY(int, gpuBufferMemory, 0)
     STATS_PROPERTY(int, gpuTextures, 0)
@@ -308,6 +323,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, engineFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(float, avatarAnimationTime, 0)
 
     STATS_PROPERTY(int, stylusPicksCount, 0)
     STATS_PROPERTY(int, rayPicksCount, 0)
@@ -489,6 +505,27 @@ signals:
      */
     void notUpdatedAvatarCountChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>fullAnimLODAvatarCount</code> property changes.
+     * @function Stats.fullAnimLODAvatarCountChanged
+     * @returns {Signal}
+     */
+    void fullAnimLODAvatarCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>reducedAnimLODAvatarCount</code> property changes.
+     * @function Stats.reducedAnimLODAvatarCountChanged
+     * @returns {Signal}
+     */
+    void reducedAnimLODAvatarCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>minimalAnimLODAvatarCount</code> property changes.
+     * @function Stats.minimalAnimLODAvatarCountChanged
+     * @returns {Signal}
+     */
+    void minimalAnimLODAvatarCountChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>packetInCount</code> property changes.
      * @function Stats.packetInCountChanged
@@ -939,6 +976,13 @@ signals:
      */
     void gameUpdateStatsChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>entityUpdateStats</code> property changes.
+     * @function Stats.entityUpdateStatsChanged
+     * @returns {Signal}
+     */
+    void entityUpdateStatsChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>glContextSwapchainMemory</code> property changes.
      * @function Stats.glContextSwapchainMemoryChanged
@@ -1086,6 +1130,13 @@ signals:
      */
     void avatarSimulationTimeChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>avatarAnimationTime</code> property changes.
+     * @function Stats.avatarAnimationTimeChanged
+     * @returns {Signal}
+     */
+    void avatarAnimationTimeChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>rectifiedTextureCount</code> property changes.
      * @function Stats.rectifiedTextureCountChanged
@@ -1100,6 +1151,20 @@ signals:
      */
     void decimatedTextureCountChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>ktxLoadedMemory</code> property changes.
+     * @function Stats.ktxLoadedMemoryChanged
+     * @returns {Signal}
+     */
+    void ktxLoadedMemoryChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>ktxSampledMemory</code> property changes.
+     * @function Stats.ktxSampledMemoryChanged
+     * @returns {Signal}
+     */
+    void ktxSampledMemoryChanged();
+
 
     void refreshRateTargetChanged();
 
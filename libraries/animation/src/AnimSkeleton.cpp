@@ -54,6 +54,17 @@ AnimSkeleton::AnimSkeleton(const HFMModel& hfmModel) {
             dummyClustersList.push_back(localCluster);
         }
         _clusterBindMatrixOriginalValues.push_back(dummyClustersList);
+
+        std::vector<int> jointIndices;
+        std::vector<glm::mat4> inverseBindMatrices;
+        jointIndices.reserve(dummyClustersList.size());
+        inverseBindMatrices.reserve(dummyClustersList.size());
+        for (const auto& localCluster : dummyClustersList) {
+            jointIndices.push_back(localCluster.jointIndex);
+            inverseBindMatrices.push_back(localCluster.inverseBindMatrix);
+        }
+        _clusterJointIndices.push_back(jointIndices);
+        _clusterInverseBindMatrices.push_back(inverseBindMatrices);
     }
 }
 
@@ -70,6 +70,10 @@ public:
     std::vector<int> lookUpJointIndices(const std::vector<QString>& jointNames) const;
     const HFMCluster getClusterBindMatricesOriginalValues(const int meshIndex, const int clusterIndex) const { return _clusterBindMatrixOriginalValues[meshIndex][clusterIndex]; }
 
+    // the same clusters as contiguous arrays per mesh, for composing all of a mesh's cluster matrices in one pass
+    const std::vector<int>& getClusterJointIndices(int meshIndex) const { return _clusterJointIndices[meshIndex]; }
+    const std::vector<glm::mat4>& getClusterInverseBindMatrices(int meshIndex) const { return _clusterInverseBindMatrices[meshIndex]; }
+
 protected:
     void buildSkeletonFromJoints(const std::vector<HFMJoint>& joints, const QMap<int, glm::quat> jointOffsets);
 
@@ -85,6 +89,8 @@ protected:
     std::vector<int> _mirrorMap;
     QHash<QString, int> _jointIndicesByName;
     std::vector<std::vector<HFMCluster>> _clusterBindMatrixOriginalValues;
+    std::vector<std::vector<int>> _clusterJointIndices;
+    std::vector<std::vector<glm::mat4>> _clusterInverseBindMatrices;
     glm::mat4 _geometryOffset;
 
     // no copies
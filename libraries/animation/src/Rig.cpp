@@ -88,6 +88,9 @@ static const QString RIGHT_HAND_IK_ROTATION_VAR("rightHandIKRotationVar");
 static const QString MAIN_STATE_MACHINE_RIGHT_HAND_ROTATION("mainStateMachineRightHandRotation");
 static const QString MAIN_STATE_MACHINE_RIGHT_HAND_POSITION("mainStateMachineRightHandPosition");
 
+// a key pose that arrives after a pause is interpolated to over no more than this (seconds)
+static const float MAX_ANIMATION_LOD_KEY_INTERVAL = 0.25f;
+
 
 /**jsdoc
  * <p>An <code>AnimStateDictionary</code> object may have the following properties. It may also have other properties, set by 
@@ -663,6 +666,51 @@ void Rig::initJointStates(const HFMModel& hfmModel, const glm::mat4& modelOffset
 
     _leftEyeJointChildren = _animSkeleton->getChildrenOfJoint(indexOfJoint("LeftEye"));
     _rightEyeJointChildren = _animSkeleton->getChildrenOfJoint(indexOfJoint("RightEye"));
+
+    // fingers are too small to see at a distance, the minimal animation LOD holds them and all their descendants
+    static const QStringList FINGER_JOINT_NAMES = { "Thumb", "Index", "Middle", "Ring", "Pinky" };
+    int numJoints = _animSkeleton->getNumJoints();
+    _isMinimalLODJoint.assign(numJoints, true);
+    for (int i = 0; i < numJoints; i++) {
+        const QString& jointName = _animSkeleton->getJointName(i);
+        if (jointName.contains("Hand")) {
+            for (const auto& fingerName : FINGER_JOINT_NAMES) {
+                if (jointName.contains(fingerName)) {
+                    _isMinimalLODJoint[i] = false;
+                    break;
+                }
+            }
+        }
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < numJoints; i++) {
+            int parentIndex = _animSkeleton->getParentIndex(i);
+            if (_isMinimalLODJoint[i] && parentIndex >= 0 && !_isMinimalLODJoint[parentIndex]) {
+                _isMinimalLODJoint[i] = false;
+                changed = true;
+            }
+        }
+    }
+}
+
+void Rig::setAnimationLOD(AnimationLOD lod) {
+    if (lod != _animationLOD) {
+        _animationLOD = lod;
+        // update on the next call, so a rig coming closer doesn't wait out the old LOD's interval
+        _animationLODUpdateCount = 0;
+        _animationLODPrevPoses.clear();
+        _animationLODNextPoses.clear();
+    }
+}
+
+bool Rig::shouldUpdateAtAnimationLOD() {
+    static const int LOD_UPDATE_INTERVALS[(int)AnimationLOD::NumLODs] = { 1, 2, 4 };
+    int interval = LOD_UPDATE_INTERVALS[(int)_animationLOD];
+    bool shouldUpdate = (_animationLODUpdateCount % interval) == 0;
+    _animationLODUpdateCount = (_animationLODUpdateCount + 1) % interval;
+    return shouldUpdate;
 }
 
 void Rig::reset(const HFMModel& hfmModel) {
@@ -2584,19 +2632,59 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
     if (numJoints != (int)_internalPoseSet._relativePoses.size()) {
         _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
     }
+
+    // below full LOD the copy is the next key pose, which the relative poses are interpolated towards
+    AnimPoseVec* poses = &_internalPoseSet._relativePoses;
+    if (_animationLOD != AnimationLOD::Full) {
+        if (_animationLODNextPoses.size() != _internalPoseSet._relativePoses.size()) {
+            // the first key at this LOD
+            _animationLODNextPoses = _internalPoseSet._relativePoses;
+            _animationLODTimeSinceKey = 0.0f;
+        }
+        // start from the poses shown now, which are the previous key unless that key arrived early
+        _animationLODPrevPoses = _internalPoseSet._relativePoses;
+        _animationLODKeyInterval = glm::min(_animationLODTimeSinceKey, MAX_ANIMATION_LOD_KEY_INTERVAL);
+        _animationLODTimeSinceKey = 0.0f;
+        poses = &_animationLODNextPoses;
+    }
+    bool isMinimalLOD = _animationLOD == AnimationLOD::Minimal && (int)_isMinimalLODJoint.size() == numJoints;
+
     const AnimPoseVec& relativeDefaultPoses = _animSkeleton->getRelativeDefaultPoses();
     for (int i = 0; i < numJoints; i++) {
+        if (isMinimalLOD && !_isMinimalLODJoint[i]) {
+            continue;
+        }
         const JointData& data = jointDataVec.at(i);
-        _internalPoseSet._relativePoses[i].rot() = rotations[i];
+        (*poses)[i].rot() = rotations[i];
         if (data.translationIsDefaultPose) {
-            _internalPoseSet._relativePoses[i].trans() = relativeDefaultPoses[i].trans();
+            (*poses)[i].trans() = relativeDefaultPoses[i].trans();
         } else {
             // JointData translations are in relative-frame
-            _internalPoseSet._relativePoses[i].trans() = data.translation;
+            (*poses)[i].trans() = data.translation;
         }
     }
 }
 
+bool Rig::updateAnimationLODInterpolation(float deltaTime) {
+    _animationLODTimeSinceKey += deltaTime;
+    if (_animationLODPrevPoses.empty() || _animationLODPrevPoses.size() != _internalPoseSet._relativePoses.size() ||
+        _animationLODNextPoses.size() != _internalPoseSet._relativePoses.size()) {
+        return false;
+    }
+
+    // cover the time between the last two keys, so the poses reach the newest just as the next is due
+    float alpha = 1.0f;
+    if (_animationLODKeyInterval > 0.0f) {
+        alpha = glm::min(_animationLODTimeSinceKey / _animationLODKeyInterval, 1.0f);
+    }
+    ::blend(_internalPoseSet._relativePoses.size(), &_animationLODPrevPoses[0], &_animationLODNextPoses[0], alpha,
+            &_internalPoseSet._relativePoses[0]);
+    if (alpha >= 1.0f) {
+        _animationLODPrevPoses.clear();
+    }
+    return true;
+}
+
 void Rig::computeExternalPoses(const glm::mat4& modelOffsetMat) {
     _modelOffset = AnimPose(modelOffsetMat);
     _geometryToRigTransform = _modelOffset * _geometryOffset;
@@ -226,6 +226,24 @@ public:
     void copyJointsFromJointData(const QVector<JointData>& jointDataVec);
     void computeExternalPoses(const glm::mat4& modelOffsetMat);
 
+    // animation level of detail for rigs driven by copyJointsFromJointData(), lowered by the owner for rigs that are far
+    // away or small on screen
+    enum class AnimationLOD {
+        Full = 0, // every update with new joint data is copied
+        Reduced,  // every other update is copied, and the frames between interpolated
+        Minimal,  // every fourth update is copied, and the frames between interpolated, finger joints held
+        NumLODs
+    };
+    void setAnimationLOD(AnimationLOD lod);
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
+
+    // counts an update at the current LOD, returns false for the updates this LOD skips
+    bool shouldUpdateAtAnimationLOD();
+
+    // Below AnimationLOD::Full each copy is a key pose.  Call every frame: moves the relative poses from where they were
+    // when the last key was copied towards it, over the time between the last two keys.  Returns true if they changed.
+    bool updateAnimationLODInterpolation(float deltaTime);
+
     void computeAvatarBoundingCapsule(const HFMModel& hfmModel, float& radiusOut, float& heightOut, glm::vec3& offsetOut) const;
 
     void setEnableInverseKinematics(bool enable);
@@ -435,6 +453,14 @@ protected:
     std::map<QString, RoleAnimState> _roleAnimStates;
     int _evaluationCount{ 0 };
 
+    AnimationLOD _animationLOD { AnimationLOD::Full };
+    int _animationLODUpdateCount { 0 };
+    AnimPoseVec _animationLODPrevPoses; // interpolated from, empty once the next key has been reached
+    AnimPoseVec _animationLODNextPoses; // the last key copied below AnimationLOD::Full
+    float _animationLODKeyInterval { 0.0f };
+    float _animationLODTimeSinceKey { 0.0f };
+    std::vector<bool> _isMinimalLODJoint; // joints still updated at AnimationLOD::Minimal
+
     float _leftHandOverlayAlpha { 0.0f };
     float _rightHandOverlayAlpha { 0.0f };
     float _talkIdleInterpTime { 0.0f };
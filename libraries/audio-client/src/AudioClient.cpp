@@ -11,6 +11,7 @@
 
 #include "AudioClient.h"
 
+#include <condition_variable>
 #include <cstring>
 #include <math.h>
 #include <sys/stat.h>
@@ -300,6 +301,74 @@ static inline float convertToFloat(int16_t sample) {
     return (float)sample * (1 / 32768.0f);
 }
 
+// Keeps the local injectors' ring buffer topped up and releases finished injectors, so that the device callback
+// only has to wake it up
+class LocalInjectorsThread : public QThread {
+public:
+    LocalInjectorsThread(AudioClient* audio) : _audio(audio) {
+        setObjectName("LocalInjectorsThread");
+    }
+
+    // realtime safe
+    void wake() {
+        _isWoken.store(true, std::memory_order_release);
+        _condition.notify_one();
+    }
+
+    // wakes the thread up while it waits for injectors, which it can't miss
+    void injectorAdded() {
+        wakeLocked();
+    }
+
+    void stop() {
+        _isStopping.store(true, std::memory_order_release);
+        wakeLocked();
+        wait();
+    }
+
+protected:
+    void run() override {
+        // a missed wake up costs at most one wait, the device callback can still prepare the audio itself
+        const auto MAX_WAIT = std::chrono::milliseconds((int)(AudioConstants::NETWORK_FRAME_MSECS / 2));
+
+        bool hasInjectors = false;
+        while (!_isStopping.load(std::memory_order_acquire)) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                auto isWoken = [this] {
+                    return _isWoken.load(std::memory_order_acquire) || _isStopping.load(std::memory_order_acquire);
+                };
+                if (hasInjectors) {
+                    _condition.wait_for(lock, MAX_WAIT, isWoken);
+                } else {
+                    // nothing to prepare or release until an injector is added
+                    _condition.wait(lock, isWoken);
+                }
+            }
+            _isWoken.store(false, std::memory_order_release);
+
+            _audio->prepareLocalAudioInjectors();
+            hasInjectors = _audio->collectLocalInjectors();
+        }
+    }
+
+private:
+    // setting the flag under the mutex orders it against the thread's check, so the wake up can't be lost
+    void wakeLocked() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isWoken.store(true, std::memory_order_release);
+        }
+        _condition.notify_one();
+    }
+
+    AudioClient* _audio;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::atomic<bool> _isWoken { false };
+    std::atomic<bool> _isStopping { false };
+};
+
 AudioClient::AudioClient() {
 
     // avoid putting a lock in the device callback
@@ -357,6 +426,9 @@ AudioClient::AudioClient() {
     configureWebrtc();
 #endif
 
+    _localInjectorsThread.reset(new LocalInjectorsThread(this));
+    _localInjectorsThread->start(QThread::HighPriority);
+
     auto nodeList = DependencyManager::get<NodeList>();
     auto& packetReceiver = nodeList->getPacketReceiver();
     packetReceiver.registerListener(PacketType::AudioStreamStats, &_stats, "processStreamStatsPacket");
@@ -786,6 +858,8 @@ void AudioClient::start() {
 }
 
 void AudioClient::stop() {
+    _localInjectorsThread->stop();
+
     qCDebug(audioclient) << "AudioClient::stop(), requesting switchInputToAudioDevice() to shut down";
     switchInputToAudioDevice(HifiAudioDeviceInfo(), true);
 
@@ -1468,10 +1542,12 @@ void AudioClient::handleRecordedAudioInput(const QByteArray& audio) {
     handleAudioInput(audioBuffer);
 }
 
-void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLock) {
-    bool doSynchronously = localAudioLock.operator bool();
+void AudioClient::prepareLocalAudioInjectors(Lock* localAudioLock) {
+    bool doSynchronously = (localAudioLock != nullptr);
+    Lock lock(_localAudioMutex, std::defer_lock);
     if (!localAudioLock) {
-        localAudioLock.reset(new Lock(_localAudioMutex));
+        lock.lock();
+        localAudioLock = &lock;
     }
 
     int samplesNeeded = std::numeric_limits<int>::max();
@@ -1534,122 +1610,36 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
 }
 
 bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
-    // check the flag for injectors before attempting to lock
-    if (!_localInjectorsAvailable.load(std::memory_order_acquire)) {
+    // check for injectors before doing any work
+    if (!_localInjectors.isPlaying()) {
         return false;
     }
 
-    // lock the injectors
-    Lock lock(_injectorsMutex);
-
-    QVector<AudioInjectorPointer> injectorsToRemove;
-
-    memset(mixBuffer, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
-
-    for (const AudioInjectorPointer& injector : _activeLocalAudioInjectors) {
-        // the lock guarantees that injectorBuffer, if found, is invariant
-        auto injectorBuffer = injector->getLocalBuffer();
-        if (injectorBuffer) {
-
-            auto options = injector->getOptions();
-
-            static const int HRTF_DATASET_INDEX = 1;
-
-            int numChannels = options.ambisonic ? AudioConstants::AMBISONIC : (options.stereo ? AudioConstants::STEREO : AudioConstants::MONO);
-            size_t bytesToRead = numChannels * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
-
-            // get one frame from the injector
-            memset(_localScratchBuffer, 0, bytesToRead);
-            if (0 < injectorBuffer->readData((char*)_localScratchBuffer, bytesToRead)) {
-
-                bool isSystemSound = !options.positionSet && !options.ambisonic;
-
-                float gain = options.volume * (isSystemSound ? _systemInjectorGain : _localInjectorGain);
-
-                if (options.ambisonic) {
-
-                    if (options.positionSet) {
-
-                        // distance attenuation
-                        glm::vec3 relativePosition = options.position - _positionGetter();
-                        float distance = glm::max(glm::length(relativePosition), EPSILON);
-                        gain = gainForSource(distance, gain);
-                    }
-
-                    //
-                    // Calculate the soundfield orientation relative to the listener.
-                    // Injector orientation can be used to align a recording to our world coordinates.
-                    //
-                    glm::quat relativeOrientation = options.orientation * glm::inverse(_orientationGetter());
-
-                    // convert from Y-up (OpenGL) to Z-up (Ambisonic) coordinate system
-                    float qw = relativeOrientation.w;
-                    float qx = -relativeOrientation.z;
-                    float qy = -relativeOrientation.x;
-                    float qz = relativeOrientation.y;
-
-                    // spatialize into mixBuffer
-                    injector->getLocalFOA().render(_localScratchBuffer, mixBuffer, HRTF_DATASET_INDEX,
-                                                   qw, qx, qy, qz, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-                } else if (options.stereo) {
-
-                    if (options.positionSet) {
-
-                        // distance attenuation
-                        glm::vec3 relativePosition = options.position - _positionGetter();
-                        float distance = glm::max(glm::length(relativePosition), EPSILON);
-                        gain = gainForSource(distance, gain);
-                    }
-
-                    // direct mix into mixBuffer
-                    injector->getLocalHRTF().mixStereo(_localScratchBuffer, mixBuffer, gain,
-                                                       AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-                } else {  // injector is mono
-
-                    if (options.positionSet) {
+    // the listener is the same for every injector
+    LocalInjectorTable::Listener listener;
+    listener.position = _positionGetter();
+    listener.orientation = _orientationGetter();
+    listener.localInjectorGain = _localInjectorGain;
+    listener.systemInjectorGain = _systemInjectorGain;
 
-                        // distance attenuation
-                        glm::vec3 relativePosition = options.position - _positionGetter();
-                        float distance = glm::max(glm::length(relativePosition), EPSILON);
-                        gain = gainForSource(distance, gain);
-
-                        float azimuth = azimuthForSource(relativePosition);
-
-                        // spatialize into mixBuffer
-                        injector->getLocalHRTF().render(_localScratchBuffer, mixBuffer, HRTF_DATASET_INDEX,
-                                                        azimuth, distance, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-                    } else {
-
-                        // direct mix into mixBuffer
-                        injector->getLocalHRTF().mixMono(_localScratchBuffer, mixBuffer, gain,
-                                                         AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-                    }
-                }
-
-            } else {
-
-                //qCDebug(audioclient) << "injector has no more data, marking finished for removal";
-                injector->finishLocalInjection();
-                injectorsToRemove.append(injector);
-            }
-
-        } else {
+    // runs on the device callback: no allocations or locks, finished injectors are released by collectLocalInjectors()
+    return _localInjectors.mixFrame(mixBuffer, listener);
+}
 
-            //qCDebug(audioclient) << "injector has no local buffer, marking as finished for removal";
-            injector->finishLocalInjection();
-            injectorsToRemove.append(injector);
-        }
+bool AudioClient::collectLocalInjectors() {
+    QVector<AudioInjectorPointer> finishedInjectors;
+    bool hasInjectors;
+    {
+        Lock lock(_injectorsMutex);
+        finishedInjectors = _localInjectors.update();
+        hasInjectors = _localInjectors.size() > 0;
     }
 
-    for (const AudioInjectorPointer& injector : injectorsToRemove) {
+    for (const AudioInjectorPointer& injector : finishedInjectors) {
         //qCDebug(audioclient) << "removing injector";
-        _activeLocalAudioInjectors.removeOne(injector);
+        injector->finishLocalInjection();
     }
-
-    // update the flag
-    _localInjectorsAvailable.exchange(!_activeLocalAudioInjectors.empty(), std::memory_order_release);
-
-    return true;
+    return hasInjectors;
 }
 
 void AudioClient::processReceivedSamples(const QByteArray& decodedBuffer, QByteArray& outputBuffer) {
@@ -1774,16 +1764,15 @@ bool AudioClient::outputLocalInjector(const AudioInjectorPointer& injector) {
     auto injectorBuffer = injector->getLocalBuffer();
     if (injectorBuffer) {
         // local injectors are on the AudioInjectorsThread, so we must guard access
-        Lock lock(_injectorsMutex);
-        if (!_activeLocalAudioInjectors.contains(injector)) {
-            //qCDebug(audioclient) << "adding new injector";
-            _activeLocalAudioInjectors.append(injector);
-
-            // update the flag
-            _localInjectorsAvailable.exchange(true, std::memory_order_release);
-        } else {
-            qCDebug(audioclient) << "injector exists in active list already";
+        {
+            Lock lock(_injectorsMutex);
+            if (_localInjectors.add(injector)) {
+                //qCDebug(audioclient) << "adding new injector";
+            } else {
+                qCDebug(audioclient) << "injector exists in active list already";
+            }
         }
+        _localInjectorsThread->injectorAdded();
 
         return true;
 
@@ -1795,7 +1784,7 @@ bool AudioClient::outputLocalInjector(const AudioInjectorPointer& injector) {
 
 int AudioClient::getNumLocalInjectors() {
     Lock lock(_injectorsMutex);
-    return _activeLocalAudioInjectors.size();
+    return _localInjectors.size();
 }
 
 void AudioClient::outputFormatChanged() {
@@ -2238,41 +2227,6 @@ int AudioClient::calculateNumberOfFrameSamples(int numBytes) const {
     return frameSamples;
 }
 
-float AudioClient::azimuthForSource(const glm::vec3& relativePosition) {
-    glm::quat inverseOrientation = glm::inverse(_orientationGetter());
-
-    glm::vec3 rotatedSourcePosition = inverseOrientation * relativePosition;
-
-    // project the rotated source position vector onto the XZ plane
-    rotatedSourcePosition.y = 0.0f;
-
-    static const float SOURCE_DISTANCE_THRESHOLD = 1e-30f;
-
-    float rotatedSourcePositionLength2 = glm::length2(rotatedSourcePosition);
-    if (rotatedSourcePositionLength2 > SOURCE_DISTANCE_THRESHOLD) {
-
-        // produce an oriented angle about the y-axis
-        glm::vec3 direction = rotatedSourcePosition * (1.0f / fastSqrtf(rotatedSourcePositionLength2));
-        float angle = fastAcosf(glm::clamp(-direction.z, -1.0f, 1.0f));  // UNIT_NEG_Z is "forward"
-        return (direction.x < 0.0f) ? -angle : angle;
-
-    } else {
-        // no azimuth if they are in same spot
-        return 0.0f;
-    }
-}
-
-float AudioClient::gainForSource(float distance, float volume) {
-
-    // attenuation = -6dB * log2(distance)
-    // reference attenuation of 0dB at distance = ATTN_DISTANCE_REF
-    float d = (1.0f / ATTN_DISTANCE_REF) * std::max(distance, HRTF_NEARFIELD_MIN);
-    float gain = volume / d;
-    gain = std::min(gain, ATTN_GAIN_MAX);
-
-    return gain;
-}
-
 qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
 
     // lock-free wait for initialization to avoid races
@@ -2313,11 +2267,11 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
         int samplesAvailable = _audio->_localSamplesAvailable.load(std::memory_order_acquire);
 
         // if we do not have enough samples buffered despite having injectors, buffer them synchronously
-        if (samplesAvailable < samplesRequested && _audio->_localInjectorsAvailable.load(std::memory_order_acquire)) {
+        if (samplesAvailable < samplesRequested && _audio->_localInjectors.isPlaying()) {
             // try_to_lock, in case the device is being shut down already
-            std::unique_ptr<Lock> localAudioLock(new Lock(_audio->_localAudioMutex, std::try_to_lock));
-            if (localAudioLock->owns_lock()) {
-                _audio->prepareLocalAudioInjectors(std::move(localAudioLock));
+            Lock localAudioLock(_audio->_localAudioMutex, std::try_to_lock);
+            if (localAudioLock.owns_lock()) {
+                _audio->prepareLocalAudioInjectors(&localAudioLock);
                 samplesAvailable = _audio->_localSamplesAvailable.load(std::memory_order_acquire);
             }
         }
@@ -2329,10 +2283,10 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
         }
     }
 
-    // prepare injectors for the next callback
-    QtConcurrent::run(QThreadPool::globalInstance(), [this] {
-        _audio->prepareLocalAudioInjectors();
-    });
+    // prepare injectors for the next callback, the thread releases the last finished ones without being woken
+    if (_audio->_localInjectors.isPlaying()) {
+        _audio->_localInjectorsThread->wake();
+    }
 
     int samplesPopped = std::max(networkSamplesPopped, injectorSamplesPopped);
     if (samplesPopped == 0) {
@@ -46,6 +46,7 @@
 #include <AudioLimiter.h>
 #include <AudioConstants.h>
 #include <AudioGate.h>
+#include <LocalInjectorTable.h>
 
 #include <shared/RateCounter.h>
 
@@ -79,6 +80,7 @@ class QIODevice;
 
 class Transform;
 class NLPacket;
+class LocalInjectorsThread;
 
 #define DEFAULT_STARVE_DETECTION_ENABLED true
 #define DEFAULT_BUFFER_FRAMES 1
@@ -315,10 +317,10 @@ private:
 
     void outputFormatChanged();
     void handleAudioInput(QByteArray& audioBuffer);
-    void prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLock = nullptr);
+    void prepareLocalAudioInjectors(Lock* localAudioLock = nullptr);
     bool mixLocalAudioInjectors(float* mixBuffer);
-    float azimuthForSource(const glm::vec3& relativePosition);
-    float gainForSource(float distance, float volume);
+    // Returns false once no injectors are left to play or release
+    bool collectLocalInjectors();
 
 #ifdef Q_OS_ANDROID
     QTimer _checkInputTimer{ this };
@@ -370,9 +372,8 @@ private:
     AudioRingBuffer _inputRingBuffer{ 0 };
     LocalInjectorsStream _localInjectorsStream{ 0 , 1 };
     // In order to use _localInjectorsStream as a lock-free pipe,
-    // use it with a single producer/consumer, and track available samples and injectors
+    // use it with a single producer/consumer, and track available samples
     std::atomic<int> _localSamplesAvailable { 0 };
-    std::atomic<bool> _localInjectorsAvailable { false };
     MixedProcessedAudioStream _receivedAudioStream{ RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES };
     bool _isStereoInput{ false };
     std::atomic<bool> _enablePeakValues { false };
@@ -427,7 +428,6 @@ private:
     std::atomic<float> _localInjectorGain { 1.0f };
     std::atomic<float> _systemInjectorGain { 1.0f };
     float _localMixBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
-    int16_t _localScratchBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
     float* _localOutputMixBuffer { NULL };
     Mutex _localAudioMutex;
     AudioLimiter _audioLimiter{ AudioConstants::SAMPLE_RATE, OUTPUT_CHANNEL_COUNT };
@@ -487,7 +487,9 @@ private:
 
     bool _hasReceivedFirstPacket { false };
 
-    QVector<AudioInjectorPointer> _activeLocalAudioInjectors;
+    // mixed without locking, _injectorsMutex serializes adding and releasing injectors
+    LocalInjectorTable _localInjectors;
+    std::unique_ptr<LocalInjectorsThread> _localInjectorsThread;
 
     bool _isPlayingBackRecording { false };
     bool _audioPaused { false };
@@ -108,7 +108,9 @@ void AudioInjector::finish() {
         _state |= AudioInjectorState::Finished;
     });
     emit finished();
-    _localBuffer = nullptr;
+    withWriteLock([&] {
+        _localBuffer = nullptr;
+    });
 }
 
 void AudioInjector::restart() {
@@ -165,14 +167,19 @@ bool AudioInjector::injectLocally() {
     if (_localAudioInterface) {
         if (_audioData->getNumBytes() > 0) {
 
-            _localBuffer = QSharedPointer<AudioInjectorLocalBuffer>(new AudioInjectorLocalBuffer(_audioData), &AudioInjectorLocalBuffer::deleteLater);
-            _localBuffer->moveToThread(thread());
+            auto localBuffer = QSharedPointer<AudioInjectorLocalBuffer>(new AudioInjectorLocalBuffer(_audioData), &AudioInjectorLocalBuffer::deleteLater);
+            localBuffer->moveToThread(thread());
 
-            _localBuffer->open(QIODevice::ReadOnly);
-            _localBuffer->setShouldLoop(_options.loop);
+            localBuffer->open(QIODevice::ReadOnly);
+            localBuffer->setShouldLoop(_options.loop);
 
             // give our current send position to the local buffer
-            _localBuffer->setCurrentOffset(_currentSendOffset);
+            localBuffer->setCurrentOffset(_currentSendOffset);
+
+            // the audio client reads it from its own threads
+            withWriteLock([&] {
+                _localBuffer = localBuffer;
+            });
 
             // call this function on the AudioClient's thread
             // this will move the local buffer's thread to the LocalInjectorThread
@@ -338,6 +345,7 @@ int64_t AudioInjector::injectNextFrame() {
     }
 
     auto samples = _audioData->data();
+    auto numSamplesAvailable = _audioData->getNumSamplesAvailable();
     auto currentSample = _currentSendOffset / AudioConstants::SAMPLE_SIZE;
     auto samplesLeftToCopy = totalBytesLeftToCopy / AudioConstants::SAMPLE_SIZE;
 
@@ -350,7 +358,8 @@ int64_t AudioInjector::injectNextFrame() {
         _loudness = 0.0f;
         for (int i = 0; i < samplesLeftToCopy; ++i) {
             auto index = (currentSample + i) % _audioData->getNumSamples();
-            auto sample = samples[index];
+            // a sound that is still decoding is silent past what has been decoded so far
+            AudioSample sample = (index < numSamplesAvailable) ? samples[index] : 0;
             samplesOut[i] = sample;
             _loudness += abs(sample) / (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
         }
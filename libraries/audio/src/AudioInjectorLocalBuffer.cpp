@@ -46,7 +46,7 @@ qint64 AudioInjectorLocalBuffer::readData(char* data, qint64 maxSize) {
             bytesRead = bytesToEnd;
         }
         
-        memcpy(data, _audioData->rawData() + _currentOffset, bytesRead);
+        copyAudio(data, _currentOffset, bytesRead);
         
         // now check if we are supposed to loop and if we can copy more from the beginning
         if (_shouldLoop && maxSize != bytesRead) {
@@ -65,6 +65,15 @@ qint64 AudioInjectorLocalBuffer::readData(char* data, qint64 maxSize) {
     }
 }
 
+void AudioInjectorLocalBuffer::copyAudio(char* data, int offset, int size) {
+    // a sound that is still decoding is silent past what has been decoded so far
+    int bytesAvailable = (int)(_audioData->getNumSamplesAvailable() * sizeof(AudioConstants::AudioSample)) - offset;
+    int bytesToCopy = glm::clamp(bytesAvailable, 0, size);
+
+    memcpy(data, _audioData->rawData() + offset, bytesToCopy);
+    memset(data + bytesToCopy, 0, size - bytesToCopy);
+}
+
 qint64 AudioInjectorLocalBuffer::recursiveReadFromFront(char* data, qint64 maxSize) {
     // see how much we can get in this pass
     int bytesRead = maxSize;
@@ -74,7 +83,7 @@ qint64 AudioInjectorLocalBuffer::recursiveReadFromFront(char* data, qint64 maxSi
     }
     
     // copy that amount
-    memcpy(data, _audioData->rawData(), bytesRead);
+    copyAudio(data, 0, bytesRead);
     
     // check if we need to call ourselves again and pull from the front again
     if (bytesRead < maxSize) {
@@ -36,6 +36,7 @@ public:
 
 private:
     qint64 recursiveReadFromFront(char* data, qint64 maxSize);
+    void copyAudio(char* data, int offset, int size);
 
     AudioDataPointer _audioData;
     bool _shouldLoop { false };
@@ -188,6 +188,8 @@ AudioInjectorPointer AudioInjectorManager::playSound(const SharedSoundPointer& s
             const int resampledRate = glm::round(SAMPLE_RATE / pitch);
 
             auto audioData = sound->getAudioData();
+            // the whole sound is resampled up front, so it has to be fully decoded
+            audioData->waitUntilComplete();
             auto numChannels = audioData->getNumChannels();
             auto numFrames = audioData->getNumFrames();
 
@@ -239,6 +241,8 @@ AudioInjectorPointer AudioInjectorManager::playSound(const AudioDataPointer& aud
         const float pitch = glm::clamp(options.pitch, 1 / 16.0f, 16.0f);
         const int resampledRate = glm::round(SAMPLE_RATE / pitch);
 
+        // the whole sound is resampled up front, so it has to be fully decoded
+        audioData->waitUntilComplete();
         auto numChannels = audioData->getNumChannels();
         auto numFrames = audioData->getNumFrames();
 
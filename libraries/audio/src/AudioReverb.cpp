@@ -8,10 +8,18 @@
 
 #include "AudioReverb.h"
 
+#include <assert.h>
 #include <stdint.h>
 #include <string.h>
 #include <math.h>
 
+// keep multiplies and adds separate, so the block kernels round the same as the frame at a time code
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
 #ifdef _MSC_VER
 #include <intrin.h>
 #define MULHI(a,b)  ((int32_t)(__emul(a, b) >> 32))
@@ -625,6 +633,157 @@ void PZShelf(double coef[3], double w0, double dbgain, int isHigh) {
     coef[2] = a1 * scale;
 }
 
+//
+// Vector kernels for block processing
+//
+// allpass: output = delayed - coef * input, feedback = input + coef * output
+// scale:   output = gain * input
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static void allpass_SSE(const float* delayed, const float* input, float* output, float* feedback, float coef, int numFrames) {
+    __m128 c = _mm_set1_ps(coef);
+
+    int i = 0;
+    for (; i < numFrames - 3; i += 4) {
+        __m128 x = _mm_loadu_ps(&input[i]);
+        __m128 y = _mm_sub_ps(_mm_loadu_ps(&delayed[i]), _mm_mul_ps(c, x));
+        _mm_storeu_ps(&output[i], y);
+        _mm_storeu_ps(&feedback[i], _mm_add_ps(x, _mm_mul_ps(c, y)));
+    }
+    for (; i < numFrames; i++) {
+        output[i] = delayed[i] - coef * input[i];
+        feedback[i] = input[i] + coef * output[i];
+    }
+}
+
+static void scale_SSE(const float* input, float* output, float gain, int numFrames) {
+    __m128 g = _mm_set1_ps(gain);
+
+    int i = 0;
+    for (; i < numFrames - 3; i += 4) {
+        _mm_storeu_ps(&output[i], _mm_mul_ps(g, _mm_loadu_ps(&input[i])));
+    }
+    for (; i < numFrames; i++) {
+        output[i] = gain * input[i];
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void allpass_AVX2(const float* delayed, const float* input, float* output, float* feedback, float coef, int numFrames);
+void scale_AVX2(const float* input, float* output, float gain, int numFrames);
+
+static void allpassBlock(const float* delayed, const float* input, float* output, float* feedback, float coef, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? allpass_AVX2 : allpass_SSE;
+    (*f)(delayed, input, output, feedback, coef, numFrames);    // dispatch
+}
+
+static void scaleBlock(const float* input, float* output, float gain, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? scale_AVX2 : scale_SSE;
+    (*f)(input, output, gain, numFrames);   // dispatch
+}
+
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+static void allpassBlock(const float* delayed, const float* input, float* output, float* feedback, float coef, int numFrames) {
+    float32x4_t c = vdupq_n_f32(coef);
+
+    int i = 0;
+    for (; i < numFrames - 3; i += 4) {
+        float32x4_t x = vld1q_f32(&input[i]);
+        float32x4_t y = vsubq_f32(vld1q_f32(&delayed[i]), vmulq_f32(c, x));
+        vst1q_f32(&output[i], y);
+        vst1q_f32(&feedback[i], vaddq_f32(x, vmulq_f32(c, y)));
+    }
+    for (; i < numFrames; i++) {
+        output[i] = delayed[i] - coef * input[i];
+        feedback[i] = input[i] + coef * output[i];
+    }
+}
+
+static void scaleBlock(const float* input, float* output, float gain, int numFrames) {
+    float32x4_t g = vdupq_n_f32(gain);
+
+    int i = 0;
+    for (; i < numFrames - 3; i += 4) {
+        vst1q_f32(&output[i], vmulq_f32(g, vld1q_f32(&input[i])));
+    }
+    for (; i < numFrames; i++) {
+        output[i] = gain * input[i];
+    }
+}
+
+#else   // portable reference code
+
+static void allpassBlock(const float* delayed, const float* input, float* output, float* feedback, float coef, int numFrames) {
+    for (int i = 0; i < numFrames; i++) {
+        output[i] = delayed[i] - coef * input[i];
+        feedback[i] = input[i] + coef * output[i];
+    }
+}
+
+static void scaleBlock(const float* input, float* output, float gain, int numFrames) {
+    for (int i = 0; i < numFrames; i++) {
+        output[i] = gain * input[i];
+    }
+}
+
+#endif
+
+//
+// Block processing gives the same result as processing one frame at a time. Every element outputs
+// the value it computed on the previous frame, so a block is run element by element in the same order.
+// Delay buffers are read in contiguous runs that don't wrap or overtake the frames written in this block.
+//
+static const int REVERB_VECTOR_BLOCK = 32;
+static const int REVERB_MIN_VECTOR_BLOCK = 4;
+
+// Reads one tap of a delay buffer over a block, output[i] is the tap from the previous frame like process().
+// The frames of this block are taken from input once the delay reaches them, input may be null if it never does.
+static void readTapBlock(const float* buffer, int size, int index, int delay, float gain, float& state,
+                         const float* input, float* output, int numFrames) {
+    float tap[REVERB_VECTOR_BLOCK];
+
+    // a zero delay reads the oldest frame in the buffer
+    delay = ((delay - 1) & (size - 1)) + 1;
+
+    int fromBuffer = MIN(delay, numFrames);
+    int i = 0;
+    while (i < fromBuffer) {
+        int k = (index - delay + i) & (size - 1);
+        int n = MIN(fromBuffer - i, size - k);
+        scaleBlock(&buffer[k], &tap[i], gain, n);
+        i += n;
+    }
+    if (i < numFrames) {
+        assert(input);
+        scaleBlock(&input[i - delay], &tap[i], gain, numFrames - i);
+    }
+
+    output[0] = state;
+    memcpy(&output[1], tap, (numFrames - 1) * sizeof(float));
+    state = tap[numFrames - 1];
+}
+
+static void writeBlock(float* buffer, int size, int& index, const float* input, int numFrames) {
+    int i = 0;
+    while (i < numFrames) {
+        int n = MIN(numFrames - i, size - index);
+        memcpy(&buffer[index], &input[i], n * sizeof(float));
+        index = (index + n) & (size - 1);
+        i += n;
+    }
+}
+
 class BandwidthEQ {
 
     float _buffer[4] {};
@@ -685,6 +844,12 @@ public:
         _buffer[3] = _b2 * input1 - _a2 * _output1;
     }
 
+    void process(const float* input0, const float* input1, float* output0, float* output1, int numFrames) {
+        for (int i = 0; i < numFrames; i++) {
+            process(input0[i], input1[i], output0[i], output1[i]);
+        }
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output0 = 0.0f;
@@ -722,6 +887,11 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    void process(const float* input, float* output, int numFrames) {
+        readTapBlock(_buffer, N, _index, _delay, 1.0f, _output, input, output, numFrames);
+        writeBlock(_buffer, N, _index, input, numFrames);
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output = 0.0f;
@@ -768,6 +938,27 @@ public:
         _index1 = (_index1 + 1) & (N - 1);
     }
 
+    void process(const float* input, float* output, int numFrames) {
+        float result[REVERB_VECTOR_BLOCK];
+
+        // runs no longer than the delay only read frames from before the run
+        for (int i = 0; i < numFrames;) {
+            int n = MIN(numFrames - i, _delay);
+            n = MIN(n, N - _index0);
+            n = MIN(n, N - _index1);
+
+            allpassBlock(&_buffer[_index1], &input[i], &result[i], &_buffer[_index0], _coef, n);
+
+            _index0 = (_index0 + n) & (N - 1);
+            _index1 = (_index1 + n) & (N - 1);
+            i += n;
+        }
+
+        output[0] = _output;
+        memcpy(&output[1], result, (numFrames - 1) * sizeof(float));
+        _output = result[numFrames - 1];
+    }
+
     void getOutput(float& output) {
         output = _output;
     }
@@ -859,6 +1050,12 @@ public:
         lfoSin = 2 * MULHI(lfoSin, _m0) + _b0;  // Q31
         lfoCos = 2 * MULHI(lfoCos, _m1) + _b1;  // Q31
     }
+
+    void process(int32_t* lfoSin, int32_t* lfoCos, int numFrames) {
+        for (int i = 0; i < numFrames; i++) {
+            process(lfoSin[i], lfoCos[i]);
+        }
+    }
 };
 
 template<int N>
@@ -922,6 +1119,13 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // the modulated taps are interpolated one frame at a time
+    void process(const float* input, const int32_t* mod, float* output, int numFrames) {
+        for (int i = 0; i < numFrames; i++) {
+            process(input[i], mod[i], output[i]);
+        }
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output = 0.0f;
@@ -957,6 +1161,12 @@ public:
         _buffer[0] = input;
     }
 
+    void process(const float* input, float* output, int numFrames) {
+        for (int i = 0; i < numFrames; i++) {
+            process(input[i], output[i]);
+        }
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output = 0.0f;
@@ -1003,6 +1213,12 @@ public:
         _buffer[1] = _b2 * input - _a2 * _output;
     }
 
+    void process(const float* input, float* output, int numFrames) {
+        for (int i = 0; i < numFrames; i++) {
+            process(input[i], output[i]);
+        }
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output = 0.0f;
@@ -1060,6 +1276,21 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // tap 0 read ahead of the input, the block must not be longer than its delay
+    void readTap0(float* output0, int numFrames) {
+        assert(numFrames <= _delay0);
+        readTapBlock(_buffer, N, _index, _delay0, _gain0, _output0, nullptr, output0, numFrames);
+    }
+
+    // output0 is null when tap 0 was already read ahead
+    void process(const float* input, float* output0, float* output1, int numFrames) {
+        if (output0) {
+            readTapBlock(_buffer, N, _index, _delay0, _gain0, _output0, input, output0, numFrames);
+        }
+        readTapBlock(_buffer, N, _index, _delay1, _gain1, _output1, input, output1, numFrames);
+        writeBlock(_buffer, N, _index, input, numFrames);
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output0 = 0.0f;
@@ -1127,6 +1358,13 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    void process(const float* input, float* output0, float* output1, float* output2, int numFrames) {
+        readTapBlock(_buffer, N, _index, _delay0, _gain0, _output0, input, output0, numFrames);
+        readTapBlock(_buffer, N, _index, _delay1, _gain1, _output1, input, output1, numFrames);
+        readTapBlock(_buffer, N, _index, _delay2, _gain2, _output2, input, output2, numFrames);
+        writeBlock(_buffer, N, _index, input, numFrames);
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output0 = 0.0f;
@@ -1205,9 +1443,14 @@ class ReverbImpl {
     float _earlyGain = 0.0f;
     float _wetDryMix = 0.0f;
 
+    int _blockSize = 1;
+
+    void processBlock(const float* input0, const float* input1, float* output0, float* output1, int numFrames);
+
 public:
     void setParameters(ReverbParameters *p);
     void process(float** inputs, float** outputs, int numFrames);
+    void processFrames(float** inputs, float** outputs, int numFrames);
     void reset();
 };
 
@@ -1575,10 +1818,186 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
 
     _wetDryMix = p->wetDryMix * (1/100.0f);
     _wetDryMix = MIN(MAX(_wetDryMix, 0.0f), 1.0f);
+
+    // The late taps feeding back into the network are read a block ahead, so a block can't be longer than them
+    int feedbackDelay = MIN(MIN(_mt6.getDelay(0), _mt7.getDelay(0)), MIN(_mt8.getDelay(0), _mt9.getDelay(0)));
+    _blockSize = MIN(feedbackDelay, REVERB_VECTOR_BLOCK);
 }
 
 void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
 
+    if (_blockSize < REVERB_MIN_VECTOR_BLOCK) {
+        processFrames(inputs, outputs, numFrames);
+        return;
+    }
+
+    for (int i = 0; i < numFrames; i += _blockSize) {
+        int n = MIN(numFrames - i, _blockSize);
+        processBlock(&inputs[0][i], &inputs[1][i], &outputs[0][i], &outputs[1][i], n);
+    }
+}
+
+//
+// Same network as processFrames(), one element at a time over a block of frames.
+// The late taps are read first, they only depend on frames from before the block.
+//
+void ReverbImpl::processBlock(const float* input0, const float* input1, float* output0, float* output1, int numFrames) {
+
+    float x0[REVERB_VECTOR_BLOCK], x1[REVERB_VECTOR_BLOCK];
+    float y0[REVERB_VECTOR_BLOCK], y1[REVERB_VECTOR_BLOCK], y2[REVERB_VECTOR_BLOCK], y3[REVERB_VECTOR_BLOCK];
+    float sum[REVERB_VECTOR_BLOCK];
+
+    // Preprocess
+    float preL[REVERB_VECTOR_BLOCK], preR[REVERB_VECTOR_BLOCK];
+    _bw.process(input0, input1, x0, x1, numFrames);
+    _dl0.process(x0, preL, numFrames);
+    _dl1.process(x1, preR, numFrames);
+
+    // Early Left
+    float early0L[REVERB_VECTOR_BLOCK], early1L[REVERB_VECTOR_BLOCK], early2L[REVERB_VECTOR_BLOCK];
+    float earlyOutL[REVERB_VECTOR_BLOCK];
+    _mt0.process(preL, x0, x1, y0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = x0[i] + x1[i];
+    }
+    _ap0.process(sum, y1, numFrames);
+    _mt1.process(y1, x0, x1, early0L, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = x0[i] + x1[i];
+    }
+    _ap1.process(sum, y2, numFrames);
+    _ap2.process(y2, x0, numFrames);
+    _mt2.process(x0, early1L, early2L, numFrames);
+
+    for (int i = 0; i < numFrames; i++) {
+        earlyOutL[i] = (y0[i] + y1[i] * _earlyMix1L + y2[i] * _earlyMix2L) * _earlyGain;
+    }
+
+    // Early Right
+    float early0R[REVERB_VECTOR_BLOCK], early1R[REVERB_VECTOR_BLOCK], early2R[REVERB_VECTOR_BLOCK];
+    float earlyOutR[REVERB_VECTOR_BLOCK];
+    _mt3.process(preR, x0, x1, y0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = x0[i] + x1[i];
+    }
+    _ap3.process(sum, y1, numFrames);
+    _mt4.process(y1, x0, x1, early0R, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = x0[i] + x1[i];
+    }
+    _ap4.process(sum, y2, numFrames);
+    _ap5.process(y2, x0, numFrames);
+    _mt5.process(x0, early1R, early2R, numFrames);
+
+    for (int i = 0; i < numFrames; i++) {
+        earlyOutR[i] = (y0[i] + y1[i] * _earlyMix1R + y2[i] * _earlyMix2R) * _earlyGain;
+    }
+
+    // LFO update
+    int32_t lfoSin[REVERB_VECTOR_BLOCK], lfoCos[REVERB_VECTOR_BLOCK];
+    _lfo.process(lfoSin, lfoCos, numFrames);
+
+    // Late taps feeding back, read ahead of their input
+    float late2[REVERB_VECTOR_BLOCK], late3[REVERB_VECTOR_BLOCK];
+    _mt6.readTap0(y0, numFrames);
+    _mt7.readTap0(y1, numFrames);
+    _mt8.readTap0(late2, numFrames);
+    _mt9.readTap0(late3, numFrames);
+    _lp0.process(late2, y2, numFrames);
+    _lp1.process(late3, y3, numFrames);
+
+    // Feedback matrix, the allpass outputs start each late path
+    float late0In[REVERB_VECTOR_BLOCK], late1In[REVERB_VECTOR_BLOCK];
+    float late2In[REVERB_VECTOR_BLOCK], late3In[REVERB_VECTOR_BLOCK];
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = early1L[i] + y2[i] - y3[i];
+    }
+    _ap6.process(sum, late0In, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = early1R[i] - y2[i] - y3[i];
+    }
+    _ap8.process(sum, late1In, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -early2R[i] + y0[i] + y1[i];
+    }
+    _ap10.process(sum, late2In, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -early2L[i] - y0[i] + y1[i];
+    }
+    _ap14.process(sum, late3In, numFrames);
+
+    // Late
+    float lateOut0[REVERB_VECTOR_BLOCK];
+    _ap7.process(late0In, lfoSin, x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -early0L[i] + x0[i];
+    }
+    _eq0.process(sum, x0, numFrames);
+    _mt6.process(x0, nullptr, lateOut0, numFrames);
+
+    float lateOut1[REVERB_VECTOR_BLOCK];
+    _ap9.process(late1In, lfoCos, x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -early0R[i] + x0[i];
+    }
+    _eq1.process(sum, x0, numFrames);
+    _mt7.process(x0, nullptr, lateOut1, numFrames);
+
+    float lateOut2[REVERB_VECTOR_BLOCK];
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -early2L[i] + late2In[i];
+    }
+    _ap11.process(sum, x0, numFrames);
+    _ap12.process(x0, x1, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -early2L[i] - x1[i];
+    }
+    _ap13.process(sum, x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -early0L[i] + x0[i];
+    }
+    _mt8.process(sum, nullptr, lateOut2, numFrames);
+
+    float lateOut3[REVERB_VECTOR_BLOCK];
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -early2R[i] + late3In[i];
+    }
+    _ap15.process(sum, x0, numFrames);
+    _ap16.process(x0, x1, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -early2R[i] - x1[i];
+    }
+    _ap17.process(sum, x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -early0R[i] + x0[i];
+    }
+    _mt9.process(sum, nullptr, lateOut3, numFrames);
+
+    // Output Left
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -earlyOutL[i] + lateOut0[i] + lateOut3[i];
+    }
+    _ap18.process(sum, x0, numFrames);
+    _ap19.process(x0, y0, numFrames);
+
+    // Output Right
+    for (int i = 0; i < numFrames; i++) {
+        sum[i] = -earlyOutR[i] + lateOut1[i] + lateOut2[i];
+    }
+    _ap20.process(sum, x1, numFrames);
+    _ap21.process(x1, y1, numFrames);
+
+    for (int i = 0; i < numFrames; i++) {
+        float dry0 = input0[i];
+        float dry1 = input1[i];
+        output0[i] = dry0 + (y0[i] - dry0) * _wetDryMix;
+        output1[i] = dry1 + (y1[i] - dry1) * _wetDryMix;
+    }
+}
+
+// One frame at a time, used when the network has feedback paths too short for block processing
+void ReverbImpl::processFrames(float** inputs, float** outputs, int numFrames) {
+
     for (int i = 0; i < numFrames; i++) {
         float x0, x1, y0, y1, y2, y3;
 
@@ -1791,6 +2210,10 @@ void AudioReverb::render(float** inputs, float** outputs, int numFrames) {
     _impl->process(inputs, outputs, numFrames);
 }
 
+void AudioReverb::renderFrames(float** inputs, float** outputs, int numFrames) {
+    _impl->processFrames(inputs, outputs, numFrames);
+}
+
 //
 // on x86 architecture, assume that SSE2 is present
 //
@@ -48,6 +48,7 @@ typedef struct ReverbParameters {
 } ReverbParameters;
 
 class ReverbImpl;
+class AudioDSPTests;
 
 class AudioReverb {
 public:
@@ -68,11 +69,16 @@ public:
     void render(const float* input, float* output, int numFrames);
 
 private:
+    friend class ::AudioDSPTests;
+
     ReverbImpl *_impl;
     ReverbParameters _params;
 
     float* _inout[2];
 
+    // the frame at a time network, whatever the block size, so it can be checked against render()
+    void renderFrames(float** inputs, float** outputs, int numFrames);
+
     void convertInput(const int16_t* input, float** outputs, int numFrames);
     void convertOutput(float** inputs, int16_t* output, int numFrames);
 
@@ -428,6 +428,317 @@ int AudioSRC::multirateFilter4_ref(const float* input0, const float* input1, con
 
 #if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
 
+#include <emmintrin.h>  // SSE2
+
+//
+// SSE2 fallback, for CPUs without AVX2
+//
+
+int AudioSRC::multirateFilter1_SSE(const float* input0, float* output0, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 8 == 0);  // SIMD8
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                //float coef = c0[j];
+                __m128 coef0 = _mm_loadu_ps(&c0[j + 0]);
+                __m128 coef1 = _mm_loadu_ps(&c0[j + 4]);
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+            }
+            acc0 = _mm_add_ps(acc0, acc1);
+
+            // horizontal sum
+            acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+            acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(0,0,0,1)));
+
+            _mm_store_ss(&output0[outputFrames], acc0);
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            __m128 frac = _mm_set1_ps((f & SRC_FRACMASK) * QFRAC_TO_FLOAT);
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                __m128 coef0 = _mm_loadu_ps(&c0[j + 0]);
+                __m128 coef1 = _mm_loadu_ps(&c0[j + 4]);
+                __m128 coef2 = _mm_loadu_ps(&c1[j + 0]);
+                __m128 coef3 = _mm_loadu_ps(&c1[j + 4]);
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                coef2 = _mm_sub_ps(coef2, coef0);
+                coef3 = _mm_sub_ps(coef3, coef1);
+                coef0 = _mm_add_ps(coef0, _mm_mul_ps(coef2, frac));
+                coef1 = _mm_add_ps(coef1, _mm_mul_ps(coef3, frac));
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+            }
+            acc0 = _mm_add_ps(acc0, acc1);
+
+            // horizontal sum
+            acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+            acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(0,0,0,1)));
+
+            _mm_store_ss(&output0[outputFrames], acc0);
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+
+    return outputFrames;
+}
+
+int AudioSRC::multirateFilter2_SSE(const float* input0, const float* input1, float* output0, float* output1, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 8 == 0);  // SIMD8
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                //float coef = c0[j];
+                __m128 coef0 = _mm_loadu_ps(&c0[j + 0]);
+                __m128 coef1 = _mm_loadu_ps(&c0[j + 4]);
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 0]), coef0));
+
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 4]), coef1));
+            }
+
+            // horizontal sum
+            __m128 t0 = _mm_add_ps(_mm_unpacklo_ps(acc0, acc1), _mm_unpackhi_ps(acc0, acc1));
+            t0 = _mm_add_ps(t0, _mm_movehl_ps(t0, t0));
+
+            _mm_store_ss(&output0[outputFrames], t0);
+            _mm_store_ss(&output1[outputFrames], _mm_shuffle_ps(t0, t0, _MM_SHUFFLE(0,0,0,1)));
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            __m128 frac = _mm_set1_ps((f & SRC_FRACMASK) * QFRAC_TO_FLOAT);
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                __m128 coef0 = _mm_loadu_ps(&c0[j + 0]);
+                __m128 coef1 = _mm_loadu_ps(&c0[j + 4]);
+                __m128 coef2 = _mm_loadu_ps(&c1[j + 0]);
+                __m128 coef3 = _mm_loadu_ps(&c1[j + 4]);
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                coef2 = _mm_sub_ps(coef2, coef0);
+                coef3 = _mm_sub_ps(coef3, coef1);
+                coef0 = _mm_add_ps(coef0, _mm_mul_ps(coef2, frac));
+                coef1 = _mm_add_ps(coef1, _mm_mul_ps(coef3, frac));
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 0]), coef0));
+
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 4]), coef1));
+            }
+
+            // horizontal sum
+            __m128 t0 = _mm_add_ps(_mm_unpacklo_ps(acc0, acc1), _mm_unpackhi_ps(acc0, acc1));
+            t0 = _mm_add_ps(t0, _mm_movehl_ps(t0, t0));
+
+            _mm_store_ss(&output0[outputFrames], t0);
+            _mm_store_ss(&output1[outputFrames], _mm_shuffle_ps(t0, t0, _MM_SHUFFLE(0,0,0,1)));
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+
+    return outputFrames;
+}
+
+int AudioSRC::multirateFilter4_SSE(const float* input0, const float* input1, const float* input2, const float* input3, 
+                                   float* output0, float* output1, float* output2, float* output3, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 8 == 0);  // SIMD8
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+            __m128 acc2 = _mm_setzero_ps();
+            __m128 acc3 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                //float coef = c0[j];
+                __m128 coef0 = _mm_loadu_ps(&c0[j + 0]);
+                __m128 coef1 = _mm_loadu_ps(&c0[j + 4]);
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 0]), coef0));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(&input2[i + j + 0]), coef0));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(&input3[i + j + 0]), coef0));
+
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 4]), coef1));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(&input2[i + j + 4]), coef1));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(&input3[i + j + 4]), coef1));
+            }
+
+            // horizontal sum
+            _MM_TRANSPOSE4_PS(acc0, acc1, acc2, acc3);
+            acc0 = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+
+            _mm_store_ss(&output0[outputFrames], acc0);
+            _mm_store_ss(&output1[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(0,0,0,1)));
+            _mm_store_ss(&output2[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(0,0,0,2)));
+            _mm_store_ss(&output3[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(0,0,0,3)));
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            __m128 frac = _mm_set1_ps((f & SRC_FRACMASK) * QFRAC_TO_FLOAT);
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+            __m128 acc2 = _mm_setzero_ps();
+            __m128 acc3 = _mm_setzero_ps();
+
+            for (int j = 0; j < _numTaps; j += 8) {
+
+                __m128 coef0 = _mm_loadu_ps(&c0[j + 0]);
+                __m128 coef1 = _mm_loadu_ps(&c0[j + 4]);
+                __m128 coef2 = _mm_loadu_ps(&c1[j + 0]);
+                __m128 coef3 = _mm_loadu_ps(&c1[j + 4]);
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                coef2 = _mm_sub_ps(coef2, coef0);
+                coef3 = _mm_sub_ps(coef3, coef1);
+                coef0 = _mm_add_ps(coef0, _mm_mul_ps(coef2, frac));
+                coef1 = _mm_add_ps(coef1, _mm_mul_ps(coef3, frac));
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 0]), coef0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 0]), coef0));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(&input2[i + j + 0]), coef0));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(&input3[i + j + 0]), coef0));
+
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&input0[i + j + 4]), coef1));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&input1[i + j + 4]), coef1));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(&input2[i + j + 4]), coef1));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(&input3[i + j + 4]), coef1));
+            }
+
+            // horizontal sum
+            _MM_TRANSPOSE4_PS(acc0, acc1, acc2, acc3);
+            acc0 = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+
+            _mm_store_ss(&output0[outputFrames], acc0);
+            _mm_store_ss(&output1[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(0,0,0,1)));
+            _mm_store_ss(&output2[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(0,0,0,2)));
+            _mm_store_ss(&output3[outputFrames], _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(0,0,0,3)));
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+
+    return outputFrames;
+}
+
 //
 // Runtime CPU dispatch
 //
@@ -435,18 +746,21 @@ int AudioSRC::multirateFilter4_ref(const float* input0, const float* input1, con
 #include "CPUDetect.h"
 
 int AudioSRC::multirateFilter1(const float* input0, float* output0, int inputFrames) {
-    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter1_AVX2 : &AudioSRC::multirateFilter1_ref;
+    static auto f = cpuSupportsAVX512() ? &AudioSRC::multirateFilter1_AVX512 :
+                    (cpuSupportsAVX2() ? &AudioSRC::multirateFilter1_AVX2 : &AudioSRC::multirateFilter1_SSE);
     return (this->*f)(input0, output0, inputFrames);    // dispatch
 }
 
 int AudioSRC::multirateFilter2(const float* input0, const float* input1, float* output0, float* output1, int inputFrames) {
-    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter2_AVX2 : &AudioSRC::multirateFilter2_ref;
+    static auto f = cpuSupportsAVX512() ? &AudioSRC::multirateFilter2_AVX512 :
+                    (cpuSupportsAVX2() ? &AudioSRC::multirateFilter2_AVX2 : &AudioSRC::multirateFilter2_SSE);
     return (this->*f)(input0, input1, output0, output1, inputFrames);   // dispatch
 }
 
 int AudioSRC::multirateFilter4(const float* input0, const float* input1, const float* input2, const float* input3, 
                                float* output0, float* output1, float* output2, float* output3, int inputFrames) {
-    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter4_AVX2 : &AudioSRC::multirateFilter4_ref;
+    static auto f = cpuSupportsAVX512() ? &AudioSRC::multirateFilter4_AVX512 :
+                    (cpuSupportsAVX2() ? &AudioSRC::multirateFilter4_AVX2 : &AudioSRC::multirateFilter4_SSE);
     return (this->*f)(input0, input1, input2, input3, output0, output1, output2, output3, inputFrames); // dispatch
 }
 
@@ -28,6 +28,8 @@ static const float Q32_TO_FLOAT = 1.0f / (1ULL << 32);
 // blocking size in frames, chosen so block processing fits in L1 cache
 static const int SRC_BLOCK = 256;
 
+class AudioDSPTests;
+
 class AudioSRC {
 
 public:
@@ -55,6 +57,8 @@ public:
     int getMaxInput(int outputFrames);
 
 private:
+    friend class ::AudioDSPTests;
+
     float* _polyphaseFilter;
     int* _stepTable;
 
@@ -89,11 +93,21 @@ private:
     int multirateFilter4_ref(const float* input0, const float* input1, const float* input2, const float* input3, 
                              float* output0, float* output1, float* output2, float* output3, int inputFrames);
 
+    int multirateFilter1_SSE(const float* input0, float* output0, int inputFrames);
+    int multirateFilter2_SSE(const float* input0, const float* input1, float* output0, float* output1, int inputFrames);
+    int multirateFilter4_SSE(const float* input0, const float* input1, const float* input2, const float* input3, 
+                             float* output0, float* output1, float* output2, float* output3, int inputFrames);
+
     int multirateFilter1_AVX2(const float* input0, float* output0, int inputFrames);
     int multirateFilter2_AVX2(const float* input0, const float* input1, float* output0, float* output1, int inputFrames);
     int multirateFilter4_AVX2(const float* input0, const float* input1, const float* input2, const float* input3, 
                               float* output0, float* output1, float* output2, float* output3, int inputFrames);
 
+    int multirateFilter1_AVX512(const float* input0, float* output0, int inputFrames);
+    int multirateFilter2_AVX512(const float* input0, const float* input1, float* output0, float* output1, int inputFrames);
+    int multirateFilter4_AVX512(const float* input0, const float* input1, const float* input2, const float* input3, 
+                                float* output0, float* output1, float* output2, float* output3, int inputFrames);
+
     void convertInput(const int16_t* input, float** outputs, int numFrames);
     void convertOutput(float** inputs, int16_t* output, int numFrames);
 
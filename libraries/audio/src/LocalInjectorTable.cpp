@@ -0,0 +1,305 @@
+//
+//  LocalInjectorTable.cpp
+//  libraries/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LocalInjectorTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include <glm/gtx/norm.hpp>
+
+#include <AudioHelpers.h>
+#include <NumericalConstants.h>
+
+const int LocalInjectorTable::CAPACITY;
+
+bool LocalInjectorTable::add(const AudioInjectorPointer& injector) {
+    auto localBuffer = injector->getLocalBuffer();
+    bool isRestarting = false;
+    for (auto& voice : _voices) {
+        if (voice.state.load(std::memory_order_acquire) != FREE && voice.injector == injector) {
+            if (voice.localBuffer == localBuffer) {
+                return false;
+            }
+            // restarted, the old buffer fades out while the new one starts
+            fadeOut(voice);
+            isRestarting = true;
+        }
+    }
+    if (std::find(_pending.begin(), _pending.end(), injector) != _pending.end()) {
+        return false;
+    }
+
+    Voice* voice = findFreeVoice();
+    if (voice) {
+        start(*voice, injector);
+        return true;
+    }
+
+    // steal the quietest voice that is still playing, unless a restart is already freeing one
+    Voice* quietest = nullptr;
+    for (auto& other : _voices) {
+        if (other.state.load(std::memory_order_acquire) == PLAYING &&
+            (!quietest || other.loudness.load(std::memory_order_relaxed) < quietest->loudness.load(std::memory_order_relaxed))) {
+            quietest = &other;
+        }
+    }
+    if (quietest && !isRestarting) {
+        fadeOut(*quietest);
+    }
+
+    // never wait on more injectors than there are voices, the oldest ones would be stolen anyway
+    _pending.push_back(injector);
+    if ((int)_pending.size() > CAPACITY) {
+        _dropped.append(_pending.front());
+        _pending.pop_front();
+    }
+    return true;
+}
+
+QVector<AudioInjectorPointer> LocalInjectorTable::update() {
+    QVector<AudioInjectorPointer> finished;
+    finished.swap(_dropped);
+
+    for (auto& voice : _voices) {
+        if (voice.state.load(std::memory_order_acquire) == FINISHED) {
+            // a restarted injector is still playing from its new buffer
+            auto localBuffer = voice.injector->getLocalBuffer();
+            if (!localBuffer || localBuffer == voice.localBuffer) {
+                finished.append(voice.injector);
+            }
+            voice.injector.reset();
+            voice.localBuffer.reset();
+            voice.state.store(FREE, std::memory_order_release);
+        }
+    }
+
+    while (!_pending.empty()) {
+        Voice* voice = findFreeVoice();
+        if (!voice) {
+            break;
+        }
+        start(*voice, _pending.front());
+        _pending.pop_front();
+    }
+
+    for (auto& voice : _voices) {
+        int state = voice.state.load(std::memory_order_acquire);
+        if (state == PLAYING || state == STEALING) {
+            publishOptions(voice, voice.injector->getOptions());
+            // stopped or restarted since the voice started
+            if (voice.injector->getLocalBuffer() != voice.localBuffer) {
+                fadeOut(voice);
+            }
+        }
+    }
+
+    return finished;
+}
+
+int LocalInjectorTable::size() const {
+    int result = (int)_pending.size();
+    for (const auto& voice : _voices) {
+        if (voice.state.load(std::memory_order_acquire) != FREE) {
+            result++;
+        }
+    }
+    return result;
+}
+
+void LocalInjectorTable::start(Voice& voice, const AudioInjectorPointer& injector) {
+    // the realtime side doesn't look at a free voice, so it can be set up without the options lock
+    voice.injector = injector;
+    voice.localBuffer = injector->getLocalBuffer();
+    voice.options = injector->getOptions();
+    voice.pendingOptions = voice.options;
+
+    // not a candidate for stealing until it has been heard
+    voice.loudness.store(std::numeric_limits<float>::max(), std::memory_order_relaxed);
+
+    _numPlaying.fetch_add(1, std::memory_order_release);
+    voice.state.store(PLAYING, std::memory_order_release);
+}
+
+void LocalInjectorTable::fadeOut(Voice& voice) {
+    // a voice already fading out, or finished, is left as it is
+    int expected = PLAYING;
+    voice.state.compare_exchange_strong(expected, STEALING, std::memory_order_acq_rel);
+}
+
+void LocalInjectorTable::publishOptions(Voice& voice, const AudioInjectorOptions& options) {
+    // only held by mix() while it copies the options out
+    while (voice.optionsLock.test_and_set(std::memory_order_acquire)) {
+    }
+    voice.pendingOptions = options;
+    voice.optionsLock.clear(std::memory_order_release);
+}
+
+LocalInjectorTable::Voice* LocalInjectorTable::findFreeVoice() {
+    for (auto& voice : _voices) {
+        if (voice.state.load(std::memory_order_acquire) == FREE) {
+            return &voice;
+        }
+    }
+    return nullptr;
+}
+
+static float azimuthForSource(const glm::vec3& relativePosition, const glm::quat& listenerOrientation) {
+    glm::quat inverseOrientation = glm::inverse(listenerOrientation);
+
+    glm::vec3 rotatedSourcePosition = inverseOrientation * relativePosition;
+
+    // project the rotated source position vector onto the XZ plane
+    rotatedSourcePosition.y = 0.0f;
+
+    static const float SOURCE_DISTANCE_THRESHOLD = 1e-30f;
+
+    float rotatedSourcePositionLength2 = glm::length2(rotatedSourcePosition);
+    if (rotatedSourcePositionLength2 > SOURCE_DISTANCE_THRESHOLD) {
+
+        // produce an oriented angle about the y-axis
+        glm::vec3 direction = rotatedSourcePosition * (1.0f / fastSqrtf(rotatedSourcePositionLength2));
+        float angle = fastAcosf(glm::clamp(-direction.z, -1.0f, 1.0f));  // UNIT_NEG_Z is "forward"
+        return (direction.x < 0.0f) ? -angle : angle;
+
+    } else {
+        // no azimuth if they are in same spot
+        return 0.0f;
+    }
+}
+
+static float gainForSource(float distance, float volume) {
+
+    // attenuation = -6dB * log2(distance)
+    // reference attenuation of 0dB at distance = ATTN_DISTANCE_REF
+    float d = (1.0f / ATTN_DISTANCE_REF) * std::max(distance, HRTF_NEARFIELD_MIN);
+    float gain = volume / d;
+    gain = std::min(gain, ATTN_GAIN_MAX);
+
+    return gain;
+}
+
+bool LocalInjectorTable::mixFrame(float* mixBuffer, const Listener& listener) {
+    // check for injectors before doing any work
+    if (!isPlaying()) {
+        return false;
+    }
+
+    memset(mixBuffer, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
+
+    mix([&](Voice& voice, bool isStolen) {
+        return renderVoice(voice, isStolen, listener, mixBuffer);
+    });
+    return true;
+}
+
+bool LocalInjectorTable::renderVoice(Voice& voice, bool isStolen, const Listener& listener, float* mixBuffer) {
+    const AudioInjectorPointer& injector = voice.injector;
+    const AudioInjectorOptions& options = voice.options;
+
+    // the voice's own reference, copying the injector's would race with it finishing
+    const auto& injectorBuffer = voice.localBuffer;
+    if (!injectorBuffer) {
+        return false;
+    }
+
+    static const int HRTF_DATASET_INDEX = 1;
+
+    int numChannels = options.ambisonic ? AudioConstants::AMBISONIC : (options.stereo ? AudioConstants::STEREO : AudioConstants::MONO);
+    size_t bytesToRead = numChannels * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
+
+    // get one frame from the injector
+    int16_t* scratchBuffer = voice.buffer;
+    memset(scratchBuffer, 0, bytesToRead);
+    if (injectorBuffer->readData((char*)scratchBuffer, bytesToRead) <= 0) {
+        return false;
+    }
+
+    bool isSystemSound = !options.positionSet && !options.ambisonic;
+
+    float gain = options.volume * (isSystemSound ? listener.systemInjectorGain : listener.localInjectorGain);
+
+    // a stolen voice gets one last frame, over which every renderer ramps its gain down to silence
+    if (isStolen) {
+        gain = 0.0f;
+    }
+
+    if (options.ambisonic) {
+
+        if (options.positionSet) {
+
+            // distance attenuation
+            glm::vec3 relativePosition = options.position - listener.position;
+            float distance = glm::max(glm::length(relativePosition), EPSILON);
+            gain = gainForSource(distance, gain);
+        }
+
+        //
+        // Calculate the soundfield orientation relative to the listener.
+        // Injector orientation can be used to align a recording to our world coordinates.
+        //
+        glm::quat relativeOrientation = options.orientation * glm::inverse(listener.orientation);
+
+        // convert from Y-up (OpenGL) to Z-up (Ambisonic) coordinate system
+        float qw = relativeOrientation.w;
+        float qx = -relativeOrientation.z;
+        float qy = -relativeOrientation.x;
+        float qz = relativeOrientation.y;
+
+        // spatialize into mixBuffer
+        injector->getLocalFOA().render(scratchBuffer, mixBuffer, HRTF_DATASET_INDEX,
+                                       qw, qx, qy, qz, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    } else if (options.stereo) {
+
+        if (options.positionSet) {
+
+            // distance attenuation
+            glm::vec3 relativePosition = options.position - listener.position;
+            float distance = glm::max(glm::length(relativePosition), EPSILON);
+            gain = gainForSource(distance, gain);
+        }
+
+        // direct mix into mixBuffer
+        injector->getLocalHRTF().mixStereo(scratchBuffer, mixBuffer, gain,
+                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    } else {  // injector is mono
+
+        if (options.positionSet) {
+
+            // distance attenuation
+            glm::vec3 relativePosition = options.position - listener.position;
+            float distance = glm::max(glm::length(relativePosition), EPSILON);
+            gain = gainForSource(distance, gain);
+
+            float azimuth = azimuthForSource(relativePosition, listener.orientation);
+
+            // spatialize into mixBuffer
+            injector->getLocalHRTF().render(scratchBuffer, mixBuffer, HRTF_DATASET_INDEX,
+                                            azimuth, distance, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        } else {
+
+            // direct mix into mixBuffer
+            injector->getLocalHRTF().mixMono(scratchBuffer, mixBuffer, gain,
+                                             AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        }
+    }
+
+    // how loud the injector is in the mix, for voice stealing
+    int peak = 0;
+    for (size_t i = 0; i < bytesToRead / sizeof(int16_t); i++) {
+        peak = std::max(peak, std::abs((int)scratchBuffer[i]));
+    }
+    voice.loudness.store(gain * peak, std::memory_order_relaxed);
+
+    return true;
+}
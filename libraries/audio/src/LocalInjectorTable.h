@@ -0,0 +1,125 @@
+//
+//  LocalInjectorTable.h
+//  libraries/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_LocalInjectorTable_h
+#define hifi_LocalInjectorTable_h
+
+#include <array>
+#include <atomic>
+#include <deque>
+
+#include <QtCore/QVector>
+
+#include <GLMHelpers.h>
+
+#include "AudioConstants.h"
+#include "AudioInjector.h"
+
+// Fixed set of voices that local injectors are played through.
+//
+// The realtime side (mix) only touches preallocated voices and atomics: it never allocates, locks, or drops the
+// last reference to an injector or its local buffer. Everything else is done on the other side (add, update),
+// whose calls the owner must serialize. A voice goes FREE -> PLAYING (add/update) -> FINISHED (mix) -> FREE
+// (update), and a PLAYING voice is marked STEALING when a new injector needs it, or when its injector stops or
+// restarts with a new buffer, which mix fades out and finishes.
+class LocalInjectorTable {
+public:
+    static const int CAPACITY = 64;
+
+    struct Voice {
+        AudioInjectorPointer injector;
+        // taken when the voice starts, and only released by update(), as the injector drops its own when it finishes
+        QSharedPointer<AudioInjectorLocalBuffer> localBuffer;
+        // latest options of the injector, as seen by the realtime side
+        AudioInjectorOptions options;
+        // one network frame of the injector
+        AudioConstants::AudioSample buffer[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
+        // level of the last frame mixed, the quietest voice is the one stolen
+        std::atomic<float> loudness { 0.0f };
+
+    private:
+        friend class LocalInjectorTable;
+        std::atomic<int> state { 0 };
+        std::atomic_flag optionsLock = ATOMIC_FLAG_INIT;
+        AudioInjectorOptions pendingOptions;
+    };
+
+    // Where local injectors are heard from, and the gains of positional and system sounds
+    struct Listener {
+        glm::vec3 position { Vectors::ZERO };
+        glm::quat orientation { Quaternions::IDENTITY };
+        float localInjectorGain { 1.0f };
+        float systemInjectorGain { 1.0f };
+    };
+
+    // Returns false if the injector is already in the table with its current buffer. When every voice is busy the
+    // quietest one is stolen, and the injector plays once it has been released by update().
+    bool add(const AudioInjectorPointer& injector);
+
+    // Releases the voices that finished, starts the injectors waiting for a voice, and hands the injectors' current
+    // options to the realtime side. Returns the injectors that are done playing.
+    QVector<AudioInjectorPointer> update();
+
+    // Injectors playing or waiting for a voice
+    int size() const;
+
+    // Realtime safe
+    bool isPlaying() const { return _numPlaying.load(std::memory_order_acquire) > 0; }
+
+    // Realtime safe, one mix at a time. Calls render(Voice& voice, bool isStolen) for each playing voice, which
+    // returns false once the injector has no more audio. A stolen voice is rendered one last time to fade it out.
+    template <typename F>
+    void mix(F&& render);
+
+    // Realtime safe, one mix at a time. Mixes a network frame of every playing voice into the stereo mixBuffer,
+    // spatialized around the listener. Returns false, leaving mixBuffer untouched, when nothing is playing.
+    bool mixFrame(float* mixBuffer, const Listener& listener);
+
+private:
+    enum VoiceState { FREE, PLAYING, STEALING, FINISHED };
+
+    void start(Voice& voice, const AudioInjectorPointer& injector);
+    void fadeOut(Voice& voice);
+    static bool renderVoice(Voice& voice, bool isStolen, const Listener& listener, float* mixBuffer);
+    void publishOptions(Voice& voice, const AudioInjectorOptions& options);
+    Voice* findFreeVoice();
+
+    std::array<Voice, CAPACITY> _voices;
+    std::atomic<int> _numPlaying { 0 };
+
+    std::deque<AudioInjectorPointer> _pending;
+    QVector<AudioInjectorPointer> _dropped;
+};
+
+template <typename F>
+void LocalInjectorTable::mix(F&& render) {
+    for (auto& voice : _voices) {
+        int state = voice.state.load(std::memory_order_acquire);
+        if (state != PLAYING && state != STEALING) {
+            continue;
+        }
+
+        // keep the previous options if they are being written right now
+        if (!voice.optionsLock.test_and_set(std::memory_order_acquire)) {
+            voice.options = voice.pendingOptions;
+            voice.optionsLock.clear(std::memory_order_release);
+        }
+
+        bool isStolen = (state == STEALING);
+        if (!render(voice, isStolen) || isStolen) {
+            voice.state.store(FINISHED, std::memory_order_release);
+            _numPlaying.fetch_sub(1, std::memory_order_release);
+        }
+    }
+}
+
+#endif // hifi_LocalInjectorTable_h
@@ -37,8 +37,7 @@ int audioDataPointerMetaTypeID = qRegisterMetaType<AudioDataPointer>("AudioDataP
 
 using AudioConstants::AudioSample;
 
-AudioDataPointer AudioData::make(uint32_t numSamples, uint32_t numChannels,
-                                 const AudioSample* samples) {
+std::shared_ptr<AudioData> AudioData::allocate(uint32_t numSamples, uint32_t numChannels) {
     // Compute the amount of memory required for the audio data object
     const size_t bufferSize = numSamples * sizeof(AudioSample);
     const size_t memorySize = sizeof(AudioData) + bufferSize;
@@ -52,16 +51,40 @@ AudioDataPointer AudioData::make(uint32_t numSamples, uint32_t numChannels,
     // Use placement new to construct the audio data object at the memory allocated
     ::new(audioData) AudioData(numSamples, numChannels, buffer);
 
-    // Copy the samples to the buffer
-    memcpy(buffer, samples, bufferSize);
-
     // Return shared_ptr that properly destruct the object and release the memory
-    return AudioDataPointer(audioData, [](AudioData* ptr) {
+    return std::shared_ptr<AudioData>(audioData, [](AudioData* ptr) {
         ptr->~AudioData();
         ::free(ptr);
     });
 }
 
+AudioDataPointer AudioData::make(uint32_t numSamples, uint32_t numChannels,
+                                 const AudioSample* samples) {
+    auto audioData = allocate(numSamples, numChannels);
+
+    // Copy the samples to the buffer
+    memcpy(audioData->editData(), samples, numSamples * sizeof(AudioSample));
+    audioData->setNumSamplesAvailable(numSamples);
+
+    return audioData;
+}
+
+void AudioData::waitUntilComplete() const {
+    if (isComplete()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_completeMutex);
+    _completeCondition.wait(lock, [this] { return isComplete(); });
+}
+
+void AudioData::setNumSamplesAvailable(uint32_t numSamples) const {
+    _numSamplesAvailable.store(numSamples, std::memory_order_release);
+    if (numSamples == _numSamples) {
+        // taking the lock orders this with a waiter between its check and its wait, so the wakeup can't be missed
+        std::lock_guard<std::mutex> lock(_completeMutex);
+        _completeCondition.notify_all();
+    }
+}
 
 AudioData::AudioData(uint32_t numSamples, uint32_t numChannels, const AudioSample* samples)
     : _numSamples(numSamples),
@@ -104,6 +127,9 @@ SoundProcessor::SoundProcessor(QWeakPointer<Resource> sound, QByteArray data) :
 {
 }
 
+SoundProcessor::~SoundProcessor() {
+}
+
 void SoundProcessor::run() {
     auto sound = qSharedPointerCast<Sound>(_sound.lock());
     if (!sound) {
@@ -121,15 +147,18 @@ void SoundProcessor::run() {
     static const QString STEREO_RAW_EXTENSION = ".stereo.raw";
     QString fileType;
 
-    QByteArray outputAudioByteArray;
     AudioProperties properties;
+    int pcmOffset = 0;
+    int numPCMBytes = 0;
+    uint32_t numMP3Frames = 0;
 
     if (fileName.endsWith(WAV_EXTENSION)) {
         fileType = "WAV";
-        properties = interpretAsWav(_data, outputAudioByteArray);
+        properties = interpretAsWav(_data, pcmOffset, numPCMBytes);
     } else if (fileName.endsWith(MP3_EXTENSION)) {
         fileType = "MP3";
-        properties = interpretAsMP3(_data, outputAudioByteArray);
+        // a first pass only reads the frame headers, to size the buffer before decoding
+        properties = interpretAsMP3(_data, false, numMP3Frames);
     } else if (fileName.endsWith(STEREO_RAW_EXTENSION)) {
         // check if this was a stereo raw file
         // since it's raw the only way for us to know that is if the file was called .stereo.raw
@@ -137,12 +166,12 @@ void SoundProcessor::run() {
         // Process as 48khz RAW file
         properties.numChannels = 2;
         properties.sampleRate = 48000;
-        outputAudioByteArray = _data;
+        numPCMBytes = _data.size();
     } else if (fileName.endsWith(RAW_EXTENSION)) {
         // Process as 48khz RAW file
         properties.numChannels = 1;
         properties.sampleRate = 48000;
-        outputAudioByteArray = _data;
+        numPCMBytes = _data.size();
     } else {
         qCWarning(audio) << "Unknown sound file type";
         emit onError(300, "Failed to load sound file, reason: unknown sound file type");
@@ -155,43 +184,83 @@ void SoundProcessor::run() {
         return;
     }
 
-    auto data = downSample(outputAudioByteArray, properties);
-
-    int numSamples = data.size() / AudioConstants::SAMPLE_SIZE;
-    auto audioData = AudioData::make(numSamples, properties.numChannels,
-                                     (const AudioSample*)data.constData());
-    emit onSuccess(audioData);
+    if (fileType == "MP3") {
+        startWriting(properties, numMP3Frames);
+        interpretAsMP3(_data, true, numMP3Frames);
+    } else {
+        int numFrames = numPCMBytes / (properties.numChannels * AudioConstants::SAMPLE_SIZE);
+        startWriting(properties, numFrames);
+        writeFrames(reinterpret_cast<const int16_t*>(_data.constData() + pcmOffset), numFrames);
+    }
+    finishWriting();
 }
 
-QByteArray SoundProcessor::downSample(const QByteArray& rawAudioByteArray,
-                                      AudioProperties properties) {
+// Source frames decoded and resampled at once, the sound can start playing after the first block
+static const int SOUND_BLOCK_FRAMES = 4096;
 
+void SoundProcessor::startWriting(AudioProperties properties, uint32_t numSourceFrames) {
     // we want to convert it to the format that the audio-mixer wants
     // which is signed, 16-bit, 24Khz
+    _numChannels = properties.numChannels;
+    uint32_t numFrames = numSourceFrames;
+    if (properties.sampleRate != AudioConstants::SAMPLE_RATE) {
+        _resampler.reset(new AudioSRC(properties.sampleRate, AudioConstants::SAMPLE_RATE, _numChannels));
+        // a few frames of slack, the resampler's phase can carry one extra frame into a block
+        _resampleBuffer.resize((_resampler->getMaxOutput(SOUND_BLOCK_FRAMES) + 4) * _numChannels);
+        // the whole sound is guaranteed to produce at least this many frames
+        numFrames = _resampler->getMinOutput((int)numSourceFrames);
+    }
 
-    if (properties.sampleRate == AudioConstants::SAMPLE_RATE) {
-        // no resampling needed
-        return rawAudioByteArray;
+    _audioData = AudioData::allocate(numFrames * _numChannels, _numChannels);
+    _numSamplesWritten = 0;
+    _isPlayable = false;
+}
+
+void SoundProcessor::writeFrames(const int16_t* samples, int numFrames) {
+    while (numFrames > 0) {
+        int blockFrames = std::min(numFrames, SOUND_BLOCK_FRAMES);
+        if (_resampler) {
+            int numOutputFrames = _resampler->render(samples, _resampleBuffer.data(), blockFrames);
+            appendOutput(_resampleBuffer.data(), numOutputFrames);
+        } else {
+            appendOutput(samples, blockFrames);
+        }
+        samples += blockFrames * _numChannels;
+        numFrames -= blockFrames;
     }
+}
 
-    AudioSRC resampler(properties.sampleRate, AudioConstants::SAMPLE_RATE,
-                       properties.numChannels);
+void SoundProcessor::appendOutput(const int16_t* samples, int numFrames) {
+    uint32_t numSamples = std::min((uint32_t)(numFrames * _numChannels),
+                                   _audioData->getNumSamples() - _numSamplesWritten);
+    memcpy(_audioData->editData() + _numSamplesWritten, samples, numSamples * sizeof(AudioSample));
+    _numSamplesWritten += numSamples;
+    _audioData->setNumSamplesAvailable(_numSamplesWritten);
 
-    // resize to max possible output
-    int numSourceFrames = rawAudioByteArray.size() / (properties.numChannels * AudioConstants::SAMPLE_SIZE);
-    int maxDestinationFrames = resampler.getMaxOutput(numSourceFrames);
-    int maxDestinationBytes = maxDestinationFrames * properties.numChannels * AudioConstants::SAMPLE_SIZE;
-    QByteArray data(maxDestinationBytes, Qt::Uninitialized);
+    if (!_isPlayable) {
+        _isPlayable = true;
+        emit onSuccess(_audioData);
+    }
+}
 
-    int numDestinationFrames = resampler.render((int16_t*)rawAudioByteArray.data(),
-                                                (int16_t*)data.data(),
-                                                numSourceFrames);
+void SoundProcessor::finishWriting() {
+    // anything the decoder came up short on is left silent
+    uint32_t numSamplesLeft = _audioData->getNumSamples() - _numSamplesWritten;
+    if (numSamplesLeft > 0) {
+        memset(_audioData->editData() + _numSamplesWritten, 0, numSamplesLeft * sizeof(AudioSample));
+        _numSamplesWritten += numSamplesLeft;
+    }
+    _audioData->setNumSamplesAvailable(_numSamplesWritten);
 
-    // truncate to actual output
-    int numDestinationBytes = numDestinationFrames * properties.numChannels * sizeof(AudioSample);
-    data.resize(numDestinationBytes);
+    if (!_isPlayable) {
+        _isPlayable = true;
+        emit onSuccess(_audioData);
+    }
 
-    return data;
+    // the decoder state is no longer needed
+    _resampler.reset();
+    _resampleBuffer = std::vector<int16_t>();
+    _audioData.reset();
 }
 
 //
@@ -240,7 +309,7 @@ struct WAVEFormat {
 
 // returns wavfile sample rate, used for resampling
 SoundProcessor::AudioProperties SoundProcessor::interpretAsWav(const QByteArray& inputAudioByteArray,
-                                                               QByteArray& outputAudioByteArray) {
+                                                               int& dataOffset, int& numDataBytes) {
     AudioProperties properties;
 
     // Create a data stream to analyze the data
@@ -320,14 +389,15 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsWav(const QByteArray&
         waveStream.skipRawData(qFromLittleEndian<quint32>(data.size));  // next chunk
     }
 
-    // Read the "data" chunk
-    quint32 outputAudioByteArraySize = qFromLittleEndian<quint32>(data.size);
-    outputAudioByteArray.resize(outputAudioByteArraySize);
-    auto bytesRead = waveStream.readRawData(outputAudioByteArray.data(), outputAudioByteArraySize);
-    if (bytesRead != (int)outputAudioByteArraySize) {
+    // Locate the "data" chunk, it is decoded in place
+    quint32 dataSize = qFromLittleEndian<quint32>(data.size);
+    qint64 offset = waveStream.device()->pos();
+    if (offset + (qint64)dataSize > (qint64)inputAudioByteArray.size()) {
         qCWarning(audio) << "Error reading WAV file";
         return AudioProperties();
     }
+    dataOffset = (int)offset;
+    numDataBytes = (int)dataSize;
 
     properties.sampleRate = wave.sampleRate;
     return properties;
@@ -335,7 +405,7 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsWav(const QByteArray&
 
 // returns MP3 sample rate, used for resampling
 SoundProcessor::AudioProperties SoundProcessor::interpretAsMP3(const QByteArray& inputAudioByteArray,
-                                                               QByteArray& outputAudioByteArray) {
+                                                               bool decode, uint32_t& numFrames) {
     AudioProperties properties;
 
     using namespace flump3dec;
@@ -361,6 +431,7 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsMP3(const QByteArray&
     // initialize
     bs_set_data(bitstream, (uint8_t*)inputAudioByteArray.data(), inputAudioByteArray.size());
     int frameCount = 0;
+    uint32_t numFramesFound = 0;
 
     // skip ID3 tag, if present
     Mp3TlRetcode result = mp3tl_skip_id3(decoder);
@@ -377,9 +448,11 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsMP3(const QByteArray&
 
             if (frameCount++ == 0) {
 
-                qCDebug(audio) << "Decoding MP3 with bitrate =" << header->bitrate
-                               << "sample rate =" << header->sample_rate
-                               << "channels =" << header->channels;
+                if (decode) {
+                    qCDebug(audio) << "Decoding MP3 with bitrate =" << header->bitrate
+                                   << "sample rate =" << header->sample_rate
+                                   << "channels =" << header->channels;
+                }
 
                 // save header info
                 properties.sampleRate = header->sample_rate;
@@ -389,19 +462,29 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsMP3(const QByteArray&
                 result = mp3tl_skip_xing(decoder, header);
             }
 
-            // decode MP3 frame
             if (result == MP3TL_ERR_OK) {
-
-                result = mp3tl_decode_frame(decoder, mp3Buffer, MP3_BUFFER_SIZE);
-
-                // fill bad frames with silence
-                int len = header->frame_samples * header->channels * sizeof(int16_t);
-                if (result == MP3TL_ERR_BAD_FRAME) {
-                    memset(mp3Buffer, 0, len);
-                }
-
-                if (result == MP3TL_ERR_OK || result == MP3TL_ERR_BAD_FRAME) {
-                    outputAudioByteArray.append((char*)mp3Buffer, len);
+                // frames that switch channel count can't be mixed into the rest of the sound
+                bool isUsable = (header->channels == properties.numChannels);
+
+                if (!decode) {
+                    result = mp3tl_skip_frame(decoder);
+                    if (result == MP3TL_ERR_OK && isUsable) {
+                        numFramesFound += header->frame_samples;
+                    }
+                } else {
+                    // decode MP3 frame
+                    result = mp3tl_decode_frame(decoder, mp3Buffer, MP3_BUFFER_SIZE);
+
+                    // fill bad frames with silence
+                    int len = header->frame_samples * header->channels * sizeof(int16_t);
+                    if (result == MP3TL_ERR_BAD_FRAME) {
+                        memset(mp3Buffer, 0, len);
+                    }
+
+                    if ((result == MP3TL_ERR_OK || result == MP3TL_ERR_BAD_FRAME) && isUsable) {
+                        writeFrames((const int16_t*)mp3Buffer, header->frame_samples);
+                        numFramesFound += header->frame_samples;
+                    }
                 }
             }
         }
@@ -413,11 +496,12 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsMP3(const QByteArray&
     // free bitstream
     bs_free(bitstream);
 
-    if (outputAudioByteArray.isEmpty()) {
+    if (numFramesFound == 0) {
         qCWarning(audio) << "Error decoding MP3 file";
         return AudioProperties();
     }
 
+    numFrames = numFramesFound;
     return properties;
 }
 
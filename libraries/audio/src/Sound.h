@@ -12,6 +12,12 @@
 #ifndef hifi_Sound_h
 #define hifi_Sound_h
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <QRunnable>
 #include <QtCore/QObject>
 #include <QtNetwork/QNetworkReply>
@@ -22,6 +28,7 @@
 #include "AudioConstants.h"
 
 class AudioData;
+class AudioSRC;
 using AudioDataPointer = std::shared_ptr<const AudioData>;
 
 Q_DECLARE_METATYPE(AudioDataPointer);
@@ -29,6 +36,8 @@ Q_DECLARE_METATYPE(AudioDataPointer);
 // AudioData is designed to be immutable
 // All of its members and methods are const
 // This makes it perfectly safe to access from multiple threads at once
+// A sound can be handed out while it is still being decoded: its samples are then written in order, each one once,
+// and only published through getNumSamplesAvailable() after it has been written
 class AudioData {
 public:
     using AudioSample = AudioConstants::AudioSample;
@@ -38,6 +47,13 @@ public:
                                  const AudioSample* samples);
 
     uint32_t getNumSamples() const { return _numSamples; }
+
+    // Samples past this are silence until the sound has been decoded
+    uint32_t getNumSamplesAvailable() const { return _numSamplesAvailable.load(std::memory_order_acquire); }
+    bool isComplete() const { return getNumSamplesAvailable() == _numSamples; }
+    // Blocks until the last sample has been published, without polling
+    void waitUntilComplete() const;
+
     uint32_t getNumChannels() const { return _numChannels; }
     const AudioSample* data() const { return _data; }
     const char* rawData() const { return reinterpret_cast<const char*>(_data); }
@@ -49,11 +65,23 @@ public:
     uint32_t getNumBytes() const { return _numSamples * sizeof(AudioSample); }
 
 private:
+    friend class SoundProcessor;
+
     AudioData(uint32_t numSamples, uint32_t numChannels, const AudioSample* samples);
 
+    // Allocates the buffer with no samples available yet, for the SoundProcessor to decode into
+    static std::shared_ptr<AudioData> allocate(uint32_t numSamples, uint32_t numChannels);
+    AudioSample* editData() const { return const_cast<AudioSample*>(_data); }
+    void setNumSamplesAvailable(uint32_t numSamples) const;
+
     const uint32_t _numSamples { 0 };
     const uint32_t _numChannels { 0 };
     const AudioSample* const _data { nullptr };
+    mutable std::atomic<uint32_t> _numSamplesAvailable { 0 };
+
+    // only used by waitUntilComplete, notified once the last sample is published
+    mutable std::mutex _completeMutex;
+    mutable std::condition_variable _completeCondition;
 };
 
 class Sound : public Resource {
@@ -99,23 +127,37 @@ public:
     };
 
     SoundProcessor(QWeakPointer<Resource> sound, QByteArray data);
+    ~SoundProcessor();
 
+    // Decodes and resamples a block at a time straight into the sound's buffer,
+    // emitting onSuccess as soon as the first block can be played
     virtual void run() override;
 
-    QByteArray downSample(const QByteArray& rawAudioByteArray,
-                          AudioProperties properties);
+    // Finds the PCM data in a WAV file without copying it
     AudioProperties interpretAsWav(const QByteArray& inputAudioByteArray,
-                                   QByteArray& outputAudioByteArray);
-    AudioProperties interpretAsMP3(const QByteArray& inputAudioByteArray,
-                                   QByteArray& outputAudioByteArray);
+                                   int& dataOffset, int& numDataBytes);
+    // Walks the frames of an MP3, decoding each one for writeFrames, or only counting its frames when not decoding
+    AudioProperties interpretAsMP3(const QByteArray& inputAudioByteArray, bool decode, uint32_t& numFrames);
 
 signals:
     void onSuccess(AudioDataPointer audioData);
     void onError(int error, QString str);
 
 private:
+    void startWriting(AudioProperties properties, uint32_t numSourceFrames);
+    void writeFrames(const int16_t* samples, int numFrames);
+    void appendOutput(const int16_t* samples, int numFrames);
+    void finishWriting();
+
     const QWeakPointer<Resource> _sound;
     const QByteArray _data;
+
+    std::shared_ptr<AudioData> _audioData;
+    std::unique_ptr<AudioSRC> _resampler;
+    std::vector<int16_t> _resampleBuffer;
+    int _numChannels { 0 };
+    uint32_t _numSamplesWritten { 0 };
+    bool _isPlayable { false };
 };
 
 typedef QSharedPointer<Sound> SharedSoundPointer;
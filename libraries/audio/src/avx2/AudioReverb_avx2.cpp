@@ -0,0 +1,56 @@
+//
+//  AudioReverb_avx2.cpp
+//  libraries/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+// keep the multiply and add separate, so results match the SSE and frame at a time code
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// output = delayed - coef * input, feedback = input + coef * output
+void allpass_AVX2(const float* delayed, const float* input, float* output, float* feedback, float coef, int numFrames) {
+    __m256 c = _mm256_set1_ps(coef);
+
+    int i = 0;
+    for (; i < numFrames - 7; i += 8) {
+        __m256 x = _mm256_loadu_ps(&input[i]);
+        __m256 y = _mm256_sub_ps(_mm256_loadu_ps(&delayed[i]), _mm256_mul_ps(c, x));
+        _mm256_storeu_ps(&output[i], y);
+        _mm256_storeu_ps(&feedback[i], _mm256_add_ps(x, _mm256_mul_ps(c, y)));
+    }
+    for (; i < numFrames; i++) {
+        output[i] = delayed[i] - coef * input[i];
+        feedback[i] = input[i] + coef * output[i];
+    }
+
+    _mm256_zeroupper();
+}
+
+// output = gain * input
+void scale_AVX2(const float* input, float* output, float gain, int numFrames) {
+    __m256 g = _mm256_set1_ps(gain);
+
+    int i = 0;
+    for (; i < numFrames - 7; i += 8) {
+        _mm256_storeu_ps(&output[i], _mm256_mul_ps(g, _mm256_loadu_ps(&input[i])));
+    }
+    for (; i < numFrames; i++) {
+        output[i] = gain * input[i];
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
@@ -81,10 +81,10 @@ void Head::simulate(float deltaTime) {
         const float SACCADE_MAGNITUDE = 0.04f;
         const float NOMINAL_FRAME_RATE = 60.0f;
 
-        if (randFloat() < deltaTime / AVERAGE_MICROSACCADE_INTERVAL) {
-            _saccadeTarget = MICROSACCADE_MAGNITUDE * randVector();
-        } else if (randFloat() < deltaTime / AVERAGE_SACCADE_INTERVAL) {
-            _saccadeTarget = SACCADE_MAGNITUDE * randVector();
+        if (randomFloat() < deltaTime / AVERAGE_MICROSACCADE_INTERVAL) {
+            _saccadeTarget = MICROSACCADE_MAGNITUDE * randomVector();
+        } else if (randomFloat() < deltaTime / AVERAGE_SACCADE_INTERVAL) {
+            _saccadeTarget = SACCADE_MAGNITUDE * randomVector();
         }
         _saccade += (_saccadeTarget - _saccade) * pow(0.5f, NOMINAL_FRAME_RATE * deltaTime);
     } else {
@@ -113,10 +113,11 @@ void Head::simulate(float deltaTime) {
             // no blinking when brows are raised; blink less with increasing loudness
             const float BASE_BLINK_RATE = 15.0f / 60.0f;
             const float ROOT_LOUDNESS_TO_BLINK_INTERVAL = 0.25f;
+            float blinkInterval = glm::max(1.0f, sqrt(fabs(_averageLoudness - _longTermAverageLoudness)) *
+                ROOT_LOUDNESS_TO_BLINK_INTERVAL) / BASE_BLINK_RATE;
             if (_forceBlinkToRetarget || forceBlink ||
-                (_browAudioLift < EPSILON && shouldDo(glm::max(1.0f, sqrt(fabs(_averageLoudness - _longTermAverageLoudness)) *
-                ROOT_LOUDNESS_TO_BLINK_INTERVAL) / BASE_BLINK_RATE, deltaTime))) {
-                float randSpeedVariability = randFloat();
+                (_browAudioLift < EPSILON && randomFloat() < deltaTime / blinkInterval)) {
+                float randSpeedVariability = randomFloat();
                 float eyeBlinkVelocity = BLINK_SPEED + randSpeedVariability * BLINK_SPEED_VARIABILITY;
                 if (_forceBlinkToRetarget) {
                     // Slow down by half the blink if reseting eye target
@@ -125,7 +126,7 @@ void Head::simulate(float deltaTime) {
                 }
                 _leftEyeBlinkVelocity = eyeBlinkVelocity;
                 _rightEyeBlinkVelocity = eyeBlinkVelocity;
-                if (randFloat() < 0.5f) {
+                if (randomFloat() < 0.5f) {
                     _leftEyeBlink = BLINK_START_VARIABILITY;
                     _rightEyeBlink = BLINK_START_VARIABILITY;
                 }
@@ -203,6 +204,14 @@ void Head::simulate(float deltaTime) {
     _eyePosition = 0.5f * (_leftEyePosition + _rightEyePosition);
 }
 
+float Head::randomFloat() {
+    return std::uniform_real_distribution<float>(0.0f, 1.0f)(_random);
+}
+
+glm::vec3 Head::randomVector() {
+    return glm::vec3(randomFloat() - 0.5f, randomFloat() - 0.5f, randomFloat() - 0.5f) * 2.0f;
+}
+
 void Head::calculateMouthShapes(float deltaTime) {
     const float JAW_OPEN_SCALE = 0.35f;
     const float JAW_OPEN_RATE = 0.9f;
@@ -11,6 +11,8 @@
 #ifndef hifi_Head_h
 #define hifi_Head_h
 
+#include <random>
+
 #include <GLMHelpers.h>
 #include <SharedUtil.h>
 #include <HeadData.h>
@@ -130,9 +132,14 @@ protected:
     bool _forceBlinkToRetarget { false };
     bool _isEyeLookAtUpdated { false };
 
+    // other avatars' heads are simulated on worker threads, where the shared rand() isn't safe
+    std::minstd_rand _random { std::random_device()() };
+
     // private methods
     void calculateMouthShapes(float timeRatio);
     void applyEyelidOffset(glm::quat headOrientation);
+    float randomFloat();
+    glm::vec3 randomVector();
 };
 
 #endif // hifi_Head_h
@@ -33,6 +33,7 @@
 #include <EntitySimulation.h>
 #include <ZoneRenderer.h>
 #include <PhysicalEntitySimulation.h>
+#include <TBBHelpers.h>
 
 #include "EntitiesRendererLogging.h"
 #include "RenderableEntityItem.h"
@@ -72,6 +73,11 @@ EntityTreeRenderer::EntityTreeRenderer(bool wantScripts, AbstractViewStateInterf
     EntityRenderer::initEntityRenderers();
     _currentHoverOverEntityID = UNKNOWN_ENTITY_ID;
     _currentClickingOnEntityID = UNKNOWN_ENTITY_ID;
+    for (int i = 0; i < EntityTypes::NUM_TYPES; i++) {
+        _renderableUpdateUsecs[i] = 0;
+        _renderableUpdateCounts[i] = 0;
+        _renderableUpdateStats[i] = { (EntityTypes::EntityType)i, 0.0f, 0.0f };
+    }
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>().data();
     auto pointerManager = DependencyManager::get<PointerManager>();
@@ -406,9 +412,66 @@ void EntityTreeRenderer::addPendingEntities(const render::ScenePointer& scene, r
     }
 }
 
+void EntityTreeRenderer::updateRenderableInScene(const EntityRendererPointer& renderable, const render::ScenePointer& scene,
+                                                 render::Transaction& transaction) {
+    uint64_t start = usecTimestampNow();
+    renderable->updateInScene(scene, transaction);
+    auto type = renderable->getEntity()->getType();
+    _renderableUpdateUsecs[type] += usecTimestampNow() - start;
+    _renderableUpdateCounts[type]++;
+}
+
+void EntityTreeRenderer::updateRenderablesConcurrently(const render::ScenePointer& scene, render::Transaction& transaction) {
+    std::vector<EntityRendererPointer> renderables;
+    for (auto itr = _renderablesToUpdate.begin(); itr != _renderablesToUpdate.end();) {
+        if ((*itr)->canUpdateInSceneConcurrently()) {
+            renderables.push_back(*itr);
+            itr = _renderablesToUpdate.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    if (renderables.empty()) {
+        return;
+    }
+
+    PROFILE_RANGE_EX(simulation_physics, "UpdateRenderablesConcurrently", 0xffff00ff, (uint64_t)renderables.size());
+
+    // each block fills its own transaction, and they are merged in block order so that
+    // the frame's transaction doesn't depend on how the blocks were scheduled
+    const size_t RENDERABLES_PER_BLOCK = 32;
+    size_t numBlocks = (renderables.size() + RENDERABLES_PER_BLOCK - 1) / RENDERABLES_PER_BLOCK;
+    std::vector<render::Transaction> blockTransactions(numBlocks);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t block = range.begin(); block < range.end(); ++block) {
+            size_t end = std::min((block + 1) * RENDERABLES_PER_BLOCK, renderables.size());
+            for (size_t i = block * RENDERABLES_PER_BLOCK; i < end; ++i) {
+                updateRenderableInScene(renderables[i], scene, blockTransactions[block]);
+            }
+        }
+    });
+    transaction.merge(std::move(blockTransactions));
+}
+
+void EntityTreeRenderer::getRenderableUpdateStats(std::vector<RenderableUpdateStat>& stats) const {
+    // the averages only decay towards zero, so types which have stopped updating are dropped below this
+    const float MIN_REPORTED_COUNT = 0.1f;
+    stats.clear();
+    for (const auto& stat : _renderableUpdateStats) {
+        if (stat.count >= MIN_REPORTED_COUNT) {
+            stats.push_back(stat);
+        }
+    }
+}
+
 void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene, render::Transaction& transaction) {
     PROFILE_RANGE_EX(simulation_physics, "ChangeInScene", 0xffff00ff, (uint64_t)_changedEntities.size());
     PerformanceTimer pt("change");
+    for (int i = 0; i < EntityTypes::NUM_TYPES; i++) {
+        _renderableUpdateUsecs[i] = 0;
+        _renderableUpdateCounts[i] = 0;
+    }
+
     std::unordered_set<EntityItemID> changedEntities;
     _changedEntitiesGuard.withWriteLock([&] {
         changedEntities.swap(_changedEntities);
@@ -425,6 +488,9 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         }
     }
 
+    // renderables which are safe to update off the main thread are always updated, and don't count against the budget
+    updateRenderablesConcurrently(scene, transaction);
+
     float expectedUpdateCost = _avgRenderableUpdateCost * _renderablesToUpdate.size();
     if (expectedUpdateCost < MAX_UPDATE_RENDERABLES_TIME_BUDGET) {
         // we expect to update all renderables within available time budget
@@ -432,7 +498,7 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         uint64_t updateStart = usecTimestampNow();
         for (const auto& renderable : _renderablesToUpdate) {
             assert(renderable); // only valid renderables are added to _renderablesToUpdate
-            renderable->updateInScene(scene, transaction);
+            updateRenderableInScene(renderable, scene, transaction);
         }
         size_t numRenderables = _renderablesToUpdate.size() + 1; // add one to avoid divide by zero
         _renderablesToUpdate.clear();
@@ -490,7 +556,7 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
                     break;
                 }
                 const auto& renderable = sortedRenderable.getRenderer();
-                renderable->updateInScene(scene, transaction);
+                updateRenderableInScene(renderable, scene, transaction);
                 _renderablesToUpdate.erase(renderable);
             }
 
@@ -501,6 +567,13 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
             _avgRenderableUpdateCost = (1.0f - BLEND) * _avgRenderableUpdateCost + BLEND * cost;
         }
     }
+
+    const float STATS_BLEND = 0.1f;
+    for (int i = 0; i < EntityTypes::NUM_TYPES; i++) {
+        auto& stat = _renderableUpdateStats[i];
+        stat.count = (1.0f - STATS_BLEND) * stat.count + STATS_BLEND * (float)_renderableUpdateCounts[i];
+        stat.usecs = (1.0f - STATS_BLEND) * stat.usecs + STATS_BLEND * (float)_renderableUpdateUsecs[i];
+    }
 }
 
 void EntityTreeRenderer::preUpdate() {
@@ -12,6 +12,9 @@
 #ifndef hifi_EntityTreeRenderer_h
 #define hifi_EntityTreeRenderer_h
 
+#include <array>
+#include <atomic>
+
 #include <QtCore/QSet>
 #include <QtCore/QStack>
 #include <QtGui/QMouseEvent>
@@ -73,6 +76,16 @@ public:
     static float getEntityLoadingPriority(const EntityItem& item) { return _calculateEntityLoadingPriorityFunc(item); }
     static void setEntityLoadingPriorityFunction(CalculateEntityLoadingPriority fn) { _calculateEntityLoadingPriorityFunc = fn; }
 
+    // Renderables updated in the scene per frame and the time it took, averaged over recent frames, by entity type
+    class RenderableUpdateStat {
+    public:
+        EntityTypes::EntityType type;
+        float count;
+        float usecs;
+    };
+    // MUST only be called on the main thread
+    void getRenderableUpdateStats(std::vector<RenderableUpdateStat>& stats) const;
+
     void setMouseRayPickID(unsigned int rayPickID) { _mouseRayPickID = rayPickID; }
     unsigned int getMouseRayPickID() { return _mouseRayPickID; }
     void setMouseRayPickResultOperator(std::function<RayToEntityIntersectionResult(unsigned int)> getPrevRayPickResultOperator) { _getPrevRayPickResultOperator = getPrevRayPickResultOperator;  }
@@ -166,6 +179,8 @@ protected:
 private:
     void addPendingEntities(const render::ScenePointer& scene, render::Transaction& transaction);
     void updateChangedEntities(const render::ScenePointer& scene, render::Transaction& transaction);
+    void updateRenderablesConcurrently(const render::ScenePointer& scene, render::Transaction& transaction);
+    void updateRenderableInScene(const EntityRendererPointer& renderable, const render::ScenePointer& scene, render::Transaction& transaction);
     EntityRendererPointer renderableForEntity(const EntityItemPointer& entity) const { return renderableForEntityId(entity->getID()); }
     render::ItemID renderableIdForEntity(const EntityItemPointer& entity) const { return renderableIdForEntityId(entity->getID()); }
 
@@ -246,6 +261,11 @@ private:
 
     float _avgRenderableUpdateCost { 0.0f };
 
+    // Filled by the main thread and the workers during updateChangedEntities, then folded into the averages
+    std::array<std::atomic<uint64_t>, EntityTypes::NUM_TYPES> _renderableUpdateUsecs;
+    std::array<std::atomic<uint32_t>, EntityTypes::NUM_TYPES> _renderableUpdateCounts;
+    std::array<RenderableUpdateStat, EntityTypes::NUM_TYPES> _renderableUpdateStats;
+
     ReadWriteLockable _changedEntitiesGuard;
     std::unordered_set<EntityItemID> _changedEntities;
 
@@ -0,0 +1,250 @@
+//
+//  PolyVoxChunks.cpp
+//  libraries/entities-renderer/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunks.h"
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning( disable : 4267 )
+#endif
+#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
+#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
+#include <PolyVoxCore/Material.h>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+const int PolyVoxChunks::CHUNK_SIZE = 16;
+
+PolyVoxChunks::PolyVoxChunks(const glm::ivec3& volumeSize, bool marchingCubes) :
+    _volumeSize(glm::max(volumeSize, glm::ivec3(1))),
+    _marchingCubes(marchingCubes)
+{
+    // surface cells lie between voxel x and x + 1, so there is one less cell than voxels along each axis
+    _numChunks = glm::max((_volumeSize - 1 + CHUNK_SIZE - 1) / CHUNK_SIZE, glm::ivec3(1));
+    _chunks.resize(_numChunks.x * _numChunks.y * _numChunks.z);
+
+    int index = 0;
+    for (int z = 0; z < _numChunks.z; z++) {
+        for (int y = 0; y < _numChunks.y; y++) {
+            for (int x = 0; x < _numChunks.x; x++) {
+                Chunk& chunk = _chunks[index++];
+                glm::ivec3 coord(x, y, z);
+                chunk.lower = coord * CHUNK_SIZE;
+                // the last chunk along an axis also owns the final plane of voxels, for the cubic collision hulls
+                chunk.upper = glm::ivec3(
+                    (x == _numChunks.x - 1) ? _volumeSize.x : (x + 1) * CHUNK_SIZE,
+                    (y == _numChunks.y - 1) ? _volumeSize.y : (y + 1) * CHUNK_SIZE,
+                    (z == _numChunks.z - 1) ? _volumeSize.z : (z + 1) * CHUNK_SIZE);
+            }
+        }
+    }
+}
+
+int PolyVoxChunks::getNumDirtyChunks() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    int count = 0;
+    for (const auto& chunk : _chunks) {
+        if (chunk.meshDirty) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int PolyVoxChunks::chunkIndexForCell(int cell, int axis) const {
+    cell = glm::clamp(cell, 0, _volumeSize[axis] - 1);
+    return std::min(cell / CHUNK_SIZE, _numChunks[axis] - 1);
+}
+
+void PolyVoxChunks::markVoxelDirty(const glm::ivec3& volumeCoord) {
+    // a voxel is a corner of the cells on either side of it, and marching-cubes normals are central differences
+    // which reach one voxel further, so cells p - 2 through p + 1 can change.  The cubic collision hull of a voxel
+    // depends on its six neighbors, which is covered by the same range.
+    glm::ivec3 low, high;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (int axis = 0; axis < 3; axis++) {
+        low[axis] = chunkIndexForCell(volumeCoord[axis] - 2, axis);
+        high[axis] = chunkIndexForCell(volumeCoord[axis] + 1, axis);
+    }
+
+    for (int z = low.z; z <= high.z; z++) {
+        for (int y = low.y; y <= high.y; y++) {
+            for (int x = low.x; x <= high.x; x++) {
+                _chunks[(z * _numChunks.y + y) * _numChunks.x + x].meshDirty = true;
+            }
+        }
+    }
+}
+
+void PolyVoxChunks::markAllDirty() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& chunk : _chunks) {
+        chunk.meshDirty = true;
+    }
+}
+
+void PolyVoxChunks::extractChunk(PolyVox::SimpleVolume<uint8_t>* volData, Chunk& chunk) {
+    // regions are inclusive, so each chunk reaches one voxel into the next to close the cells on its upper faces
+    glm::ivec3 upper = glm::min(chunk.upper, _volumeSize - 1);
+    PolyVox::Region region(PolyVox::Vector3DInt32(chunk.lower.x, chunk.lower.y, chunk.lower.z),
+                           PolyVox::Vector3DInt32(upper.x, upper.y, upper.z));
+
+    PolyVox::SurfaceMesh<Vertex> polyVoxMesh;
+    if (_marchingCubes) {
+        PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+            (volData, region, &polyVoxMesh);
+        surfaceExtractor.execute();
+    } else {
+        PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+            (volData, region, &polyVoxMesh);
+        surfaceExtractor.execute();
+    }
+
+    // the extractors emit positions relative to the lower corner of the region
+    PolyVox::Vector3DFloat offset((float)chunk.lower.x, (float)chunk.lower.y, (float)chunk.lower.z);
+    chunk.vertices = polyVoxMesh.getRawVertexData();
+    for (auto& vertex : chunk.vertices) {
+        vertex.setPosition(vertex.getPosition() + offset);
+    }
+    chunk.indices = polyVoxMesh.getIndices();
+
+    chunk.meshDirty = false;
+    chunk.shapeDirty = true;
+}
+
+int PolyVoxChunks::extractDirtyChunks(PolyVox::SimpleVolume<uint8_t>* volData) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    int count = 0;
+    for (auto& chunk : _chunks) {
+        if (chunk.meshDirty) {
+            extractChunk(volData, chunk);
+            count++;
+        }
+    }
+    return count;
+}
+
+void PolyVoxChunks::getMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t numVertices = 0;
+    size_t numIndices = 0;
+    for (const auto& chunk : _chunks) {
+        numVertices += chunk.vertices.size();
+        numIndices += chunk.indices.size();
+    }
+
+    vertices.clear();
+    indices.clear();
+    vertices.reserve(numVertices);
+    indices.reserve(numIndices);
+
+    for (const auto& chunk : _chunks) {
+        uint32_t baseVertex = (uint32_t)vertices.size();
+        vertices.insert(vertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+        for (uint32_t index : chunk.indices) {
+            indices.push_back(baseVertex + index);
+        }
+    }
+}
+
+void PolyVoxChunks::computeMarchingCubesHulls(Chunk& chunk, const glm::mat4& voxelToLocal, float hullOffset) {
+    // pull each triangle in the mesh into a polyhedron which can be collided with
+    for (size_t i = 0; i + 2 < chunk.indices.size(); i += 3) {
+        const PolyVox::Vector3DFloat& v0 = chunk.vertices[chunk.indices[i]].getPosition();
+        const PolyVox::Vector3DFloat& v1 = chunk.vertices[chunk.indices[i + 1]].getPosition();
+        const PolyVox::Vector3DFloat& v2 = chunk.vertices[chunk.indices[i + 2]].getPosition();
+        glm::vec3 p0(v0.getX(), v0.getY(), v0.getZ());
+        glm::vec3 p1(v1.getX(), v1.getY(), v1.getZ());
+        glm::vec3 p2(v2.getX(), v2.getY(), v2.getZ());
+
+        glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
+        glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+        glm::vec3 p3 = av - normal * hullOffset;
+
+        ShapeInfo::PointList pointsInPart;
+        pointsInPart << glm::vec3(voxelToLocal * glm::vec4(p0, 1.0f));
+        pointsInPart << glm::vec3(voxelToLocal * glm::vec4(p1, 1.0f));
+        pointsInPart << glm::vec3(voxelToLocal * glm::vec4(p2, 1.0f));
+        pointsInPart << glm::vec3(voxelToLocal * glm::vec4(p3, 1.0f));
+        for (const auto& point : pointsInPart) {
+            chunk.box += point;
+        }
+        chunk.points << pointsInPart;
+    }
+}
+
+void PolyVoxChunks::computeCubicHulls(PolyVox::SimpleVolume<uint8_t>* volData, Chunk& chunk, const glm::mat4& voxelToLocal,
+                                      int userOffset, const glm::ivec3& userSize) {
+    glm::ivec3 lower = glm::max(chunk.lower, glm::ivec3(userOffset));
+    glm::ivec3 upper = glm::min(chunk.upper, userSize + userOffset);
+
+    for (int z = lower.z; z < upper.z; z++) {
+        for (int y = lower.y; y < upper.y; y++) {
+            for (int x = lower.x; x < upper.x; x++) {
+                if (volData->getVoxelAt(x, y, z) == 0) {
+                    continue;
+                }
+
+                glm::ivec3 v = glm::ivec3(x, y, z) - userOffset;
+                if (glm::all(glm::greaterThan(v, glm::ivec3(0))) &&
+                    glm::all(glm::lessThan(v, userSize - 1)) &&
+                    volData->getVoxelAt(x - 1, y, z) > 0 &&
+                    volData->getVoxelAt(x, y - 1, z) > 0 &&
+                    volData->getVoxelAt(x, y, z - 1) > 0 &&
+                    volData->getVoxelAt(x + 1, y, z) > 0 &&
+                    volData->getVoxelAt(x, y + 1, z) > 0 &&
+                    volData->getVoxelAt(x, y, z + 1) > 0) {
+                    // this voxel has neighbors in every cardinal direction, so there's no need
+                    // to include it in the collision hull.
+                    continue;
+                }
+
+                ShapeInfo::PointList pointsInPart;
+                for (int corner = 0; corner < 8; corner++) {
+                    glm::vec3 p((float)x + ((corner & 4) ? 0.5f : -0.5f),
+                                (float)y + ((corner & 2) ? 0.5f : -0.5f),
+                                (float)z + ((corner & 1) ? 0.5f : -0.5f));
+                    glm::vec3 pModel = glm::vec3(voxelToLocal * glm::vec4(p, 1.0f));
+                    chunk.box += pModel;
+                    pointsInPart << pModel;
+                }
+                chunk.points << pointsInPart;
+            }
+        }
+    }
+}
+
+void PolyVoxChunks::getCollisionPoints(PolyVox::SimpleVolume<uint8_t>* volData, const glm::mat4& voxelToLocal,
+                                       int userOffset, const glm::ivec3& userSize, float hullOffset,
+                                       ShapeInfo::PointCollection& points, AABox& box) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // the hulls are cached in model space, so a change of dimensions or registration invalidates all of them
+    bool transformChanged = voxelToLocal != _lastVoxelToLocal;
+    _lastVoxelToLocal = voxelToLocal;
+
+    for (auto& chunk : _chunks) {
+        if (chunk.shapeDirty || transformChanged) {
+            chunk.points.clear();
+            chunk.box.clear();
+            if (_marchingCubes) {
+                computeMarchingCubesHulls(chunk, voxelToLocal, hullOffset);
+            } else {
+                computeCubicHulls(volData, chunk, voxelToLocal, userOffset, userSize);
+            }
+            chunk.shapeDirty = false;
+        }
+
+        if (!chunk.points.isEmpty()) {
+            points << chunk.points;
+            box += chunk.box;
+        }
+    }
+}
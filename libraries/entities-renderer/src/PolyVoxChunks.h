@@ -0,0 +1,96 @@
+//
+//  PolyVoxChunks.h
+//  libraries/entities-renderer/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunks_h
+#define hifi_PolyVoxChunks_h
+
+#include <mutex>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+#include <ShapeInfo.h>
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning( disable : 4267 )
+#endif
+#include <PolyVoxCore/SimpleVolume.h>
+#include <PolyVoxCore/SurfaceMesh.h>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+// Splits a PolyVox volume into fixed-size chunks which are meshed and collided independently, so that editing a
+// voxel only re-extracts the few chunks around it.  Chunk regions share their upper plane of voxels with the next
+// chunk, which gives exactly the cells a single extraction over the whole volume would visit.
+//
+// Extraction and shape building run on worker threads, possibly at the same time, so every call takes the chunks'
+// own mutex.  The volume passed in must still be held under the owner's read lock.
+class PolyVoxChunks {
+public:
+    using Vertex = PolyVox::PositionMaterialNormal;
+
+    static const int CHUNK_SIZE;
+
+    // volumeSize is the width, height and depth of the volume in voxels, including any edge padding
+    PolyVoxChunks(const glm::ivec3& volumeSize, bool marchingCubes);
+
+    const glm::ivec3& getVolumeSize() const { return _volumeSize; }
+    bool isMarchingCubes() const { return _marchingCubes; }
+    int getNumChunks() const { return (int)_chunks.size(); }
+    int getNumDirtyChunks() const;
+
+    // coords are in volume space, i.e. already offset for edged surface styles
+    void markVoxelDirty(const glm::ivec3& volumeCoord);
+    void markAllDirty();
+
+    // re-extract the surface of every dirty chunk, returns the number of chunks extracted
+    int extractDirtyChunks(PolyVox::SimpleVolume<uint8_t>* volData);
+
+    // the concatenation of all chunk meshes, with positions in volume space
+    void getMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) const;
+
+    // rebuild the collision hulls of chunks whose surface changed since the last call, and append all of them.
+    // userOffset is the distance from volume coords to user voxel-coords, userSize the user-visible volume size.
+    void getCollisionPoints(PolyVox::SimpleVolume<uint8_t>* volData, const glm::mat4& voxelToLocal,
+                            int userOffset, const glm::ivec3& userSize, float hullOffset,
+                            ShapeInfo::PointCollection& points, AABox& box);
+
+private:
+    struct Chunk {
+        glm::ivec3 lower;   // first cell owned by this chunk
+        glm::ivec3 upper;   // one past the last cell owned by this chunk
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        ShapeInfo::PointCollection points;
+        AABox box;
+        bool meshDirty { true };
+        bool shapeDirty { true };
+    };
+
+    int chunkIndexForCell(int cell, int axis) const;
+    void extractChunk(PolyVox::SimpleVolume<uint8_t>* volData, Chunk& chunk);
+    void computeMarchingCubesHulls(Chunk& chunk, const glm::mat4& voxelToLocal, float hullOffset);
+    void computeCubicHulls(PolyVox::SimpleVolume<uint8_t>* volData, Chunk& chunk, const glm::mat4& voxelToLocal,
+                           int userOffset, const glm::ivec3& userSize);
+
+    glm::ivec3 _volumeSize;
+    glm::ivec3 _numChunks;
+    bool _marchingCubes;
+    std::vector<Chunk> _chunks;
+
+    glm::mat4 _lastVoxelToLocal;
+
+    mutable std::mutex _mutex;
+};
+
+#endif // hifi_PolyVoxChunks_h
@@ -53,6 +53,10 @@ public:
     virtual bool addToScene(const ScenePointer& scene, Transaction& transaction) final;
     virtual void removeFromScene(const ScenePointer& scene, Transaction& transaction);
 
+    // True for renderers whose synchronous update only reads the entity and writes their own state under their lock,
+    // which lets EntityTreeRenderer run their updateInScene on worker threads, each with its own transaction
+    virtual bool canUpdateInSceneConcurrently() const { return false; }
+
     const uint64_t& getUpdateTime() const { return _updateTime; }
 
     virtual void addMaterial(graphics::MaterialLayer material, const std::string& parentMaterialName);
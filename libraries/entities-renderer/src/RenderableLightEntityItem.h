@@ -24,6 +24,7 @@ class LightEntityRenderer final : public TypedEntityRenderer<LightEntityItem> {
 
 public:
     LightEntityRenderer(const EntityItemPointer& entity) : Parent(entity) { }
+    virtual bool canUpdateInSceneConcurrently() const override { return true; }
 
 protected:
     virtual void doRenderUpdateAsynchronousTyped(const TypedEntityPointer& entity) override;
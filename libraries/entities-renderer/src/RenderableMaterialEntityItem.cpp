@@ -300,9 +300,12 @@ void MaterialEntityRenderer::doRender(RenderArgs* args) {
     if (!proceduralRender) {
         drawMaterial->setTextureTransforms(textureTransform, MaterialMappingMode::UV, true);
         // bind the material
-        if (RenderPipelines::bindMaterial(drawMaterial, batch, args->_renderMode, args->_enableTexturing)) {
+        graphics::MultiMaterial materials;
+        materials.push(graphics::MaterialLayer(drawMaterial, 0));
+        if (RenderPipelines::bindMaterials(materials, batch, args->_renderMode, args->_enableTexturing)) {
             args->_details._materialSwitches++;
         }
+        RenderPipelines::requestMipDemand(materials, args, _bound);
 
         // Draw!
         DependencyManager::get<GeometryCache>()->renderSphere(batch);
@@ -16,6 +16,8 @@
 
 #include <glm/gtx/transform.hpp>
 
+#include <QtConcurrent/QtConcurrentRun>
+
 using namespace render;
 using namespace render::entities;
 
@@ -46,7 +48,11 @@ struct GpuParticle {
     glm::vec2 uv; // Lifetime + seed
 };
 
-using GpuParticles = std::vector<GpuParticle>;
+static const size_t FLOATS_PER_GPU_PARTICLE = 5;
+static_assert(sizeof(GpuParticle) == FLOATS_PER_GPU_PARTICLE * sizeof(float), "GpuParticle layout doesn't match.");
+
+// emitters with fewer particles than this step inline, more and they step on a worker thread
+static const size_t MIN_PARTICLES_FOR_WORKER_SIMULATION = 256;
 
 ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
     ParticleUniforms uniforms;
@@ -64,6 +70,131 @@ ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPoint
     });
 }
 
+ParticleEffectEntityRenderer::~ParticleEffectEntityRenderer() {
+    _simulationFuture.waitForFinished();
+}
+
+void ParticleEffectEntityRenderer::CpuParticles::grow() {
+    size_t newCapacity = std::max<size_t>(2 * _capacity, 64);
+
+    // unwrap the ring into the front of the new arrays
+    auto unwrap = [&](auto& values) {
+        std::remove_reference_t<decltype(values)> newValues(newCapacity);
+        size_t firstSpan = std::min(_size, _capacity - _head);
+        std::copy(values.begin() + _head, values.begin() + _head + firstSpan, newValues.begin());
+        std::copy(values.begin(), values.begin() + (_size - firstSpan), newValues.begin() + firstSpan);
+        values.swap(newValues);
+    };
+    unwrap(_seed);
+    unwrap(_expiration);
+    unwrap(_lifetime);
+    for (int axis = 0; axis < 3; axis++) {
+        unwrap(_basePosition[axis]);
+        unwrap(_relativePosition[axis]);
+        unwrap(_velocity[axis]);
+        unwrap(_acceleration[axis]);
+    }
+    _head = 0;
+    _capacity = newCapacity;
+}
+
+void ParticleEffectEntityRenderer::CpuParticles::pushBack(const CpuParticle& particle) {
+    if (_size == _capacity) {
+        grow();
+    }
+    size_t i = (_head + _size) % _capacity;
+    _seed[i] = particle.seed;
+    _expiration[i] = particle.expiration;
+    _lifetime[i] = particle.lifetime;
+    for (int axis = 0; axis < 3; axis++) {
+        _basePosition[axis][i] = particle.basePosition[axis];
+        _relativePosition[axis][i] = particle.relativePosition[axis];
+        _velocity[axis][i] = particle.velocity[axis];
+        _acceleration[axis][i] = particle.acceleration[axis];
+    }
+    _size++;
+}
+
+void ParticleEffectEntityRenderer::CpuParticles::popFront() {
+    _head = (_head + 1) % _capacity;
+    _size--;
+}
+
+template <typename F>
+void ParticleEffectEntityRenderer::CpuParticles::forEachSpan(F f) const {
+    if (_size == 0) {
+        return;
+    }
+    size_t end = _head + _size;
+    if (end <= _capacity) {
+        f(_head, end);
+    } else {
+        f(_head, _capacity);
+        f((size_t)0, end - _capacity);
+    }
+}
+
+void ParticleEffectEntityRenderer::CpuParticles::integrate(float deltaTime) {
+    const float halfDeltaTimeSquared = 0.5f * deltaTime * deltaTime;
+    forEachSpan([&](size_t begin, size_t end) {
+        for (int axis = 0; axis < 3; axis++) {
+            float* position = _relativePosition[axis].data();
+            float* velocity = _velocity[axis].data();
+            const float* acceleration = _acceleration[axis].data();
+            for (size_t i = begin; i < end; i++) {
+                position[i] += velocity[i] * deltaTime + acceleration[i] * halfDeltaTimeSquared;
+                velocity[i] += acceleration[i] * deltaTime;
+            }
+        }
+        float* lifetime = _lifetime.data();
+        for (size_t i = begin; i < end; i++) {
+            lifetime[i] += deltaTime;
+        }
+    });
+}
+
+void ParticleEffectEntityRenderer::CpuParticles::rebase(const glm::vec3& newBasePosition, bool wasTrailing) {
+    forEachSpan([&](size_t begin, size_t end) {
+        for (int axis = 0; axis < 3; axis++) {
+            float* position = _relativePosition[axis].data();
+            float* base = _basePosition[axis].data();
+            float newBase = newBasePosition[axis];
+            if (wasTrailing) {
+                for (size_t i = begin; i < end; i++) {
+                    position[i] += base[i] - newBase;
+                }
+            }
+            std::fill(base + begin, base + end, newBase);
+        }
+    });
+}
+
+void ParticleEffectEntityRenderer::CpuParticles::writeGpuParticles(float* gpuParticles, bool shouldTrail, const glm::vec3& emitterPosition) const {
+    forEachSpan([&](size_t begin, size_t end) {
+        for (int axis = 0; axis < 3; axis++) {
+            const float* position = _relativePosition[axis].data();
+            const float* base = _basePosition[axis].data();
+            float* out = gpuParticles + axis;
+            if (shouldTrail) {
+                for (size_t i = begin; i < end; i++) {
+                    out[(i - begin) * FLOATS_PER_GPU_PARTICLE] = position[i] + base[i];
+                }
+            } else {
+                float emitter = emitterPosition[axis];
+                for (size_t i = begin; i < end; i++) {
+                    out[(i - begin) * FLOATS_PER_GPU_PARTICLE] = position[i] + emitter;
+                }
+            }
+        }
+        for (size_t i = begin; i < end; i++) {
+            float* out = gpuParticles + (i - begin) * FLOATS_PER_GPU_PARTICLE;
+            out[3] = _lifetime[i];
+            out[4] = _seed[i];
+        }
+        gpuParticles += (end - begin) * FLOATS_PER_GPU_PARTICLE;
+    });
+}
+
 void ParticleEffectEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) {
     auto newParticleProperties = entity->getParticleProperties();
     if (!newParticleProperties.valid()) {
@@ -71,13 +202,9 @@ void ParticleEffectEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePoi
     }
 
     if (resultWithReadLock<bool>([&] { return _particleProperties != newParticleProperties; })) {
-        _timeUntilNextEmit = 0;
         withWriteLock([&] {
             _particleProperties = newParticleProperties;
-            if (!_prevEmitterShouldTrailInitialized) {
-                _prevEmitterShouldTrailInitialized = true;
-                _prevEmitterShouldTrail = _particleProperties.emission.shouldTrail;
-            }
+            _shouldResetEmitTimer = true;
         });
     }
 
@@ -87,11 +214,11 @@ void ParticleEffectEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePoi
         QString compoundShapeURL = entity->getCompoundShapeURL();
         if (_compoundShapeURL != compoundShapeURL) {
             _compoundShapeURL = compoundShapeURL;
-            _hasComputedTriangles = false;
+            _shouldComputeTriangles = true;
             fetchGeometryResource();
         }
+        _emitting = entity->getIsEmitting();
     });
-    _emitting = entity->getIsEmitting();
 
     bool textureEmpty = resultWithReadLock<bool>([&] { return _particleProperties.textures.isEmpty(); });
     if (textureEmpty) {
@@ -147,6 +274,35 @@ void ParticleEffectEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEn
     });
     // Update particle uniforms
     memcpy(&_uniformBuffer.edit<ParticleUniforms>(), &particleUniforms, sizeof(ParticleUniforms));
+
+    // Step the simulation here rather than in doRender, so drawing never waits for it. Large emitters step on a
+    // worker thread while the frame renders, and are drawn from the first update after they finish.
+    // FIXME migrate simulation to a compute stage
+    if (!_simulationFuture.isFinished()) {
+        return;
+    }
+    if (_hasSimulationStep) {
+        _hasSimulationStep = false;
+        std::swap(_particleBuffer, _simulatedParticleBuffer);
+    }
+    if (_cpuParticles.size() >= MIN_PARTICLES_FOR_WORKER_SIMULATION) {
+        _hasSimulationStep = true;
+        _simulationFuture = QtConcurrent::run([this] {
+            PROFILE_RANGE(render, "stepParticleSimulation");
+            stepSimulation();
+        });
+    } else {
+        stepSimulation();
+        std::swap(_particleBuffer, _simulatedParticleBuffer);
+    }
+}
+
+bool ParticleEffectEntityRenderer::needsRenderUpdate() const {
+    // the simulation steps in the render update, so keep updating while there are particles to step
+    if (_particleBuffer->getSize() > 0 || resultWithReadLock<bool>([&] { return _emitting; })) {
+        return true;
+    }
+    return Parent::needsRenderUpdate();
 }
 
 ItemKey ParticleEffectEntityRenderer::getKey() {
@@ -383,27 +539,39 @@ void ParticleEffectEntityRenderer::stepSimulation() {
     const auto interval = std::min<uint64_t>(USECS_PER_SECOND / 60, now - _lastSimulated);
     _lastSimulated = now;
 
+    // The step may run on a worker thread while the entity is updated, so it works from a copy of the entity state
+    // and takes over the resets the updates asked for
     particle::Properties particleProperties;
+    bool emitting;
     ShapeType shapeType;
     GeometryResource::Pointer geometryResource;
-    withReadLock([&] {
+    Transform modelTransform;
+    withWriteLock([&] {
         particleProperties = _particleProperties;
+        emitting = _emitting;
         shapeType = _shapeType;
         geometryResource = _geometryResource;
+        modelTransform = getModelTransform();
+        if (_shouldResetEmitTimer) {
+            _shouldResetEmitTimer = false;
+            _timeUntilNextEmit = 0;
+        }
+        if (_shouldComputeTriangles) {
+            _shouldComputeTriangles = false;
+            _hasComputedTriangles = false;
+        }
     });
-
-    const auto& modelTransform = getModelTransform();
-    if (_emitting && particleProperties.emitting() &&
+    if (emitting && particleProperties.emitting() &&
         (shapeType != SHAPE_TYPE_COMPOUND || (geometryResource && geometryResource->isLoaded()))) {
         uint64_t emitInterval = particleProperties.emitIntervalUsecs();
         if (emitInterval > 0 && interval >= _timeUntilNextEmit) {
             auto timeRemaining = interval;
             while (timeRemaining > _timeUntilNextEmit) {
-                if (_shapeType == SHAPE_TYPE_COMPOUND && !_hasComputedTriangles) {
+                if (shapeType == SHAPE_TYPE_COMPOUND && !_hasComputedTriangles) {
                     computeTriangles(geometryResource->getHFMModel());
                 }
                 // emit particle
-                _cpuParticles.push_back(createParticle(now, modelTransform, particleProperties, shapeType, geometryResource, _triangleInfo));
+                _cpuParticles.pushBack(createParticle(now, modelTransform, particleProperties, shapeType, geometryResource, _triangleInfo));
                 _timeUntilNextEmit = emitInterval;
                 if (emitInterval < timeRemaining) {
                     timeRemaining -= emitInterval;
@@ -415,38 +583,28 @@ void ParticleEffectEntityRenderer::stepSimulation() {
     }
 
     // Kill any particles that have expired or are over the max size
-    while (_cpuParticles.size() > particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration <= now)) {
-        _cpuParticles.pop_front();
+    while (_cpuParticles.size() > particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.frontExpiration() <= now)) {
+        _cpuParticles.popFront();
     }
 
     const float deltaTime = (float)interval / (float)USECS_PER_SECOND;
     // update the particles
-    for (auto& particle : _cpuParticles) {
-        if (_prevEmitterShouldTrail != particleProperties.emission.shouldTrail) {
-            if (_prevEmitterShouldTrail) {
-                particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
-            }
-            particle.basePosition = modelTransform.getTranslation();
-        }
-        particle.integrate(deltaTime);
+    if (!_prevEmitterShouldTrailInitialized) {
+        _prevEmitterShouldTrailInitialized = true;
+        _prevEmitterShouldTrail = particleProperties.emission.shouldTrail;
+    }
+    if (_prevEmitterShouldTrail != particleProperties.emission.shouldTrail) {
+        _cpuParticles.rebase(modelTransform.getTranslation(), _prevEmitterShouldTrail);
     }
+    _cpuParticles.integrate(deltaTime);
     _prevEmitterShouldTrail = particleProperties.emission.shouldTrail;
 
-    // Build particle primitives
-    static GpuParticles gpuParticles;
-    gpuParticles.clear();
-    gpuParticles.reserve(_cpuParticles.size()); // Reserve space
-    std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), [&particleProperties, &modelTransform] (const CpuParticle& particle) {
-        glm::vec3 position = particle.relativePosition + (particleProperties.emission.shouldTrail ? particle.basePosition : modelTransform.getTranslation());
-        return GpuParticle(position, glm::vec2(particle.lifetime, particle.seed));
-    });
-
-    // Update particle buffer
-    auto& particleBuffer = _particleBuffer;
-    size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
-    particleBuffer->resize(numBytes);
+    // Build particle primitives directly in the vertex buffer, which no frame draws until it is swapped in
+    size_t numBytes = sizeof(GpuParticle) * _cpuParticles.size();
+    _simulatedParticleBuffer->resize(numBytes);
     if (numBytes != 0) {
-        particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
+        _cpuParticles.writeGpuParticles((float*)_simulatedParticleBuffer->editSubData(0, numBytes),
+            particleProperties.emission.shouldTrail, modelTransform.getTranslation());
     }
 }
 
@@ -455,9 +613,6 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
         return;
     }
 
-    // FIXME migrate simulation to a compute stage
-    stepSimulation();
-
     gpu::Batch& batch = *args->_batch;
     batch.setResourceTexture(0, _networkTexture->getGPUTexture());
 
@@ -11,6 +11,8 @@
 #ifndef hifi_RenderableParticleEffectEntityItem_h
 #define hifi_RenderableParticleEffectEntityItem_h
 
+#include <QtCore/QFuture>
+
 #include "RenderableEntityItem.h"
 #include <ParticleEffectEntityItem.h>
 #include <TextureCache.h>
@@ -23,10 +25,12 @@ class ParticleEffectEntityRenderer : public TypedEntityRenderer<ParticleEffectEn
 
 public:
     ParticleEffectEntityRenderer(const EntityItemPointer& entity);
+    ~ParticleEffectEntityRenderer();
 
 protected:
     virtual void doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) override;
     virtual void doRenderUpdateAsynchronousTyped(const TypedEntityPointer& entity) override;
+    virtual bool needsRenderUpdate() const override;
 
     virtual ItemKey getKey() override;
     virtual ShapeKey getShapeKey() override;
@@ -41,8 +45,7 @@ private:
     using Buffer = gpu::Buffer;
     using BufferView = gpu::BufferView;
 
-    // CPU particles
-    // FIXME either switch to GPU compute particles or switch to simd updating of the particles
+    // A newly emitted particle
     struct CpuParticle {
         float seed { 0.0f };
         uint64_t expiration { 0 };
@@ -51,15 +54,40 @@ private:
         glm::vec3 relativePosition;
         glm::vec3 velocity;
         glm::vec3 acceleration;
+    };
 
-        void integrate(float deltaTime) {
-            glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
-            relativePosition += velocity * deltaTime + atSquared;
-            velocity += acceleration * deltaTime;
-            lifetime += deltaTime;
-        }
+    // CPU particles, oldest first, as a ring buffer of one array per component so that each
+    // simulation step is a few straight loops over floats the compiler can vectorize
+    class CpuParticles {
+    public:
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+        uint64_t frontExpiration() const { return _expiration[_head]; }
+
+        void pushBack(const CpuParticle& particle);
+        void popFront();
+
+        void integrate(float deltaTime);
+        void rebase(const glm::vec3& newBasePosition, bool wasTrailing);
+        // writes position, lifetime and seed in the GpuParticle vertex layout
+        void writeGpuParticles(float* gpuParticles, bool shouldTrail, const glm::vec3& emitterPosition) const;
+
+    private:
+        void grow();
+        // calls f(begin, end) for the contiguous index ranges holding the live particles, oldest first
+        template <typename F> void forEachSpan(F f) const;
+
+        size_t _head { 0 };
+        size_t _size { 0 };
+        size_t _capacity { 0 };
+        std::vector<float> _seed;
+        std::vector<uint64_t> _expiration;
+        std::vector<float> _lifetime;
+        std::vector<float> _basePosition[3];
+        std::vector<float> _relativePosition[3];
+        std::vector<float> _velocity[3];
+        std::vector<float> _acceleration[3];
     };
-    using CpuParticles = std::deque<CpuParticle>;
 
 
     template<typename T>
@@ -79,6 +107,7 @@ private:
         glm::vec2 spare;
     };
 
+    // only used by the simulation step, which may run on a worker thread
     void computeTriangles(const hfm::Model& hfmModel);
     bool _hasComputedTriangles{ false };
     struct TriangleInfo {
@@ -94,11 +123,19 @@ private:
     void stepSimulation();
 
     particle::Properties _particleProperties;
-    bool _prevEmitterShouldTrail;
+    // simulation only
+    bool _prevEmitterShouldTrail { false };
     bool _prevEmitterShouldTrailInitialized { false };
     CpuParticles _cpuParticles;
-    bool _emitting { false };
     uint64_t _timeUntilNextEmit { 0 };
+    BufferPointer _simulatedParticleBuffer { std::make_shared<Buffer>() }; // swapped with _particleBuffer after each step
+
+    QFuture<void> _simulationFuture;
+    bool _hasSimulationStep { false }; // a worker step whose result hasn't been swapped in
+    // written by the entity update and read by the simulation, under the lock
+    bool _emitting { false };
+    bool _shouldResetEmitTimer { false };
+    bool _shouldComputeTriangles { false };
     BufferPointer _particleBuffer { std::make_shared<Buffer>() };
     BufferView _uniformBuffer;
     quint64 _lastSimulated { 0 };
@@ -13,13 +13,16 @@
 #include "RenderablePolyVoxEntityItem.h"
 
 #include <math.h>
+#include <mutex>
 
 #include <glm/gtx/transform.hpp>
 
 #include <QObject>
 #include <QByteArray>
+#include <QHash>
 #include <QtConcurrent/QtConcurrentRun>
 
+#include <AbstractViewStateInterface.h>
 #include <model-networking/SimpleMeshProxy.h>
 #include <ModelScriptingInterface.h>
 #include <EntityEditPacketSender.h>
@@ -73,6 +76,7 @@
 
 #include "RenderablePolyVoxEntityItem.h"
 #include "PhysicalEntitySimulation.h"
+#include "PolyVoxChunks.h"
 
 const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
@@ -135,6 +139,11 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
   _voxelDataDirty to be set true while worker threads are attempting to bake meshes or shapes.  If this happens,
   we jump back to a higher point in the diagram to avoid wasting effort.
 
+  The voxel space is split into chunks (see PolyVoxChunks) which each keep their own piece of the mesh and of the
+  collision hulls.  Changing a voxel marks the chunks around it dirty, and only those are re-extracted by the next
+  bake.  Mesh bakes from all polyvoxes share a small number of worker slots, which are handed to the entity nearest
+  the avatar first.
+
   PolyVoxes are designed to seemlessly fit up against neighbors.  If voxels go right up to the edge of polyvox,
   the resulting mesh wont be closed -- the library assumes you'll have another polyvox next to it to continue the
   mesh.
@@ -225,6 +234,7 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
             volSizeChanged = true;
         }
         _voxelSurfaceStyle = voxelSurfaceStyle;
+        _chunks.reset();
         startUpdates();
     });
 
@@ -777,6 +787,61 @@ void RenderablePolyVoxEntityItem::stopUpdates() {
     changeUpdates(false);
 }
 
+// Mesh bakes from every polyvox share a few worker threads.  An entity waiting for a slot asks again on each of its
+// updates, and a free slot goes to the waiting entity nearest the avatar.  Requests that aren't renewed (the entity
+// was deleted, or found other work) expire.
+class PolyVoxMeshingSlots {
+public:
+    bool tryAcquire(const QUuid& id, float distance, quint64 now) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _waiting[id] = { distance, now };
+        if (_running >= MAX_CONCURRENT_MESH_BAKES) {
+            return false;
+        }
+
+        auto itr = _waiting.begin();
+        while (itr != _waiting.end()) {
+            if (itr.value().second + REQUEST_TIMEOUT < now) {
+                itr = _waiting.erase(itr);
+                continue;
+            }
+            if (itr.key() != id && itr.value().first < distance) {
+                // someone nearer is waiting
+                return false;
+            }
+            ++itr;
+        }
+
+        _waiting.remove(id);
+        _running++;
+        return true;
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running--;
+    }
+
+private:
+    static const int MAX_CONCURRENT_MESH_BAKES = 2;
+    static const quint64 REQUEST_TIMEOUT = USECS_PER_SECOND;
+
+    std::mutex _mutex;
+    int _running { 0 };
+    QHash<QUuid, QPair<float, quint64>> _waiting;
+};
+
+static PolyVoxMeshingSlots meshingSlots;
+
+bool RenderablePolyVoxEntityItem::acquireMeshingSlot(const quint64& now) {
+    float distance = 0.0f;
+    auto viewState = AbstractViewStateInterface::instance();
+    if (viewState) {
+        distance = glm::distance(viewState->getAvatarPosition(), getWorldPosition());
+    }
+    return meshingSlots.tryAcquire(getID(), distance, now);
+}
+
 void RenderablePolyVoxEntityItem::update(const quint64& now) {
     bool doRecomputeMesh { false };
     bool doUncompress { false };
@@ -790,6 +855,9 @@ void RenderablePolyVoxEntityItem::update(const quint64& now) {
 
             case PolyVoxState::Ready: {
                 if (_volDataDirty) {
+                    if (!acquireMeshingSlot(now)) {
+                        break; // wait for a worker, nearer polyvoxes go first
+                    }
                     _volDataDirty = _voxelDataDirty = false;
                     _state = PolyVoxState::BakingMesh;
                     doRecomputeMesh = true;
@@ -812,6 +880,9 @@ void RenderablePolyVoxEntityItem::update(const quint64& now) {
             }
             case PolyVoxState::UncompressingFinished: {
                 if (_volDataDirty) {
+                    if (!acquireMeshingSlot(now)) {
+                        break;
+                    }
                     _volDataDirty = _voxelDataDirty = false;
                     _state = PolyVoxState::BakingMeshNoCompress;
                     doRecomputeMesh = true;
@@ -831,6 +902,9 @@ void RenderablePolyVoxEntityItem::update(const quint64& now) {
             }
             case PolyVoxState::BakingMeshFinished: {
                 if (_volDataDirty) {
+                    if (!acquireMeshingSlot(now)) {
+                        break;
+                    }
                     _volDataDirty = _voxelDataDirty = false;
                     _state = PolyVoxState::BakingMesh;
                     // a local edit happened while we were baking the mesh.  rebake mesh...
@@ -852,6 +926,9 @@ void RenderablePolyVoxEntityItem::update(const quint64& now) {
             }
             case PolyVoxState::BakingMeshNoCompressFinished: {
                 if (_volDataDirty) {
+                    if (!acquireMeshingSlot(now)) {
+                        break;
+                    }
                     _volDataDirty = _voxelDataDirty = false;
                     _state = PolyVoxState::BakingMesh;
                     // a local edit happened while we were baking the mesh.  rebake mesh...
@@ -914,6 +991,7 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _voxelDataDirty = true;
         _voxelVolumeSize = voxelVolumeSize;
         _volData.reset();
+        _chunks.reset();
         _onCount = 0;
         _updateFromNeighborXEdge = _updateFromNeighborYEdge = _updateFromNeighborZEdge = true;
         startUpdates();
@@ -992,6 +1070,9 @@ uint8_t RenderablePolyVoxEntityItem::getVoxelInternal(const ivec3& v) const {
 
 void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue) {
     _volData->setVoxelAt(x, y, z, toValue);
+    if (_chunks) {
+        _chunks->markVoxelDirty({ x, y, z });
+    }
     if (x == 0) {
         _neighborXNeedsUpdate = true;
         startUpdates();
@@ -1092,6 +1173,8 @@ void RenderablePolyVoxEntityItem::setVoxelsFromData(QByteArray uncompressedData,
                                                     quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) {
     // this accepts the payload from uncompressVolumeData
     withWriteLock([&] {
+        // every voxel may change, so the chunks are rebuilt from scratch rather than marked one voxel at a time
+        _chunks.reset();
         loop3(ivec3(0), ivec3(voxelXSize, voxelYSize, voxelZSize), [&](const ivec3& v) {
             int uncompressedIndex = (v.z * voxelYSize * voxelXSize) + (v.y * voxelZSize) + v.x;
             setVoxelInternal(v, uncompressedData[uncompressedIndex]);
@@ -1244,6 +1327,9 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            if (_chunks) {
+                                _chunks->markVoxelDirty({ x, y, z });
+                            }
                             _volDataDirty = true;
                         }
                     }
@@ -1264,6 +1350,9 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            if (_chunks) {
+                                _chunks->markVoxelDirty({ x, y, z });
+                            }
                             _volDataDirty = true;
                         }
                     }
@@ -1284,6 +1373,9 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            if (_chunks) {
+                                _chunks->markVoxelDirty({ x, y, z });
+                            }
                             _volDataDirty = true;
                         }
                     }
@@ -1324,49 +1416,41 @@ void RenderablePolyVoxEntityItem::tellNeighborsToRecopyEdges(bool force) {
 
 
 void RenderablePolyVoxEntityItem::recomputeMesh() {
-    // use _volData to make a renderable mesh
-    PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
-        voxelSurfaceStyle = _voxelSurfaceStyle;
+    // use _volData to make a renderable mesh.  The caller holds a meshing slot, which is released once the
+    // surface has been extracted.
+    std::shared_ptr<PolyVoxChunks> chunks;
+    withWriteLock([&] {
+        ivec3 volumeSize { _volData->getWidth(), _volData->getHeight(), _volData->getDepth() };
+        bool marchingCubes = _voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
+            _voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES;
+        if (!_chunks || _chunks->getVolumeSize() != volumeSize || _chunks->isMarchingCubes() != marchingCubes) {
+            _chunks = std::make_shared<PolyVoxChunks>(volumeSize, marchingCubes);
+        }
+        chunks = _chunks;
     });
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
+    QtConcurrent::run([entity, chunks] {
         graphics::MeshPointer mesh(new graphics::Mesh());
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
-
+        // only the chunks touched since the last bake are extracted again
         entity->withReadLock([&] {
-            PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-            }
+            chunks->extractDirtyChunks(entity->getVolData());
         });
 
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+        std::vector<uint32_t> vecIndices;
+        chunks->getMesh(vecVertices, vecIndices);
+        meshingSlots.release();
+
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
@@ -1412,132 +1496,34 @@ void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
 }
 
 void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
-    // this creates a collision-shape for the physics engine.  The shape comes from
-    // _volData for cubic extractors and from _mesh for marching-cube extractors
+    // this creates a collision-shape for the physics engine.  The shape comes from _volData for cubic extractors
+    // and from the mesh for marching-cube extractors.  Each chunk keeps its own hulls, and only chunks whose
+    // surface was re-extracted since the last shape are rebuilt.
 
     EntityItemPointer entity = getThisPointer();
 
     PolyVoxSurfaceStyle voxelSurfaceStyle;
     glm::vec3 voxelVolumeSize;
-    graphics::MeshPointer mesh;
+    std::shared_ptr<PolyVoxChunks> chunks;
 
     withReadLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
         voxelVolumeSize = _voxelVolumeSize;
-        mesh = _mesh;
+        chunks = _chunks;
     });
 
-    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
+    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, chunks] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
-        QVector<QVector<glm::vec3>> pointCollection;
+        ShapeInfo::PointCollection pointCollection;
         AABox box;
-        glm::mat4 vtoM = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->voxelToLocalMatrix();
-
-        if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
-            voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
-            // pull each triangle in the mesh into a polyhedron which can be collided with
-            unsigned int i = 0;
-
-            const gpu::BufferView& vertexBufferView = mesh->getVertexBuffer();
-            const gpu::BufferView& indexBufferView = mesh->getIndexBuffer();
-
-            gpu::BufferView::Iterator<const uint32_t> it = indexBufferView.cbegin<uint32_t>();
-            while (it != indexBufferView.cend<uint32_t>()) {
-                uint32_t p0Index = *(it++);
-                uint32_t p1Index = *(it++);
-                uint32_t p2Index = *(it++);
-
-                const glm::vec3& p0 = vertexBufferView.get<const glm::vec3>(p0Index);
-                const glm::vec3& p1 = vertexBufferView.get<const glm::vec3>(p1Index);
-                const glm::vec3& p2 = vertexBufferView.get<const glm::vec3>(p2Index);
-
-                glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
-                glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-                glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
-
-                glm::vec3 p0Model = glm::vec3(vtoM * glm::vec4(p0, 1.0f));
-                glm::vec3 p1Model = glm::vec3(vtoM * glm::vec4(p1, 1.0f));
-                glm::vec3 p2Model = glm::vec3(vtoM * glm::vec4(p2, 1.0f));
-                glm::vec3 p3Model = glm::vec3(vtoM * glm::vec4(p3, 1.0f));
-
-                box += p0Model;
-                box += p1Model;
-                box += p2Model;
-                box += p3Model;
-
-                QVector<glm::vec3> pointsInPart;
-                pointsInPart << p0Model;
-                pointsInPart << p1Model;
-                pointsInPart << p2Model;
-                pointsInPart << p3Model;
-                // add next convex hull
-                QVector<glm::vec3> newMeshPoints;
-                pointCollection << newMeshPoints;
-                // add points to the new convex hull
-                pointCollection[i++] << pointsInPart;
-            }
-        } else {
-            unsigned int i = 0;
-            polyVoxEntity->forEachVoxelValue(voxelVolumeSize, [&](const ivec3& v, uint8_t value) {
-                if (value > 0) {
-                    const auto& x = v.x;
-                    const auto& y = v.y;
-                    const auto& z = v.z;
-                    if (glm::all(glm::greaterThan(v, ivec3(0))) &&
-                        glm::all(glm::lessThan(v, ivec3(voxelVolumeSize) - 1)) &&
-                        (polyVoxEntity->getVoxelInternal({ x - 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y - 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z - 1 }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x + 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y + 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z + 1 }) > 0)) {
-                        // this voxel has neighbors in every cardinal direction, so there's no need
-                        // to include it in the collision hull.
-                        return;
-                    }
-
-                    QVector<glm::vec3> pointsInPart;
-
-                    float offL = -0.5f;
-                    float offH = 0.5f;
-                    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
-                        offL += 1.0f;
-                        offH += 1.0f;
-                    }
-
-                    glm::vec3 p000 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offL, 1.0f));
-                    glm::vec3 p001 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offH, 1.0f));
-                    glm::vec3 p010 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offL, 1.0f));
-                    glm::vec3 p011 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offH, 1.0f));
-                    glm::vec3 p100 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offL, 1.0f));
-                    glm::vec3 p101 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offH, 1.0f));
-                    glm::vec3 p110 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offL, 1.0f));
-                    glm::vec3 p111 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offH, 1.0f));
-
-                    box += p000;
-                    box += p001;
-                    box += p010;
-                    box += p011;
-                    box += p100;
-                    box += p101;
-                    box += p110;
-                    box += p111;
-
-                    pointsInPart << p000;
-                    pointsInPart << p001;
-                    pointsInPart << p010;
-                    pointsInPart << p011;
-                    pointsInPart << p100;
-                    pointsInPart << p101;
-                    pointsInPart << p110;
-                    pointsInPart << p111;
-
-                    // add next convex hull
-                    QVector<glm::vec3> newMeshPoints;
-                    pointCollection << newMeshPoints;
-                    // add points to the new convex hull
-                    pointCollection[i++] << pointsInPart;
-                }
+        glm::mat4 vtoM = polyVoxEntity->voxelToLocalMatrix();
+
+        if (chunks) {
+            // with _EDGED_ styles, user voxel-coords are one less than the coords in _volData
+            int userOffset = PolyVoxEntityItem::isEdged(voxelSurfaceStyle) ? 1 : 0;
+            polyVoxEntity->withReadLock([&] {
+                chunks->getCollisionPoints(polyVoxEntity->getVolData(), vtoM, userOffset, ivec3(voxelVolumeSize),
+                                           MARCHING_CUBE_COLLISION_HULL_OFFSET, pointCollection, box);
             });
         }
         polyVoxEntity->setCollisionPoints(pointCollection, box);
@@ -28,6 +28,8 @@
 
 #include "RenderableEntityItem.h"
 
+class PolyVoxChunks;
+
 namespace render { namespace entities {
 class PolyVoxEntityRenderer;
 } }
@@ -152,6 +154,7 @@ private:
     void startUpdates();
     void stopUpdates();
 
+    bool acquireMeshingSlot(const quint64& now);
     void recomputeMesh();
     void cacheNeighbors();
     void copyUpperEdgesFromNeighbors();
@@ -177,6 +180,7 @@ private:
     ShapeInfo _shapeInfo;
 
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
+    std::shared_ptr<PolyVoxChunks> _chunks; // per-chunk meshes and collision hulls, rebuilt only where voxels changed
     int _onCount; // how many non-zero voxels are in _volData
 
     bool _neighborXNeedsUpdate { false };
@@ -274,6 +274,7 @@ void ShapeEntityRenderer::doRender(RenderArgs* args) {
         if (RenderPipelines::bindMaterials(materials, batch, args->_renderMode, args->_enableTexturing)) {
             args->_details._materialSwitches++;
         }
+        RenderPipelines::requestMipDemand(materials, args, _bound);
 
         geometryCache->renderShape(batch, geometryShape);
     }
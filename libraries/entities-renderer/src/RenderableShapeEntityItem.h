@@ -23,6 +23,7 @@ public:
     ShapeEntityRenderer(const EntityItemPointer& entity);
 
     virtual scriptable::ScriptableModelBase getScriptableModel() override;
+    virtual bool canUpdateInSceneConcurrently() const override { return true; }
 
 protected:
     ShapeKey getShapeKey() override;
@@ -18,6 +18,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include <BlendshapeConstants.h>
+#include <TBBHelpers.h>
 
 #include <hfm/ModelFormatLogging.h>
 
@@ -451,6 +452,19 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
     glm::vec3 ambientColor;
     QString hifiGlobalNodeID;
     unsigned int meshIndex = 0;
+
+    struct PendingMesh {
+        QString id;
+        const FBXNode* node;
+        unsigned int meshIndex;
+    };
+    struct PendingBlendshape {
+        int blendshapeIndex;
+        const FBXNode* node;
+    };
+    std::vector<PendingMesh> pendingMeshes;
+    std::vector<PendingBlendshape> pendingBlendshapes;
+
     haveReportedUnhandledRotationOrder = false;
     int fbxVersionNumber = -1;
     foreach (const FBXNode& child, node.children) {
@@ -513,10 +527,11 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex, deduplicateIndices));
+                        // defer the extraction so that all geometry can be decoded in parallel once the tree has been walked
+                        pendingMeshes.push_back({ getID(object.properties), &object, meshIndex++ });
                     } else { // object.properties.at(2) == "Shape"
-                        ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
-                        blendshapes.append(extracted);
+                        pendingBlendshapes.push_back({ blendshapes.size(), &object });
+                        blendshapes.append({ getID(object.properties), HFMBlendshape() });
                     }
                 } else if (object.name == "Model") {
                     QString name = getModelName(object.properties);
@@ -1205,6 +1220,28 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
 #endif
     }
 
+    // extractMesh and extractBlendshape only read from the node they are given, so the Geometry objects
+    // collected above are decoded concurrently and merged back in document order
+    std::vector<ExtractedMesh> extractedMeshes(pendingMeshes.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, pendingMeshes.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            unsigned int pendingMeshIndex = pendingMeshes[i].meshIndex;
+            extractedMeshes[i] = extractMesh(*pendingMeshes[i].node, pendingMeshIndex, deduplicateIndices);
+        }
+    });
+    for (size_t i = 0; i < pendingMeshes.size(); i++) {
+        meshes.insert(pendingMeshes[i].id, extractedMeshes[i]);
+    }
+    extractedMeshes.clear();
+
+    ExtractedBlendshape* blendshapesData = blendshapes.data();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, pendingBlendshapes.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            const auto& pending = pendingBlendshapes[i];
+            blendshapesData[pending.blendshapeIndex].blendshape = extractBlendshape(*pending.node);
+        }
+    });
+
     // TODO: check if is code is needed
     if (!lights.empty()) {
         if (hifiGlobalNodeID.isEmpty()) {
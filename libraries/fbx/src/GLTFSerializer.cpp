@@ -167,8 +167,10 @@ hifi::ByteArray GLTFSerializer::setGLBChunks(const hifi::ByteArray& data) {
         QDataStream tempBinLen(binLengthChunk);
         tempBinLen.setByteOrder(QDataStream::LittleEndian);
         tempBinLen >> binLength;
+        binLength = std::max(0, std::min(binLength, data.size() - (binStart + byte)));
 
-        _glbBinary = data.mid(binStart + byte, binLength);
+        // Reference the binary chunk in place rather than copying it; it is only read while data is alive in read()
+        _glbBinary = hifi::ByteArray::fromRawData(data.constData() + binStart + byte, binLength);
     }
     return jsonChunk;
 }
@@ -1646,19 +1648,24 @@ HFMModel::Pointer GLTFSerializer::read(const hifi::ByteArray& data, const hifi::
         _url = hifi::URL(QFileInfo(localFileName).absoluteFilePath());
     }
 
+    HFMModel::Pointer hfmModelPtr;
     if (parseGLTF(data)) {
         //_file.dump();
-        auto hfmModelPtr = std::make_shared<HFMModel>();
+        hfmModelPtr = std::make_shared<HFMModel>();
         HFMModel& hfmModel = *hfmModelPtr;
         buildGeometry(hfmModel, mapping, _url);
 
         //hfmDebugDump(data);
-        return hfmModelPtr;
     } else {
         qCDebug(modelformat) << "Error parsing GLTF file.";
     }
 
-    return nullptr;
+    // The buffers may reference data that is owned by the caller, and a partial parse
+    // mustn't leak into the next read
+    _file = GLTFFile();
+    _glbBinary.clear();
+
+    return hfmModelPtr;
 }
 
 bool GLTFSerializer::readBinary(const QString& url, hifi::ByteArray& outdata) {
@@ -1747,13 +1754,22 @@ HFMTexture GLTFSerializer::getHFMTexture(const GLTFTexture& texture) {
         
         if (_url.toString().endsWith("glb") && !_glbBinary.isEmpty()) {
             int bufferView = _file.images[texture.source].bufferView;
-       
-            GLTFBufferView& imagesBufferview = _file.bufferviews[bufferView];
-            int offset = imagesBufferview.byteOffset;
-            int length = imagesBufferview.byteLength;
-
-            fbxtex.content = _glbBinary.mid(offset, length);
-            fbxtex.filename = textureUrl.toEncoded().append(texture.source);
+            if (bufferView >= 0 && bufferView < _file.bufferviews.size()) {
+                const GLTFBufferView& imagesBufferview = _file.bufferviews[bufferView];
+                int offset = imagesBufferview.byteOffset;
+                int length = imagesBufferview.byteLength;
+
+                // the offsets come from the downloaded file, so check them against the binary chunk
+                if (offset >= 0 && length >= 0 && offset <= _glbBinary.size() - length) {
+                    // _glbBinary doesn't own its data, so take a deep copy of the image
+                    fbxtex.content = hifi::ByteArray(_glbBinary.constData() + offset, length);
+                    fbxtex.filename = textureUrl.toEncoded().append(texture.source);
+                } else {
+                    qCWarning(modelformat) << "GLTFSerializer::getHFMTexture -- image bufferView out of range" << offset << length;
+                }
+            } else {
+                qCWarning(modelformat) << "GLTFSerializer::getHFMTexture -- invalid image bufferView" << bufferView;
+            }
         }
 
         if (url.contains("data:image/jpeg;base64,") || url.contains("data:image/png;base64,")) {
@@ -1836,12 +1852,6 @@ void GLTFSerializer::setHFMMaterial(HFMMaterial& hfmMat, const GLTFMaterial& mat
 template<typename T, typename L>
 bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count,
                            QVector<L>& outarray, int accessorType) {
-    
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
 
     int bufferCount = 0;
     switch (accessorType) {
@@ -1868,23 +1878,24 @@ bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int c
         break;
     default:
         qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-        blobstream.setDevice(nullptr);
         return false;
     }
-    for (int i = 0; i < count; ++i) {
-        for (int j = 0; j < bufferCount; ++j) {
-            if (!blobstream.atEnd()) {
-                T value;
-                blobstream >> value;
-                outarray.push_back(value);
-            } else {
-                blobstream.setDevice(nullptr);
-                return false;
-            }
-        }
+
+    // Read the values straight out of the buffer rather than through a QDataStream.  glTF buffers are
+    // little endian, as are all of our target platforms, so each value is a plain copy.
+    const qint64 valueCount = (qint64)count * bufferCount;
+    if (byteOffset < 0 || count < 0 || (qint64)byteOffset + valueCount * (qint64)sizeof(T) > (qint64)bin.size()) {
+        return false;
     }
 
-    blobstream.setDevice(nullptr);
+    const char* source = bin.constData() + byteOffset;
+    outarray.reserve(outarray.size() + (int)valueCount);
+    for (qint64 i = 0; i < valueCount; ++i) {
+        T value;
+        memcpy(&value, source, sizeof(T));
+        source += sizeof(T);
+        outarray.push_back(value);
+    }
     return true;
 }
 template<typename T>
@@ -162,6 +162,16 @@ void GLTextureTransferEngineDefault::shutdown() {
 #endif
 }
 
+// Promoting past the mip the texture is drawn at only spends memory on texels that are never sampled
+static bool wantsPromote(const Texture& texture, const GLVariableAllocationSupport* vartexture) {
+    return vartexture->canPromote() && vartexture->allocatedMip() > texture.getDemandedMip();
+}
+
+// Mips finer than what the texture is drawn at are the first to go when over budget
+static bool hasUnneededMips(const Texture& texture, const GLVariableAllocationSupport* vartexture) {
+    return vartexture->canDemote() && vartexture->allocatedMip() < texture.getDemandedMip();
+}
+
 void GLTextureTransferEngineDefault::manageMemory() {
     PROFILE_RANGE(render_gpu_gl, __FUNCTION__);
     // reset the count used to limit the number of textures created per frame
@@ -201,14 +211,14 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         GLVariableAllocationSupport* vartexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
         vartexture->sanityCheck();
 
-        // Track how much the texture thinks it should be using
-        idealMemoryAllocation += texture->evalTotalSize();
+        // Track how much the texture thinks it should be using, given the mips it is drawn at
+        idealMemoryAllocation += texture->evalTotalSize(texture->getDemandedMip());
         // Track how much we're actually using
         totalVariableMemoryAllocation += gltexture->size();
         if (vartexture->canDemote()) {
             canDemote |= true;
         }
-        if (vartexture->canPromote()) {
+        if (wantsPromote(*texture, vartexture)) {
             canPromote |= true;
         }
         if (vartexture->hasPendingTransfers()) {
@@ -217,7 +227,7 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
     }
 
     Backend::textureResourceIdealGPUMemSize.set(idealMemoryAllocation);
-    size_t unallocated = idealMemoryAllocation - totalVariableMemoryAllocation;
+    size_t unallocated = (idealMemoryAllocation > totalVariableMemoryAllocation) ? idealMemoryAllocation - totalVariableMemoryAllocation : 0;
     float pressure = (float)totalVariableMemoryAllocation / (float)allowedMemoryAllocation;
 
     // If we're oversubscribed we need to demote textures IMMEDIATELY
@@ -254,7 +264,7 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         for (const auto& texture : strongTextures) {
             GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
             GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
-            if (MemoryPressureState::Undersubscribed == _memoryPressureState && vargltexture->canPromote()) {
+            if (MemoryPressureState::Undersubscribed == _memoryPressureState && wantsPromote(*texture, vargltexture)) {
                 // Promote smallest first
                 _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
             } else if (MemoryPressureState::Transfer == _memoryPressureState && vargltexture->hasPendingTransfers()) {
@@ -444,7 +454,7 @@ void GLTextureTransferEngineDefault::processPromotes() {
         auto originalSize = gltexture->size();
         vartexture->promote();
         auto allocationDelta = gltexture->size() - originalSize;
-        if (vartexture->canPromote()) {
+        if (wantsPromote(*texture, vartexture)) {
             // Promote smallest first
             _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
         }
@@ -465,29 +475,34 @@ void GLTextureTransferEngineDefault::processPromotes() {
 }
 
 void GLTextureTransferEngineDefault::processDemotes(size_t reliefRequired, const std::vector<TexturePointer>& strongTextures) {
-    // Demote largest first
+    // Demote textures holding mips they aren't drawn at first, then largest first
+    ImmediateWorkQueue unneededDemoteQueue;
     ImmediateWorkQueue demoteQueue;
     for (const auto& texture : strongTextures) {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
-        if (vargltexture->canDemote()) {
+        if (hasUnneededMips(*texture, vargltexture)) {
+            unneededDemoteQueue.push({ texture, (float)gltexture->size() });
+        } else if (vargltexture->canDemote()) {
             demoteQueue.push({ texture, (float)gltexture->size() });
         }
     }
 
     size_t relieved = 0;
-    while (!demoteQueue.empty() && relieved < reliefRequired) {
-        {
-            const auto& target = demoteQueue.top();
-            const auto& texture = target.first;
-            GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
-            auto oldSize = gltexture->size();
-            GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
-            vargltexture->demote();
-            auto newSize = gltexture->size();
-            relieved += (oldSize - newSize);
+    for (auto queue : { &unneededDemoteQueue, &demoteQueue }) {
+        while (!queue->empty() && relieved < reliefRequired) {
+            {
+                const auto& target = queue->top();
+                const auto& texture = target.first;
+                GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
+                auto oldSize = gltexture->size();
+                GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
+                vargltexture->demote();
+                auto newSize = gltexture->size();
+                relieved += (oldSize - newSize);
+            }
+            queue->pop();
         }
-        demoteQueue.pop();
     }
 }
 
@@ -12,6 +12,7 @@
 #define hifi_gpu_Batch_h
 
 #include <vector>
+#include <atomic>
 #include <mutex>
 #include <functional>
 #include <glm/gtc/type_ptr.hpp>
@@ -79,7 +80,7 @@ public:
     using NamedBatchDataMap = std::map<std::string, NamedBatchData>;
 
     DrawCallInfoBuffer _drawCallInfos;
-    static size_t _drawCallInfosMax;
+    static std::atomic<size_t> _drawCallInfosMax;
 
     mutable std::string _currentNamedCall;
 
@@ -407,7 +408,7 @@ public:
         typedef T Data;
         Data _data;
         Cache<T>(const Data& data) : _data(data) {}
-        static size_t _max;
+        static std::atomic<size_t> _max;
 
         class Vector {
         public:
@@ -418,7 +419,7 @@ public:
             }
 
             ~Vector() {
-                _max = std::max(_items.size(), _max);
+                updateMax(_max, _items.size());
             }
 
 
@@ -484,16 +485,16 @@ public:
     }
 
     Commands _commands;
-    static size_t _commandsMax;
+    static std::atomic<size_t> _commandsMax;
 
     CommandOffsets _commandOffsets;
-    static size_t _commandOffsetsMax;
+    static std::atomic<size_t> _commandOffsetsMax;
 
     Params _params;
-    static size_t _paramsMax;
+    static std::atomic<size_t> _paramsMax;
 
     Bytes _data;
-    static size_t _dataMax;
+    static std::atomic<size_t> _dataMax;
 
     // SSBO class... layout MUST match the layout in Transform.slh
     class TransformObject {
@@ -506,7 +507,7 @@ public:
     bool _invalidModel { true };
     Transform _currentModel;
     TransformObjects _objects;
-    static size_t _objectsMax;
+    static std::atomic<size_t> _objectsMax;
 
     BufferCaches _buffers;
     TextureCaches _textures;
@@ -536,6 +537,12 @@ protected:
     friend class Context;
     friend class Frame;
 
+    // The preallocation sizes are shared by every batch, and batches can be recorded and released on any thread
+    static void updateMax(std::atomic<size_t>& max, size_t size) {
+        size_t current = max.load();
+        while (size > current && !max.compare_exchange_weak(current, size)) {}
+    }
+
     // Apply all the named calls to the end of the batch
     // and prepare updates for the render shadow copies of the buffers
     void finishFrame(BufferUpdates& updates);
@@ -554,7 +561,7 @@ protected:
 };
 
 template <typename T>
-size_t Batch::Cache<T>::_max = BATCH_PREALLOCATE_MIN;
+std::atomic<size_t> Batch::Cache<T>::_max { BATCH_PREALLOCATE_MIN };
 
 }
 
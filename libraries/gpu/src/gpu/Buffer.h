@@ -73,6 +73,10 @@ public:
     // \return the number of bytes copied
     Size setSubData(Size offset, Size size, const Byte* data);
 
+    // Mark [offset, offset + size) as changed and return it for the caller to write in place, rather than copying from
+    // its own staging memory.  The pointer is invalidated by the next resize.
+    Byte* editSubData(Size offset, Size size);
+
     template <typename T>
     Size setSubData(Size index, const T& t) {
         Size offset = index * sizeof(T);
@@ -11,6 +11,8 @@
 #include <limits>
 #include "Context.h"
 
+#include <tbb/task_group.h>
+
 #include <shared/GlobalAppProperties.h>
 
 #include "Frame.h"
@@ -47,16 +49,25 @@ void ContextStats::evalDelta(const ContextStats& begin, const ContextStats& end)
 Context::CreateBackend Context::_createBackendCallback = nullptr;
 std::once_flag Context::_initialized;
 
-Context::Context() {
+// The batches of the current frame being recorded on worker threads
+class Context::FrameRecordings {
+public:
+    tbb::task_group tasks;
+};
+
+Context::Context() :
+    _frameRecordings(std::make_unique<FrameRecordings>()) {
     if (_createBackendCallback) {
         _backend = _createBackendCallback();
     }
 }
 
-Context::Context(const Context& context) {
+Context::Context(const Context& context) :
+    _frameRecordings(std::make_unique<FrameRecordings>()) {
 }
 
 Context::~Context() {
+    _frameRecordings->tasks.wait();
     clearBatches();
     _syncedPrograms.clear();
 }
@@ -92,9 +103,33 @@ void Context::appendFrameBatch(const BatchPointer& batch) {
     _currentFrame->batches.push_back(batch);
 }
 
+void Context::appendFrameBatchAsync(const char* name, const std::function<void(Batch& batch)>& f) {
+    if (!_frameActive) {
+        qWarning() << "Batch executed outside of frame boundaries";
+        return;
+    }
+
+    // Reserve the batch's place in the frame before recording it, so that the order doesn't depend on the workers
+    auto batch = acquireBatch(name);
+    _currentFrame->batches.push_back(batch);
+
+    if (!_parallelBatchRecording) {
+        f(*batch);
+        return;
+    }
+    _frameRecordings->tasks.run([batch, f] {
+        PROFILE_RANGE(render_gpu, batch->getName().c_str());
+        f(*batch);
+    });
+}
+
 FramePointer Context::endFrame() {
     PROFILE_RANGE(render_gpu, __FUNCTION__);
     assert(_frameActive);
+    {
+        PROFILE_RANGE(render_gpu, "waitForFrameBatches");
+        _frameRecordings->tasks.wait();
+    }
     auto result = _currentFrame;
     _currentFrame.reset();
     _frameActive = false;
@@ -434,3 +469,9 @@ void gpu::doInBatch(const char* name,
     f(*batch);
     context->appendFrameBatch(batch);
 }
+
+void gpu::doInBatchAsync(const char* name,
+                         const std::shared_ptr<gpu::Context>& context,
+                         const std::function<void(Batch& batch)>& f) {
+    context->appendFrameBatchAsync(name, f);
+}
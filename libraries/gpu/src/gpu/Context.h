@@ -12,6 +12,8 @@
 #define hifi_gpu_Context_h
 
 #include <assert.h>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <queue>
 
@@ -162,8 +164,18 @@ public:
 
     void beginFrame(const glm::mat4& renderView = glm::mat4(), const glm::mat4& renderPose = glm::mat4());
     void appendFrameBatch(const BatchPointer& batch);
+
+    // Append a batch to the current frame and record it with the lambda on a worker thread.
+    // The batch takes its place in the frame now, so batches execute in the order they were appended
+    // no matter which finishes recording first.  Everything the lambda touches must stay valid and
+    // unmodified until endFrame(), which waits for all the pending recordings.
+    void appendFrameBatchAsync(const char* name, const std::function<void(Batch& batch)>& f);
     FramePointer endFrame();
 
+    // When disabled, appendFrameBatchAsync records on the calling thread
+    void setParallelBatchRecording(bool enabled) { _parallelBatchRecording = enabled; }
+    bool isParallelBatchRecording() const { return _parallelBatchRecording; }
+
     static BatchPointer acquireBatch(const char* name = nullptr);
     static void releaseBatch(Batch* batch);
 
@@ -276,6 +288,9 @@ protected:
     std::shared_ptr<Backend> _backend;
     bool _frameActive{ false };
     FramePointer _currentFrame;
+    std::atomic<bool> _parallelBatchRecording { true };
+    class FrameRecordings;
+    std::unique_ptr<FrameRecordings> _frameRecordings;
     RangeTimerPointer _frameRangeTimer;
     StereoState _stereo;
 
@@ -302,6 +317,9 @@ typedef std::shared_ptr<Context> ContextPointer;
 
 void doInBatch(const char* name, const std::shared_ptr<gpu::Context>& context, const std::function<void(Batch& batch)>& f);
 
+// Same as doInBatch, but the batch may be recorded on a worker thread, see Context::appendFrameBatchAsync
+void doInBatchAsync(const char* name, const std::shared_ptr<gpu::Context>& context, const std::function<void(Batch& batch)>& f);
+
 };  // namespace gpu
 
 #endif
@@ -22,6 +22,7 @@
 
 #include <ktx/KTX.h>
 #include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 #include "GPULogging.h"
 #include "Context.h"
@@ -909,6 +910,46 @@ bool Texture::incremementMinMip(uint16 count) {
     return setMinMip(_minMip + count);
 }
 
+static const uint64_t MIP_DEMAND_WINDOW_USECS = USECS_PER_SECOND;
+
+uint16 Texture::evalMipForScreenSize(float screenSize) const {
+    float largerDim = (float)std::max(_width, _height);
+    if (screenSize >= largerDim) {
+        return 0;
+    }
+    if (screenSize <= 1.0f) {
+        return getMaxMip();
+    }
+    return std::min((uint16)log2f(largerDim / screenSize), getMaxMip());
+}
+
+void Texture::requestMipDemand(uint16 level) {
+    level = std::min(level, getMaxMip());
+    uint64_t now = usecTimestampNow();
+    uint64_t windowStart = _demandWindowStart.load();
+    if (now > windowStart + MIP_DEMAND_WINDOW_USECS) {
+        // Several draws can race to start the window; any of them winning is fine
+        if (_demandWindowStart.compare_exchange_strong(windowStart, now)) {
+            bool wasDrawnRecently = (windowStart != 0) && (now <= windowStart + 2 * MIP_DEMAND_WINDOW_USECS);
+            _previousDemandedMip.store(wasDrawnRecently ? _demandedMip.load() : getMaxMip());
+            _demandedMip.store(level);
+            return;
+        }
+    }
+    uint16 current = _demandedMip.load();
+    while (level < current && !_demandedMip.compare_exchange_weak(current, level)) {
+    }
+}
+
+uint16 Texture::getDemandedMip() const {
+    uint64_t windowStart = _demandWindowStart.load();
+    if (windowStart == 0) {
+        return 0;
+    }
+    // Not being drawn lately doesn't tell how fine the texture will be needed next, so it keeps what it last needed
+    return std::min(_demandedMip.load(), _previousDemandedMip.load());
+}
+
 Vec3u Texture::evalMipDimensions(uint16 level) const { 
     auto dimensions = getDimensions();
     dimensions >>= level; 
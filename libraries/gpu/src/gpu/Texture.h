@@ -514,6 +514,16 @@ public:
     uint16 getMinMip() const { return _minMip; }
     uint16 usedMipLevels() const { return (getNumMips() - _minMip); }
 
+    // Screen-space mip demand, reported by the renderers each time the texture is drawn, so that loaders
+    // and the backend only fetch and keep resident the mips that are actually sampled
+    // The mip whose larger dimension best matches a footprint of screenSize pixels
+    uint16 evalMipForScreenSize(float screenSize) const;
+    // Lowers the demanded mip to level, if it is finer than what was demanded recently
+    void requestMipDemand(uint16 level);
+    // The finest mip demanded recently: 0 if demand was never reported, so textures drawn outside of the
+    // tracked paths keep all their mips, and the last demand if the texture hasn't been drawn for a while
+    uint16 getDemandedMip() const;
+
     // Generate the sub mips automatically for the texture
     // If the storage version is not available (from CPU memory)
     // Only works for the standard formats
@@ -623,6 +633,11 @@ protected:
     uint16 _maxMipLevel { 0 };
 
     uint16 _minMip { 0 };
+
+    // Demand is accumulated over a window and reported as the finest of the current and previous windows
+    std::atomic<uint16> _demandedMip { 0 };
+    std::atomic<uint16> _previousDemandedMip { 0 };
+    std::atomic<uint64_t> _demandWindowStart { 0 };
  
     Type _type { TEX_1D };
 
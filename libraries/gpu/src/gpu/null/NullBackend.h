@@ -27,7 +27,7 @@ class Backend : public gpu::Backend {
     // Context Backend static interface required
     friend class gpu::Context;
     static void init() {}
-    static gpu::Backend* createBackend() { return new Backend(); }
+    static gpu::BackendPointer createBackend() { return gpu::BackendPointer(new Backend()); }
 
 protected:
     explicit Backend(bool syncCache) : Parent() { }
@@ -35,6 +35,11 @@ protected:
 public:
     ~Backend() { }
 
+    const std::string& getVersion() const final {
+        static const std::string NULL_VERSION { "null" };
+        return NULL_VERSION;
+    }
+
     void render(const Batch& batch) final { }
 
     // This call synchronize the Full Backend cache with the current GLState
@@ -48,6 +53,10 @@ public:
     // This is the ugly "download the pixels to sysmem for taking a snapshot"
     // Just avoid using it, it's ugly and will break performances
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) final { }
+
+    void recycle() const final { }
+    bool supportedTextureFormat(const gpu::Element& format) final { return true; }
+    bool isTextureManagementSparseEnabled() const final { return false; }
 };
 
 } }
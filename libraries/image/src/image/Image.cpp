@@ -234,6 +234,13 @@ void Image::invertPixels() {
     _packedData.invertPixels(QImage::InvertRgba);
 }
 
+void Image::reinterpretAsFormat(Format newFormat) {
+    assert(_format != Format_RGBAF && newFormat != Format_RGBAF);
+    if (_packedData.reinterpretAsFormat((QImage::Format)newFormat)) {
+        _format = newFormat;
+    }
+}
+
 Image Image::getSubImage(QRect rect) const {
     assert(_format != Format_RGBAF);
     return _packedData.copy(rect);
@@ -119,6 +119,8 @@ namespace image {
 
         // Inplace transformations
         void invertPixels();
+        // Relabels the pixels as another format of the same depth without touching them
+        void reinterpretAsFormat(Format newFormat);
 
     private:
 
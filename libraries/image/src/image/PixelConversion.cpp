@@ -0,0 +1,120 @@
+//
+//  PixelConversion.cpp
+//  image/src/image
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PixelConversion.h"
+
+#include <array>
+#include <cmath>
+
+using namespace image;
+
+static const float GAMMA = 2.2f;
+static const uint32_t OPAQUE_ALPHA = 0xff000000;
+
+static int getChannelShift(ColorChannel channel) {
+    switch (channel) {
+        case ColorChannel::GREEN:
+            return 8;
+        case ColorChannel::BLUE:
+            return 0;
+        case ColorChannel::ALPHA:
+            return 24;
+        case ColorChannel::RED:
+        default:
+            return 16;
+    }
+}
+
+// pow(i / 255, 2.2) for every 8 bit value
+static const std::array<float, 256>& getGammaToLinearTable() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> result;
+        for (int i = 0; i < 256; i++) {
+            result[i] = std::pow((float)i / 255.0f, GAMMA);
+        }
+        return result;
+    }();
+    return table;
+}
+
+// Entry k is the smallest linear value that encodes to k or more, so encoding is a search instead of a pow
+static const std::array<float, 256>& getLinearToGammaThresholds() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> result;
+        for (int k = 0; k < 256; k++) {
+            result[k] = (float)std::pow((double)k / 255.0, (double)GAMMA);
+        }
+        return result;
+    }();
+    return table;
+}
+
+static inline uint32_t encodeGamma(const std::array<float, 256>& thresholds, float value) {
+    // Branch-free binary search; NaN and negatives fail every comparison and encode to 0
+    uint32_t k = 0;
+    for (uint32_t step = 128; step > 0; step >>= 1) {
+        k += (value >= thresholds[k + step]) ? step : 0;
+    }
+    return k;
+}
+
+static void copyChannelToRed_scalar(const uint32_t* source, uint32_t* dest, size_t count, int shift) {
+    for (size_t i = 0; i < count; i++) {
+        dest[i] = OPAQUE_ALPHA | (((source[i] >> shift) & 0xff) << 16);
+    }
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+void image::copyChannelToRed(const uint32_t* source, uint32_t* dest, size_t count, ColorChannel channel) {
+    const int shift = getChannelShift(channel);
+    const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+    const __m128i byteMask = _mm_set1_epi32(0xff);
+    const __m128i alpha = _mm_set1_epi32((int)OPAQUE_ALPHA);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        pixels = _mm_and_si128(_mm_srl_epi32(pixels, shiftCount), byteMask);
+        pixels = _mm_or_si128(_mm_slli_epi32(pixels, 16), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), pixels);
+    }
+    copyChannelToRed_scalar(source + i, dest + i, count - i, shift);
+}
+
+#else
+
+void image::copyChannelToRed(const uint32_t* source, uint32_t* dest, size_t count, ColorChannel channel) {
+    copyChannelToRed_scalar(source, dest, count, getChannelShift(channel));
+}
+
+#endif
+
+void image::convertGammaToLinear(const uint32_t* source, glm::vec3* dest, size_t count) {
+    const auto& table = getGammaToLinearTable();
+    for (size_t i = 0; i < count; i++) {
+        uint32_t pixel = source[i];
+        dest[i] = glm::vec3(table[(pixel >> 16) & 0xff], table[(pixel >> 8) & 0xff], table[pixel & 0xff]);
+    }
+}
+
+void image::convertLinearToGamma(const glm::vec3* source, uint32_t* dest, size_t count) {
+    const auto& thresholds = getLinearToGammaThresholds();
+    for (size_t i = 0; i < count; i++) {
+        const glm::vec3& color = source[i];
+        dest[i] = OPAQUE_ALPHA | (encodeGamma(thresholds, color.r) << 16) |
+                  (encodeGamma(thresholds, color.g) << 8) | encodeGamma(thresholds, color.b);
+    }
+}
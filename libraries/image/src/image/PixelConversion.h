@@ -0,0 +1,38 @@
+//
+//  PixelConversion.h
+//  image/src/image
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_image_PixelConversion_h
+#define hifi_image_PixelConversion_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <glm/vec3.hpp>
+
+#include "ColorChannel.h"
+
+namespace image {
+
+    // Line converters for ARGB32 pixels (0xAARRGGBB in a uint32), used instead of per-pixel QRgb accessors.
+    // Source and destination may be the same buffer.
+
+    // Moves the given channel into red, with green and blue cleared and alpha opaque
+    void copyChannelToRed(const uint32_t* source, uint32_t* dest, size_t count, ColorChannel channel);
+
+    // Decodes the gamma 2.2 encoded RGB of each pixel to linear [0, 1]
+    void convertGammaToLinear(const uint32_t* source, glm::vec3* dest, size_t count);
+
+    // Encodes linear colors to gamma 2.2, clamped to 1, as opaque pixels.
+    // Matches truncating std::pow(c, 1 / 2.2) * 255 without calling pow.
+    void convertLinearToGamma(const glm::vec3* source, uint32_t* dest, size_t count);
+
+} // namespace image
+
+#endif // hifi_image_PixelConversion_h
@@ -30,6 +30,7 @@
 #endif
 #include "ImageLogging.h"
 #include "CubeMap.h"
+#include "PixelConversion.h"
 
 using namespace gpu;
 
@@ -253,7 +254,38 @@ std::function<glm::vec3(gpu::uint32)> getHDRUnpackingFunction() {
     return getHDRUnpackingFunction(GPU_CUBEMAP_HDR_FORMAT);
 }
 
-Image processRawImageData(QIODevice& content, const std::string& filename) {
+// The size an image has to be scaled to so that it holds no more than maxNumPixels
+static QSize getSizeWithinPixelCount(const QSize& size, int maxNumPixels) {
+    if (maxNumPixels <= 0 || (qint64)size.width() * size.height() <= maxNumPixels) {
+        return size;
+    }
+    float scaleFactor = sqrtf(maxNumPixels / ((float)size.width() * (float)size.height()));
+    return QSize((int)(scaleFactor * (float)size.width() + 0.5f), (int)(scaleFactor * (float)size.height() + 0.5f));
+}
+
+static Image readImage(QImageReader& imageReader, int maxNumPixels) {
+    // Scaling while decoding lets the JPEG decoder skip most of the work for oversized images
+    QSize size = imageReader.size();
+    if (size.isValid()) {
+        QSize scaledSize = getSizeWithinPixelCount(size, maxNumPixels);
+        if (scaledSize != size) {
+            imageReader.setScaledSize(scaledSize);
+            qCDebug(imagelogging).nospace() << "Downscaling while decoding (" << size << " to " << scaledSize << ")";
+        }
+    }
+    return Image(imageReader.read());
+}
+
+// RGB32 pixels are stored as 0xffRRGGBB, which is already ARGB32 with an opaque alpha
+static void convertToARGB32(Image& image) {
+    if (image.getFormat() == Image::Format_RGB32) {
+        image.reinterpretAsFormat(Image::Format_ARGB32);
+    } else if (image.getFormat() != Image::Format_ARGB32) {
+        image = image.getConvertedToFormat(Image::Format_ARGB32);
+    }
+}
+
+Image processRawImageData(QIODevice& content, const std::string& filename, int maxNumPixels) {
     // Help the Image loader by extracting the image file format from the url filename ext.
     // Some tga are not created properly without it.
     auto filenameExtension = filename.substr(filename.find_last_of('.') + 1);
@@ -284,7 +316,7 @@ Image processRawImageData(QIODevice& content, const std::string& filename) {
     QImageReader imageReader(&content, filenameExtension.c_str());
 
     if (imageReader.canRead()) {
-        return Image(imageReader.read());
+        return readImage(imageReader, maxNumPixels);
     } else {
         // Extension could be incorrect, try to detect the format from the content
         QImageReader newImageReader;
@@ -293,7 +325,7 @@ Image processRawImageData(QIODevice& content, const std::string& filename) {
         newImageReader.setDevice(&content);
 
         if (newImageReader.canRead()) {
-            return Image(newImageReader.read());
+            return readImage(newImageReader, maxNumPixels);
         }
     }
 
@@ -302,39 +334,12 @@ Image processRawImageData(QIODevice& content, const std::string& filename) {
 
 void mapToRedChannel(Image& image, ColorChannel sourceChannel) {
     // Change format of image so we know exactly how to process it
-    if (image.getFormat() != Image::Format_ARGB32) {
-        image = image.getConvertedToFormat(Image::Format_ARGB32);
-    }
+    convertToARGB32(image);
 
+    // Dump the color in the red channel, ignore the rest
     for (glm::uint32 i = 0; i < image.getHeight(); i++) {
-        QRgb* pixel = reinterpret_cast<QRgb*>(image.editScanLine(i));
-        // Past end pointer
-        QRgb* lineEnd = pixel + image.getWidth();
-
-        // Transfer channel data from source to target
-        for (; pixel < lineEnd; pixel++) {
-            int colorValue;
-            switch (sourceChannel) {
-            case ColorChannel::RED:
-                colorValue = qRed(*pixel);
-                break;
-            case ColorChannel::GREEN:
-                colorValue = qGreen(*pixel);
-                break;
-            case ColorChannel::BLUE:
-                colorValue = qBlue(*pixel);
-                break;
-            case ColorChannel::ALPHA:
-                colorValue = qAlpha(*pixel);
-                break;
-            default:
-                colorValue = qRed(*pixel);
-                break;
-            }
-
-            // Dump the color in the red channel, ignore the rest
-            *pixel = qRgba(colorValue, 0, 0, 255);
-        }
+        uint32* pixels = reinterpret_cast<uint32*>(image.editScanLine(i));
+        copyChannelToRed(pixels, pixels, image.getWidth(), sourceChannel);
     }
 }
 
@@ -342,7 +347,7 @@ gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::
                                  int maxNumPixels, TextureUsage::Type textureType,
                                  bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
 
-    Image image = processRawImageData(*content.get(), filename);
+    Image image = processRawImageData(*content.get(), filename, maxNumPixels);
     // Texture content can take up a lot of memory. Here we release our ownership of that content
     // in case it can be released.
     content.reset();
@@ -358,16 +363,12 @@ gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::
     }
 
     // Validate the image is less than _maxNumPixels, and downscale if necessary
-    if (imageWidth * imageHeight > maxNumPixels) {
-        float scaleFactor = sqrtf(maxNumPixels / (float)(imageWidth * imageHeight));
-        int originalWidth = imageWidth;
-        int originalHeight = imageHeight;
-        imageWidth = (int)(scaleFactor * (float)imageWidth + 0.5f);
-        imageHeight = (int)(scaleFactor * (float)imageHeight + 0.5f);
-        image = image.getScaled(glm::uvec2(imageWidth, imageHeight), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    // (only images that couldn't be scaled while decoding, such as TGA and EXR, get here oversized)
+    QSize scaledSize = getSizeWithinPixelCount(QSize(imageWidth, imageHeight), maxNumPixels);
+    if (scaledSize != QSize(imageWidth, imageHeight)) {
+        image = image.getScaled(glm::uvec2(scaledSize.width(), scaledSize.height()), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
         qCDebug(imagelogging).nospace() << "Downscaled " << " (" <<
-            QSize(originalWidth, originalHeight) << " to " <<
-            QSize(imageWidth, imageHeight) << ")";
+            QSize(imageWidth, imageHeight) << " to " << scaledSize << ")";
     }
 
     // Re-map to image with single red channel texture if requested
@@ -645,9 +646,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     int mipLevel = baseMipLevel;
 
     if (target != BackendTarget::GLES32) {
-        if (localCopy.getFormat() != Image::Format_ARGB32) {
-            localCopy = localCopy.getConvertedToFormat(Image::Format_ARGB32);
-        }
+        convertToARGB32(localCopy);
 
         const void* data = static_cast<const void*>(localCopy.getBits());
         nvtt::TextureType textureType = nvtt::TextureType_2D;
@@ -896,9 +895,7 @@ gpu::TexturePointer TextureUsage::process2DTextureColorFromImage(Image&& srcImag
     bool validAlpha = image.hasAlphaChannel();
     bool alphaAsMask = false;
 
-    if (image.getFormat() != Image::Format_ARGB32) {
-        image = image.getConvertedToFormat(Image::Format_ARGB32);
-    }
+    convertToARGB32(image);
 
     if (validAlpha) {
         processTextureAlpha(image, validAlpha, alphaAsMask);
@@ -1040,9 +1037,7 @@ gpu::TexturePointer TextureUsage::process2DTextureNormalMapFromImage(Image&& src
     }
 
     // Make sure the normal map source image is ARGB32
-    if (image.getFormat() != Image::Format_ARGB32) {
-        image = image.getConvertedToFormat(Image::Format_ARGB32);
-    }
+    convertToARGB32(image);
 
     gpu::TexturePointer theTexture = nullptr;
     if ((image.getWidth() > 0) && (image.getHeight() > 0)) {
@@ -1075,9 +1070,7 @@ gpu::TexturePointer TextureUsage::process2DTextureGrayscaleFromImage(Image&& src
     PROFILE_RANGE(resource_parse, "process2DTextureGrayscaleFromImage");
     Image image = processSourceImage(std::move(srcImage), false, target);
 
-    if (image.getFormat() != Image::Format_ARGB32) {
-        image = image.getConvertedToFormat(Image::Format_ARGB32);
-    }
+    convertToARGB32(image);
 
     if (isInvertedPixels) {
         // Gloss turned into Rough
@@ -1382,27 +1375,15 @@ Image convertToLDRFormat(Image&& srcImage, Image::Format format) {
 
     Image ldrImage(localCopy.getWidth(), localCopy.getHeight(), format);
     auto unpackFunc = getHDRUnpackingFunction();
+    std::vector<glm::vec3> colors(localCopy.getWidth());
 
     for (glm::uint32 y = 0; y < localCopy.getHeight(); y++) {
-        const QRgb* srcLineIt = reinterpret_cast<const QRgb*>(localCopy.getScanLine(y));
-        const QRgb* srcLineEnd = srcLineIt + localCopy.getWidth();
-        uint32* ldrLineIt = reinterpret_cast<uint32*>(ldrImage.editScanLine(y));
-        glm::vec3 color;
-
-        while (srcLineIt < srcLineEnd) {
-            color = unpackFunc(*srcLineIt);
-            // Apply reverse gamma and clamp
-            color.r = std::pow(color.r, 1.0f / 2.2f);
-            color.g = std::pow(color.g, 1.0f / 2.2f);
-            color.b = std::pow(color.b, 1.0f / 2.2f);
-            color.r = std::min(1.0f, color.r) * 255.0f;
-            color.g = std::min(1.0f, color.g) * 255.0f;
-            color.b = std::min(1.0f, color.b) * 255.0f;
-            *ldrLineIt = qRgb((int)color.r, (int)color.g, (int)color.b);
-
-            ++srcLineIt;
-            ++ldrLineIt;
+        const uint32* srcLine = reinterpret_cast<const uint32*>(localCopy.getScanLine(y));
+        for (glm::uint32 x = 0; x < localCopy.getWidth(); x++) {
+            colors[x] = unpackFunc(srcLine[x]);
         }
+        // Apply reverse gamma and clamp
+        convertLinearToGamma(colors.data(), reinterpret_cast<uint32*>(ldrImage.editScanLine(y)), colors.size());
     }
     return ldrImage;
 }
@@ -1437,29 +1418,19 @@ Image convertToHDRFormat(Image&& srcImage, gpu::Element format) {
             return localCopy;
     }
 
-    localCopy = localCopy.getConvertedToFormat(Image::Format_ARGB32);
+    convertToARGB32(localCopy);
+    std::vector<glm::vec3> colors(localCopy.getWidth());
     for (glm::uint32 y = 0; y < localCopy.getHeight(); y++) {
-        const QRgb* srcLineIt = reinterpret_cast<const QRgb*>( localCopy.getScanLine(y) );
-        const QRgb* srcLineEnd = srcLineIt + localCopy.getWidth();
-        uint32* hdrLineIt = reinterpret_cast<uint32*>( hdrImage.editScanLine(y) );
-        glm::vec3 color;
-
-        while (srcLineIt < srcLineEnd) {
-            color.r = qRed(*srcLineIt);
-            color.g = qGreen(*srcLineIt);
-            color.b = qBlue(*srcLineIt);
-            // Normalize and apply gamma
-            color /= 255.0f;
-            color.r = std::pow(color.r, 2.2f);
-            color.g = std::pow(color.g, 2.2f);
-            color.b = std::pow(color.b, 2.2f);
-            *hdrLineIt = packFunc(color);
+        // Normalize and apply gamma
+        convertGammaToLinear(reinterpret_cast<const uint32*>(localCopy.getScanLine(y)), colors.data(), colors.size());
+        uint32* hdrLine = reinterpret_cast<uint32*>(hdrImage.editScanLine(y));
+
+        for (glm::uint32 x = 0; x < localCopy.getWidth(); x++) {
+            hdrLine[x] = packFunc(colors[x]);
 #ifdef DEBUG_COLOR_PACKING
-            glm::vec3 ucolor = unpackFunc(*hdrLineIt);
-            assert(glm::distance(color, ucolor) <= 5e-2);
+            glm::vec3 ucolor = unpackFunc(hdrLine[x]);
+            assert(glm::distance(colors[x], ucolor) <= 5e-2);
 #endif
-            ++srcLineIt;
-            ++hdrLineIt;
         }
     }
     return hdrImage;
@@ -121,6 +121,10 @@ gpu::TexturePointer processCubeTextureColorFromImage(Image&& srcImage, const std
 
 const QStringList getSupportedFormats();
 
+// Decodes an image file, scaling it while decoding when it holds more than maxNumPixels (if positive)
+Image processRawImageData(QIODevice& content, const std::string& filename, int maxNumPixels = 0);
+void mapToRedChannel(Image& image, ColorChannel sourceChannel);
+
 gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::string& url, ColorChannel sourceChannel,
                                  int maxNumPixels, TextureUsage::Type textureType,
                                  bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false);
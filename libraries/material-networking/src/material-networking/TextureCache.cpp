@@ -105,11 +105,49 @@ TextureCache::TextureCache() {
 #endif
     setUnusedResourceCacheSize(0);
     setObjectName("TextureCache");
+
+    static const int MIP_DEMAND_CHECK_INTERVAL_MSECS = 250;
+    connect(&_mipDemandTimer, &QTimer::timeout, this, &TextureCache::checkMipDemand);
+    _mipDemandTimer.start(MIP_DEMAND_CHECK_INTERVAL_MSECS);
 }
 
 TextureCache::~TextureCache() {
 }
 
+void TextureCache::watchMipDemand(const QWeakPointer<Resource>& resource, const gpu::TexturePointer& texture) {
+    _mipDemandTextures.emplace_back(resource, texture);
+}
+
+void TextureCache::checkMipDemand() {
+    size_t bytesLoaded = 0;
+    size_t bytesSampled = 0;
+    for (auto it = _mipDemandTextures.begin(); it != _mipDemandTextures.end();) {
+        auto resource = it->first.lock();
+        auto texture = it->second.lock();
+        if (!resource || !texture) {
+            it = _mipDemandTextures.erase(it);
+            continue;
+        }
+        ++it;
+
+        uint16_t minAvailableMip = texture->minAvailableMipLevel();
+        uint16_t demandedMip = texture->getDemandedMip();
+        for (uint16_t level = minAvailableMip; level <= texture->getMaxMip(); level++) {
+            auto size = texture->getStoredMipSize(level);
+            bytesLoaded += size;
+            if (level >= demandedMip) {
+                bytesSampled += size;
+            }
+        }
+
+        if (demandedMip < minAvailableMip) {
+            QMetaObject::invokeMethod(resource.data(), "startRequestForNextMipLevel");
+        }
+    }
+    _ktxBytesLoaded.store(bytesLoaded);
+    _ktxBytesSampled.store(bytesSampled);
+}
+
 // use fixed table of permutations. Could also make ordered list programmatically
 // and then shuffle algorithm. For testing, this ensures consistent behavior in each run.
 // this list taken from Ken Perlin's Improved Noise reference implementation (orig. in Java) at
@@ -364,6 +402,14 @@ QSharedPointer<Resource> TextureCache::createResourceCopy(const QSharedPointer<R
     return QSharedPointer<Resource>(new NetworkTexture(*resource.staticCast<NetworkTexture>()), &Resource::deleter);
 }
 
+gpu::TexturePointer Texture::getGPUTexture() const {
+    auto texture = _textureSource->getGPUTexture();
+    if (texture) {
+        texture->requestMipDemand(0);
+    }
+    return texture;
+}
+
 int networkTexturePointerMetaTypeId = qRegisterMetaType<QWeakPointer<NetworkTexture>>();
 
 NetworkTexture::NetworkTexture(const QUrl& url, bool resourceTexture) :
@@ -686,12 +732,20 @@ void NetworkTexture::startRequestForNextMipLevel() {
         return;
     }
 
+    if (_mipDemandTexture.lock() != texture) {
+        _mipDemandTexture = texture;
+        DependencyManager::get<TextureCache>()->watchMipDemand(_self, texture);
+    }
+
+    // Only go down to the mip the texture is drawn at; TextureCache calls back in if it gets larger on screen
     _lowestKnownPopulatedMip = texture->minAvailableMipLevel();
-    if (_lowestRequestedMipLevel < _lowestKnownPopulatedMip) {
+    uint16_t targetMipLevel = std::max(_lowestRequestedMipLevel, texture->getDemandedMip());
+    if (targetMipLevel < _lowestKnownPopulatedMip) {
         _ktxResourceState = PENDING_MIP_REQUEST;
 
         init(false);
-        float priority = -(float)_originalKtxDescriptor->header.numberOfMipmapLevels + (float)_lowestKnownPopulatedMip;
+        // The further a texture is from the resolution it is drawn at, the sooner it gets its next mip
+        float priority = -(float)_originalKtxDescriptor->header.numberOfMipmapLevels + (float)(_lowestKnownPopulatedMip - targetMipLevel);
         setLoadPriority(this, priority);
         _url.setFragment(QString::number(_lowestKnownPopulatedMip - 1));
         TextureCache::attemptRequest(self);
@@ -16,6 +16,7 @@
 
 #include <QImage>
 #include <QMap>
+#include <QTimer>
 #include <QColor>
 #include <QMetaEnum>
 
@@ -37,7 +38,8 @@ class Batch;
 /// A simple object wrapper for an OpenGL texture.
 class Texture {
 public:
-    gpu::TexturePointer getGPUTexture() const { return _textureSource->getGPUTexture(); }
+    // Callers draw the texture outside of the material paths that report mip demand, so this claims every mip
+    gpu::TexturePointer getGPUTexture() const;
     gpu::TextureSourcePointer _textureSource;
 };
 
@@ -119,6 +121,9 @@ private:
 
     KTXResourceState _ktxResourceState { PENDING_INITIAL_LOAD };
 
+    // The GPU texture TextureCache is watching the mip demand of on our behalf
+    std::weak_ptr<gpu::Texture> _mipDemandTexture;
+
     // The current mips that are currently being requested w/ _ktxMipRequest
     std::pair<uint16_t, uint16_t> _ktxMipLevelRangeInFlight{ NULL_MIP_LEVEL, NULL_MIP_LEVEL };
 
@@ -195,6 +200,11 @@ public:
     static const int DEFAULT_SPECTATOR_CAM_WIDTH { 2048 };
     static const int DEFAULT_SPECTATOR_CAM_HEIGHT { 1024 };
 
+    /// Bytes of KTX mips loaded for the network textures in use, and how many of those are at or below the mip
+    /// each texture is drawn at; the difference is what was fetched but is never sampled
+    size_t getKTXBytesLoaded() const { return _ktxBytesLoaded.load(); }
+    size_t getKTXBytesSampled() const { return _ktxBytesSampled.load(); }
+
     void setGPUContext(const gpu::ContextPointer& context) { _gpuContext = context; }
     gpu::ContextPointer getGPUContext() const { return _gpuContext; }
 
@@ -218,6 +228,11 @@ private:
     TextureCache();
     virtual ~TextureCache();
 
+    // Network KTX textures stop fetching mips once they reach the resolution they are drawn at; these are checked
+    // periodically so they resume when they get larger on screen
+    void watchMipDemand(const QWeakPointer<Resource>& resource, const gpu::TexturePointer& texture);
+    void checkMipDemand();
+
     static const std::string KTX_DIRNAME;
     static const std::string KTX_EXT;
 
@@ -229,6 +244,11 @@ private:
     std::unordered_map<std::string, std::weak_ptr<gpu::Texture>> _texturesByHashes;
     std::mutex _texturesByHashesMutex;
 
+    std::vector<std::pair<QWeakPointer<Resource>, std::weak_ptr<gpu::Texture>>> _mipDemandTextures;
+    QTimer _mipDemandTimer;
+    std::atomic<size_t> _ktxBytesLoaded { 0 };
+    std::atomic<size_t> _ktxBytesSampled { 0 };
+
     gpu::TexturePointer _permutationNormalTexture;
     gpu::TexturePointer _whiteTexture;
     gpu::TexturePointer _grayTexture;
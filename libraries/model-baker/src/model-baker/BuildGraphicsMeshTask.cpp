@@ -380,20 +380,20 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
 
     auto& graphicsMeshes = output;
 
-    int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
+    graphicsMeshes.resize(meshes.size());
+    baker::parallelForEachMesh(meshes.size(), [&](size_t i) {
         auto& graphicsMesh = graphicsMeshes[i];
-        
+        int meshIndex = (int)i;
+
         // Try to create the graphics::Mesh
         buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
 
         // Choose a name for the mesh
         if (graphicsMesh) {
             graphicsMesh->displayName = url.toString().toStdString() + "#/mesh/" + std::to_string(i);
-            if (meshIndicesToModelNames.find(i) != meshIndicesToModelNames.cend()) {
-                graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
+            if (meshIndicesToModelNames.find(meshIndex) != meshIndicesToModelNames.cend()) {
+                graphicsMesh->modelName = meshIndicesToModelNames[meshIndex].toStdString();
             }
         }
-    }
+    });
 }
@@ -18,12 +18,11 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
     const auto& meshes = input.get1();
     auto& normalsPerBlendshapePerMeshOut = output;
 
-    normalsPerBlendshapePerMeshOut.reserve(blendshapesPerMesh.size());
-    for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
+    normalsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
+    baker::parallelForEachMesh(blendshapesPerMesh.size(), [&](size_t i) {
         const auto& mesh = meshes[i];
         const auto& blendshapes = blendshapesPerMesh[i];
-        normalsPerBlendshapePerMeshOut.emplace_back();
-        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[normalsPerBlendshapePerMeshOut.size()-1];
+        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[i];
 
         normalsPerBlendshapeOut.reserve(blendshapes.size());
         for (size_t j = 0; j < blendshapes.size(); j++) {
@@ -66,5 +65,5 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
                     });
             }
         }
-    }
+    });
 }
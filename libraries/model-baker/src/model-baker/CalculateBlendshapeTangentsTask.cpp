@@ -21,13 +21,12 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
     const auto& meshes = input.get2();
     auto& tangentsPerBlendshapePerMeshOut = output;
     
-    tangentsPerBlendshapePerMeshOut.reserve(normalsPerBlendshapePerMesh.size());
-    for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
+    tangentsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
+    baker::parallelForEachMesh(blendshapesPerMesh.size(), [&](size_t i) {
         const auto& normalsPerBlendshape = baker::safeGet(normalsPerBlendshapePerMesh, i);
         const auto& blendshapes = blendshapesPerMesh[i];
         const auto& mesh = meshes[i];
-        tangentsPerBlendshapePerMeshOut.emplace_back();
-        auto& tangentsPerBlendshapeOut = tangentsPerBlendshapePerMeshOut[tangentsPerBlendshapePerMeshOut.size()-1];
+        auto& tangentsPerBlendshapeOut = tangentsPerBlendshapePerMeshOut[i];
 
         for (size_t j = 0; j < blendshapes.size(); j++) {
             const auto& blendshape = blendshapes[j];
@@ -80,5 +79,5 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
                 }
             });
         }
-    }
+    });
 }
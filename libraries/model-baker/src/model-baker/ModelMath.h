@@ -10,6 +10,7 @@
 //
 
 #include <hfm/HFM.h>
+#include <TBBHelpers.h>
 
 #include "BakerTypes.h"
 
@@ -36,6 +37,17 @@ namespace baker {
         }
     }
 
+    // Calls function(i) for each mesh index in [0, numMeshes) across the TBB worker pool.
+    // Callers size their outputs beforehand and only write to slot i from function(i).
+    template<typename F>
+    void parallelForEachMesh(size_t numMeshes, const F& function) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numMeshes, 1), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); i++) {
+                function(i);
+            }
+        });
+    }
+
     // Returns a reference to the normal at the specified index, or nullptr if it cannot be accessed
     using NormalAccessor = std::function<glm::vec3*(int index)>;
 
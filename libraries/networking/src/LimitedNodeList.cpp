@@ -11,6 +11,7 @@
 
 #include "LimitedNodeList.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
@@ -127,6 +128,14 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     }
 }
 
+LimitedNodeList::~LimitedNodeList() {
+    // nothing can be reading the node list anymore
+    delete _nodeSnapshot.load();
+    for (const auto& retired : _retiredNodeSnapshots) {
+        delete retired.first;
+    }
+}
+
 QUuid LimitedNodeList::getSessionUUID() const {
     QReadLocker lock { &_sessionUUIDLock };
     return _sessionUUID;
@@ -577,14 +586,14 @@ NodeData* LimitedNodeList::getOrCreateLinkedData(SharedNodePointer node) {
 }
 
 SharedNodePointer LimitedNodeList::nodeWithUUID(const QUuid& nodeUUID) {
-    QReadLocker readLocker(&_nodeMutex);
+    NodeReadLocker readLocker(this);
 
     NodeHash::const_iterator it = _nodeHash.find(nodeUUID);
     return it == _nodeHash.cend() ? SharedNodePointer() : it->second;
  }
 
 SharedNodePointer LimitedNodeList::nodeWithLocalID(Node::LocalID localID) const {
-    QReadLocker readLocker(&_nodeMutex);
+    NodeReadLocker readLocker(this);
 
     LocalIDMapping::const_iterator idIter = _localIDMap.find(localID);
     return idIter == _localIDMap.cend() ? nullptr : idIter->second;
@@ -596,7 +605,7 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
     {
         // iterate the current nodes - grab them so we can emit that they are dying
         // and then remove them from the hash
-        QWriteLocker writeLocker(&_nodeMutex);
+        NodeWriteLocker writeLocker(this);
 
         if (_nodeHash.size() > 0) {
             qCDebug(networking) << "LimitedNodeList::eraseAllNodes() removing all nodes from NodeList:" << reason;
@@ -609,6 +618,7 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
         _localIDMap.clear();
         _nodeHash.clear();
     }
+    publishNodeSnapshot();
 
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         handleNodeKill(killedNode);
@@ -630,10 +640,11 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID, ConnectionID newCo
 
     if (matchingNode) {
         {
-            QWriteLocker writeLocker(&_nodeMutex);
-            _localIDMap.unsafe_erase(matchingNode->getLocalID());
+            NodeWriteLocker writeLocker(this);
+            unsafeEraseLocalID(*matchingNode);
             _nodeHash.unsafe_erase(matchingNode->getUUID());
         }
+        publishNodeSnapshot();
 
         handleNodeKill(matchingNode, newConnectionID);
         return true;
@@ -690,10 +701,11 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
     auto removeOldNode = [&](auto node) {
         if (node) {
             {
-                QWriteLocker writeLocker(&_nodeMutex);
-                _localIDMap.unsafe_erase(node->getLocalID());
+                NodeWriteLocker writeLocker(this);
+                unsafeEraseLocalID(*node);
                 _nodeHash.unsafe_erase(node->getUUID());
             }
+            publishNodeSnapshot();
             handleNodeKill(node);
         }
     };
@@ -702,12 +714,15 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
     if (SOLO_NODE_TYPES.count(nodeType)) {
         removeOldNode(soloNodeOfType(nodeType));
     }
-    // If there is a new node with the same socket, this is a reconnection, kill the old node
-    removeOldNode(findNodeWithAddr(publicSocket));
-    removeOldNode(findNodeWithAddr(localSocket));
-    // If there is an old Connection to the new node's address kill it
-    _nodeSocket.cleanupConnection(publicSocket);
-    _nodeSocket.cleanupConnection(localSocket);
+    // Replicated nodes share the socket of the node that relays them, so their sockets say nothing about reconnection
+    if (!isReplicated) {
+        // If there is a new node with the same socket, this is a reconnection, kill the old node
+        removeOldNode(findNodeWithAddr(publicSocket));
+        removeOldNode(findNodeWithAddr(localSocket));
+        // If there is an old Connection to the new node's address kill it
+        _nodeSocket.cleanupConnection(publicSocket);
+        _nodeSocket.cleanupConnection(localSocket);
+    }
 
     auto it = _connectionIDs.find(uuid);
     if (it == _connectionIDs.end()) {
@@ -733,11 +748,15 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
 
 
     {
-        QReadLocker readLocker(&_nodeMutex);
+        NodeReadLocker readLocker(this);
         // insert the new node and release our read lock
         _nodeHash.insert({ newNode->getUUID(), newNodePointer });
-        _localIDMap.insert({ localID, newNodePointer });
+        // replicated nodes never source their own packets, so they stay out of the local ID lookup
+        if (!isReplicated) {
+            _localIDMap.insert({ localID, newNodePointer });
+        }
     }
+    publishNodeSnapshot();
 
     qCDebug(networking) << "Added" << *newNode;
 
@@ -901,7 +920,7 @@ void LimitedNodeList::removeSilentNodes() {
         if (!node->isForcedNeverSilent()
             && (usecTimestampNow() - node->getLastHeardMicrostamp()) > (NODE_SILENCE_THRESHOLD_MSECS * USECS_PER_MSEC)) {
             // call the NodeHash erase to get rid of this node
-            _localIDMap.unsafe_erase(node->getLocalID());
+            unsafeEraseLocalID(*node);
             it = _nodeHash.unsafe_erase(it);
 
             killedNodes.insert(node);
@@ -913,6 +932,13 @@ void LimitedNodeList::removeSilentNodes() {
         node->getMutex().unlock();
     });
 
+    if (!killedNodes.isEmpty()) {
+        publishNodeSnapshot();
+    } else {
+        // free the snapshots that readers were still iterating when they were replaced
+        reclaimNodeSnapshots();
+    }
+
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         auto now = usecTimestampNow();
         qCDebug(networking_ice) << "Removing silent node" << *killedNode << "\n"
@@ -1284,24 +1310,89 @@ void LimitedNodeList::sendPeerQueryToIceServer(const HifiSockAddr& iceServerSock
     sendPacketToIceServer(PacketType::ICEServerQuery, iceServerSockAddr, clientID, peerID);
 }
 
+void LimitedNodeList::unsafeEraseLocalID(const Node& node) {
+    // only drop the mapping if it is this node's, a replicated node may share the local ID of a real one
+    auto it = _localIDMap.find(node.getLocalID());
+    if (it != _localIDMap.end() && it->second.data() == &node) {
+        _localIDMap.unsafe_erase(it);
+    }
+}
+
 SharedNodePointer LimitedNodeList::findNodeWithAddr(const HifiSockAddr& addr) {
-    QReadLocker locker(&_nodeMutex);
-    auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&addr](const UUIDNodePair& pair) {
-        return pair.second->getPublicSocket() == addr
-            || pair.second->getLocalSocket() == addr
-            || pair.second->getSymmetricSocket() == addr;
+    return nodeMatchingPredicate([&addr](const SharedNodePointer& node) {
+        return node->getPublicSocket() == addr
+            || node->getLocalSocket() == addr
+            || node->getSymmetricSocket() == addr;
     });
-    return (it != std::end(_nodeHash)) ? it->second : SharedNodePointer();
 }
 
 bool LimitedNodeList::sockAddrBelongsToNode(const HifiSockAddr& sockAddr) {
-    QReadLocker locker(&_nodeMutex);
-    auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&sockAddr](const UUIDNodePair& pair) {
-        return pair.second->getPublicSocket() == sockAddr
-            || pair.second->getLocalSocket() == sockAddr
-            || pair.second->getSymmetricSocket() == sockAddr;
+    return !findNodeWithAddr(sockAddr).isNull();
+}
+
+void LimitedNodeList::publishNodeSnapshot() {
+    std::vector<const NodeSnapshot*> reclaimed;
+    {
+        // serialize the rebuilds so that the last one published always reflects every change made before it started
+        std::lock_guard<std::mutex> publishLock(_nodeSnapshotPublishMutex);
+
+        auto snapshot = new NodeSnapshot();
+        {
+            NodeReadLocker readLocker(this);
+            snapshot->reserve(_nodeHash.size());
+            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(*snapshot), [](const NodeHash::value_type& it) {
+                return it.second;
+            });
+        }
+
+        // readers may still be iterating the previous snapshot, it is freed once every reader that could have loaded it is done
+        auto previous = _nodeSnapshot.exchange(snapshot, std::memory_order_seq_cst);
+        _retiredNodeSnapshots.emplace_back(previous, ReadEpochs::retire());
+        _nodeSnapshotsPublished++;
+
+        reclaimed = unsafeTakeReclaimableNodeSnapshots();
+    }
+
+    // outside the lock, this can release the last reference to a killed node
+    for (auto snapshot : reclaimed) {
+        delete snapshot;
+    }
+}
+
+void LimitedNodeList::reclaimNodeSnapshots() {
+    std::vector<const NodeSnapshot*> reclaimed;
+    {
+        std::lock_guard<std::mutex> publishLock(_nodeSnapshotPublishMutex);
+        reclaimed = unsafeTakeReclaimableNodeSnapshots();
+    }
+    for (auto snapshot : reclaimed) {
+        delete snapshot;
+    }
+}
+
+std::vector<const NodeSnapshot*> LimitedNodeList::unsafeTakeReclaimableNodeSnapshots() {
+    std::vector<const NodeSnapshot*> reclaimable;
+    auto it = std::remove_if(_retiredNodeSnapshots.begin(), _retiredNodeSnapshots.end(),
+                             [&](const std::pair<const NodeSnapshot*, uint64_t>& retired) {
+        if (ReadEpochs::canReclaim(retired.second)) {
+            reclaimable.push_back(retired.first);
+            return true;
+        }
+        return false;
     });
-    return it != std::end(_nodeHash);
+    _retiredNodeSnapshots.erase(it, _retiredNodeSnapshots.end());
+    return reclaimable;
+}
+
+LimitedNodeList::NodeAccessStats LimitedNodeList::sampleNodeAccessStats() {
+    NodeAccessStats stats;
+    // summed over the readers' own counters, so the iterations themselves never share a counter
+    uint64_t snapshotReads = ReadEpochs::getNumReads();
+    stats.snapshotReads = snapshotReads - _lastNodeSnapshotReads.exchange(snapshotReads);
+    stats.snapshotsPublished = _nodeSnapshotsPublished.exchange(0);
+    stats.lockAcquisitions = _nodeMutexAcquisitions.exchange(0);
+    stats.lockContentions = _nodeMutexContentions.exchange(0);
+    return stats;
 }
 
 void LimitedNodeList::sendPacketToIceServer(PacketType packetType, const HifiSockAddr& iceServerSockAddr,
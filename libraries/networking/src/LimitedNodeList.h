@@ -14,8 +14,10 @@
 
 #include <assert.h>
 #include <stdint.h>
+#include <atomic>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -34,6 +36,7 @@
 #include <TBBHelpers.h>
 
 #include <DependencyManager.h>
+#include <ReadEpochs.h>
 #include <SharedUtil.h>
 
 #include "DomainHandler.h"
@@ -72,6 +75,7 @@ const ConnectionID INITIAL_CONNECTION_ID { 0 };
 
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
 typedef tbb::concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
+typedef std::vector<SharedNodePointer> NodeSnapshot;
 
 typedef quint8 PingType_t;
 namespace PingType {
@@ -85,6 +89,7 @@ class LimitedNodeList : public QObject, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
 public:
+    ~LimitedNodeList();
 
     enum ConnectionStep {
         LookupAddress = 1,
@@ -166,7 +171,7 @@ public:
 
     std::function<void(Node*)> linkedDataCreateCallback;
 
-    size_t size() const { QReadLocker readLock(&_nodeMutex); return _nodeHash.size(); }
+    size_t size() const { NodeSnapshotReader nodes(this); return nodes->size(); }
 
     SharedNodePointer nodeWithUUID(const QUuid& nodeUUID);
     SharedNodePointer nodeWithLocalID(Node::LocalID localID) const;
@@ -205,73 +210,77 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
-    // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    // Pins the immutable copy of the current nodes, republished whenever a node is added or removed,
+    // for as long as it is in scope.  It can be iterated from any thread without taking _nodeMutex;
+    // the node list may change meanwhile.  Entering and leaving only touch the calling thread's
+    // epoch slot, so readers don't contend with each other or with a publish.
+    class NodeSnapshotReader {
+    public:
+        NodeSnapshotReader(const LimitedNodeList* nodeList) :
+            _nodes(nodeList->_nodeSnapshot.load(std::memory_order_seq_cst)) {}
+
+        const NodeSnapshot& operator*() const { return *_nodes; }
+        const NodeSnapshot* operator->() const { return _nodes; }
+
+    private:
+        // entered before _nodes is loaded
+        ReadEpochs::ReadGuard _guard;
+        const NodeSnapshot* _nodes;
+    };
+
+    // Cede control of iteration over a single snapshot (e.g. for use by thread pools)
+    // Use this for nested loops instead of taking a snapshot per loop
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor,
                     int* lockWaitOut = nullptr,
                     int* nodeTransformOut = nullptr,
                     int* functorOut = nullptr) {
-        quint64 start, endTransform, endFunctor;
+        quint64 start, endSnapshot, endFunctor;
 
         start = usecTimestampNow();
-        std::vector<SharedNodePointer> nodes;
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
-
-            // Size of _nodeHash could change at any time,
-            // so reserve enough memory for the current size
-            // and then back insert all the nodes found
-            nodes.reserve(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(nodes), [&](const NodeHash::value_type& it) {
-                return it.second;
-            });
-
-            endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
+        NodeSnapshotReader nodes(this);
+        endSnapshot = usecTimestampNow();
+        if (lockWaitOut) {
+            *lockWaitOut = (endSnapshot - start);
+        }
+        if (nodeTransformOut) {
+            // the snapshot is shared, there is no per-call copy of the nodes anymore
+            *nodeTransformOut = 0;
         }
 
-        functor(nodes.cbegin(), nodes.cend());
+        functor(nodes->cbegin(), nodes->cend());
         endFunctor = usecTimestampNow();
         if (functorOut) {
-            *functorOut = (endFunctor - endTransform);
+            *functorOut = (endFunctor - endSnapshot);
         }
     }
 
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeSnapshotReader nodes(this);
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const auto& node : *nodes) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeSnapshotReader nodes(this);
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const auto& node : *nodes) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeSnapshotReader nodes(this);
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const auto& node : *nodes) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -279,27 +288,36 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeSnapshotReader nodes(this);
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const auto& node : *nodes) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
         return SharedNodePointer();
     }
 
-    // This is unsafe because it does not take a lock
-    // Must only be called when you know that a read lock on the node mutex is held
-    // and will be held for the duration of your iteration
+    // For the inner loops of code that is already iterating through nestedEach
     template<typename NodeLambda>
     void unsafeEachNode(NodeLambda functor) {
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        NodeSnapshotReader nodes(this);
+
+        for (const auto& node : *nodes) {
+            functor(node);
         }
     }
 
+    // counts since the last sample, for the assignment stats
+    struct NodeAccessStats {
+        uint64_t snapshotReads { 0 };
+        uint64_t snapshotsPublished { 0 };
+        uint64_t lockAcquisitions { 0 };
+        uint64_t lockContentions { 0 };
+    };
+    NodeAccessStats sampleNodeAccessStats();
+
     void putLocalPortIntoSharedMemory(const QString key, QObject* parent, quint16 localPort);
     bool getLocalServerPortFromSharedMemory(const QString key, quint16& localPort);
 
@@ -436,8 +454,55 @@ protected:
     void removeDelayedAdd(QUuid nodeUUID);
     bool isDelayedNode(QUuid nodeUUID);
 
+    // QReadLocker/QWriteLocker equivalents for _nodeMutex that count the acquisitions that had to wait
+    class NodeReadLocker {
+    public:
+        NodeReadLocker(const LimitedNodeList* nodeList) : _nodeList(nodeList) {
+            if (!_nodeList->_nodeMutex.tryLockForRead()) {
+                _nodeList->_nodeMutexContentions++;
+                _nodeList->_nodeMutex.lockForRead();
+            }
+            _nodeList->_nodeMutexAcquisitions++;
+        }
+        ~NodeReadLocker() { _nodeList->_nodeMutex.unlock(); }
+    private:
+        const LimitedNodeList* _nodeList;
+    };
+
+    class NodeWriteLocker {
+    public:
+        NodeWriteLocker(const LimitedNodeList* nodeList) : _nodeList(nodeList) {
+            if (!_nodeList->_nodeMutex.tryLockForWrite()) {
+                _nodeList->_nodeMutexContentions++;
+                _nodeList->_nodeMutex.lockForWrite();
+            }
+            _nodeList->_nodeMutexAcquisitions++;
+        }
+        ~NodeWriteLocker() { _nodeList->_nodeMutex.unlock(); }
+    private:
+        const LimitedNodeList* _nodeList;
+    };
+
+    // rebuilds _nodeSnapshot from _nodeHash, must be called without holding _nodeMutex
+    // after every change to _nodeHash
+    void publishNodeSnapshot();
+    // frees the retired snapshots that no reader can still be iterating
+    void reclaimNodeSnapshots();
+    // removes them from _retiredNodeSnapshots, the caller holds _nodeSnapshotPublishMutex
+    std::vector<const NodeSnapshot*> unsafeTakeReclaimableNodeSnapshots();
+
+    void unsafeEraseLocalID(const Node& node); // caller holds the node write lock
+
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex { QReadWriteLock::Recursive };
+    std::atomic<const NodeSnapshot*> _nodeSnapshot { new NodeSnapshot() };
+    // the snapshots replaced by a publish, with the epoch they were retired in
+    std::vector<std::pair<const NodeSnapshot*, uint64_t>> _retiredNodeSnapshots;
+    std::mutex _nodeSnapshotPublishMutex;
+    std::atomic<uint64_t> _lastNodeSnapshotReads { 0 };
+    std::atomic<uint64_t> _nodeSnapshotsPublished { 0 };
+    mutable std::atomic<uint64_t> _nodeMutexAcquisitions { 0 };
+    mutable std::atomic<uint64_t> _nodeMutexContentions { 0 };
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket { nullptr };
     HifiSockAddr _localSockAddr;
@@ -463,7 +528,7 @@ protected:
 
     template<typename IteratorLambda>
     void eachNodeHashIterator(IteratorLambda functor) {
-        QWriteLocker writeLock(&_nodeMutex);
+        NodeWriteLocker writeLock(this);
         NodeHash::iterator it = _nodeHash.begin();
 
         while (it != _nodeHash.end()) {
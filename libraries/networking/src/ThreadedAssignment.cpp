@@ -121,6 +121,17 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
 
     statsObject["io_stats"] = ioStats;
 
+    // how the node list was accessed since the last stats packet - iterations run over the shared
+    // snapshot without locking, only node lookups and node list changes still take the node mutex
+    auto nodeAccessStats = nodeList->sampleNodeAccessStats();
+    QJsonObject nodeListStats;
+    nodeListStats["snapshot_iterations"] = (qint64)nodeAccessStats.snapshotReads;
+    nodeListStats["snapshots_published"] = (qint64)nodeAccessStats.snapshotsPublished;
+    nodeListStats["lock_acquisitions"] = (qint64)nodeAccessStats.lockAcquisitions;
+    nodeListStats["lock_contentions"] = (qint64)nodeAccessStats.lockContentions;
+
+    statsObject["node_list_stats"] = nodeListStats;
+
     QJsonObject assignmentStats;
     assignmentStats["numQueuedCheckIns"] = _numQueuedCheckIns;
 
@@ -41,6 +41,8 @@ PacketVersion versionForPacketType(PacketType packetType) {
             return static_cast<PacketVersion>(AvatarMixerPacketVersion::ARKitBlendshapes);
         case PacketType::BulkAvatarData:
         case PacketType::KillAvatar:
+        case PacketType::BotAvatarData:
+        case PacketType::BotKillAvatar:
             return static_cast<PacketVersion>(AvatarMixerPacketVersion::ARKitBlendshapes);
         case PacketType::MessagesData:
             return static_cast<PacketVersion>(MessageDataVersion::TextOrBinaryData);
@@ -135,6 +135,8 @@ public:
         AudioSoloRequest,
         BulkAvatarTraitsAck,
         StopInjector,
+        BotAvatarData,
+        BotKillAvatar,
         NUM_PACKET_TYPE
     };
 
@@ -16,6 +16,14 @@ class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // optional tuning, for encoders that can adapt to the connection they are sending over
+    virtual bool isTunable() const { return false; }
+    virtual int getBitrate() const { return 0; }
+    virtual void setBitrate(int bitrate) { }
+    virtual void setComplexity(int complexity) { }
+    virtual void setInbandFEC(int inBandFEC) { }
+    virtual void setExpectedPacketLossPercentage(int percentage) { }
 };
 
 class Decoder {
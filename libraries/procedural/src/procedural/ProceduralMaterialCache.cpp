@@ -830,8 +830,9 @@ bool NetworkMaterial::isMissingTexture() {
             continue;
         }
         // Failed texture downloads need to be considered as 'loaded'
-        // or the object will never fade in
-        bool finished = texture->isFailed() || (texture->isLoaded() && texture->getGPUTexture() && texture->getGPUTexture()->isDefined());
+        // or the object will never fade in.  Goes through the source so that checking doesn't claim every mip
+        auto gpuTexture = texture->_textureSource ? texture->_textureSource->getGPUTexture() : gpu::TexturePointer();
+        bool finished = texture->isFailed() || (texture->isLoaded() && gpuTexture && gpuTexture->isDefined());
         if (!finished) {
             return true;
         }
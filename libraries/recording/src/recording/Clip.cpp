@@ -13,6 +13,8 @@
 
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
+#include "impl/ClipIndex.h"
+#include "impl/IndexedFileClip.h"
 
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -22,6 +24,12 @@
 using namespace recording;
 
 Clip::Pointer Clip::fromFile(const QString& filePath) {
+    // Clips with a footer index open without walking their frames
+    auto indexedResult = std::make_shared<IndexedFileClip>(filePath);
+    if (indexedResult->frameCount() != 0) {
+        return indexedResult;
+    }
+
     auto result = std::make_shared<FileClip>(filePath);
     if (result->frameCount() == 0) {
         return Clip::Pointer();
@@ -54,8 +62,13 @@ float Clip::position() const {
     return Frame::frameTimeToSeconds(positionFrameTime());
 }
 
+FrameType Clip::peekFrameType() const {
+    auto frame = peekFrame();
+    return frame ? frame->type : Frame::TYPE_INVALID;
+}
+
 // FIXME move to frame?
-bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
+bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true, FrameSize* writtenDataSize = nullptr) {
     if (frame.type == Frame::TYPE_INVALID) {
         qWarning() << "Attempting to write invalid frame";
         return true;
@@ -80,6 +93,9 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
     if (written != sizeof(uint16_t)) {
         return false;
     }
+    if (writtenDataSize) {
+        *writtenDataSize = dataSize;
+    }
 
     if (dataSize != 0) {
         written = output.write(frameData);
@@ -106,14 +122,29 @@ bool Clip::write(QIODevice& output) {
     rootObject.insert(FRAME_COMREPSSION_FLAG, true);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
     // Never compress the header frame
-    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
+    FrameSize dataSize = 0;
+    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false, &dataSize)) {
         return false;
     }
+    quint64 offset = PointerClip::MINIMUM_FRAME_SIZE + dataSize;
 
     seek(0);
 
+    ClipIndex index;
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        if (frame->type == Frame::TYPE_INVALID) {
+            continue;
+        }
+        if (!writeFrame(output, *frame, true, &dataSize)) {
+            return false;
+        }
+        index.addFrame(frame->type, frame->timeOffset, dataSize, offset + PointerClip::MINIMUM_FRAME_SIZE);
+        offset += PointerClip::MINIMUM_FRAME_SIZE + dataSize;
+    }
+
+    // Footer index, lets readers open the clip and seek without walking the frames
+    for (const auto& indexFrameData : index.toFrameData(offset)) {
+        if (!writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, indexFrameData }), false)) {
             return false;
         }
     }
@@ -43,6 +43,8 @@ public:
     virtual Frame::Time positionFrameTime() const = 0;
 
     virtual FrameConstPointer peekFrame() const = 0;
+    // Type of the next frame, clips that can tell without reading the frame should override this
+    virtual FrameType peekFrameType() const;
     virtual FrameConstPointer nextFrame() = 0;
     virtual void skipFrame() = 0;
     virtual void addFrame(FrameConstPointer) = 0;
@@ -145,6 +145,11 @@ void Deck::processFrames() {
         if (framePosition > triggerPosition) {
             break;
         }
+        // Frames of types nobody handles are skipped without being read or decompressed
+        if (!Frame::hasFrameHandler(nextClip->peekFrameType())) {
+            nextClip->skipFrame();
+            continue;
+        }
         // Handle the frame and advance the clip
         Frame::handleFrame(nextClip->nextFrame());
     }
@@ -149,6 +149,10 @@ void Frame::clearFrameHandler(const QString& frameTypeName) {
     clearFrameHandler(frameType); 
 }
 
+bool Frame::hasFrameHandler(FrameType type) {
+    Locker lock(mutex);
+    return handlerMap.contains(type);
+}
 
 void Frame::handleFrame(const Frame::ConstPointer& frame) {
     Handler handler; 
@@ -36,6 +36,8 @@ struct FrameHeader {
 
     static const FrameType TYPE_INVALID = 0xFFFF;
     static const FrameType TYPE_HEADER = 0x0;
+    // Frames holding a clip's footer index, never registered so readers drop them like any unknown type
+    static const FrameType TYPE_INDEX = 0xFFFE;
 
     static Time secondsToFrameTime(float seconds);
     static float frameTimeToSeconds(Time frameTime);
@@ -72,6 +74,7 @@ public:
     static void clearFrameHandler(const QString& frameTypeName);
     static QMap<QString, FrameType> getFrameTypes();
     static QMap<FrameType, QString> getFrameTypeNames();
+    static bool hasFrameHandler(FrameType type);
     static void handleFrame(const ConstPointer& frame);
 };
 
@@ -12,6 +12,7 @@
 
 #include "../Clip.h"
 
+#include <algorithm>
 #include <mutex>
 
 namespace recording {
@@ -43,12 +44,7 @@ public:
 
     virtual void seekFrameTime(Frame::Time offset) override {
         Locker lock(_mutex);
-        auto itr = std::lower_bound(_frames.begin(), _frames.end(), offset,
-                [](const T& a, Frame::Time b)->bool {
-                return a.timeOffset < b;
-            }
-        );
-        _frameIndex = itr - _frames.begin();
+        _frameIndex = frameIndexForTime(offset);
     }
 
     virtual Frame::Time positionFrameTime() const override {
@@ -69,6 +65,15 @@ public:
         return result;
     }
 
+    virtual FrameType peekFrameType() const override {
+        Locker lock(_mutex);
+        FrameType result = Frame::TYPE_INVALID;
+        if (_frameIndex < _frames.size()) {
+            result = _frames[_frameIndex].type;
+        }
+        return result;
+    }
+
     virtual FrameConstPointer nextFrame() override {
         Locker lock(_mutex);
         FrameConstPointer result;
@@ -85,6 +90,42 @@ public:
         }
     }
 
+    // Random access that leaves the clip's own cursor alone, so many players can share one clip
+
+    // Index of the first frame at or after the given time, frameCount() if there is none
+    size_t frameIndexForTime(Frame::Time offset) const {
+        Locker lock(_mutex);
+        auto itr = std::lower_bound(_frames.begin(), _frames.end(), offset,
+                [](const T& a, Frame::Time b)->bool {
+                return a.timeOffset < b;
+            }
+        );
+        return itr - _frames.begin();
+    }
+
+    Frame::Time frameTimeAt(size_t index) const {
+        Locker lock(_mutex);
+        Frame::Time result = Frame::INVALID_TIME;
+        if (index < _frames.size()) {
+            result = _frames[index].timeOffset;
+        }
+        return result;
+    }
+
+    FrameType frameTypeAt(size_t index) const {
+        Locker lock(_mutex);
+        FrameType result = Frame::TYPE_INVALID;
+        if (index < _frames.size()) {
+            result = _frames[index].type;
+        }
+        return result;
+    }
+
+    FrameConstPointer frameAt(size_t index) const {
+        Locker lock(_mutex);
+        return readFrame(index);
+    }
+
 protected:
     virtual void reset() override {
         _frameIndex = 0;
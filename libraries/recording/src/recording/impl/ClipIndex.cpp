@@ -0,0 +1,187 @@
+//
+//  ClipIndex.cpp
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ClipIndex.h"
+
+#include <cstring>
+#include <limits>
+
+#include "../Logging.h"
+
+using namespace recording;
+
+static const quint32 INDEX_MAGIC = 0x58444E49; // "INDX"
+static const quint16 INDEX_VERSION = 1;
+
+static const quint64 FRAME_HEADER_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
+// fileOffset, timeOffset, size, padding
+static const quint64 ENTRY_SIZE = 16;
+// firstEntry, count, type, padding
+static const quint64 STREAM_SIZE = 24;
+// indexOffset, entryCount, streamCount, version, magic
+static const quint64 TRAILER_SIZE = 24;
+static const quint64 ENTRY_FRAME_STRIDE = FRAME_HEADER_SIZE + ClipIndex::ENTRIES_PER_FRAME * ENTRY_SIZE;
+static const quint64 MAX_STREAMS = (std::numeric_limits<FrameSize>::max() - TRAILER_SIZE) / STREAM_SIZE;
+
+template <typename T>
+static void appendValue(QByteArray& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static T readValue(const uchar* data) {
+    T result;
+    memcpy(&result, data, sizeof(T));
+    return result;
+}
+
+static quint64 entryFramesSize(quint64 entryCount) {
+    quint64 remainder = entryCount % ClipIndex::ENTRIES_PER_FRAME;
+    quint64 result = (entryCount / ClipIndex::ENTRIES_PER_FRAME) * ENTRY_FRAME_STRIDE;
+    if (remainder != 0) {
+        result += FRAME_HEADER_SIZE + remainder * ENTRY_SIZE;
+    }
+    return result;
+}
+
+void ClipIndex::addFrame(FrameType type, Frame::Time timeOffset, FrameSize size, quint64 fileOffset) {
+    Entry entry;
+    entry.fileOffset = fileOffset;
+    entry.timeOffset = timeOffset;
+    entry.size = size;
+    _pendingStreams[type].push_back(entry);
+}
+
+std::vector<QByteArray> ClipIndex::toFrameData(quint64 indexOffset) const {
+    std::vector<QByteArray> results;
+    if (_pendingStreams.size() > MAX_STREAMS) {
+        qCWarning(recordingLog) << "Too many frame types to index clip:" << _pendingStreams.size();
+        return results;
+    }
+
+    const quint16 padding16 = 0;
+    const quint32 padding32 = 0;
+    QByteArray streamTable;
+    QByteArray entryFrame;
+    quint64 entryCount = 0;
+    for (const auto& stream : _pendingStreams) {
+        const auto& entries = stream.second;
+        appendValue(streamTable, entryCount);
+        appendValue(streamTable, (quint64)entries.size());
+        appendValue(streamTable, stream.first);
+        appendValue(streamTable, padding16);
+        appendValue(streamTable, padding32);
+
+        for (const auto& entry : entries) {
+            if ((quint64)entryFrame.size() == ENTRIES_PER_FRAME * ENTRY_SIZE) {
+                results.push_back(entryFrame);
+                entryFrame.clear();
+            }
+            appendValue(entryFrame, entry.fileOffset);
+            appendValue(entryFrame, entry.timeOffset);
+            appendValue(entryFrame, entry.size);
+            appendValue(entryFrame, padding16);
+        }
+        entryCount += entries.size();
+    }
+    if (!entryFrame.isEmpty()) {
+        results.push_back(entryFrame);
+    }
+
+    QByteArray trailerFrame = streamTable;
+    appendValue(trailerFrame, indexOffset);
+    appendValue(trailerFrame, entryCount);
+    appendValue(trailerFrame, (quint16)_pendingStreams.size());
+    appendValue(trailerFrame, INDEX_VERSION);
+    appendValue(trailerFrame, INDEX_MAGIC);
+    results.push_back(trailerFrame);
+    return results;
+}
+
+bool ClipIndex::read(const uchar* data, size_t size) {
+    _data = nullptr;
+    _indexOffset = 0;
+    _entryCount = 0;
+    _streams.clear();
+
+    if (size < FRAME_HEADER_SIZE + TRAILER_SIZE) {
+        return false;
+    }
+
+    const uchar* trailer = data + size - TRAILER_SIZE;
+    auto indexOffset = readValue<quint64>(trailer);
+    auto entryCount = readValue<quint64>(trailer + 8);
+    auto streamCount = readValue<quint16>(trailer + 16);
+    auto version = readValue<quint16>(trailer + 18);
+    auto magic = readValue<quint32>(trailer + 20);
+    if (magic != INDEX_MAGIC || version != INDEX_VERSION) {
+        return false;
+    }
+
+    // The trailer must close a TYPE_INDEX frame holding it and the stream table
+    quint64 trailerDataSize = streamCount * STREAM_SIZE + TRAILER_SIZE;
+    if (size < FRAME_HEADER_SIZE + trailerDataSize) {
+        return false;
+    }
+    const uchar* trailerFrame = data + size - trailerDataSize - FRAME_HEADER_SIZE;
+    if (readValue<FrameType>(trailerFrame) != Frame::TYPE_INDEX ||
+        readValue<FrameSize>(trailerFrame + sizeof(FrameType) + sizeof(Frame::Time)) != trailerDataSize) {
+        qCWarning(recordingLog) << "Clip index trailer is damaged, ignoring index";
+        return false;
+    }
+
+    // and the entry frames must fill the space between the frames and the trailer
+    quint64 trailerFrameOffset = trailerFrame - data;
+    if (indexOffset > trailerFrameOffset || entryCount > trailerFrameOffset / ENTRY_SIZE ||
+        entryFramesSize(entryCount) != trailerFrameOffset - indexOffset) {
+        qCWarning(recordingLog) << "Clip index entries are damaged, ignoring index";
+        return false;
+    }
+
+    const uchar* streamTable = trailerFrame + FRAME_HEADER_SIZE;
+    _streams.reserve(streamCount);
+    for (quint16 i = 0; i < streamCount; ++i) {
+        const uchar* streamData = streamTable + i * STREAM_SIZE;
+        Stream stream;
+        stream.firstEntry = readValue<quint64>(streamData);
+        stream.count = readValue<quint64>(streamData + 8);
+        stream.type = readValue<FrameType>(streamData + 16);
+        if (stream.firstEntry > entryCount || stream.count > entryCount - stream.firstEntry) {
+            qCWarning(recordingLog) << "Clip index stream table is damaged, ignoring index";
+            _streams.clear();
+            return false;
+        }
+        _streams.push_back(stream);
+    }
+
+    _data = data;
+    _indexOffset = indexOffset;
+    _entryCount = entryCount;
+    return true;
+}
+
+ClipIndex::Entry ClipIndex::getEntry(quint64 entryIndex) const {
+    Entry result;
+    if (!_data || entryIndex >= _entryCount) {
+        return result;
+    }
+
+    const uchar* entryData = _data + _indexOffset + (entryIndex / ENTRIES_PER_FRAME) * ENTRY_FRAME_STRIDE +
+        FRAME_HEADER_SIZE + (entryIndex % ENTRIES_PER_FRAME) * ENTRY_SIZE;
+    result.fileOffset = readValue<quint64>(entryData);
+    result.timeOffset = readValue<Frame::Time>(entryData + 8);
+    result.size = readValue<FrameSize>(entryData + 12);
+    // Entries pointing past the frames are treated as empty rather than read out of bounds
+    if (result.fileOffset > _indexOffset || result.size > _indexOffset - result.fileOffset) {
+        result.fileOffset = 0;
+        result.size = 0;
+    }
+    return result;
+}
@@ -0,0 +1,67 @@
+//
+//  ClipIndex.h
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_ClipIndex_h
+#define hifi_Recording_Impl_ClipIndex_h
+
+#include <map>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "../Frame.h"
+
+namespace recording {
+
+// Footer written after the frames of a clip, listing the frames of each type in time order so a clip can be
+// opened without walking it. It is stored as TYPE_INDEX frames, which older readers drop as an unknown type:
+//   entry frames   the entries of every stream back to back, ENTRIES_PER_FRAME to a frame
+//   trailer frame  the stream table followed by a fixed size trailer that ends the clip
+class ClipIndex {
+public:
+    struct Entry {
+        quint64 fileOffset { 0 };  // of the frame data, from the start of the clip
+        Frame::Time timeOffset { 0 };
+        FrameSize size { 0 };
+    };
+
+    struct Stream {
+        FrameType type { Frame::TYPE_INVALID };  // as stored in the clip
+        quint64 firstEntry { 0 };
+        quint64 count { 0 };
+    };
+
+    // Writing
+    void addFrame(FrameType type, Frame::Time timeOffset, FrameSize size, quint64 fileOffset);
+    // Data of the TYPE_INDEX frames to write, uncompressed, starting at indexOffset
+    std::vector<QByteArray> toFrameData(quint64 indexOffset) const;
+
+    // Reading, only touches the end of the clip. Returns false if the clip has no valid index.
+    bool read(const uchar* data, size_t size);
+    const std::vector<Stream>& getStreams() const { return _streams; }
+    Entry getEntry(quint64 entryIndex) const;
+    // Where the frames end and the index begins
+    quint64 getIndexOffset() const { return _indexOffset; }
+
+    static const quint32 ENTRIES_PER_FRAME = 2048;
+
+private:
+    std::map<FrameType, std::vector<Entry>> _pendingStreams;
+
+    const uchar* _data { nullptr };
+    quint64 _indexOffset { 0 };
+    quint64 _entryCount { 0 };
+    std::vector<Stream> _streams;
+};
+
+}
+
+#endif
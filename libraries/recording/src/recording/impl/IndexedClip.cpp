@@ -0,0 +1,223 @@
+//
+//  IndexedClip.cpp
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IndexedClip.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QDebug>
+#include <QtCore/QJsonObject>
+
+#include "../Logging.h"
+#include "PointerClip.h"
+
+using namespace recording;
+
+bool IndexedClip::init(uchar* data, size_t size) {
+    Locker lock(_mutex);
+    reset();
+
+    if (!_index.read(data, size)) {
+        return false;
+    }
+
+    // Grab the file header, the only frame that has to be read to open the clip
+    {
+        FrameType headerType = Frame::TYPE_INVALID;
+        FrameSize headerSize = 0;
+        if (_index.getIndexOffset() >= (quint64)PointerClip::MINIMUM_FRAME_SIZE) {
+            memcpy(&headerType, data, sizeof(FrameType));
+            memcpy(&headerSize, data + sizeof(FrameType) + sizeof(Frame::Time), sizeof(FrameSize));
+        }
+        if (headerType != Frame::TYPE_HEADER ||
+            PointerClip::MINIMUM_FRAME_SIZE + headerSize > (qint64)_index.getIndexOffset()) {
+            qWarning() << "Missing header frame, invalid file";
+            reset();
+            return false;
+        }
+
+        QByteArray fileHeaderData((char*)data + PointerClip::MINIMUM_FRAME_SIZE, headerSize);
+        _header = QJsonDocument::fromBinaryData(fileHeaderData);
+        _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
+    }
+
+    FrameTranslationMap translationMap = parseTranslationMap(_header);
+    if (translationMap.empty()) {
+        qWarning() << "Header missing frame type map, invalid file";
+        reset();
+        return false;
+    }
+
+    // Frame types this session doesn't know are dropped as a whole
+    for (const auto& indexStream : _index.getStreams()) {
+        if (indexStream.count == 0 || !translationMap.contains(indexStream.type)) {
+            continue;
+        }
+        Stream stream;
+        stream.type = translationMap[indexStream.type];
+        stream.firstEntry = indexStream.firstEntry;
+        stream.count = indexStream.count;
+        _streams.push_back(stream);
+
+        _frameCount += stream.count;
+        _duration = std::max(_duration, _index.getEntry(stream.firstEntry + stream.count - 1).timeOffset);
+    }
+
+    _data = data;
+    _size = size;
+    advance();
+    return true;
+}
+
+void IndexedClip::reset() {
+    _index = ClipIndex();
+    _streams.clear();
+    _currentStream = 0;
+    _currentEntry = ClipIndex::Entry();
+    _header = QJsonDocument();
+    _data = nullptr;
+    _size = 0;
+    _frameCount = 0;
+    _duration = 0;
+}
+
+Clip::Pointer IndexedClip::duplicate() const {
+    auto result = newClip();
+    Locker lock(_mutex);
+    auto streams = _streams;
+    for (auto& stream : streams) {
+        stream.position = 0;
+    }
+
+    ClipIndex::Entry entry;
+    for (auto i = findNextStream(streams, entry); i < streams.size(); i = findNextStream(streams, entry)) {
+        result->addFrame(readFrame(streams[i].type, entry));
+        ++streams[i].position;
+    }
+    return result;
+}
+
+float IndexedClip::duration() const {
+    Locker lock(_mutex);
+    return Frame::frameTimeToSeconds(_duration);
+}
+
+size_t IndexedClip::frameCount() const {
+    Locker lock(_mutex);
+    return _frameCount;
+}
+
+void IndexedClip::seekFrameTime(Frame::Time offset) {
+    Locker lock(_mutex);
+    // Binary search each frame type for its first frame at or after the offset
+    for (auto& stream : _streams) {
+        quint64 low = 0;
+        quint64 high = stream.count;
+        while (low < high) {
+            quint64 middle = low + (high - low) / 2;
+            if (_index.getEntry(stream.firstEntry + middle).timeOffset < offset) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        stream.position = low;
+    }
+    advance();
+}
+
+Frame::Time IndexedClip::positionFrameTime() const {
+    Locker lock(_mutex);
+    Frame::Time result = Frame::INVALID_TIME;
+    if (_currentStream < _streams.size()) {
+        result = _currentEntry.timeOffset;
+    }
+    return result;
+}
+
+FrameConstPointer IndexedClip::peekFrame() const {
+    Locker lock(_mutex);
+    FrameConstPointer result;
+    if (_currentStream < _streams.size()) {
+        result = readFrame(_streams[_currentStream].type, _currentEntry);
+    }
+    return result;
+}
+
+FrameType IndexedClip::peekFrameType() const {
+    Locker lock(_mutex);
+    FrameType result = Frame::TYPE_INVALID;
+    if (_currentStream < _streams.size()) {
+        result = _streams[_currentStream].type;
+    }
+    return result;
+}
+
+FrameConstPointer IndexedClip::nextFrame() {
+    Locker lock(_mutex);
+    FrameConstPointer result;
+    if (_currentStream < _streams.size()) {
+        result = readFrame(_streams[_currentStream].type, _currentEntry);
+        ++_streams[_currentStream].position;
+        advance();
+    }
+    return result;
+}
+
+void IndexedClip::skipFrame() {
+    Locker lock(_mutex);
+    if (_currentStream < _streams.size()) {
+        ++_streams[_currentStream].position;
+        advance();
+    }
+}
+
+void IndexedClip::addFrame(FrameConstPointer) {
+    throw std::runtime_error("Indexed clips are read only, use duplicate to create a read/write clip");
+}
+
+// Internal only function, needs no locking
+size_t IndexedClip::findNextStream(const std::vector<Stream>& streams, ClipIndex::Entry& nextEntry) const {
+    size_t result = streams.size();
+    for (size_t i = 0; i < streams.size(); ++i) {
+        const auto& stream = streams[i];
+        if (stream.position >= stream.count) {
+            continue;
+        }
+        auto entry = _index.getEntry(stream.firstEntry + stream.position);
+        // Frames at the same time keep the order they were recorded in
+        if (result == streams.size() || entry.timeOffset < nextEntry.timeOffset ||
+                (entry.timeOffset == nextEntry.timeOffset && entry.fileOffset < nextEntry.fileOffset)) {
+            result = i;
+            nextEntry = entry;
+        }
+    }
+    return result;
+}
+
+// Internal only function, needs no locking
+void IndexedClip::advance() {
+    _currentStream = findNextStream(_streams, _currentEntry);
+}
+
+// Internal only function, needs no locking
+FrameConstPointer IndexedClip::readFrame(FrameType type, const ClipIndex::Entry& entry) const {
+    auto result = std::make_shared<Frame>();
+    result->type = type;
+    result->timeOffset = entry.timeOffset;
+    if (entry.size) {
+        result->data.insert(0, reinterpret_cast<char*>(_data) + entry.fileOffset, entry.size);
+        if (_compressed) {
+            result->data = qUncompress(result->data);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,80 @@
+//
+//  IndexedClip.h
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_IndexedClip_h
+#define hifi_Recording_Impl_IndexedClip_h
+
+#include "../Clip.h"
+
+#include <vector>
+
+#include <QtCore/QJsonDocument>
+
+#include "ClipIndex.h"
+
+namespace recording {
+
+// Read only clip over data with a footer index. Opening reads the header frame and the end of the index only,
+// frames are located through the index when they are played and each frame type is seeked on its own.
+class IndexedClip : public Clip {
+public:
+    using Pointer = std::shared_ptr<IndexedClip>;
+
+    // Returns false, leaving the clip empty, if the data has no valid header frame and footer index
+    bool init(uchar* data, size_t size);
+
+    virtual Clip::Pointer duplicate() const override;
+
+    virtual float duration() const override;
+    virtual size_t frameCount() const override;
+
+    virtual void seekFrameTime(Frame::Time offset) override;
+    virtual Frame::Time positionFrameTime() const override;
+
+    virtual FrameConstPointer peekFrame() const override;
+    virtual FrameType peekFrameType() const override;
+    virtual FrameConstPointer nextFrame() override;
+    virtual void skipFrame() override;
+    virtual void addFrame(FrameConstPointer) override;
+
+    const QJsonDocument& getHeader() const { return _header; }
+
+protected:
+    virtual void reset() override;
+
+    struct Stream {
+        FrameType type { Frame::TYPE_INVALID };  // translated to the frame types of this session
+        quint64 firstEntry { 0 };
+        quint64 count { 0 };
+        quint64 position { 0 };  // next entry to play
+    };
+
+    // Stream whose next frame was recorded first, streams.size() once all of them are played out
+    size_t findNextStream(const std::vector<Stream>& streams, ClipIndex::Entry& nextEntry) const;
+    void advance();
+    FrameConstPointer readFrame(FrameType type, const ClipIndex::Entry& entry) const;
+
+    ClipIndex _index;
+    std::vector<Stream> _streams;
+    size_t _currentStream { 0 };
+    ClipIndex::Entry _currentEntry;
+
+    QJsonDocument _header;
+    uchar* _data { nullptr };
+    size_t _size { 0 };
+    bool _compressed { true };
+    size_t _frameCount { 0 };
+    Frame::Time _duration { 0 };
+};
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+//
+//  IndexedFileClip.cpp
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IndexedFileClip.h"
+
+#include <QtCore/QDebug>
+
+#include "../Logging.h"
+
+using namespace recording;
+
+IndexedFileClip::IndexedFileClip(const QString& fileName) : _file(fileName) {
+    auto size = _file.size();
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(recordingLog) << "Unable to open file " << fileName;
+        return;
+    }
+
+    // Mapping doesn't read the file, only the pages holding the header and the index trailer are touched here
+    _mappedFile = _file.map(0, size, QFile::MapPrivateOption);
+    if (!_mappedFile || !init(_mappedFile, size)) {
+        if (_mappedFile) {
+            _file.unmap(_mappedFile);
+            _mappedFile = nullptr;
+        }
+        _file.close();
+    }
+}
+
+QString IndexedFileClip::getName() const {
+    return _file.fileName();
+}
+
+IndexedFileClip::~IndexedFileClip() {
+    Locker lock(_mutex);
+    reset();
+    if (_mappedFile) {
+        _file.unmap(_mappedFile);
+    }
+    if (_file.isOpen()) {
+        _file.close();
+    }
+}
@@ -0,0 +1,38 @@
+//
+//  IndexedFileClip.h
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_IndexedFileClip_h
+#define hifi_Recording_Impl_IndexedFileClip_h
+
+#include "IndexedClip.h"
+
+#include <QtCore/QFile>
+
+namespace recording {
+
+// Memory maps a clip file with a footer index, the clip is empty if the file has no index
+class IndexedFileClip : public IndexedClip {
+public:
+    using Pointer = std::shared_ptr<IndexedFileClip>;
+
+    IndexedFileClip(const QString& file);
+    virtual ~IndexedFileClip();
+
+    virtual QString getName() const override;
+
+private:
+    QFile _file;
+    uchar* _mappedFile { nullptr };
+};
+
+}
+
+#endif
@@ -9,6 +9,8 @@
 #include "PointerClip.h"
 
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
@@ -19,12 +21,11 @@
 #include "../Frame.h"
 #include "../Logging.h"
 #include "BufferClip.h"
+#include "ClipIndex.h"
 
 
 using namespace recording;
 
-using FrameTranslationMap = QMap<FrameType, FrameType>;
-
 FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
     FrameTranslationMap results;
     auto headerObj = doc.object();
@@ -45,13 +46,14 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
 }
 
 
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
+PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size,
+        size_t maxFrames = std::numeric_limits<size_t>::max()) {
     PointerFrameHeaderList results;
     auto current = start;
     auto end = current + size;
     // Read all the frame headers
     // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
+    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE && results.size() < maxFrames) {
         PointerFrameHeader header;
         memcpy(&(header.type), current, sizeof(FrameType));
         current += sizeof(FrameType);
@@ -87,7 +89,32 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
+    PointerFrameHeaderList parsedFrameHeaders;
+    ClipIndex index;
+    if (index.read(data, size)) {
+        // The footer index lists every frame, so only the header frame has to be walked
+        parsedFrameHeaders = parseFrameHeaders(data, index.getIndexOffset(), 1);
+        std::vector<PointerFrameHeader> indexedFrameHeaders;
+        for (const auto& stream : index.getStreams()) {
+            for (quint64 i = 0; i < stream.count; ++i) {
+                auto entry = index.getEntry(stream.firstEntry + i);
+                PointerFrameHeader header;
+                header.type = stream.type;
+                header.timeOffset = entry.timeOffset;
+                header.size = entry.size;
+                header.fileOffset = entry.fileOffset;
+                indexedFrameHeaders.push_back(header);
+            }
+        }
+        // Restore the recorded order of the frames across types
+        std::sort(indexedFrameHeaders.begin(), indexedFrameHeaders.end(),
+            [](const PointerFrameHeader& a, const PointerFrameHeader& b) {
+                return a.fileOffset < b.fileOffset;
+            });
+        parsedFrameHeaders.insert(parsedFrameHeaders.end(), indexedFrameHeaders.begin(), indexedFrameHeaders.end());
+    } else {
+        parsedFrameHeaders = parseFrameHeaders(data, size);
+    }
     // Verify that at least one frame exists and that the first frame is a header
     if (0 == parsedFrameHeaders.size()) {
         qWarning() << "No frames found, invalid file";
@@ -15,6 +15,7 @@
 #include <mutex>
 
 #include <QtCore/QJsonDocument>
+#include <QtCore/QMap>
 
 #include "../Frame.h"
 
@@ -29,6 +30,10 @@ struct PointerFrameHeader : public FrameHeader {
 
 using PointerFrameHeaderList = std::list<PointerFrameHeader>;
 
+// Maps the frame types stored in a clip header to the frame types registered in this session
+using FrameTranslationMap = QMap<FrameType, FrameType>;
+FrameTranslationMap parseTranslationMap(const QJsonDocument& doc);
+
 class PointerClip : public ArrayClip<PointerFrameHeader> {
 public:
     using Pointer = std::shared_ptr<PointerClip>;
@@ -34,6 +34,10 @@ FrameConstPointer WrapperClip::peekFrame() const {
     return _wrappedClip->peekFrame();
 }
 
+FrameType WrapperClip::peekFrameType() const {
+    return _wrappedClip->peekFrameType();
+}
+
 FrameConstPointer WrapperClip::nextFrame() {
     return _wrappedClip->nextFrame();
 }
@@ -32,6 +32,7 @@ public:
     virtual Frame::Time positionFrameTime() const override;
 
     virtual FrameConstPointer peekFrame() const override;
+    virtual FrameType peekFrameType() const override;
     virtual FrameConstPointer nextFrame() override;
     virtual void skipFrame() override;
     virtual void addFrame(FrameConstPointer) override;
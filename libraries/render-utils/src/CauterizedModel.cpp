@@ -112,21 +112,21 @@ void CauterizedModel::updateClusterMatrices() {
         const HFMMesh& mesh = hfmModel.meshes.at(i);
         int meshIndex = i;
 
+        if (!_useDualQuaternionSkinning) {
+            computeClusterMatrices(meshIndex, state.clusterMatrices);
+            continue;
+        }
+
         for (int j = 0; j < mesh.clusters.size(); j++) {
             const HFMCluster& cluster = mesh.clusters.at(j);
             int clusterIndex = j;
 
-            if (_useDualQuaternionSkinning) {
-                auto jointPose = _rig.getJointPose(cluster.jointIndex);
-                Transform jointTransform(jointPose.rot(), jointPose.scale(), jointPose.trans());
-                Transform clusterTransform;
-                Transform::mult(clusterTransform, jointTransform, _rig.getAnimSkeleton()->getClusterBindMatricesOriginalValues(meshIndex, clusterIndex).inverseBindTransform);
-                state.clusterDualQuaternions[j] = Model::TransformDualQuaternion(clusterTransform);
-                state.clusterDualQuaternions[j].setCauterizationParameters(0.0f, jointPose.trans());
-            } else {
-                auto jointMatrix = _rig.getJointTransform(cluster.jointIndex);
-                glm_mat4u_mul(jointMatrix, _rig.getAnimSkeleton()->getClusterBindMatricesOriginalValues(meshIndex, clusterIndex).inverseBindMatrix, state.clusterMatrices[j]);
-            }
+            auto jointPose = _rig.getJointPose(cluster.jointIndex);
+            Transform jointTransform(jointPose.rot(), jointPose.scale(), jointPose.trans());
+            Transform clusterTransform;
+            Transform::mult(clusterTransform, jointTransform, _rig.getAnimSkeleton()->getClusterBindMatricesOriginalValues(meshIndex, clusterIndex).inverseBindTransform);
+            state.clusterDualQuaternions[j] = Model::TransformDualQuaternion(clusterTransform);
+            state.clusterDualQuaternions[j].setCauterizationParameters(0.0f, jointPose.trans());
         }
     }
 
@@ -175,12 +175,7 @@ void CauterizedModel::updateClusterMatrices() {
         }
     }
 
-    // post the blender if we're not currently waiting for one to finish
-    auto modelBlender = DependencyManager::get<ModelBlender>();
-    if (modelBlender->shouldComputeBlendshapes() && hfmModel.hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
-        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        modelBlender->noteRequiresBlend(getThisPointer());
-    }
+    postBlendIfNeeded();
 }
 
 void CauterizedModel::updateRenderItems() {
@@ -204,6 +204,7 @@ void MeshPartPayload::render(RenderArgs* args) {
         if (RenderPipelines::bindMaterials(_drawMaterials, batch, args->_renderMode, args->_enableTexturing)) {
             args->_details._materialSwitches++;
         }
+        RenderPipelines::requestMipDemand(_drawMaterials, args, _worldBound);
     }
 
     // Draw!
@@ -242,6 +243,10 @@ template <> void payloadRender(const ModelMeshPartPayload::Pointer& payload, Ren
     return payload->render(args);
 }
 
+template <> bool payloadPrepareAsyncRender(const ModelMeshPartPayload::Pointer& payload, RenderArgs* args) {
+    return payload && payload->prepareAsyncRender(args);
+}
+
 }
 
 ModelMeshPartPayload::ModelMeshPartPayload(ModelPointer model, int meshIndex, int partIndex, int shapeIndex,
@@ -510,6 +515,7 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
         if (RenderPipelines::bindMaterials(_drawMaterials, batch, args->_renderMode, args->_enableTexturing)) {
             args->_details._materialSwitches++;
         }
+        RenderPipelines::requestMipDemand(_drawMaterials, args, _worldBound);
     }
 
     // Draw!
@@ -522,6 +528,19 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
 }
 
+bool ModelMeshPartPayload::prepareAsyncRender(RenderArgs* args) {
+    // Procedurals prepare their programs and uniforms as they render
+    if (!_drawMaterials.empty() && _drawMaterials.top().material && _drawMaterials.top().material->isProcedural()) {
+        return false;
+    }
+
+    if (_drawMaterials.shouldUpdate()) {
+        RenderPipelines::updateMultiMaterial(_drawMaterials);
+    }
+    // Materials waiting on textures update on every render, which the other passes of the frame do as well
+    return !_drawMaterials.shouldUpdate();
+}
+
 void ModelMeshPartPayload::computeAdjustedLocalBound(const std::vector<glm::mat4>& clusterMatrices) {
     _adjustedLocalBound = _localBound;
     if (clusterMatrices.size() > 0) {
@@ -111,6 +111,8 @@ public:
     // Render Item interface
     render::ShapeKey getShapeKey() const override;
     void render(RenderArgs* args) override;
+    // resolves the materials, so that render only reads them when recorded on a worker thread
+    bool prepareAsyncRender(RenderArgs* args);
 
     void setShapeKey(bool invalidateShapeKey, PrimitiveMode primitiveMode, bool useDualQuaternionSkinning);
     void setCauterized(bool cauterized) { _cauterized = cauterized; }
@@ -154,6 +156,7 @@ namespace render {
     template <> const Item::Bound payloadGetBound(const ModelMeshPartPayload::Pointer& payload);
     template <> const ShapeKey shapeGetShapeKey(const ModelMeshPartPayload::Pointer& payload);
     template <> void payloadRender(const ModelMeshPartPayload::Pointer& payload, RenderArgs* args);
+    template <> bool payloadPrepareAsyncRender(const ModelMeshPartPayload::Pointer& payload, RenderArgs* args);
 }
 
 #endif // hifi_MeshPartPayload_h
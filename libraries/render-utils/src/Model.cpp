@@ -1410,30 +1410,92 @@ void Model::updateClusterMatrices() {
         MeshState& state = _meshStates[i];
         int meshIndex = i;
         const HFMMesh& mesh = hfmModel.meshes.at(i);
+
+        if (!_useDualQuaternionSkinning) {
+            computeClusterMatrices(meshIndex, state.clusterMatrices);
+            continue;
+        }
+
         for (int j = 0; j < mesh.clusters.size(); j++) {
             const HFMCluster& cluster = mesh.clusters.at(j);
             int clusterIndex = j;
 
-            if (_useDualQuaternionSkinning) {
-                auto jointPose = _rig.getJointPose(cluster.jointIndex);
-                Transform jointTransform(jointPose.rot(), jointPose.scale(), jointPose.trans());
-                Transform clusterTransform;
-                Transform::mult(clusterTransform, jointTransform, _rig.getAnimSkeleton()->getClusterBindMatricesOriginalValues(meshIndex, clusterIndex).inverseBindTransform);
-                state.clusterDualQuaternions[j] = Model::TransformDualQuaternion(clusterTransform);
-            } else {
-                auto jointMatrix = _rig.getJointTransform(cluster.jointIndex);
-                glm_mat4u_mul(jointMatrix, _rig.getAnimSkeleton()->getClusterBindMatricesOriginalValues(meshIndex, clusterIndex).inverseBindMatrix, state.clusterMatrices[j]);
-            }
+            auto jointPose = _rig.getJointPose(cluster.jointIndex);
+            Transform jointTransform(jointPose.rot(), jointPose.scale(), jointPose.trans());
+            Transform clusterTransform;
+            Transform::mult(clusterTransform, jointTransform, _rig.getAnimSkeleton()->getClusterBindMatricesOriginalValues(meshIndex, clusterIndex).inverseBindTransform);
+            state.clusterDualQuaternions[j] = Model::TransformDualQuaternion(clusterTransform);
         }
     }
 
+    postBlendIfNeeded();
+}
+
+void Model::postBlendIfNeeded() {
     // post the blender if we're not currently waiting for one to finish
     auto modelBlender = DependencyManager::get<ModelBlender>();
-    if (modelBlender->shouldComputeBlendshapes() && hfmModel.hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
+    if (modelBlender->shouldComputeBlendshapes() && getHFMModel().hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
         _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        modelBlender->noteRequiresBlend(getThisPointer());
+        if (_deferBlendRequests) {
+            _hasDeferredBlendRequest = true;
+        } else {
+            modelBlender->noteRequiresBlend(getThisPointer());
+        }
+    }
+}
+
+void Model::postDeferredBlendRequest() {
+    if (_hasDeferredBlendRequest) {
+        _hasDeferredBlendRequest = false;
+        DependencyManager::get<ModelBlender>()->noteRequiresBlend(getThisPointer());
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include <CPUDetect.h>
+
+void multiplyClusterMatrices_AVX2(const float (*jointMatrices)[16], const float (*inverseBindMatrices)[16],
+                                  float (*clusterMatrices)[16], int size);
+
+static void multiplyClusterMatrices(const glm::mat4* jointMatrices, const glm::mat4* inverseBindMatrices,
+                                    glm::mat4* clusterMatrices, int size) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    if (_cpuSupportsAVX2) {
+        static_assert(sizeof(glm::mat4) == 16 * sizeof(float), "glm::mat4 size doesn't match.");
+        multiplyClusterMatrices_AVX2((const float(*)[16])jointMatrices, (const float(*)[16])inverseBindMatrices,
+                                     (float(*)[16])clusterMatrices, size);
+    } else {
+        for (int i = 0; i < size; i++) {
+            glm_mat4u_mul(jointMatrices[i], inverseBindMatrices[i], clusterMatrices[i]);
+        }
+    }
+}
+
+#else   // portable reference code
+static void multiplyClusterMatrices(const glm::mat4* jointMatrices, const glm::mat4* inverseBindMatrices,
+                                    glm::mat4* clusterMatrices, int size) {
+    for (int i = 0; i < size; i++) {
+        glm_mat4u_mul(jointMatrices[i], inverseBindMatrices[i], clusterMatrices[i]);
     }
 }
+#endif
+
+void Model::computeClusterMatrices(int meshIndex, std::vector<glm::mat4>& clusterMatrices) {
+    auto animSkeleton = _rig.getAnimSkeleton();
+    const std::vector<int>& jointIndices = animSkeleton->getClusterJointIndices(meshIndex);
+    const std::vector<glm::mat4>& inverseBindMatrices = animSkeleton->getClusterInverseBindMatrices(meshIndex);
+    int numClusters = (int)std::min(jointIndices.size(), clusterMatrices.size());
+
+    // gather the joint transforms into a contiguous array, so the products run as one pass over three arrays
+    _clusterJointMatrices.resize(numClusters);
+    for (int j = 0; j < numClusters; j++) {
+        _clusterJointMatrices[j] = _rig.getJointTransform(jointIndices[j]);
+    }
+    multiplyClusterMatrices(_clusterJointMatrices.data(), inverseBindMatrices.data(), clusterMatrices.data(), numClusters);
+}
 
 void Model::deleteGeometry() {
     _deleteGeometryCounter++;
@@ -1735,6 +1797,20 @@ static void packBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, Blends
     }
 }
 
+static void accumulateBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, const HFMBlendshape& blendshape,
+                                            float vertexCoefficient, float normalCoefficient) {
+    for (int j = 0; j < blendshape.indices.size(); ++j) {
+        int index = blendshape.indices.at(j);
+
+        auto& currentBlendshapeOffset = unpacked[index];
+        currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
+        currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
+        if (j < blendshape.tangents.size()) {
+            currentBlendshapeOffset.tangentOffset += blendshape.tangents.at(j) * normalCoefficient;
+        }
+    }
+}
+
 #if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
 //
 // Runtime CPU dispatch
@@ -1754,8 +1830,29 @@ static void packBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, Blendshape
     }
 }
 
+void accumulateBlendshapeOffsets_AVX2(float (*unpacked)[9], const int* indices, const float (*vertices)[3],
+                                      const float (*normals)[3], const float (*tangents)[3], int numTangents, int size,
+                                      float vertexCoefficient, float normalCoefficient);
+
+static void accumulateBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, const HFMBlendshape& blendshape,
+                                        float vertexCoefficient, float normalCoefficient) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    int size = std::min(blendshape.indices.size(), std::min(blendshape.vertices.size(), blendshape.normals.size()));
+    if (_cpuSupportsAVX2 && size == blendshape.indices.size()) {
+        static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "glm::vec3 size doesn't match.");
+        accumulateBlendshapeOffsets_AVX2((float(*)[9])unpacked, blendshape.indices.constData(),
+                                         (const float(*)[3])blendshape.vertices.constData(),
+                                         (const float(*)[3])blendshape.normals.constData(),
+                                         (const float(*)[3])blendshape.tangents.constData(), blendshape.tangents.size(),
+                                         size, vertexCoefficient, normalCoefficient);
+    } else {
+        accumulateBlendshapeOffsets_ref(unpacked, blendshape, vertexCoefficient, normalCoefficient);
+    }
+}
+
 #else   // portable reference code
 static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
+static auto& accumulateBlendshapeOffsets = accumulateBlendshapeOffsets_ref;
 #endif
 
 class Blender : public QRunnable {
@@ -1827,16 +1924,7 @@ void Blender::run() {
 
             float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
             const HFMBlendshape& blendshape = meshIter->blendshapes.at(i);
-            for (int j = 0; j < blendshape.indices.size(); ++j) {
-                int index = blendshape.indices.at(j);
-
-                auto& currentBlendshapeOffset = unpackedBlendshapeOffsets[index];
-                currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
-                currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
-                if (j < blendshape.tangents.size()) {
-                    currentBlendshapeOffset.tangentOffset += blendshape.tangents.at(j) * normalCoefficient;
-                }
-            }
+            accumulateBlendshapeOffsets(unpackedBlendshapeOffsets.data(), blendshape, vertexCoefficient, normalCoefficient);
         }
 
         // convert unpackedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
@@ -179,6 +179,11 @@ public:
     virtual void simulate(float deltaTime, bool fullUpdate = true);
     virtual void updateClusterMatrices();
 
+    /// While deferred, blends needed by updateClusterMatrices() are only noted, for postDeferredBlendRequest() to post
+    /// later from the main thread.  The ModelBlender queue isn't safe to touch from the threads avatars skin on.
+    void setDeferBlendRequests(bool deferBlendRequests) { _deferBlendRequests = deferBlendRequests; }
+    void postDeferredBlendRequest();
+
     /// Returns a reference to the shared geometry.
     const Geometry::Pointer& getGeometry() const { return _renderGeometry; }
 
@@ -423,6 +428,10 @@ protected:
 
     std::vector<MeshState> _meshStates;
 
+    // clusterMatrices = joint transform * inverse bind matrix for every cluster of the mesh, in one SIMD pass
+    void computeClusterMatrices(int meshIndex, std::vector<glm::mat4>& clusterMatrices);
+    std::vector<glm::mat4> _clusterJointMatrices; // scratch for computeClusterMatrices
+
     virtual void initJointStates();
 
     void setScaleInternal(const glm::vec3& scale);
@@ -440,6 +449,9 @@ protected:
 
     virtual void deleteGeometry();
 
+    // called at the end of updateClusterMatrices()
+    void postBlendIfNeeded();
+
     QUrl _url;
 
     BlendShapeOperator _modelBlendshapeOperator { nullptr };
@@ -475,6 +487,8 @@ protected:
     bool _needsFixupInScene { true }; // needs to be removed/re-added to scene
     bool _needsReload { true };
     bool _needsUpdateClusterMatrices { true };
+    bool _deferBlendRequests { false };
+    bool _hasDeferredBlendRequest { false };
     QVariantMap _pendingTextures { };
 
     friend class ModelMeshPartPayload;
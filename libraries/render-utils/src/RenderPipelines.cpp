@@ -373,6 +373,26 @@ bool RenderPipelines::bindMaterial(graphics::MaterialPointer& material, gpu::Bat
     return bindMaterials(multiMaterial, batch, renderMode, enableTextures);
 }
 
+void RenderPipelines::requestMipDemand(const graphics::MultiMaterial& multiMaterial, const RenderArgs* args, const AABox& bound) {
+    // Shadows are sampled coarsely and don't get a say
+    if (args->_renderMode == render::Args::SHADOW_RENDER_MODE || !args->hasViewFrustum() || !multiMaterial.getTextureTable()) {
+        return;
+    }
+
+    // Assume the textures span the bound, which holds for most models; tiled textures end up a bit blurrier
+    const ViewFrustum& frustum = args->getViewFrustum();
+    float halfDiagonal = 0.5f * glm::length(bound.getDimensions());
+    float distance = std::max(glm::distance(frustum.getPosition(), bound.calcCenter()) - halfDiagonal, frustum.getNearClip());
+    float pixelsPerRadian = (float)args->_viewport.w / (2.0f * tanf(0.5f * glm::radians(frustum.getFieldOfView())));
+    float screenSize = pixelsPerRadian * bound.getLargestDimension() / distance;
+
+    for (const auto& texture : multiMaterial.getTextureTable()->getTextures()) {
+        if (texture) {
+            texture->requestMipDemand(texture->evalMipForScreenSize(screenSize));
+        }
+    }
+}
+
 void RenderPipelines::updateMultiMaterial(graphics::MultiMaterial& multiMaterial) {
     auto& schemaBuffer = multiMaterial.getSchemaBuffer();
 
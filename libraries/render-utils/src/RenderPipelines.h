@@ -19,6 +19,9 @@ public:
     static void updateMultiMaterial(graphics::MultiMaterial& multiMaterial);
     static bool bindMaterial(graphics::MaterialPointer& material, gpu::Batch& batch, render::Args::RenderMode renderMode, bool enableTextures);
     static bool bindMaterials(graphics::MultiMaterial& multiMaterial, gpu::Batch& batch, render::Args::RenderMode renderMode, bool enableTextures);
+
+    // Tells the material's textures which mip is needed to cover bound on screen
+    static void requestMipDemand(const graphics::MultiMaterial& multiMaterial, const RenderArgs* args, const AABox& bound);
 };
 
 
@@ -203,6 +203,89 @@ static void adjustNearFar(const AABox& inShapeBounds, ViewFrustum& shadowFrustum
     }
 }
 
+// Records the shapes into the cascade's shadow map, with the view and projection of the context's args
+static void recordShadowMap(const render::RenderContextPointer& renderContext, const render::ShapePlumberPointer& shapePlumber,
+                            const gpu::FramebufferPointer& fbo, const AABox& inShapeBounds, const render::ShapeBounds& inShapes,
+                            bool clear, gpu::Batch& batch) {
+    RenderArgs* args = renderContext->args;
+    args->_batch = &batch;
+    batch.enableStereo(false);
+
+    glm::ivec4 viewport{0, 0, fbo->getWidth(), fbo->getHeight()};
+    batch.setViewportTransform(viewport);
+    batch.setStateScissorRect(viewport);
+
+    batch.setFramebuffer(fbo);
+    if (clear) {
+        batch.clearDepthFramebuffer(1.0, false);
+    }
+
+    if (!inShapeBounds.isNull()) {
+        glm::mat4 projMat;
+        Transform viewMat;
+        args->getViewFrustum().evalProjectionMatrix(projMat);
+        args->getViewFrustum().evalViewTransform(viewMat);
+
+        batch.setProjectionTransform(projMat);
+        batch.setViewTransform(viewMat, false);
+
+        const std::vector<ShapeKey::Builder> keys = {
+            ShapeKey::Builder(), ShapeKey::Builder().withFade(),
+            ShapeKey::Builder().withDeformed(), ShapeKey::Builder().withDeformed().withFade(),
+            ShapeKey::Builder().withDeformed().withDualQuatSkinned(), ShapeKey::Builder().withDeformed().withDualQuatSkinned().withFade(),
+            ShapeKey::Builder().withOwnPipeline(), ShapeKey::Builder().withOwnPipeline().withFade(),
+            ShapeKey::Builder().withOwnPipeline().withDeformed(), ShapeKey::Builder().withOwnPipeline().withDeformed().withFade(),
+            ShapeKey::Builder().withOwnPipeline().withDeformed().withDualQuatSkinned(), ShapeKey::Builder().withOwnPipeline().withDeformed().withDualQuatSkinned().withFade(),
+        };
+        std::vector<std::vector<ShapeKey>> sortedShapeKeys(keys.size());
+
+        const int OWN_PIPELINE_INDEX = 6;
+        for (const auto& items : inShapes) {
+            int index = items.first.hasOwnPipeline() ? OWN_PIPELINE_INDEX : 0;
+            if (items.first.isDeformed()) {
+                index += 2;
+                if (items.first.isDualQuatSkinned()) {
+                    index += 2;
+                }
+            }
+
+            if (items.first.isFaded()) {
+                index += 1;
+            }
+
+            sortedShapeKeys[index].push_back(items.first);
+        }
+
+        // Render non-withOwnPipeline things
+        for (size_t i = 0; i < OWN_PIPELINE_INDEX; i++) {
+            auto& shapeKeys = sortedShapeKeys[i];
+            if (shapeKeys.size() > 0) {
+                const auto& shapePipeline = shapePlumber->pickPipeline(args, keys[i]);
+                args->_shapePipeline = shapePipeline;
+                for (const auto& key : shapeKeys) {
+                    renderShapes(renderContext, shapePlumber, inShapes.at(key));
+                }
+            }
+        }
+
+        // Render withOwnPipeline things
+        for (size_t i = OWN_PIPELINE_INDEX; i < keys.size(); i++) {
+            auto& shapeKeys = sortedShapeKeys[i];
+            if (shapeKeys.size() > 0) {
+                args->_shapePipeline = nullptr;
+                for (const auto& key : shapeKeys) {
+                    args->_itemShapeKey = key._flags.to_ulong();
+                    renderShapes(renderContext, shapePlumber, inShapes.at(key));
+                }
+            }
+        }
+
+        args->_shapePipeline = nullptr;
+    }
+
+    args->_batch = nullptr;
+}
+
 void RenderShadowMap::run(const render::RenderContextPointer& renderContext, const Inputs& inputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -233,82 +316,37 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
     args->popViewFrustum();
     args->pushViewFrustum(adjustedShadowFrustum);
 
-    gpu::doInBatch("RenderShadowMap::run", args->_context, [&](gpu::Batch& batch) {
-        args->_batch = &batch;
-        batch.enableStereo(false);
-
-        glm::ivec4 viewport{0, 0, fbo->getWidth(), fbo->getHeight()};
-        batch.setViewportTransform(viewport);
-        batch.setStateScissorRect(viewport);
-
-        batch.setFramebuffer(fbo);
-        batch.clearDepthFramebuffer(1.0, false);
-
-        if (!inShapeBounds.isNull()) {
-            glm::mat4 projMat;
-            Transform viewMat;
-            args->getViewFrustum().evalProjectionMatrix(projMat);
-            args->getViewFrustum().evalViewTransform(viewMat);
-
-            batch.setProjectionTransform(projMat);
-            batch.setViewTransform(viewMat, false);
-
-            const std::vector<ShapeKey::Builder> keys = {
-                ShapeKey::Builder(), ShapeKey::Builder().withFade(),
-                ShapeKey::Builder().withDeformed(), ShapeKey::Builder().withDeformed().withFade(),
-                ShapeKey::Builder().withDeformed().withDualQuatSkinned(), ShapeKey::Builder().withDeformed().withDualQuatSkinned().withFade(),
-                ShapeKey::Builder().withOwnPipeline(), ShapeKey::Builder().withOwnPipeline().withFade(),
-                ShapeKey::Builder().withOwnPipeline().withDeformed(), ShapeKey::Builder().withOwnPipeline().withDeformed().withFade(),
-                ShapeKey::Builder().withOwnPipeline().withDeformed().withDualQuatSkinned(), ShapeKey::Builder().withOwnPipeline().withDeformed().withDualQuatSkinned().withFade(),
-            };
-            std::vector<std::vector<ShapeKey>> sortedShapeKeys(keys.size());
-
-            const int OWN_PIPELINE_INDEX = 6;
-            for (const auto& items : inShapes) {
-                int index = items.first.hasOwnPipeline() ? OWN_PIPELINE_INDEX : 0;
-                if (items.first.isDeformed()) {
-                    index += 2;
-                    if (items.first.isDualQuatSkinned()) {
-                        index += 2;
-                    }
-                }
-
-                if (items.first.isFaded()) {
-                    index += 1;
-                }
-
-                sortedShapeKeys[index].push_back(items.first);
-            }
-
-            // Render non-withOwnPipeline things
-            for (size_t i = 0; i < OWN_PIPELINE_INDEX; i++) {
-                auto& shapeKeys = sortedShapeKeys[i];
-                if (shapeKeys.size() > 0) {
-                    const auto& shapePipeline = _shapePlumber->pickPipeline(args, keys[i]);
-                    args->_shapePipeline = shapePipeline;
-                    for (const auto& key : shapeKeys) {
-                        renderShapes(renderContext, _shapePlumber, inShapes.at(key));
-                    }
-                }
-            }
-
-            // Render withOwnPipeline things
-            for (size_t i = OWN_PIPELINE_INDEX; i < keys.size(); i++) {
-                auto& shapeKeys = sortedShapeKeys[i];
-                if (shapeKeys.size() > 0) {
-                    args->_shapePipeline = nullptr;
-                    for (const auto& key : shapeKeys) {
-                        args->_itemShapeKey = key._flags.to_ulong();
-                        renderShapes(renderContext, _shapePlumber, inShapes.at(key));
-                    }
-                }
+    // The cascades are independent of each other, so each one is recorded on a worker while the render thread
+    // moves on to the next job.  It gets its own copy of the args and context, the shapes and the framebuffer
+    // stay untouched until the end of the frame.  Items are prepared for it here, on the render thread, and those
+    // that can only render on the render thread are recorded right after, in a batch that follows it in the frame.
+    auto asyncShapes = std::make_shared<render::ShapeBounds>();
+    render::ShapeBounds syncShapes;
+    const auto& scene = renderContext->_scene;
+    for (const auto& items : inShapes) {
+        for (const auto& item : items.second) {
+            if (scene->getItem(item.id).prepareAsyncRender(args)) {
+                (*asyncShapes)[items.first].push_back(item);
+            } else {
+                syncShapes[items.first].push_back(item);
             }
-
-            args->_shapePipeline = nullptr;
         }
+    }
 
-        args->_batch = nullptr;
+    auto cascadeArgs = args->makeAsyncArgs();
+    auto cascadeContext = std::make_shared<render::RenderContext>(*renderContext);
+    cascadeContext->args = cascadeArgs.get();
+    auto shapePlumber = _shapePlumber;
+
+    gpu::doInBatchAsync("RenderShadowMap::run", args->_context, [cascadeArgs, cascadeContext, shapePlumber, fbo, inShapeBounds, asyncShapes](gpu::Batch& batch) {
+        recordShadowMap(cascadeContext, shapePlumber, fbo, inShapeBounds, *asyncShapes, true, batch);
     });
+
+    if (!syncShapes.empty()) {
+        gpu::doInBatch("RenderShadowMap::run", args->_context, [&](gpu::Batch& batch) {
+            recordShadowMap(renderContext, shapePlumber, fbo, inShapeBounds, syncShapes, false, batch);
+        });
+    }
 }
 
 RenderShadowSetup::RenderShadowSetup() :
@@ -594,7 +632,7 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
             if (antiFrustum == nullptr) {
                 for (auto& item : inItems.second) {
                     if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
+                        const auto& shapeKey = scene->getItemKey(item.id);
                         if (castersFilter.test(shapeKey)) {
                             outItems->second.emplace_back(item);
                             outBounds += item.bound;
@@ -609,7 +647,7 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
             } else {
                 for (auto& item : inItems.second) {
                     if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
+                        const auto& shapeKey = scene->getItemKey(item.id);
                         if (castersFilter.test(shapeKey)) {
                             outItems->second.emplace_back(item);
                             outBounds += item.bound;
@@ -13,6 +13,7 @@
 #include <functional>
 #include <memory>
 #include <stack>
+#include <vector>
 
 #include <GLMHelpers.h>
 #include <ViewFrustum.h>
@@ -38,6 +39,13 @@ namespace render {
             int _outOfView = 0;
             int _tooSmall = 0;
             int _rendered = 0;
+
+            void add(const Item& other) {
+                _considered += other._considered;
+                _outOfView += other._outOfView;
+                _tooSmall += other._tooSmall;
+                _rendered += other._rendered;
+            }
         };
 
         int _materialSwitches = 0;
@@ -57,6 +65,14 @@ namespace render {
                     return _other;
             }
         }
+
+        void add(const RenderDetails& other) {
+            _materialSwitches += other._materialSwitches;
+            _trianglesRendered += other._trianglesRendered;
+            _item.add(other._item);
+            _shadow.add(other._shadow);
+            _other.add(other._other);
+        }
     };
 
 
@@ -106,6 +122,22 @@ namespace render {
 
         bool isStereo() const { return _displayMode != MONO; }
 
+        // Returns a copy of these args for a batch recorded on a worker thread, with details of its own which
+        // mergeAsyncDetails() adds back once the frame has waited for its recordings, see gpu::Context::endFrame()
+        std::shared_ptr<Args> makeAsyncArgs() {
+            auto asyncArgs = std::make_shared<Args>(*this);
+            asyncArgs->_details = RenderDetails();
+            asyncArgs->_asyncArgs.clear();
+            _asyncArgs.push_back(asyncArgs);
+            return asyncArgs;
+        }
+        void mergeAsyncDetails() {
+            for (const auto& asyncArgs : _asyncArgs) {
+                _details.add(asyncArgs->_details);
+            }
+            _asyncArgs.clear();
+        }
+
         std::shared_ptr<gpu::Context> _context;
         std::shared_ptr<gpu::Framebuffer> _blitFramebuffer;
         std::shared_ptr<render::ShapePipeline> _shapePipeline;
@@ -133,6 +165,7 @@ namespace render {
         bool _enableFade { false };
 
         RenderDetails _details;
+        std::vector<std::shared_ptr<Args>> _asyncArgs;
         render::ScenePointer _scene;
         int8_t _cameraMode { -1 };
 
@@ -16,14 +16,62 @@
 
 #include <PerfStat.h>
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
+// Large inputs are culled in fixed-size blocks on the TBB worker pool.  Each block collects its own items, details
+// and bounds, which are then appended in block order, so the output is the same as a serial pass over the input.
+static const size_t CULL_BLOCK_SIZE = 512;
+
+struct CullBlock {
+    ItemBounds items;
+    RenderDetails::Item details;
+    AABox bounds;
+};
+
+template <typename F>
+static void cullInBlocks(size_t numItems, std::vector<CullBlock>& blocks, F&& cullRange) {
+    size_t numBlocks = (numItems + CULL_BLOCK_SIZE - 1) / CULL_BLOCK_SIZE;
+    blocks.clear();
+    blocks.resize(numBlocks);
+    if (numBlocks == 1) {
+        cullRange(0, numItems, blocks[0]);
+    } else if (numBlocks > 1) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t b = range.begin(); b < range.end(); b++) {
+                size_t begin = b * CULL_BLOCK_SIZE;
+                cullRange(begin, std::min(begin + CULL_BLOCK_SIZE, numItems), blocks[b]);
+            }
+        });
+    }
+}
+
+static void appendCullBlocks(const std::vector<CullBlock>& blocks, ItemBounds& outItems, RenderDetails::Item& details,
+                             AABox* outBounds = nullptr) {
+    for (const auto& block : blocks) {
+        outItems.insert(outItems.end(), block.items.begin(), block.items.end());
+        details._outOfView += block.details._outOfView;
+        details._tooSmall += block.details._tooSmall;
+        if (outBounds) {
+            *outBounds += block.bounds;
+        }
+    }
+}
+
 CullTest::CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails, ViewFrustumPointer antiFrustum) :
     _functor(functor),
     _args(pargs),
     _renderDetails(renderDetails),
     _antiFrustum(antiFrustum) {
+    const ::Plane* planes = _args->getViewFrustum().getPlanes();
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+        _planeX[i] = planes[i].getNormal().x;
+        _planeY[i] = planes[i].getNormal().y;
+        _planeZ[i] = planes[i].getNormal().z;
+        _planeD[i] = planes[i].getDCoefficient();
+    }
+
     // FIXME: Keep this code here even though we don't use it yet
     /*_eyePos = _args->getViewFrustum().getPosition();
     float a = glm::degrees(Octree::getPerspectiveAccuracyAngle(_args->_sizeScale, _args->_boundaryLevelAdjust));
@@ -42,6 +90,47 @@ bool CullTest::frustumTest(const AABox& bound) {
     return true;
 }
 
+void CullTest::boxesInFrustum(const AABox* const* bounds, int numBounds, bool* inView) const {
+    assert(numBounds <= BATCH_SIZE);
+    if (numBounds <= 0) {
+        return;
+    }
+
+    float cornerX[BATCH_SIZE];
+    float cornerY[BATCH_SIZE];
+    float cornerZ[BATCH_SIZE];
+    float scaleX[BATCH_SIZE];
+    float scaleY[BATCH_SIZE];
+    float scaleZ[BATCH_SIZE];
+    bool outside[BATCH_SIZE];
+    for (int i = 0; i < BATCH_SIZE; i++) {
+        const AABox& bound = *bounds[std::min(i, numBounds - 1)];
+        cornerX[i] = bound.getCorner().x;
+        cornerY[i] = bound.getCorner().y;
+        cornerZ[i] = bound.getCorner().z;
+        scaleX[i] = bound.getScale().x;
+        scaleY[i] = bound.getScale().y;
+        scaleZ[i] = bound.getScale().z;
+        outside[i] = false;
+    }
+
+    // like ViewFrustum::boxIntersectsFrustum: a box is out once its farthest vertex along a plane normal is behind it
+    for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+        float farX = (_planeX[p] > 0.0f) ? 1.0f : 0.0f;
+        float farY = (_planeY[p] > 0.0f) ? 1.0f : 0.0f;
+        float farZ = (_planeZ[p] > 0.0f) ? 1.0f : 0.0f;
+        for (int i = 0; i < BATCH_SIZE; i++) {
+            float distance = _planeX[p] * (cornerX[i] + farX * scaleX[i]) + _planeY[p] * (cornerY[i] + farY * scaleY[i]) +
+                             _planeZ[p] * (cornerZ[i] + farZ * scaleZ[i]) + _planeD[p];
+            outside[i] = outside[i] || (distance < 0.0f);
+        }
+    }
+
+    for (int i = 0; i < numBounds; i++) {
+        inView[i] = !outside[i];
+    }
+}
+
 bool CullTest::antiFrustumTest(const AABox& bound) {
     assert(_antiFrustum);
     if (_antiFrustum->boxInsideFrustum(bound)) {
@@ -70,37 +159,35 @@ void render::cullItems(const RenderContextPointer& renderContext, const CullFunc
     assert(renderContext->args->hasViewFrustum());
 
     RenderArgs* args = renderContext->args;
-    const ViewFrustum& frustum = args->getViewFrustum();
 
     details._considered += (int)inItems.size();
 
     // Culling / LOD
-    for (auto item : inItems) {
-        if (item.bound.isNull()) {
-            outItems.emplace_back(item); // One more Item to render
-            continue;
+    CullFunctor functor = cullFunctor;
+    CullTest test(functor, args, details);
+    const AABox* batchBounds[CullTest::BATCH_SIZE];
+    bool inView[CullTest::BATCH_SIZE];
+    for (size_t begin = 0; begin < inItems.size(); begin += CullTest::BATCH_SIZE) {
+        int batchSize = (int)std::min(inItems.size() - begin, (size_t)CullTest::BATCH_SIZE);
+        for (int j = 0; j < batchSize; j++) {
+            batchBounds[j] = &inItems[begin + j].bound;
         }
+        test.boxesInFrustum(batchBounds, batchSize, inView);
 
-        // TODO: some entity types (like lights) might want to be rendered even
-        // when they are outside of the view frustum...
-        bool inView;
-        {
-            PerformanceTimer perfTimer("boxIntersectsFrustum");
-            inView = frustum.boxIntersectsFrustum(item.bound);
-        }
-        if (inView) {
-            bool bigEnoughToRender;
-            {
-                PerformanceTimer perfTimer("shouldRender");
-                bigEnoughToRender = cullFunctor(args, item.bound);
+        for (int j = 0; j < batchSize; j++) {
+            const auto& item = inItems[begin + j];
+            if (item.bound.isNull()) {
+                outItems.emplace_back(item); // One more Item to render
+                continue;
             }
-            if (bigEnoughToRender) {
+
+            // TODO: some entity types (like lights) might want to be rendered even
+            // when they are outside of the view frustum...
+            if (!inView[j]) {
+                details._outOfView++;
+            } else if (test.solidAngleTest(item.bound)) {
                 outItems.emplace_back(item); // One more Item to render
-            } else {
-                details._tooSmall++;
             }
-        } else {
-            details._outOfView++;
         }
     }
     details._rendered += (int)outItems.size();
@@ -116,9 +203,8 @@ void FetchNonspatialItems::run(const RenderContextPointer& renderContext, const
     const auto& items = scene->getNonspatialSet();
     outItems.reserve(items.size());
     for (auto& id : items) {
-        auto& item = scene->getItem(id);
-        if (filter.test(item.getKey())) {
-            outItems.emplace_back(ItemBound(id, item.getBound()));
+        if (filter.test(scene->getItemKey(id))) {
+            outItems.emplace_back(ItemBound(id, scene->getItemBound(id)));
         }
     }
 }
@@ -203,8 +289,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
     }
 
-    CullTest test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -212,141 +296,81 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     const auto srcFilter = inputs.get1();
     if (!srcFilter.selectsNothing()) {
         auto filter = render::ItemFilter::Builder(srcFilter).withoutSubMetaCulled().build();
+        bool skipCulling = _skipCulling || _overrideSkipCulling;
+        std::vector<CullBlock> blocks;
 
         // Now get the bound, and
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
+        auto selectItems = [&](const ItemIDs& itemIDs, bool testFrustum, bool testSolidAngle) {
+            testFrustum = testFrustum && !skipCulling;
+            testSolidAngle = testSolidAngle && !skipCulling;
+            cullInBlocks(itemIDs.size(), blocks, [&](size_t begin, size_t end, CullBlock& block) {
+                CullTest test(_cullFunctor, args, block.details);
+
+                // keys and bounds come from the scene's dense copies, the payloads are only visited for meta items
+                ItemID batchIDs[CullTest::BATCH_SIZE];
+                const AABox* batchBounds[CullTest::BATCH_SIZE];
+                bool inView[CullTest::BATCH_SIZE];
+                int batchSize = 0;
+                auto cullBatch = [&] {
+                    if (testFrustum) {
+                        test.boxesInFrustum(batchBounds, batchSize, inView);
                     }
-                }
-            }
-
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
+                    for (int j = 0; j < batchSize; j++) {
+                        if (testFrustum && !inView[j]) {
+                            block.details._outOfView++;
+                            continue;
                         }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
+                        if (testSolidAngle && !test.solidAngleTest(*batchBounds[j])) {
+                            continue;
                         }
-                    }
-                }
-            }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
+                        block.items.emplace_back(batchIDs[j], *batchBounds[j]);
+                        if (scene->getItemKey(batchIDs[j]).isMetaCullGroup()) {
+                            scene->getItem(batchIDs[j]).fetchMetaSubItemBounds(block.items, (*scene));
                         }
                     }
-                }
-            }
-
-        } else {
-
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
+                    batchSize = 0;
+                };
+
+                for (size_t i = begin; i < end; i++) {
+                    auto id = itemIDs[i];
+                    if (filter.test(scene->getItemKey(id))) {
+                        batchIDs[batchSize] = id;
+                        batchBounds[batchSize] = &scene->getItemBound(id);
+                        if (++batchSize == CullTest::BATCH_SIZE) {
+                            cullBatch();
                         }
                     }
                 }
-            }
+                cullBatch();
+            });
+            appendCullBlocks(blocks, outItems, details);
+        };
 
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
-            }
+        // inside & fit items: easy, just filter
+        {
+            PerformanceTimer perfTimer("insideFitItems");
+            selectItems(inSelection.insideItems, false, false);
+        }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
-            }
+        // inside & subcell items: filter & distance cull
+        {
+            PerformanceTimer perfTimer("insideSmallItems");
+            selectItems(inSelection.insideSubcellItems, false, true);
+        }
 
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            if (test.solidAngleTest(itemBound.bound)) {
-                                outItems.emplace_back(itemBound);
-                                if (item.getKey().isMetaCullGroup()) {
-                                    item.fetchMetaSubItemBounds(outItems, (*scene));
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & fit items: filter & frustum cull
+        {
+            PerformanceTimer perfTimer("partialFitItems");
+            selectItems(inSelection.partialItems, true, false);
+        }
+
+        // partial & subcell items:: filter & frutum cull & solidangle cull
+        {
+            PerformanceTimer perfTimer("partialSmallItems");
+            selectItems(inSelection.partialSubcellItems, true, true);
         }
     }
 
@@ -380,8 +404,8 @@ void CullShapeBounds::run(const RenderContextPointer& renderContext, const Input
 
     if (!cullFilter.selectsNothing() || !boundsFilter.selectsNothing()) {
         auto& details = args->_details.edit(_detailType);
-        CullTest test(_cullFunctor, args, details, antiFrustum);
         auto scene = args->_scene;
+        std::vector<CullBlock> blocks;
 
         for (auto& inItems : inShapes) {
             auto key = inItems.first;
@@ -393,31 +417,41 @@ void CullShapeBounds::run(const RenderContextPointer& renderContext, const Input
 
             details._considered += (int)inItems.second.size();
 
-            if (antiFrustum == nullptr) {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (cullFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                        }
-                        if (boundsFilter.test(shapeKey)) {
-                            outBounds += item.bound;
-                        }
+            const auto& items = inItems.second;
+            cullInBlocks(items.size(), blocks, [&](size_t begin, size_t end, CullBlock& block) {
+                CullTest test(_cullFunctor, args, block.details, antiFrustum);
+                const AABox* batchBounds[CullTest::BATCH_SIZE];
+                bool inView[CullTest::BATCH_SIZE];
+                for (size_t batchBegin = begin; batchBegin < end; batchBegin += CullTest::BATCH_SIZE) {
+                    int batchSize = (int)std::min(end - batchBegin, (size_t)CullTest::BATCH_SIZE);
+                    for (int j = 0; j < batchSize; j++) {
+                        batchBounds[j] = &items[batchBegin + j].bound;
                     }
-                }
-            } else {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (cullFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
+                    test.boxesInFrustum(batchBounds, batchSize, inView);
+
+                    for (int j = 0; j < batchSize; j++) {
+                        const auto& item = items[batchBegin + j];
+                        if (!test.solidAngleTest(item.bound)) {
+                            continue;
                         }
-                        if (boundsFilter.test(shapeKey)) {
-                            outBounds += item.bound;
+                        if (!inView[j]) {
+                            block.details._outOfView++;
+                            continue;
+                        }
+                        if (antiFrustum == nullptr || test.antiFrustumTest(item.bound)) {
+                            const auto& shapeKey = scene->getItemKey(item.id);
+                            if (cullFilter.test(shapeKey)) {
+                                block.items.emplace_back(item);
+                            }
+                            if (boundsFilter.test(shapeKey)) {
+                                block.bounds += item.bound;
+                            }
                         }
                     }
                 }
-            }
+            });
+            appendCullBlocks(blocks, outItems->second, details, &outBounds);
+
             details._rendered += (int)outItems->second.size();
         }
 
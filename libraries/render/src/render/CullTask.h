@@ -31,11 +31,22 @@ namespace render {
         glm::vec3 _eyePos;
         float _squareTanAlpha;
 
+        // The view frustum planes, one array per component so boxesInFrustum vectorizes
+        float _planeX[NUM_FRUSTUM_PLANES];
+        float _planeY[NUM_FRUSTUM_PLANES];
+        float _planeZ[NUM_FRUSTUM_PLANES];
+        float _planeD[NUM_FRUSTUM_PLANES];
+
+        static const int BATCH_SIZE = 8;
+
         CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails, ViewFrustumPointer antiFrustum = nullptr);
 
         bool frustumTest(const AABox& bound);
         bool antiFrustumTest(const AABox& bound);
         bool solidAngleTest(const AABox& bound);
+
+        // Same test as frustumTest for up to BATCH_SIZE bounds at once, without counting the culled ones
+        void boxesInFrustum(const AABox* const* bounds, int numBounds, bool* inView) const;
     };
 
     class FetchNonspatialItems {
@@ -107,7 +107,7 @@ uint32_t Item::fetchMetaSubItemBounds(ItemBounds& subItemBounds, Scene& scene) c
         if (scene.isAllocatedID(id)) {
             auto& item = scene.getItem(id);
             if (item.exist()) {
-                subItemBounds.emplace_back(id, item.getBound());
+                subItemBounds.emplace_back(id, scene.getItemBound(id));
             } else {
                 numSubs--;
             }
@@ -431,6 +431,7 @@ public:
         virtual const ItemKey getKey() const = 0;
         virtual const Bound getBound() const = 0;
         virtual void render(RenderArgs* args) = 0;
+        virtual bool prepareAsyncRender(RenderArgs* args) = 0;
 
         virtual const ShapeKey getShapeKey() const = 0;
 
@@ -480,6 +481,10 @@ public:
     // Render call for the item
     void render(RenderArgs* args) const { _payload->render(args); }
 
+    // Called on the render thread before the item is rendered in a batch recorded on a worker thread,
+    // returns false if the item has to be rendered on the render thread instead
+    bool prepareAsyncRender(RenderArgs* args) const { return _payload->prepareAsyncRender(args); }
+
     // Shape Type Interface
     const ShapeKey getShapeKey() const;
 
@@ -527,6 +532,12 @@ template <class T> const ItemKey payloadGetKey(const std::shared_ptr<T>& payload
 template <class T> const Item::Bound payloadGetBound(const std::shared_ptr<T>& payloadData) { return Item::Bound(); }
 template <class T> void payloadRender(const std::shared_ptr<T>& payloadData, RenderArgs* args) { }
 
+// Async render interface
+// A payload can be rendered in a batch recorded on a worker thread (see gpu::doInBatchAsync) if its render only reads
+// state that nothing else changes during the frame. Specialize this to bring that state up to date on the render
+// thread and return true. By default payloads are always rendered on the render thread.
+template <class T> bool payloadPrepareAsyncRender(const std::shared_ptr<T>& payloadData, RenderArgs* args) { return false; }
+
 // Shape type interface
 // This allows shapes to characterize their pipeline via a ShapeKey, to be picked with a subclass of Shape.
 // When creating a new shape payload you need to create a specialized version, or the ShapeKey will be ownPipeline,
@@ -554,6 +565,7 @@ public:
     virtual const Item::Bound getBound() const override { return payloadGetBound<T>(_data); }
 
     virtual void render(RenderArgs* args) override { payloadRender<T>(_data, args); }
+    virtual bool prepareAsyncRender(RenderArgs* args) override { return payloadPrepareAsyncRender<T>(_data, args); }
 
     // Shape Type interface
     virtual const ShapeKey getShapeKey() const override { return shapeGetShapeKey<T>(_data); }
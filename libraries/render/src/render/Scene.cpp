@@ -185,6 +185,8 @@ Scene::Scene(glm::vec3 origin, float size) :
     _masterSpatialTree(origin, size)
 {
     _items.push_back(Item()); // add the itemID #0 to nothing
+    _itemKeys.push_back(ItemKey());
+    _itemBounds.push_back(Item::Bound());
 }
 
 Scene::~Scene() {
@@ -257,6 +259,8 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         ItemID maxID = _IDAllocator.load();
         if (maxID > _items.size()) {
             _items.resize(maxID + 100); // allocate the maxId and more
+            _itemKeys.resize(_items.size());
+            _itemBounds.resize(_items.size());
         }
         // Now we know for sure that we have enough items in the array to
         // capture anything coming from the transaction
@@ -290,6 +294,11 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
     queryHighlights(transaction._highlightQueries);
 }
 
+void Scene::resetItemKeyAndBound(ItemID id, const ItemKey& key, const Item::Bound& bound) {
+    _itemKeys[id] = key;
+    _itemBounds[id] = bound;
+}
+
 void Scene::resetItems(const Transaction::Resets& transactions) {
     for (auto& reset : transactions) {
         // Access the true item
@@ -301,11 +310,13 @@ void Scene::resetItems(const Transaction::Resets& transactions) {
         // Reset the item with a new payload
         item.resetPayload(std::get<1>(reset));
         auto newKey = item.getKey();
+        auto newBound = item.getBound();
+        resetItemKeyAndBound(itemId, newKey, newBound);
 
         // Update the item's container
         assert((oldKey.isSpatial() == newKey.isSpatial()) || oldKey._flags.none());
         if (newKey.isSpatial()) {
-            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), itemId, newKey);
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, newBound, itemId, newKey);
             item.resetCell(newCell, newKey.isSmall());
         } else {
             _masterNonspatialSet.insert(itemId);
@@ -332,6 +343,7 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
 
         // Kill it
         item.kill();
+        resetItemKeyAndBound(removedID, ItemKey(), Item::Bound());
     }
 }
 
@@ -357,18 +369,20 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
         // Update the item
         item.update(std::get<1>(update));
         auto newKey = item.getKey();
+        auto newBound = item.getBound();
+        resetItemKeyAndBound(updateID, newKey, newBound);
 
         // Update the item's container
         if (oldKey.isSpatial() == newKey.isSpatial()) {
             if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, newBound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             }
         } else {
             if (newKey.isSpatial()) {
                 _masterNonspatialSet.erase(updateID);
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, newBound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             } else {
                 _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
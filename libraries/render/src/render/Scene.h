@@ -175,6 +175,11 @@ public:
     // Same as getItem, checking if the id is valid
     const Item getItemSafe(const ItemID& id) const { if (isAllocatedID(id)) { return _items[id]; } else { return Item(); } }
 
+    // Dense copies of the items' keys and bounds, refreshed whenever an item is reset or updated by a Transaction.
+    // Culling reads these instead of calling through each payload. Same lack of validity check as getItem
+    const ItemKey& getItemKey(const ItemID& id) const { return _itemKeys[id]; }
+    const Item::Bound& getItemBound(const ItemID& id) const { return _itemBounds[id]; }
+
     // Access the spatialized items
     const ItemSpatialTree& getSpatialTree() const { return _masterSpatialTree; }
 
@@ -215,9 +220,13 @@ protected:
     // database of items is protected for editing by a mutex
     std::mutex _itemsMutex;
     Item::Vector _items;
+    std::vector<ItemKey> _itemKeys; // indexed by ItemID, matching _items
+    std::vector<Item::Bound> _itemBounds;
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
 
+    void resetItemKeyAndBound(ItemID id, const ItemKey& key, const Item::Bound& bound);
+
     void resetItems(const Transaction::Resets& transactions);
     void resetTransitionFinishedOperator(const Transaction::TransitionFinishedOperators& transactions);
     void removeItems(const Transaction::Removes& transactions);
@@ -119,6 +119,37 @@ void ShapePlumber::addPipeline(const Filter& filter, const gpu::ShaderPointer& p
     }
 }
 
+ShapePipelinePointer ShapePlumber::findPipeline(RenderArgs* args, const Key& key) const {
+    std::lock_guard<std::mutex> lock(_pipelineMutex);
+
+    auto pipelineIterator = _pipelineMap.find(key);
+    if (pipelineIterator != _pipelineMap.end()) {
+        return pipelineIterator->second;
+    }
+
+    // The first time we can't find a pipeline, we should try things to solve that
+    if (_missingKeys.find(key) == _missingKeys.end()) {
+        if (key.isCustom()) {
+            auto factoryIt = ShapePipeline::_globalCustomFactoryMap.find(key.getCustom());
+            if ((factoryIt != ShapePipeline::_globalCustomFactoryMap.end()) && (factoryIt)->second) {
+                // found a factory for the custom key, can now generate a shape pipeline for this case:
+                addPipelineHelper(Filter(key), key, 0, (factoryIt)->second(*this, key, args));
+
+                pipelineIterator = _pipelineMap.find(key);
+                if (pipelineIterator != _pipelineMap.end()) {
+                    return pipelineIterator->second;
+                }
+            } else {
+                qCDebug(renderlogging) << "ShapePlumber::Couldn't find a custom pipeline factory for " << key.getCustom() << " key is: " << key;
+            }
+        }
+
+        _missingKeys.insert(key);
+        qCDebug(renderlogging) << "ShapePlumber::Couldn't find a pipeline for" << key;
+    }
+    return PipelinePointer(nullptr);
+}
+
 const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Key& key) const {
     assert(!_pipelineMap.empty());
     assert(args);
@@ -126,30 +157,11 @@ const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Ke
 
     PerformanceTimer perfTimer("ShapePlumber::pickPipeline");
 
-    auto pipelineIterator = _pipelineMap.find(key);
-    if (pipelineIterator == _pipelineMap.end()) {
-        // The first time we can't find a pipeline, we should try things to solve that
-        if (_missingKeys.find(key) == _missingKeys.end()) {
-            if (key.isCustom()) {
-                auto factoryIt = ShapePipeline::_globalCustomFactoryMap.find(key.getCustom());
-                if ((factoryIt != ShapePipeline::_globalCustomFactoryMap.end()) && (factoryIt)->second) {
-                    // found a factory for the custom key, can now generate a shape pipeline for this case:
-                    addPipelineHelper(Filter(key), key, 0, (factoryIt)->second(*this, key, args));
-
-                    return pickPipeline(args, key);
-                } else {
-                    qCDebug(renderlogging) << "ShapePlumber::Couldn't find a custom pipeline factory for " << key.getCustom() << " key is: " << key;
-                }
-            }
-
-           _missingKeys.insert(key);
-            qCDebug(renderlogging) << "ShapePlumber::Couldn't find a pipeline for" << key;
-        }
+    PipelinePointer shapePipeline = findPipeline(args, key);
+    if (!shapePipeline) {
         return PipelinePointer(nullptr);
     }
 
-    PipelinePointer shapePipeline(pipelineIterator->second);
-
     // Setup the one pipeline (to rule them all)
     args->_batch->setPipeline(shapePipeline->pipeline);
 
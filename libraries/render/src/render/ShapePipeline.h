@@ -12,6 +12,7 @@
 #ifndef hifi_render_ShapePipeline_h
 #define hifi_render_ShapePipeline_h
 
+#include <mutex>
 #include <unordered_set>
 
 #include <gpu/Batch.h>
@@ -341,6 +342,7 @@ public:
     void addPipeline(const Filter& filter, const gpu::ShaderPointer& program, const gpu::StatePointer& state,
         BatchSetter batchSetter = nullptr, ItemSetter itemSetter = nullptr);
 
+    // Safe to call from several threads recording batches at once
     const PipelinePointer pickPipeline(RenderArgs* args, const Key& key) const;
 
 protected:
@@ -348,6 +350,10 @@ protected:
     mutable PipelineMap _pipelineMap;
 
 private:
+    PipelinePointer findPipeline(RenderArgs* args, const Key& key) const;
+
+    // Guards the map and missing keys, which are filled in lazily when picking a pipeline
+    mutable std::mutex _pipelineMutex;
     mutable std::unordered_set<Key, Key::Hash, Key::KeyEqual> _missingKeys;
 };
 
@@ -14,39 +14,63 @@
 
 #include <assert.h>
 #include <ViewFrustum.h>
+#include <TBBHelpers.h>
+
+#include <tbb/parallel_sort.h>
 
 using namespace render;
 
+// Below this many items the depths are computed and sorted on the calling thread
+static const size_t PARALLEL_SORT_THRESHOLD = 2048;
+
 struct ItemBoundSort {
     float _centerDepth = 0.0f;
     float _nearDepth = 0.0f;
     float _farDepth = 0.0f;
     ItemID _id = 0;
+    uint32_t _index = 0;
     AABox _bounds;
 
     ItemBoundSort() {}
-    ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
+    ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, uint32_t index, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _index(index), _bounds(bounds) {}
 };
 
+// Equal depths are ordered by id and then input position, so that the order (and which duplicate survives)
+// doesn't depend on the sort algorithm or on how the work was split between threads
 struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
+    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) const {
+        if (left._centerDepth != right._centerDepth) {
+            return (left._centerDepth < right._centerDepth);
+        }
+        return (left._id != right._id) ? (left._id < right._id) : (left._index < right._index);
     }
 };
 
 struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
+    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) const {
+        if (left._centerDepth != right._centerDepth) {
+            return (left._centerDepth > right._centerDepth);
+        }
+        return (left._id != right._id) ? (left._id < right._id) : (left._index < right._index);
     }
 };
 
+template <typename Compare>
+static void sortItemBounds(std::vector<ItemBoundSort>& itemBoundSorts, const Compare& compare) {
+    if (itemBoundSorts.size() < PARALLEL_SORT_THRESHOLD) {
+        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), compare);
+    } else {
+        tbb::parallel_sort(itemBoundSorts.begin(), itemBoundSorts.end(), compare);
+    }
+}
+
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, 
                             const ItemBounds& inItems, ItemBounds& outItems, AABox* bounds) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
+    const ViewFrustum& frustum = args->getViewFrustum();
 
 
     // Allocate and simply copy
@@ -55,24 +79,32 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
 
 
     // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
+    std::vector<ItemBoundSort> itemBoundSorts(inItems.size());
 
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound();
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
+    auto evalDepths = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const auto& itemDetails = inItems[i];
+            auto bound = itemDetails.bound; // item.getBound();
+            float distanceSquared = frustum.distanceToCameraSquared(bound.calcCenter());
 
-        itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
+            itemBoundSorts[i] = ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, (uint32_t)i, bound);
+        }
+    };
+    if (inItems.size() < PARALLEL_SORT_THRESHOLD) {
+        evalDepths(0, inItems.size());
+    } else {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, inItems.size()), [&](const tbb::blocked_range<size_t>& range) {
+            evalDepths(range.begin(), range.end());
+        });
     }
 
     // sort against Z
     if (frontToBack) {
         FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
+        sortItemBounds(itemBoundSorts, frontToBackSort);
     } else {
         BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
+        sortItemBounds(itemBoundSorts, backToFrontSort);
     }
 
     // Finally once sorted result to a list of itemID and keep uniques
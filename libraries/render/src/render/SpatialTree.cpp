@@ -10,6 +10,8 @@
 //
 #include "SpatialTree.h"
 
+#include <algorithm>
+
 #include <ViewFrustum.h>
 
 using namespace render;
@@ -445,12 +447,7 @@ int Octree::select(CellSelection& selection, const FrustumSelector& selector) co
     selectCellBrick(cellID, selection, false);
 
     // then traverse deeper
-    for (int i = 0; i < NUM_OCTANTS; i++) {
-        Index subCellID = cell.child((Link)i);
-        if (subCellID != INVALID_CELL) {
-            selectTraverse(subCellID, selection, selector);
-        }
-    }
+    selectChildren(cell, selection, selector);
 
     return (int)selection.size() - numSelectedsIn;
 }
@@ -514,6 +511,111 @@ Octree::Location::Intersection Octree::Location::intersectCell(const Location& c
     return Inside;
 }
 
+void Octree::Location::intersectCells(const Location* cells, int numCells, const Coord4f frustum[6], Intersection* intersections) {
+    assert(numCells <= NUM_OCTANTS);
+    if (numCells <= 0) {
+        return;
+    }
+
+    // cell bounds as separate arrays of fixed width, so that each plane is tested against every cell in one pass
+    float minX[NUM_OCTANTS];
+    float minY[NUM_OCTANTS];
+    float minZ[NUM_OCTANTS];
+    float size[NUM_OCTANTS];
+    bool outside[NUM_OCTANTS];
+    bool partial[NUM_OCTANTS];
+    for (int i = 0; i < NUM_OCTANTS; i++) {
+        int c = std::min(i, numCells - 1);
+        size[i] = Octree::getInvDepthDimension(cells[c].depth);
+        minX[i] = (float)cells[c].pos.x * size[i];
+        minY[i] = (float)cells[c].pos.y * size[i];
+        minZ[i] = (float)cells[c].pos.z * size[i];
+        outside[i] = false;
+        partial[i] = false;
+    }
+
+    for (int p = 0; p < ViewFrustum::NUM_PLANES; p++) {
+        const Coord4f& plane = frustum[p];
+
+        // the corner furthest along the plane normal is the last one to leave the half space,
+        // and the nearest corner the first, as in intersectCell
+        Coord3f farOffset((plane.x >= 0.0f) ? 1.0f : 0.0f, (plane.y >= 0.0f) ? 1.0f : 0.0f, (plane.z >= 0.0f) ? 1.0f : 0.0f);
+        Coord3f nearOffset((-plane.x >= 0.0f) ? 1.0f : 0.0f, (-plane.y >= 0.0f) ? 1.0f : 0.0f, (-plane.z >= 0.0f) ? 1.0f : 0.0f);
+
+        for (int i = 0; i < NUM_OCTANTS; i++) {
+            float farDistance = plane.x * (minX[i] + size[i] * farOffset.x) + plane.y * (minY[i] + size[i] * farOffset.y) +
+                                plane.z * (minZ[i] + size[i] * farOffset.z) + plane.w;
+            float nearDistance = plane.x * (minX[i] + size[i] * nearOffset.x) + plane.y * (minY[i] + size[i] * nearOffset.y) +
+                                 plane.z * (minZ[i] + size[i] * nearOffset.z) + plane.w;
+            outside[i] = outside[i] || (farDistance < 0.0f);
+            partial[i] = partial[i] || (nearDistance < 0.0f);
+        }
+    }
+
+    for (int i = 0; i < numCells; i++) {
+        intersections[i] = outside[i] ? Outside : (partial[i] ? Intersect : Inside);
+    }
+}
+
+int Octree::selectChildren(const Cell& cell, CellSelection& selection, const FrustumSelector& selector) const {
+    int numSelectedsIn = (int) selection.size();
+
+    // test all the children against the frustum together, then descend into the visible ones
+    Index childIDs[NUM_OCTANTS];
+    Location childLocations[NUM_OCTANTS];
+    int numChildren = 0;
+    for (int i = 0; i < NUM_OCTANTS; i++) {
+        Index subCellID = cell.child((Link)i);
+        if (subCellID != INVALID_CELL) {
+            childIDs[numChildren] = subCellID;
+            childLocations[numChildren] = getConcreteCell(subCellID).getlocation();
+            numChildren++;
+        }
+    }
+    if (numChildren == 0) {
+        return 0;
+    }
+
+    Location::Intersection intersections[NUM_OCTANTS];
+    Location::intersectCells(childLocations, numChildren, selector.frustum, intersections);
+
+    for (int i = 0; i < numChildren; i++) {
+        switch (intersections[i]) {
+            case Octree::Location::Outside:
+                break;
+            case Octree::Location::Inside:
+                selectBranch(childIDs[i], selection, selector);
+                break;
+            case Octree::Location::Intersect:
+            default:
+                selectPartial(childIDs[i], selection, selector);
+                break;
+        }
+    }
+
+    return (int) selection.size() - numSelectedsIn;
+}
+
+int Octree::selectPartial(Index cellID, CellSelection& selection, const FrustumSelector& selector) const {
+    int numSelectedsIn = (int) selection.size();
+    const auto& cell = getConcreteCell(cellID);
+
+    // Test for lod
+    auto cellLocation = cell.getlocation();
+    float test = selector.testThreshold(cellLocation.getCenter(), Octree::getCoordSubcellWidth(cellLocation.depth));
+    if (test < 0.0f) {
+        return 0;
+    }
+
+    // Select this cell partially in frustum
+    selectCellBrick(cellID, selection, false);
+
+    // then traverse deeper
+    selectChildren(cell, selection, selector);
+
+    return (int) selection.size() - numSelectedsIn;
+}
+
 int Octree::selectTraverse(Index cellID, CellSelection& selection, const FrustumSelector& selector) const {
     int numSelectedsIn = (int) selection.size();
     auto cell = getConcreteCell(cellID);
@@ -534,24 +636,7 @@ int Octree::selectTraverse(Index cellID, CellSelection& selection, const Frustum
         case Octree::Location::Intersect:
         default: {
             // Cell is partially in
-
-            // Test for lod
-            auto cellLocation = cell.getlocation();
-            float test = selector.testThreshold(cellLocation.getCenter(), Octree::getCoordSubcellWidth(cellLocation.depth));
-            if (test < 0.0f) {
-                return 0;
-            }
-
-            // Select this cell partially in frustum
-            selectCellBrick(cellID, selection, false);
-
-            // then traverse deeper
-            for (int i = 0; i < NUM_OCTANTS; i++) {
-                Index subCellID = cell.child((Link)i);
-                if (subCellID != INVALID_CELL) {
-                    selectTraverse(subCellID, selection, selector);
-                }
-            }
+            selectPartial(cellID, selection, selector);
         }
     }
 
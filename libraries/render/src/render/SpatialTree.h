@@ -164,6 +164,9 @@ namespace render {
                 Inside,
             };
             static Intersection intersectCell(const Location& cell, const Coord4f frustum[6]);
+
+            // Same test for up to NUM_OCTANTS cells at once, laid out so the plane tests run across all cells in parallel
+            static void intersectCells(const Location* cells, int numCells, const Coord4f frustum[6], Intersection* intersections);
         };
         using Locations = Location::vector;
 
@@ -338,6 +341,8 @@ namespace render {
         int select(CellSelection& selection, const FrustumSelector& selector) const;
         int selectTraverse(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
         int selectBranch(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
+        int selectPartial(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
+        int selectChildren(const Cell& cell, CellSelection& selection, const FrustumSelector& selector) const;
         int selectCellBrick(Index cellID, CellSelection& selection, bool inside) const;
 
 
@@ -13,6 +13,8 @@
 
 #include <zlib.h>
 
+#include <QtCore/QIODevice>
+
 const int GZIP_WINDOWS_BIT = 31;
 const int GZIP_CHUNK_SIZE = 4096;
 const int DEFAULT_MEM_LEVEL = 8;
@@ -153,3 +155,74 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     deflateEnd(&strm);
     return status == Z_STREAM_END;
 }
+
+GzipWriter::GzipWriter(QIODevice& device, int compressionLevel) :
+    _device(device),
+    _stream(new z_stream())
+{
+    _stream->zalloc = Z_NULL;
+    _stream->zfree = Z_NULL;
+    _stream->opaque = Z_NULL;
+    _stream->next_in = Z_NULL;
+    _stream->avail_in = 0;
+
+    int status = deflateInit2(_stream.get(),
+                              qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel)),
+                              Z_DEFLATED,
+                              GZIP_WINDOWS_BIT,
+                              DEFAULT_MEM_LEVEL,
+                              Z_DEFAULT_STRATEGY);
+    _initialized = (status == Z_OK);
+    _ok = _initialized;
+}
+
+GzipWriter::~GzipWriter() {
+    if (_initialized) {
+        deflateEnd(_stream.get());
+    }
+}
+
+bool GzipWriter::write(const QByteArray& data) {
+    if (!_ok || _finished) {
+        return false;
+    }
+    if (data.isEmpty()) {
+        return true;
+    }
+
+    _stream->next_in = (unsigned char*)data.constData();
+    _stream->avail_in = (uInt)data.length();
+    return deflateToDevice(Z_NO_FLUSH);
+}
+
+bool GzipWriter::finish() {
+    if (!_ok || _finished) {
+        return false;
+    }
+    _finished = true;
+
+    _stream->next_in = Z_NULL;
+    _stream->avail_in = 0;
+    return deflateToDevice(Z_FINISH);
+}
+
+bool GzipWriter::deflateToDevice(int flush) {
+    int status;
+    do {
+        char out[GZIP_CHUNK_SIZE];
+        _stream->next_out = (unsigned char*)out;
+        _stream->avail_out = GZIP_CHUNK_SIZE;
+        status = deflate(_stream.get(), flush);
+        if (status == Z_STREAM_ERROR) {
+            _ok = false;
+            return false;
+        }
+        int available = (GZIP_CHUNK_SIZE - _stream->avail_out);
+        if (available > 0 && _device.write(out, available) != available) {
+            _ok = false;
+            return false;
+        }
+    } while (_stream->avail_out == 0 || (flush == Z_FINISH && status != Z_STREAM_END));
+
+    return true;
+}
@@ -12,8 +12,13 @@
 #ifndef GZIP_H
 #define GZIP_H
 
+#include <memory>
+
 #include <QByteArray>
 
+class QIODevice;
+struct z_stream_s;
+
 // The compression level must be Z_DEFAULT_COMPRESSION (-1), or between 0 and
 // 9: 1 gives best speed, 9 gives best compression, 0 gives no
 // compression at all (the input data is simply copied a block at a
@@ -24,4 +29,26 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// Compresses data handed over in pieces into one gzip stream written to a device, so that large content
+// doesn't have to be assembled in memory before it is gzipped.
+class GzipWriter {
+public:
+    GzipWriter(QIODevice& device, int compressionLevel = -1); // -1 is Z_DEFAULT_COMPRESSION
+    ~GzipWriter();
+
+    bool write(const QByteArray& data);
+
+    // Ends the gzip stream; nothing can be written afterwards
+    bool finish();
+
+private:
+    bool deflateToDevice(int flush);
+
+    QIODevice& _device;
+    std::unique_ptr<z_stream_s> _stream;
+    bool _initialized { false };
+    bool _ok { false };
+    bool _finished { false };
+};
+
 #endif
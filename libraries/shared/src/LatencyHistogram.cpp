@@ -0,0 +1,98 @@
+//
+//  LatencyHistogram.cpp
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+static int mostSignificantBit(uint32_t value) {
+    int bit = 0;
+    for (int shift = 16; shift > 0; shift >>= 1) {
+        if (value >= (1u << shift)) {
+            value >>= shift;
+            bit += shift;
+        }
+    }
+    return bit;
+}
+
+int LatencyHistogram::bucketForValue(uint64_t usecs) {
+    uint32_t value = (uint32_t)std::min(usecs, (uint64_t)UINT32_MAX);
+    if (value < (uint32_t)SUB_BUCKETS) {
+        return (int)value;
+    }
+
+    // the bits below the leading one pick the sub-bucket within its power of two
+    int shift = mostSignificantBit(value) - SUB_BUCKET_BITS;
+    int subBucket = (int)(value >> shift) - SUB_BUCKETS;
+    return (shift + 1) * SUB_BUCKETS + subBucket;
+}
+
+uint64_t LatencyHistogram::highestValueInBucket(int bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return (uint64_t)bucket;
+    }
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t lowest = (uint64_t)(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return lowest + (1ULL << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t usecs) {
+    ++_buckets[bucketForValue(usecs)];
+    ++_count;
+    _max = std::max(_max, usecs);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other._count == 0) {
+        return;
+    }
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        _buckets[i] += other._buckets[i];
+    }
+    _count += other._count;
+    _max = std::max(_max, other._max);
+}
+
+void LatencyHistogram::reset() {
+    if (_count == 0) {
+        return;
+    }
+    _buckets.fill(0);
+    _count = 0;
+    _max = 0;
+}
+
+uint64_t LatencyHistogram::getPercentile(float percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    uint64_t rank = std::max((uint64_t)1, (uint64_t)std::ceil((double)percentile * (double)_count));
+    uint64_t seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        seen += _buckets[i];
+        if (seen >= rank) {
+            return std::min(highestValueInBucket(i), _max);
+        }
+    }
+    return _max;
+}
+
+QJsonObject LatencyHistogram::toJson() const {
+    QJsonObject json;
+    json["count"] = (qint64)_count;
+    json["p50"] = (qint64)getPercentile(0.50f);
+    json["p95"] = (qint64)getPercentile(0.95f);
+    json["p99"] = (qint64)getPercentile(0.99f);
+    json["max"] = (qint64)_max;
+    return json;
+}
@@ -0,0 +1,51 @@
+//
+//  LatencyHistogram.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LatencyHistogram_h
+#define hifi_LatencyHistogram_h
+
+#include <array>
+#include <cstdint>
+
+#include <QtCore/QJsonObject>
+
+// Counts durations in microseconds into fixed log-linear buckets: exact below 16us, then 16 buckets per power of two,
+// so any percentile is reported within 1/16 of the true value.  Recording is a few integer operations and never
+// allocates, so each thread keeps its own histogram and they are merged when stats are reported.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    // durations are clamped to 32 bits, a little over an hour
+    static const int NUM_BUCKETS = (32 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    void record(uint64_t usecs);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t getCount() const { return _count; }
+    uint64_t getMax() const { return _max; }
+
+    // The highest duration in the bucket holding the percentile (0.0 to 1.0), capped by the max
+    uint64_t getPercentile(float percentile) const;
+
+    // count, p50, p95, p99 and max
+    QJsonObject toJson() const;
+
+    static int bucketForValue(uint64_t usecs);
+    static uint64_t highestValueInBucket(int bucket);
+
+private:
+    std::array<uint32_t, NUM_BUCKETS> _buckets {};
+    uint64_t _count { 0 };
+    uint64_t _max { 0 };
+};
+
+#endif // hifi_LatencyHistogram_h
@@ -58,9 +58,13 @@ Duration::Duration(const QLoggingCategory& category,
                    const QVariantMap& baseArgs) :
     DurationBase(category, name) {
     if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
-        tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        if (baseArgs.empty()) {
+            tracing::traceValueEvent(_category, _name, tracing::DurationBegin, "nv_payload", (double)payload);
+        } else {
+            QVariantMap args = baseArgs;
+            args["nv_payload"] = QVariant::fromValue(payload);
+            tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        }
 
 #if defined(NSIGHT_TRACING)
         nvtxEventAttributes_t eventAttrib{ 0 };
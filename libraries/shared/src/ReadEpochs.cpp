@@ -0,0 +1,111 @@
+//
+//  ReadEpochs.cpp
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReadEpochs.h"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+
+namespace {
+
+const uint64_t IDLE = std::numeric_limits<uint64_t>::max();
+const size_t CACHE_LINE_SIZE = 64;
+
+// One per thread that has read, reused once its thread exits and never freed
+struct ReaderSlot {
+    // the epoch the thread's outermost guard entered in, or IDLE
+    std::atomic<uint64_t> epoch { IDLE };
+    // only written by the owning thread
+    std::atomic<uint64_t> numReads { 0 };
+    int depth { 0 };
+
+    std::atomic<bool> isClaimed { true };
+    ReaderSlot* next { nullptr };
+
+    // keep other threads' slots off this cache line
+    char padding[CACHE_LINE_SIZE];
+};
+
+std::atomic<uint64_t> globalEpoch { 1 };
+std::atomic<ReaderSlot*> slots { nullptr };
+
+ReaderSlot* claimSlot() {
+    for (auto slot = slots.load(std::memory_order_acquire); slot; slot = slot->next) {
+        bool isClaimed = false;
+        if (!slot->isClaimed.load(std::memory_order_relaxed) &&
+            slot->isClaimed.compare_exchange_strong(isClaimed, true, std::memory_order_acquire)) {
+            return slot;
+        }
+    }
+
+    auto slot = new ReaderSlot();
+    slot->next = slots.load(std::memory_order_relaxed);
+    while (!slots.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return slot;
+}
+
+struct SlotOwner {
+    ReaderSlot* slot { claimSlot() };
+
+    ~SlotOwner() {
+        slot->depth = 0;
+        slot->epoch.store(IDLE, std::memory_order_release);
+        slot->isClaimed.store(false, std::memory_order_release);
+    }
+};
+
+ReaderSlot& localSlot() {
+    static thread_local SlotOwner owner;
+    return *owner.slot;
+}
+
+}
+
+void ReadEpochs::enter() {
+    auto& slot = localSlot();
+    if (slot.depth++ == 0) {
+        // Acquire pairs with the writer's increment in retire(), so a reader that sees the new epoch also sees the
+        // pointer that was swapped before it.  The seq_cst store orders the slot before the reader's load of the
+        // pointer, against the writer's swap and its scan of the slots in canReclaim().
+        slot.epoch.store(globalEpoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+        slot.numReads.store(slot.numReads.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+void ReadEpochs::leave() {
+    auto& slot = localSlot();
+    if (--slot.depth == 0) {
+        slot.epoch.store(IDLE, std::memory_order_release);
+    }
+}
+
+uint64_t ReadEpochs::retire() {
+    return globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+}
+
+bool ReadEpochs::canReclaim(uint64_t retiredEpoch) {
+    for (auto slot = slots.load(std::memory_order_acquire); slot; slot = slot->next) {
+        // a guard that entered after the epoch was retired can only have loaded the new value
+        if (slot->epoch.load(std::memory_order_seq_cst) <= retiredEpoch) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t ReadEpochs::getNumReads() {
+    uint64_t numReads = 0;
+    for (auto slot = slots.load(std::memory_order_acquire); slot; slot = slot->next) {
+        numReads += slot->numReads.load(std::memory_order_relaxed);
+    }
+    return numReads;
+}
@@ -0,0 +1,47 @@
+//
+//  ReadEpochs.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReadEpochs_h
+#define hifi_ReadEpochs_h
+
+#include <cstdint>
+
+// Epoch based reclamation for data published through an atomic raw pointer.
+//
+// A reader wraps its loads of the pointer, and its use of what it points to, in a ReadGuard.  Entering and leaving a
+// guard only writes to a slot owned by the calling thread, so readers never contend with each other or with a writer.
+// A writer that swaps the pointer calls retire() for the epoch of the old value, and may delete it once
+// canReclaim() is true for that epoch.  Guards nest on a thread.
+class ReadEpochs {
+public:
+    class ReadGuard {
+    public:
+        ReadGuard() { enter(); }
+        ~ReadGuard() { leave(); }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    // Call after the pointer was swapped.  Returns the epoch the old value must be kept for.
+    static uint64_t retire();
+
+    // True when no guard that might have loaded a value retired in the epoch is still alive
+    static bool canReclaim(uint64_t retiredEpoch);
+
+    // The number of outermost guards entered on all threads so far
+    static uint64_t getNumReads();
+
+private:
+    static void enter();
+    static void leave();
+};
+
+#endif // hifi_ReadEpochs_h
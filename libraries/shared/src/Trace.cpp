@@ -8,239 +8,906 @@
 
 #include "Trace.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <unordered_map>
 
 #include <QtCore/QDebug>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QThread>
-#include <QtCore/QFileInfo>
-#include <QtCore/QDir>
-#include <QtCore/QStandardPaths>
-
-#include <QtCore/QFile>
-#include <QtCore/QFileInfo>
-#include <QtCore/QTemporaryFile>
-#include <QtCore/QDataStream>
-#include <QtCore/QTextStream>
+#include <QtCore/QProcessEnvironment>
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonDocument>
 
-#include <BuildInfo.h>
-
 #include "Gzip.h"
+#include "NumericalConstants.h"
 #include "PortableHighResolutionClock.h"
 #include "SharedLogging.h"
 #include "shared/FileUtils.h"
-#include "shared/GlobalAppProperties.h"
 
 using namespace tracing;
 
+// Binary traces are a header followed by blocks of new strings, new event strings, new threads and events, in
+// the order they were drained, so a stream cut short by a crash can still be converted up to its last complete
+// block.  Values are written in the byte order of the machine which recorded them.
+static const char TRACE_FILE_MAGIC[] = { 'H', 'F', 'T', 'R', 'A', 'C', 'E', '1' };
+
+enum TraceBlockType : char {
+    StringsBlock = 'S',
+    EventStringsBlock = 'V',
+    ThreadsBlock = 'T',
+    EventsBlock = 'E'
+};
+
+// "<seconds>[,<spike msecs>]" starts a flight recorder with every Tracer
+static const QString FLIGHT_RECORDER_ENV = "HIFI_TRACE_FLIGHT_RECORDER";
+
+static std::atomic<uint32_t> nextTracerID { 1 };
+
+namespace tracing {
+
+// Events of one thread, written by that thread and read by the Tracer's writer.  The ids and JSON arguments of
+// the events are copied, as UTF-16, into a ring of text alongside them.
+class ThreadTraceBuffer {
+public:
+    // powers of two, so positions wrap with a mask
+    static const uint64_t CAPACITY = 1 << 14;
+    static const uint64_t TEXT_CAPACITY = 1 << 18;
+
+    struct Record {
+        BinaryTraceEvent event;
+        uint64_t textEnd { 0 };
+        // sizes of the id, args and extra, laid out in that order up to textEnd
+        uint32_t textSizes[3] { 0, 0, 0 };
+    };
+
+    // Never blocks: when the writer has fallen behind the event is counted and dropped
+    void push(const BinaryTraceEvent& event, const QString& id, const QString& args, const QString& extra) {
+        auto head = _head.load(std::memory_order_relaxed);
+        uint64_t textSize = (uint64_t)(id.size() + args.size() + extra.size());
+        if (head - _tail.load(std::memory_order_acquire) >= CAPACITY ||
+            _textHead - _textTail.load(std::memory_order_acquire) + textSize > TEXT_CAPACITY) {
+            dropped++;
+            return;
+        }
+        auto& record = _records[head & (CAPACITY - 1)];
+        record.event = event;
+        record.textSizes[0] = (uint32_t)id.size();
+        record.textSizes[1] = (uint32_t)args.size();
+        record.textSizes[2] = (uint32_t)extra.size();
+        writeText(id);
+        writeText(args);
+        writeText(extra);
+        record.textEnd = _textHead;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    template <typename F>
+    void drain(F&& f) {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        auto head = _head.load(std::memory_order_acquire);
+        if (tail == head) {
+            return;
+        }
+        uint64_t textEnd = 0;
+        for (; tail != head; ++tail) {
+            const auto& record = _records[tail & (CAPACITY - 1)];
+            RecordedTraceEvent recorded;
+            recorded.event = record.event;
+            uint64_t textPosition = record.textEnd - record.textSizes[0] - record.textSizes[1] - record.textSizes[2];
+            recorded.id = readText(textPosition, record.textSizes[0]);
+            recorded.args = readText(textPosition, record.textSizes[1]);
+            recorded.extra = readText(textPosition, record.textSizes[2]);
+            textEnd = record.textEnd;
+            f(std::move(recorded));
+        }
+        _textTail.store(textEnd, std::memory_order_release);
+        _tail.store(tail, std::memory_order_release);
+    }
+
+    bool isEmpty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+
+    std::atomic<bool> retired { false };
+    std::atomic<uint64_t> dropped { 0 };
+
+private:
+    void writeText(const QString& text) {
+        // constData doesn't reallocate, unlike utf16 for strings made with fromRawData
+        const QChar* units = text.constData();
+        uint64_t size = (uint64_t)text.size();
+        uint64_t offset = _textHead & (TEXT_CAPACITY - 1);
+        uint64_t firstSpan = std::min(size, TEXT_CAPACITY - offset);
+        memcpy(&_text[offset], units, firstSpan * sizeof(QChar));
+        memcpy(&_text[0], units + firstSpan, (size - firstSpan) * sizeof(QChar));
+        _textHead += size;
+    }
+
+    QByteArray readText(uint64_t& position, uint32_t size) const {
+        if (size == 0) {
+            return QByteArray();
+        }
+        uint64_t offset = position & (TEXT_CAPACITY - 1);
+        uint64_t firstSpan = std::min((uint64_t)size, TEXT_CAPACITY - offset);
+        QString text(&_text[offset], (int)firstSpan);
+        text.append(&_text[0], (int)(size - firstSpan));
+        position += size;
+        return text.toUtf8();
+    }
+
+    std::unique_ptr<Record[]> _records { new Record[CAPACITY] };
+    std::atomic<uint64_t> _head { 0 };
+    std::atomic<uint64_t> _tail { 0 };
+
+    std::unique_ptr<QChar[]> _text { new QChar[TEXT_CAPACITY] };
+    uint64_t _textHead { 0 }; // only used by the recording thread
+    std::atomic<uint64_t> _textTail { 0 };
+};
+
+}
+
+class Tracer::ThreadState {
+public:
+    ~ThreadState() {
+        if (buffer) {
+            buffer->retired = true;
+        }
+    }
+
+    uint32_t tracer { 0 };
+    uint32_t thread { 0 };
+    std::shared_ptr<ThreadTraceBuffer> buffer;
+    QHash<QString, uint32_t> strings;
+    std::unordered_map<const char*, uint32_t> literals;
+    std::unordered_map<const QLoggingCategory*, uint32_t> categories;
+};
+
+template <typename T>
+static void appendValue(QByteArray& data, const T& value) {
+    data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void appendStrings(QByteArray& data, TraceBlockType blockType, uint32_t firstIndex,
+                          const QByteArray* strings, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    data.append(blockType);
+    appendValue(data, firstIndex);
+    appendValue(data, (uint32_t)count);
+    for (size_t i = 0; i < count; i++) {
+        appendValue(data, (uint32_t)strings[i].size());
+        data.append(strings[i]);
+    }
+}
+
+static void appendStrings(QByteArray& data, const std::vector<QByteArray>& strings, size_t first) {
+    if (first < strings.size()) {
+        appendStrings(data, StringsBlock, (uint32_t)first, strings.data() + first, strings.size() - first);
+    }
+}
+
+static void appendThreads(QByteArray& data, const std::vector<std::pair<int64_t, int64_t>>& threads, size_t first) {
+    if (first >= threads.size()) {
+        return;
+    }
+    data.append(ThreadsBlock);
+    appendValue(data, (uint32_t)first);
+    appendValue(data, (uint32_t)(threads.size() - first));
+    for (size_t i = first; i < threads.size(); i++) {
+        appendValue(data, threads[i].first);
+        appendValue(data, threads[i].second);
+    }
+}
+
+// Gives the strings of each event the next EVENT_STRING indices, starting at first
+static std::vector<BinaryTraceEvent> indexEventStrings(const std::vector<RecordedTraceEvent>& events,
+                                                       std::vector<QByteArray>& eventStrings, uint32_t first) {
+    std::vector<BinaryTraceEvent> result;
+    result.reserve(events.size());
+    uint32_t next = first;
+    auto index = [&](const QByteArray& string) -> uint32_t {
+        if (string.isEmpty()) {
+            return 0;
+        }
+        eventStrings.push_back(string);
+        return BinaryTraceEvent::EVENT_STRING | next++;
+    };
+    for (const auto& recorded : events) {
+        BinaryTraceEvent event = recorded.event;
+        event.id = index(recorded.id);
+        if (event.flags & BinaryTraceEvent::HAS_ARGS) {
+            event.args = index(recorded.args);
+        }
+        if (event.flags & BinaryTraceEvent::HAS_EXTRA) {
+            event.extra = index(recorded.extra);
+        }
+        result.push_back(event);
+    }
+    return result;
+}
+
+static void appendEvents(QByteArray& data, const std::vector<BinaryTraceEvent>& events) {
+    if (events.empty()) {
+        return;
+    }
+    data.append(EventsBlock);
+    appendValue(data, (uint32_t)events.size());
+    data.append(reinterpret_cast<const char*>(events.data()), (int)(events.size() * sizeof(BinaryTraceEvent)));
+}
+
+static void appendJsonString(QByteArray& out, const QByteArray& string) {
+    out += '"';
+    for (char c : string) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    out += QByteArray("\\u00") + QByteArray::number((int)c, 16).rightJustified(2, '0');
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+// Manual serialization, since QJsonObject is far too slow for traces of millions of events
+static QByteArray toChromeJson(const std::vector<QByteArray>& strings, const std::vector<QByteArray>& eventStrings,
+                               const std::vector<std::pair<int64_t, int64_t>>& threads,
+                               const std::vector<BinaryTraceEvent>& events) {
+    auto string = [&](uint32_t index) {
+        if (index & BinaryTraceEvent::EVENT_STRING) {
+            index &= ~BinaryTraceEvent::EVENT_STRING;
+            return index < eventStrings.size() ? eventStrings[index] : QByteArray();
+        }
+        return index < strings.size() ? strings[index] : QByteArray();
+    };
+
+    QByteArray out;
+    out.reserve((int)(events.size() * 128));
+    out += "[\n";
+    bool first = true;
+    for (const auto& event : events) {
+        if (first) {
+            first = false;
+        } else {
+            out += ",\n";
+        }
+        out += "{\"name\":";
+        appendJsonString(out, string(event.name));
+        out += ",\"cat\":";
+        appendJsonString(out, string(event.category));
+        out += ",\"ph\":\"";
+        out += event.type;
+        out += "\",\"ts\":";
+        out += QByteArray::number((qlonglong)event.timestamp);
+        if (event.thread < threads.size()) {
+            out += ",\"pid\":";
+            out += QByteArray::number((qlonglong)threads[event.thread].first);
+            out += ",\"tid\":";
+            out += QByteArray::number((qlonglong)threads[event.thread].second);
+        }
+        if (event.id) {
+            out += ",\"id\":";
+            appendJsonString(out, string(event.id));
+        }
+        if (event.flags & BinaryTraceEvent::HAS_VALUE) {
+            out += ",\"args\":{";
+            appendJsonString(out, string(event.argName));
+            out += ':';
+            out += QByteArray::number(event.value, 'g', 17);
+            out += '}';
+        } else if (event.flags & BinaryTraceEvent::HAS_ARGS) {
+            out += ",\"args\":";
+            out += string(event.args);
+        }
+        if (event.flags & BinaryTraceEvent::HAS_EXTRA) {
+            // extra is a JSON object whose fields belong to the event itself
+            auto extra = string(event.extra);
+            if (extra.size() > 2) {
+                out += ',';
+                out += extra.mid(1, extra.size() - 2);
+            }
+        }
+        out += '}';
+    }
+    out += "\n]";
+    return out;
+}
+
+static QString toJson(const QVariantMap& map) {
+    return QString::fromUtf8(QJsonDocument(QJsonObject::fromVariantMap(map)).toJson(QJsonDocument::Compact));
+}
+
+static bool isNumeric(const QVariant& value) {
+    switch (value.userType()) {
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Float:
+        case QMetaType::Double:
+            return true;
+        default:
+            return false;
+    }
+}
+
 bool tracing::enabled() {
     return DependencyManager::get<Tracer>()->isEnabled();
 }
 
+Tracer::Tracer() : _id(nextTracerID++) {
+    _strings.push_back(QByteArray());
+
+    auto flightRecorder = QProcessEnvironment::systemEnvironment().value(FLIGHT_RECORDER_ENV).split(',');
+    float seconds = flightRecorder[0].toFloat();
+    if (seconds > 0.0f) {
+        float spikeMsecs = flightRecorder.size() > 1 ? flightRecorder[1].toFloat() : 0.0f;
+        startFlightRecorder(seconds, spikeMsecs);
+    }
+}
+
+Tracer::~Tracer() {
+    if (_enabled) {
+        stopTracing();
+    }
+}
+
 void Tracer::startTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
     if (_enabled) {
         qWarning() << "Tried to enable tracer, but already enabled";
         return;
     }
+    start(Memory);
+}
+
+void Tracer::startStreaming(const QString& file) {
+    if (_enabled) {
+        qWarning() << "Tried to enable tracer, but already enabled";
+        return;
+    }
+
+    QString fullPath = FileUtils::computeDocumentPath(FileUtils::replaceDateTimeTokens(file));
+    if (!FileUtils::canCreateFile(fullPath)) {
+        return;
+    }
+    _streamFile = std::make_unique<QFile>(fullPath);
+    if (!_streamFile->open(QIODevice::WriteOnly)) {
+        qDebug(shared) << "failed to open file '" << fullPath << "'";
+        _streamFile.reset();
+        return;
+    }
+    _streamFile->write(TRACE_FILE_MAGIC, sizeof(TRACE_FILE_MAGIC));
+    _streamedStrings = 0;
+    _streamedThreads = 0;
+    _streamedEventStrings = 0;
+    start(Streaming);
+}
+
+void Tracer::startFlightRecorder(float seconds, float spikeMsecs, const QString& spikeFile) {
+    if (_enabled) {
+        qWarning() << "Tried to enable tracer, but already enabled";
+        return;
+    }
+    _flightRecorderUsecs = (int64_t)(seconds * USECS_PER_SECOND);
+    _spikeUsecs = (uint64_t)(spikeMsecs * USECS_PER_MSEC);
+    _spikeFile = spikeFile;
+    _lastSpikeDump = 0;
+    start(FlightRecorder);
+}
 
-    _events.clear();
+void Tracer::start(Mode mode) {
+    // the writer isn't running, so it is safe to throw away anything recorded since the last stop
+    drain();
+    {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        _events.clear();
+    }
+
+    _mode = mode;
+    _stopWriter = false;
+    _pendingDump.clear();
+    _writer = std::thread([this] { writerLoop(); });
     _enabled = true;
 }
 
 void Tracer::stopTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
     if (!_enabled) {
         qWarning() << "Cannot stop tracing, already disabled";
         return;
     }
     _enabled = false;
+
+    {
+        std::lock_guard<std::mutex> guard(_writerMutex);
+        _stopWriter = true;
+    }
+    _writerCondition.notify_one();
+    _writer.join();
+
+    if (_streamFile) {
+        std::vector<RecordedTraceEvent> metadataEvents;
+        {
+            std::lock_guard<std::mutex> guard(_eventsMutex);
+            metadataEvents = _metadataEvents;
+        }
+        writeStreamBlocks(metadataEvents);
+        _streamFile->close();
+        _streamFile.reset();
+    }
+    _mode = Memory;
+
+    auto dropped = getDroppedEventCount();
+    if (dropped > 0) {
+        qCWarning(shared) << "Tracing dropped" << dropped << "events";
+    }
 }
 
-void TraceEvent::writeJson(QTextStream& out) const {
-#if 0
-    // FIXME QJsonObject serialization is very slow, so we should be using manual JSON serialization
-    out << "{";
-    out << "\"name\":\"" << name << "\",";
-    out << "\"cat\":\"" << category.categoryName() << "\",";
-    out << "\"ph\":\"" << QString(type) << "\",";
-    out << "\"ts\":\"" << timestamp << "\",";
-    out << "\"pid\":\"" << processID << "\",";
-    out << "\"tid\":\"" << threadID << "\"";
-    //if (!extra.empty()) {
-    //    auto it = extra.begin();
-    //    for (; it != extra.end(); it++) {
-    //        ev[it.key()] = QJsonValue::fromVariant(it.value());
-    //    }
-    //}
-    //if (!args.empty()) {
-    //    out << ",\"args\":'
-    //}
-    out << '}';
-#else
-    QJsonObject ev {
-        { "name", QJsonValue(name) },
-        { "cat", category.categoryName() },
-        { "ph", QString(type) },
-        { "ts", timestamp },
-        { "pid", processID },
-        { "tid", threadID }
-    };
-    if (!id.isEmpty()) {
-        ev["id"] = id;
+void Tracer::writerLoop() {
+    // often enough that a thread recording continuously doesn't fill its buffer
+    const auto DRAIN_INTERVAL = std::chrono::milliseconds(20);
+
+    std::unique_lock<std::mutex> lock(_writerMutex);
+    while (!_stopWriter) {
+        _writerCondition.wait_for(lock, DRAIN_INTERVAL, [this] {
+            return _stopWriter || !_pendingDump.isEmpty() || _flushesDone != _flushRequests;
+        });
+        QString dump;
+        dump.swap(_pendingDump);
+        uint64_t flushRequests = _flushRequests;
+        lock.unlock();
+
+        drain();
+        if (!dump.isEmpty()) {
+            dumpFlightRecorder(dump);
+        }
+
+        lock.lock();
+        if (_flushesDone != flushRequests) {
+            _flushesDone = flushRequests;
+            _flushedCondition.notify_all();
+        }
+    }
+    lock.unlock();
+    drain();
+
+    lock.lock();
+    _flushesDone = _flushRequests;
+    _flushedCondition.notify_all();
+}
+
+void Tracer::flush() {
+    std::unique_lock<std::mutex> lock(_writerMutex);
+    if (!_enabled || _stopWriter) {
+        return;
     }
-    if (!args.empty()) {
-        ev["args"] = QJsonObject::fromVariantMap(args);
+    uint64_t request = ++_flushRequests;
+    _writerCondition.notify_one();
+    _flushedCondition.wait(lock, [&] { return _flushesDone >= request; });
+}
+
+void Tracer::drain() {
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> guard(_buffersMutex);
+        // forget the buffers of threads which have exited once everything they recorded has been drained
+        auto itr = _buffers.begin();
+        while (itr != _buffers.end()) {
+            if ((*itr)->retired && (*itr)->isEmpty()) {
+                _retiredDroppedEvents += (*itr)->dropped;
+                itr = _buffers.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+        buffers = _buffers;
     }
-    if (!extra.empty()) {
-        auto it = extra.begin();
-        for (; it != extra.end(); it++) {
-            ev[it.key()] = QJsonValue::fromVariant(it.value());
+
+    std::vector<RecordedTraceEvent> events;
+    for (const auto& buffer : buffers) {
+        buffer->drain([&](RecordedTraceEvent&& event) {
+            events.push_back(std::move(event));
+        });
+    }
+
+    if (_mode == Streaming) {
+        writeStreamBlocks(events);
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(_eventsMutex);
+    _events.insert(_events.end(), events.begin(), events.end());
+    if (_mode == FlightRecorder) {
+        int64_t oldest = now() - _flightRecorderUsecs;
+        while (!_events.empty() && _events.front().event.timestamp < oldest) {
+            _events.pop_front();
         }
     }
-    out << QJsonDocument(ev).toJson(QJsonDocument::Compact);
-#endif
 }
 
-void Tracer::serialize(const QString& filename) {
-    QString fullPath = FileUtils::replaceDateTimeTokens(filename);
+void Tracer::writeStreamBlocks(const std::vector<RecordedTraceEvent>& events) {
+    // event strings are only kept in the file, each block continues their indices from the last
+    std::vector<QByteArray> eventStrings;
+    auto binaryEvents = indexEventStrings(events, eventStrings, _streamedEventStrings);
+    QByteArray block;
+    appendStrings(block, EventStringsBlock, _streamedEventStrings, eventStrings.data(), eventStrings.size());
+    _streamedEventStrings += (uint32_t)eventStrings.size();
+
+    // strings and threads are only ever appended, and are added before any event which refers to them is recorded
+    {
+        std::lock_guard<std::mutex> guard(_stringsMutex);
+        appendStrings(block, _strings, _streamedStrings);
+        _streamedStrings = _strings.size();
+        appendThreads(block, _threads, _streamedThreads);
+        _streamedThreads = _threads.size();
+    }
+    appendEvents(block, binaryEvents);
+    if (!block.isEmpty()) {
+        _streamFile->write(block);
+    }
+}
+
+bool Tracer::writeTrace(const QString& file, std::vector<RecordedTraceEvent> events) {
+    QString fullPath = FileUtils::replaceDateTimeTokens(file);
     fullPath = FileUtils::computeDocumentPath(fullPath);
     if (!FileUtils::canCreateFile(fullPath)) {
-        return;
+        return false;
     }
 
-    std::list<TraceEvent> currentEvents;
     {
         std::lock_guard<std::mutex> guard(_eventsMutex);
-        currentEvents.swap(_events);
-        for (auto& event : _metadataEvents) {
-            currentEvents.push_back(event);
-        }
+        events.insert(events.end(), _metadataEvents.begin(), _metadataEvents.end());
+    }
+    std::vector<QByteArray> strings;
+    std::vector<std::pair<int64_t, int64_t>> threads;
+    {
+        std::lock_guard<std::mutex> guard(_stringsMutex);
+        strings = _strings;
+        threads = _threads;
     }
 
-    // If we can't open a temp file for writing, fail early
+    std::vector<QByteArray> eventStrings;
+    auto binaryEvents = indexEventStrings(events, eventStrings, 0);
+    events.clear();
+
     QByteArray data;
-    {
-        QTextStream out(&data);
-        out << "[\n";
-        bool first = true;
-        for (const auto& event : currentEvents) {
-            if (first) {
-                first = false;
-            } else {
-                out << ",\n";
-            }
-            event.writeJson(out);
+    if (fullPath.endsWith(".trace")) {
+        data.append(TRACE_FILE_MAGIC, sizeof(TRACE_FILE_MAGIC));
+        appendStrings(data, strings, 0);
+        appendStrings(data, EventStringsBlock, 0, eventStrings.data(), eventStrings.size());
+        appendThreads(data, threads, 0);
+        appendEvents(data, binaryEvents);
+    } else {
+        data = toChromeJson(strings, eventStrings, threads, binaryEvents);
+        if (fullPath.endsWith(".gz")) {
+            QByteArray compressed;
+            gzip(data, compressed);
+            data = compressed;
         }
-        out << "\n]";
     }
 
-    if (fullPath.endsWith(".gz")) {
-        QByteArray compressed;
-        gzip(data, compressed);
-        data = compressed;
+    QFile outFile(fullPath);
+    if (!outFile.open(QIODevice::WriteOnly)) {
+        qDebug(shared) << "failed to open file '" << fullPath << "'";
+        return false;
     }
+    outFile.write(data);
+    outFile.close();
+    return true;
+}
 
+void Tracer::serialize(const QString& filename) {
+    std::vector<RecordedTraceEvent> currentEvents;
     {
-        QFile file(fullPath);
-        if (!file.open(QIODevice::WriteOnly)) {
-            qDebug(shared) << "failed to open file '" << fullPath << "'";
-            return;
-        }
-        file.write(data);
-        file.close();
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        currentEvents.assign(_events.begin(), _events.end());
+        _events.clear();
     }
+    writeTrace(filename, std::move(currentEvents));
+}
 
-#if 0
-    QByteArray data;
+bool Tracer::dumpFlightRecorder(const QString& file) {
+    std::vector<RecordedTraceEvent> currentEvents;
     {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        currentEvents.assign(_events.begin(), _events.end());
+    }
+    return writeTrace(file, std::move(currentEvents));
+}
 
-        // "traceEvents":[
-        // {"args":{"nv_payload":0},"cat":"hifi.render","name":"render::Scene::processTransactionQueue","ph":"B","pid":14796,"tid":21636,"ts":68795933487}
+void Tracer::reportFrameTime(uint64_t usecs) {
+    uint64_t spikeUsecs = _spikeUsecs;
+    if (!_enabled || _mode != FlightRecorder || spikeUsecs == 0 || usecs < spikeUsecs) {
+        return;
+    }
 
-        QJsonArray traceEvents;
+    // a dump already covers the whole window, so don't write another for spikes inside it
+    int64_t timestamp = now();
+    int64_t lastDump = _lastSpikeDump;
+    if (lastDump != 0 && timestamp - lastDump < _flightRecorderUsecs) {
+        return;
+    }
+    if (!_lastSpikeDump.compare_exchange_strong(lastDump, timestamp)) {
+        return;
+    }
+
+    qCDebug(shared) << "Frame took" << usecs / USECS_PER_MSEC << "ms, dumping trace flight recorder";
+    {
+        std::lock_guard<std::mutex> guard(_writerMutex);
+        _pendingDump = _spikeFile;
+    }
+    _writerCondition.notify_one();
+}
+
+uint64_t Tracer::getDroppedEventCount() const {
+    std::lock_guard<std::mutex> guard(_buffersMutex);
+    uint64_t dropped = _retiredDroppedEvents;
+    for (const auto& buffer : _buffers) {
+        dropped += buffer->dropped;
+    }
+    return dropped;
+}
 
-        QJsonDocument document {
-            QJsonObject {
-                { "traceEvents", traceEvents },
-                { "otherData", QJsonObject {
-                    { "version", QString { "High Fidelity Interface v1.0" } +BuildInfo::VERSION }
-                } }
+bool Tracer::convertToJson(const QString& traceFile, const QString& jsonFile) {
+    QFile inFile(traceFile);
+    if (!inFile.open(QIODevice::ReadOnly)) {
+        qDebug(shared) << "failed to open file '" << traceFile << "'";
+        return false;
+    }
+    QByteArray data = inFile.readAll();
+    inFile.close();
+
+    int position = 0;
+    auto read = [&](void* value, int size) {
+        if (position + size > data.size()) {
+            return false;
+        }
+        memcpy(value, data.constData() + position, size);
+        position += size;
+        return true;
+    };
+
+    char magic[sizeof(TRACE_FILE_MAGIC)];
+    if (!read(magic, sizeof(magic)) || memcmp(magic, TRACE_FILE_MAGIC, sizeof(magic)) != 0) {
+        qDebug(shared) << "'" << traceFile << "' is not a binary trace";
+        return false;
+    }
+
+    auto readStrings = [&](std::vector<QByteArray>& strings) {
+        uint32_t first = 0;
+        uint32_t count = 0;
+        bool complete = read(&first, sizeof(first)) && read(&count, sizeof(count));
+        for (uint32_t i = 0; complete && i < count; i++) {
+            uint32_t size = 0;
+            complete = read(&size, sizeof(size)) && position + (int)size <= data.size();
+            if (complete) {
+                if (strings.size() <= first + i) {
+                    strings.resize(first + i + 1);
+                }
+                strings[first + i] = data.mid(position, size);
+                position += size;
             }
-        };
-        data = document.toJson(QJsonDocument::Compact);
+        }
+        return complete;
+    };
+
+    std::vector<QByteArray> strings;
+    std::vector<QByteArray> eventStrings;
+    std::vector<std::pair<int64_t, int64_t>> threads;
+    std::vector<BinaryTraceEvent> events;
+    bool complete = true;
+    char blockType;
+    while (complete && read(&blockType, 1)) {
+        uint32_t first = 0;
+        uint32_t count = 0;
+        switch (blockType) {
+            case StringsBlock:
+                complete = readStrings(strings);
+                break;
+
+            case EventStringsBlock:
+                complete = readStrings(eventStrings);
+                break;
+
+            case ThreadsBlock:
+                complete = read(&first, sizeof(first)) && read(&count, sizeof(count));
+                for (uint32_t i = 0; complete && i < count; i++) {
+                    std::pair<int64_t, int64_t> thread;
+                    complete = read(&thread.first, sizeof(thread.first)) && read(&thread.second, sizeof(thread.second));
+                    if (complete) {
+                        if (threads.size() <= first + i) {
+                            threads.resize(first + i + 1);
+                        }
+                        threads[first + i] = thread;
+                    }
+                }
+                break;
+
+            case EventsBlock:
+                complete = read(&count, sizeof(count)) && position + (int)(count * sizeof(BinaryTraceEvent)) <= data.size();
+                if (complete) {
+                    size_t offset = events.size();
+                    events.resize(offset + count);
+                    read(events.data() + offset, (int)(count * sizeof(BinaryTraceEvent)));
+                }
+                break;
+
+            default:
+                complete = false;
+                break;
+        }
+    }
+    if (!complete) {
+        qCWarning(shared) << "'" << traceFile << "' is truncated, converting the events before" << position;
     }
-#endif
+
+    QFile outFile(jsonFile);
+    if (!outFile.open(QIODevice::WriteOnly)) {
+        qDebug(shared) << "failed to open file '" << jsonFile << "'";
+        return false;
+    }
+    outFile.write(toChromeJson(strings, eventStrings, threads, events));
+    outFile.close();
+    return true;
 }
 
 int64_t Tracer::now() {
     return std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
 }
 
-void Tracer::traceEvent(const QLoggingCategory& category,
-    const QString& name, EventType type,
-    qint64 timestamp, qint64 processID, qint64 threadID,
-    const QString& id,
-    const QVariantMap& args, const QVariantMap& extra) {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
+Tracer::ThreadState& Tracer::getThreadState() {
+    static thread_local ThreadState state;
+    if (state.tracer != _id) {
+        // first event from this thread, or first since the tracer was replaced
+        if (state.buffer) {
+            state.buffer->retired = true;
+            state.buffer.reset();
+        }
+        state.strings.clear();
+        state.literals.clear();
+        state.categories.clear();
+        {
+            std::lock_guard<std::mutex> guard(_stringsMutex);
+            state.thread = (uint32_t)_threads.size();
+            _threads.emplace_back(QCoreApplication::applicationPid(), int64_t(QThread::currentThreadId()));
+        }
+        state.tracer = _id;
+    }
+    return state;
+}
+
+uint32_t Tracer::intern(ThreadState& state, const QString& string) {
+    if (string.isEmpty()) {
+        return 0;
+    }
+    auto cached = state.strings.constFind(string);
+    if (cached != state.strings.constEnd()) {
+        return cached.value();
+    }
+
+    // names are expected to come from a small set, anything beyond this is a caller formatting values into them
+    const size_t MAX_INTERNED_STRINGS = 1 << 16;
+    uint32_t index;
+    {
+        std::lock_guard<std::mutex> guard(_stringsMutex);
+        auto itr = _stringIndices.constFind(string);
+        if (itr != _stringIndices.constEnd()) {
+            index = itr.value();
+        } else if (_strings.size() >= MAX_INTERNED_STRINGS) {
+            if (!_stringsFull) {
+                _stringsFull = true;
+                qCWarning(shared) << "Tracer interned" << MAX_INTERNED_STRINGS << "names, recording further new names as empty";
+            }
+            return 0;
+        } else {
+            index = (uint32_t)_strings.size();
+            _strings.push_back(string.toUtf8());
+            _stringIndices.insert(string, index);
+        }
+    }
+
+    // the table is shared by every thread, so the thread's copy is only a cache
+    const int MAX_CACHED_STRINGS = 4096;
+    if (state.strings.size() >= MAX_CACHED_STRINGS) {
+        state.strings.clear();
+    }
+    state.strings.insert(string, index);
+    return index;
+}
+
+void Tracer::recordEvent(const QLoggingCategory& category, const QString& name, EventType type, int64_t timestamp,
+                         const QString& id, const QVariantMap& args, const QVariantMap& extra, const char* argName, double value) {
+    auto& state = getThreadState();
+
+    BinaryTraceEvent event;
+    event.timestamp = timestamp;
+    event.type = type;
+    event.thread = state.thread;
+    event.name = intern(state, name);
+
+    auto categoryItr = state.categories.find(&category);
+    if (categoryItr == state.categories.end()) {
+        categoryItr = state.categories.emplace(&category, intern(state, QString(category.categoryName()))).first;
+    }
+    event.category = categoryItr->second;
+
+    if (argName) {
+        auto literalItr = state.literals.find(argName);
+        if (literalItr == state.literals.end()) {
+            literalItr = state.literals.emplace(argName, intern(state, QString(argName))).first;
+        }
+        event.argName = literalItr->second;
+        event.value = value;
+        event.flags |= BinaryTraceEvent::HAS_VALUE;
+    } else if (args.size() == 1 && isNumeric(args.first())) {
+        event.argName = intern(state, args.firstKey());
+        event.value = args.first().toDouble();
+        event.flags |= BinaryTraceEvent::HAS_VALUE;
+    }
+
+    // ids and JSON arguments can take any number of values, so they travel with the event instead of being interned
+    QString argsJson;
+    QString extraJson;
+    if (!args.empty() && !(event.flags & BinaryTraceEvent::HAS_VALUE)) {
+        argsJson = toJson(args);
+        event.flags |= BinaryTraceEvent::HAS_ARGS;
+    }
+    if (!extra.empty()) {
+        extraJson = toJson(extra);
+        event.flags |= BinaryTraceEvent::HAS_EXTRA;
+    }
 
     // We always want to store metadata events even if tracing is not enabled so that when
     // tracing is enabled we will be able to associate that metadata with that trace.
     // Metadata events should be used sparingly - as of 12/30/16 the Chrome Tracing
     // spec only supports thread+process metadata, so we should only expect to see metadata
     // events created when a new thread or process is created.
-    if (!_enabled && type != Metadata) {
+    if (type == Metadata) {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        _metadataEvents.push_back({ event, id.toUtf8(), argsJson.toUtf8(), extraJson.toUtf8() });
         return;
     }
 
-    if (type == Metadata) {
-        _metadataEvents.push_back({
-            id,
-            name,
-            type,
-            timestamp,
-            processID,
-            threadID,
-            category,
-            args,
-            extra
-        });
-    } else {
-        _events.push_back({
-            id,
-            name,
-            type,
-            timestamp,
-            processID,
-            threadID,
-            category,
-            args,
-            extra
-        });
+    if (!state.buffer) {
+        state.buffer = std::make_shared<ThreadTraceBuffer>();
+        std::lock_guard<std::mutex> guard(_buffersMutex);
+        _buffers.push_back(state.buffer);
     }
+    state.buffer->push(event, id, argsJson, extraJson);
 }
 
-void Tracer::traceEvent(const QLoggingCategory& category, 
-    const QString& name, EventType type, const QString& id, 
+void Tracer::traceEvent(const QLoggingCategory& category,
+    const QString& name, EventType type, const QString& id,
     const QVariantMap& args, const QVariantMap& extra) {
     if (!_enabled && type != Metadata) {
         return;
     }
 
-    traceEvent(category, name, type, now(), id, args, extra);
+    recordEvent(category, name, type, now(), id, args, extra, nullptr, 0.0);
 }
 
-void Tracer::traceEvent(const QLoggingCategory& category, 
-    const QString& name, EventType type, int64_t timestamp, const QString& id, 
+void Tracer::traceEvent(const QLoggingCategory& category,
+    const QString& name, EventType type, int64_t timestamp, const QString& id,
     const QVariantMap& args, const QVariantMap& extra) {
     if (!_enabled && type != Metadata) {
         return;
     }
 
-    auto processID = QCoreApplication::applicationPid();
-    auto threadID = int64_t(QThread::currentThreadId());
-    traceEvent(category, name, type, timestamp, processID, threadID, id, args, extra);
+    recordEvent(category, name, type, timestamp, id, args, extra, nullptr, 0.0);
+}
+
+void Tracer::traceValueEvent(const QLoggingCategory& category, const QString& name, EventType type,
+    const char* argName, double value) {
+    if (!_enabled) {
+        return;
+    }
+
+    recordEvent(category, name, type, now(), QString(), QVariantMap(), QVariantMap(), argName, value);
 }
@@ -10,9 +10,16 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
+#include <QtCore/QFile>
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
 #include <QtCore/QHash>
@@ -62,22 +69,48 @@ enum EventType : char {
     ContextLeave = ')'
 };
 
-struct TraceEvent {
-    QString id;
-    QString name;
-    EventType type;
-    qint64 timestamp;
-    qint64 processID;
-    qint64 threadID;
-    const QLoggingCategory& category;
-    QVariantMap args;
-    QVariantMap extra;
-
-    void writeJson(QTextStream& out) const;
+// Fixed-size record of one event, with its strings referred to by index.  Names, categories and argument names
+// are interned by the Tracer, which takes a lock and allocates only the first time a thread uses one.  Ids and
+// JSON arguments, which change from one event to the next, are copied next to the event in its thread's buffer
+// and indexed as EVENT_STRINGs once drained.  Recording an event with at most a numeric argument and names the
+// thread has already used takes no lock and doesn't allocate.  Index 0 is the empty string.
+struct BinaryTraceEvent {
+    static const uint32_t EVENT_STRING = 0x80000000;
+
+    enum Flags : uint8_t {
+        HAS_VALUE = 1, // argName and value hold the event's only argument
+        HAS_ARGS = 2, // args is the index of the JSON object of the arguments
+        HAS_EXTRA = 4 // extra is the index of a JSON object of additional event fields
+    };
+
+    int64_t timestamp { 0 };
+    double value { 0.0 };
+    uint32_t name { 0 };
+    uint32_t category { 0 };
+    uint32_t id { 0 };
+    uint32_t argName { 0 };
+    uint32_t args { 0 };
+    uint32_t extra { 0 };
+    uint32_t thread { 0 };
+    char type { Instant };
+    uint8_t flags { 0 };
 };
 
+// An event drained from its thread's buffer, holding the strings that only it uses
+struct RecordedTraceEvent {
+    BinaryTraceEvent event;
+    QByteArray id;
+    QByteArray args;
+    QByteArray extra;
+};
+
+class ThreadTraceBuffer;
+
 class Tracer : public Dependency {
 public:
+    Tracer();
+    ~Tracer();
+
     static int64_t now();
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
@@ -90,22 +123,91 @@ public:
         const QString& id = "", 
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
+    // Records an event with a single numeric argument without building a QVariantMap
+    void traceValueEvent(const QLoggingCategory& category, const QString& name, EventType type,
+        const char* argName, double value);
+
+    // Keeps every event in memory until stopTracing() and serialize()
     void startTracing();
     void stopTracing();
+    // Writes the events kept by startTracing() as Chrome JSON, or as a binary trace if the file ends in .trace
     void serialize(const QString& file);
     bool isEnabled() const { return _enabled; }
 
+    // Streams events to a binary trace file as they are recorded, until stopTracing()
+    void startStreaming(const QString& file);
+
+    // Keeps only the last seconds of events in memory, until stopTracing().  If spikeMsecs is set, a frame
+    // reported longer than that dumps the recording to spikeFile, at most once per recording window.
+    void startFlightRecorder(float seconds, float spikeMsecs = 0.0f,
+        const QString& spikeFile = "traces/flight-{DATE_TIME}.trace");
+    bool dumpFlightRecorder(const QString& file);
+    void reportFrameTime(uint64_t usecs);
+
+    // Blocks until the writer has collected everything recorded before the call, and written any spike dump
+    // requested before it.  Returns at once if tracing isn't running.
+    void flush();
+
+    // Events lost because a thread recorded faster than the writer drained them
+    uint64_t getDroppedEventCount() const;
+
+    static bool convertToJson(const QString& traceFile, const QString& jsonFile);
+
 private:
-    void traceEvent(const QLoggingCategory& category, 
-        const QString& name, EventType type,
-        qint64 timestamp, qint64 processID, qint64 threadID,
-        const QString& id = "",
-        const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
+    enum Mode {
+        Memory,
+        Streaming,
+        FlightRecorder
+    };
+
+    class ThreadState;
+    ThreadState& getThreadState();
+    uint32_t intern(ThreadState& state, const QString& string);
+    void recordEvent(const QLoggingCategory& category, const QString& name, EventType type, int64_t timestamp,
+        const QString& id, const QVariantMap& args, const QVariantMap& extra, const char* argName, double value);
+
+    void start(Mode mode);
+    void writerLoop();
+    void drain();
+    void writeStreamBlocks(const std::vector<RecordedTraceEvent>& events);
+    bool writeTrace(const QString& file, std::vector<RecordedTraceEvent> events);
+
+    const uint32_t _id;
+    std::atomic<bool> _enabled { false };
+    std::atomic<Mode> _mode { Memory };
+
+    std::mutex _stringsMutex;
+    std::vector<QByteArray> _strings; // never shrinks, so it is capped
+    QHash<QString, uint32_t> _stringIndices;
+    bool _stringsFull { false };
+    std::vector<std::pair<int64_t, int64_t>> _threads; // process and thread id, guarded by _stringsMutex
+
+    mutable std::mutex _buffersMutex;
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> _buffers;
+    uint64_t _retiredDroppedEvents { 0 };
 
-    bool _enabled { false };
-    std::list<TraceEvent> _events;
-    std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
+    std::deque<RecordedTraceEvent> _events;
+    std::vector<RecordedTraceEvent> _metadataEvents;
+
+    std::mutex _writerMutex;
+    std::condition_variable _writerCondition;
+    std::thread _writer;
+    bool _stopWriter { false };
+    QString _pendingDump;
+    std::condition_variable _flushedCondition;
+    uint64_t _flushRequests { 0 };
+    uint64_t _flushesDone { 0 };
+
+    std::unique_ptr<QFile> _streamFile;
+    size_t _streamedStrings { 0 };
+    size_t _streamedThreads { 0 };
+    uint32_t _streamedEventStrings { 0 };
+
+    std::atomic<int64_t> _flightRecorderUsecs { 0 };
+    std::atomic<uint64_t> _spikeUsecs { 0 };
+    std::atomic<int64_t> _lastSpikeDump { 0 };
+    QString _spikeFile;
 };
 
 inline void traceEvent(const QLoggingCategory& category, int64_t timestamp, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
@@ -132,6 +234,27 @@ inline void traceEvent(const QLoggingCategory& category, const QString& name, Ev
     traceEvent(category, name, type, QString::number(id), args, extra);
 }
 
+inline void traceValueEvent(const QLoggingCategory& category, const QString& name, EventType type, const char* argName, double value) {
+    if (!DependencyManager::isSet<Tracer>()) {
+        return;
+    }
+    const auto& tracer = DependencyManager::get<Tracer>();
+    if (tracer) {
+        tracer->traceValueEvent(category, name, type, argName, value);
+    }
+}
+
+// Lets a flight recorder started with a spike threshold dump when a frame runs long
+inline void reportFrameTime(uint64_t usecs) {
+    if (!DependencyManager::isSet<Tracer>()) {
+        return;
+    }
+    const auto& tracer = DependencyManager::get<Tracer>();
+    if (tracer) {
+        tracer->reportFrameTime(usecs);
+    }
+}
+
 }
 
 #endif // hifi_Trace_h
@@ -0,0 +1,76 @@
+//
+//  Skinning_avx2.cpp
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+//
+// clusterMatrices[i] = jointMatrices[i] * inverseBindMatrices[i], for column-major 4x4 matrices
+//
+void multiplyClusterMatrices_AVX2(const float (*jointMatrices)[16], const float (*inverseBindMatrices)[16],
+                                  float (*clusterMatrices)[16], int size) {
+
+    for (int i = 0; i < size; i++) {
+
+        // columns of the joint matrix, duplicated in both lanes
+        __m256 u0 = _mm256_broadcast_ps((const __m128*)&jointMatrices[i][0]);
+        __m256 u1 = _mm256_broadcast_ps((const __m128*)&jointMatrices[i][4]);
+        __m256 u2 = _mm256_broadcast_ps((const __m128*)&jointMatrices[i][8]);
+        __m256 u3 = _mm256_broadcast_ps((const __m128*)&jointMatrices[i][12]);
+
+        // two columns of the result per iteration
+        for (int c = 0; c < 16; c += 8) {
+            __m256 v = _mm256_loadu_ps(&inverseBindMatrices[i][c]);
+
+            __m256 r = _mm256_mul_ps(_mm256_permute_ps(v, _MM_SHUFFLE(0,0,0,0)), u0);
+            r = _mm256_fmadd_ps(_mm256_permute_ps(v, _MM_SHUFFLE(1,1,1,1)), u1, r);
+            r = _mm256_fmadd_ps(_mm256_permute_ps(v, _MM_SHUFFLE(2,2,2,2)), u2, r);
+            r = _mm256_fmadd_ps(_mm256_permute_ps(v, _MM_SHUFFLE(3,3,3,3)), u3, r);
+
+            _mm256_storeu_ps(&clusterMatrices[i][c], r);
+        }
+    }
+
+    _mm256_zeroupper();
+}
+
+//
+// unpacked[indices[j]] += { vertices[j] * vertexCoefficient, normals[j] * normalCoefficient, tangents[j] * normalCoefficient }
+// where tangents may be shorter than vertices and normals
+//
+void accumulateBlendshapeOffsets_AVX2(float (*unpacked)[9], const int* indices, const float (*vertices)[3],
+                                      const float (*normals)[3], const float (*tangents)[3], int numTangents, int size,
+                                      float vertexCoefficient, float normalCoefficient) {
+
+    // masked loads of the vec3 sources, which never read past the end of the arrays
+    const __m128i mask3 = _mm_setr_epi32(-1, -1, -1, 0);
+    const __m256 coefficients = _mm256_setr_ps(vertexCoefficient, vertexCoefficient, vertexCoefficient, normalCoefficient,
+                                               normalCoefficient, normalCoefficient, normalCoefficient, normalCoefficient);
+
+    for (int j = 0; j < size; j++) {
+        __m128 p = _mm_maskload_ps(vertices[j], mask3);     // px py pz 0
+        __m128 n = _mm_maskload_ps(normals[j], mask3);      // nx ny nz 0
+        __m128 t = (j < numTangents) ? _mm_maskload_ps(tangents[j], mask3) : _mm_setzero_ps();   // tx ty tz 0
+
+        // interleave as the first 8 floats of the unpacked offset
+        __m128 lo = _mm_blend_ps(p, _mm_permute_ps(n, _MM_SHUFFLE(0,0,0,0)), 0x8);   // px py pz nx
+        __m128 hi = _mm_shuffle_ps(n, t, _MM_SHUFFLE(1,0,2,1));                         // ny nz tx ty
+        __m256 src = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+
+        float* dst = unpacked[indices[j]];
+        _mm256_storeu_ps(dst, _mm256_fmadd_ps(src, coefficients, _mm256_loadu_ps(dst)));
+        dst[8] += _mm_cvtss_f32(_mm_permute_ps(t, _MM_SHUFFLE(2,2,2,2))) * normalCoefficient;
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
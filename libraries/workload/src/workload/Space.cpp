@@ -13,13 +13,49 @@
 //
 
 #include "Space.h"
+#include <cfloat>
 #include <cstring>
 #include <algorithm>
 
 #include <glm/gtx/quaternion.hpp>
 
+#include <TBBHelpers.h>
+
 using namespace workload;
 
+// Proxies are bucketed by their centers in cubic cells this wide, in meters
+static const float CELL_SIZE = 32.0f;
+// Cell coordinates are clamped to 21 bits per axis, the outermost cells reach out to infinity
+static const int32_t MAX_CELL_COORD = (1 << 20) - 1;
+static const Space::CellKey INVALID_CELL_KEY = (Space::CellKey)-1;
+// Below this many proxies to classify the work stays on the calling thread
+static const size_t PARALLEL_CLASSIFY_THRESHOLD = 1024;
+
+static glm::ivec3 cellCoordOf(const Sphere& sphere) {
+    glm::vec3 coord = glm::floor(glm::vec3(sphere) / CELL_SIZE);
+    return glm::ivec3(glm::clamp(coord, glm::vec3((float)-MAX_CELL_COORD), glm::vec3((float)MAX_CELL_COORD)));
+}
+
+static Space::CellKey cellKeyOf(const glm::ivec3& coord) {
+    const Space::CellKey MASK = (1 << 21) - 1;
+    return (((Space::CellKey)(coord.x + MAX_CELL_COORD) & MASK) << 42) |
+        (((Space::CellKey)(coord.y + MAX_CELL_COORD) & MASK) << 21) |
+        ((Space::CellKey)(coord.z + MAX_CELL_COORD) & MASK);
+}
+
+// Distances from a point to the nearest and farthest points of the cell
+static void cellDistances(const glm::ivec3& coord, const glm::vec3& point, float& nearest, float& farthest) {
+    glm::vec3 nearestOffset, farthestOffset;
+    for (int i = 0; i < 3; ++i) {
+        float low = (coord[i] == -MAX_CELL_COORD) ? -FLT_MAX : (float)coord[i] * CELL_SIZE;
+        float high = (coord[i] == MAX_CELL_COORD) ? FLT_MAX : (float)(coord[i] + 1) * CELL_SIZE;
+        nearestOffset[i] = point[i] - glm::clamp(point[i], low, high);
+        farthestOffset[i] = glm::max(glm::abs(point[i] - low), glm::abs(high - point[i]));
+    }
+    nearest = glm::length(nearestOffset);
+    farthest = glm::length(farthestOffset);
+}
+
 Space::Space() : Collection() {
 }
 
@@ -31,6 +67,9 @@ void Space::processTransactionFrame(const Transaction& transaction) {
     if (maxID > (Index) _proxies.size()) {
         _proxies.resize(maxID + 100); // allocate the maxId and more
         _owners.resize(maxID + 100);
+        _proxyCells.resize(maxID + 100, INVALID_CELL_KEY);
+        _proxyCellSlots.resize(maxID + 100, 0);
+        _proxyStamps.resize(maxID + 100, 0);
     }
     // Now we know for sure that we have enough items in the array to
     // capture anything coming from the transaction
@@ -56,6 +95,10 @@ void Space::processResets(const Transaction::Resets& transactions) {
         item.prevRegion = item.region = Region::UNKNOWN;
 
         _owners[proxyID] = (std::get<2>(reset));
+
+        removeFromCell(proxyID);
+        insertInCell(proxyID);
+        markDirty(proxyID);
     }
 }
 
@@ -72,6 +115,7 @@ void Space::processRemoves(const Transaction::Removes& transactions) {
         // Kill it
         item.prevRegion = item.region = Region::INVALID;
         _owners[removedID] = Owner();
+        removeFromCell(removedID);
     }
 }
 
@@ -87,37 +131,170 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
 
         // Update the item
         item.sphere = (std::get<1>(update));
+        if (item.region == Region::INVALID) {
+            continue;
+        }
+
+        if (_proxyCells[updateID] != cellKeyOf(cellCoordOf(item.sphere))) {
+            removeFromCell(updateID);
+            insertInCell(updateID);
+        } else {
+            auto& cell = _cells[_proxyCells[updateID]];
+            cell.maxRadius = std::max(cell.maxRadius, item.sphere.w);
+        }
+        markDirty(updateID);
     }
 }
 
+void Space::insertInCell(ProxyID id) {
+    const Sphere& sphere = _proxies[id].sphere;
+    glm::ivec3 coord = cellCoordOf(sphere);
+    CellKey key = cellKeyOf(coord);
+
+    auto& cell = _cells[key];
+    if (cell.proxies.empty()) {
+        cell.coord = coord;
+        cell.maxRadius = 0.0f;
+    }
+    cell.maxRadius = std::max(cell.maxRadius, sphere.w);
+    _proxyCells[id] = key;
+    _proxyCellSlots[id] = (uint32_t)cell.proxies.size();
+    cell.proxies.push_back(id);
+}
+
+void Space::removeFromCell(ProxyID id) {
+    CellKey key = _proxyCells[id];
+    if (key == INVALID_CELL_KEY) {
+        return;
+    }
+    _proxyCells[id] = INVALID_CELL_KEY;
+
+    auto cellItr = _cells.find(key);
+    if (cellItr == _cells.end()) {
+        return;
+    }
+    auto& proxies = cellItr->second.proxies;
+    uint32_t slot = _proxyCellSlots[id];
+    ProxyID last = proxies.back();
+    proxies[slot] = last;
+    _proxyCellSlots[last] = slot;
+    proxies.pop_back();
+    if (proxies.empty()) {
+        _cells.erase(cellItr);
+    }
+}
+
+void Space::markDirty(ProxyID id) {
+    _dirtyProxies.push_back(id);
+}
+
+bool Space::cellMayChangeRegion(const Cell& cell, const Views& prevViews) const {
+    // A proxy can only change region if one of its touch tests against the region spheres changes result.
+    // That can't happen to a cell which no proxy can touch, old or new, nor to one which lies entirely
+    // inside both the old and the new sphere.
+    for (size_t j = 0; j < _views.size(); ++j) {
+        for (uint32_t k = 0; k < Region::NUM_TRACKED_REGIONS; ++k) {
+            const Sphere& prevSphere = prevViews[j].regions[k];
+            const Sphere& sphere = _views[j].regions[k];
+            if (prevSphere == sphere) {
+                continue;
+            }
+            float prevNearest, prevFarthest, nearest, farthest;
+            cellDistances(cell.coord, glm::vec3(prevSphere), prevNearest, prevFarthest);
+            cellDistances(cell.coord, glm::vec3(sphere), nearest, farthest);
+
+            bool mayTouch = prevNearest < prevSphere.w + cell.maxRadius || nearest < sphere.w + cell.maxRadius;
+            bool alwaysTouches = prevFarthest < prevSphere.w && farthest < sphere.w;
+            if (mayTouch && !alwaysTouches) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint8_t Space::classify(const Proxy& proxy) const {
+    glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
+    float proxyRadius = proxy.sphere.w;
+    uint8_t region = Region::R4;
+    for (const auto& view : _views) {
+        // for each 'view' we need only increment 'k' below the current value of 'region'
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = proxyRadius + view.regions[k].w;
+            if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
+        }
+    }
+    return region;
+}
+
 void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    uint32_t numProxies = (uint32_t)_proxies.size();
-    uint32_t numViews = (uint32_t)_views.size();
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        Proxy& proxy = _proxies[i];
+
+    // only the proxies which changed last time have a prevRegion to forget
+    for (auto id : _lastChanges) {
+        Proxy& proxy = _proxies[id];
         if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::R4;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
-                }
-            }
             proxy.prevRegion = proxy.region;
-            proxy.region = region;
-            if (proxy.region != proxy.prevRegion) {
-                changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
+        }
+    }
+    _lastChanges.clear();
+
+    // gather the proxies to classify, each at most once
+    if (++_stamp == 0) {
+        std::fill(_proxyStamps.begin(), _proxyStamps.end(), 0);
+        _stamp = 1;
+    }
+    _candidates.clear();
+    auto addCandidate = [&](ProxyID id) {
+        if (_proxyStamps[id] != _stamp && _proxies[id].region < Region::INVALID) {
+            _proxyStamps[id] = _stamp;
+            _candidates.push_back(id);
+        }
+    };
+    for (auto id : _dirtyProxies) {
+        addCandidate(id);
+    }
+    _dirtyProxies.clear();
+
+    bool allCells = _views.size() != _classifiedViews.size();
+    for (const auto& cellEntry : _cells) {
+        const Cell& cell = cellEntry.second;
+        if (allCells || cellMayChangeRegion(cell, _classifiedViews)) {
+            for (auto id : cell.proxies) {
+                addCandidate(id);
             }
         }
     }
+    _classifiedViews = _views;
+
+    // report the changes in proxy order, whichever cell they came from
+    std::sort(_candidates.begin(), _candidates.end());
+
+    auto classifyCandidates = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Proxy& proxy = _proxies[_candidates[i]];
+            proxy.prevRegion = proxy.region;
+            proxy.region = classify(proxy);
+        }
+    };
+    if (_candidates.size() < PARALLEL_CLASSIFY_THRESHOLD) {
+        classifyCandidates(0, _candidates.size());
+    } else {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, _candidates.size()), [&](const tbb::blocked_range<size_t>& range) {
+            classifyCandidates(range.begin(), range.end());
+        });
+    }
+
+    for (auto id : _candidates) {
+        const Proxy& proxy = _proxies[id];
+        if (proxy.region != proxy.prevRegion) {
+            changes.emplace_back(Space::Change((int32_t)id, proxy.region, proxy.prevRegion));
+            _lastChanges.push_back(id);
+        }
+    }
 }
 
 uint32_t Space::copyProxyValues(Proxy* proxies, uint32_t numDestProxies) const {
@@ -149,7 +326,15 @@ void Space::clear() {
     _IDAllocator.clear();
     _proxies.clear();
     _owners.clear();
+    _cells.clear();
+    _proxyCells.clear();
+    _proxyCellSlots.clear();
+    _proxyStamps.clear();
+    _dirtyProxies.clear();
+    _candidates.clear();
+    _lastChanges.clear();
     _views.clear();
+    _classifiedViews.clear();
 }
 
 void Space::setViews(const Views& views) {
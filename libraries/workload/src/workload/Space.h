@@ -16,6 +16,7 @@
 #define hifi_workload_Space_h
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -26,6 +27,7 @@ namespace workload {
 class Space : public Collection {
 public:
     using ProxyUpdate = std::pair<int32_t, Sphere>;
+    using CellKey = uint64_t;
 
     class Change {
     public:
@@ -59,12 +61,37 @@ private:
     void processRemoves(const Transaction::Removes& transactions);
     void processUpdates(const Transaction::Updates& transactions);
 
+    // Proxies are bucketed by the grid cell holding their center, so that when the views move only the cells
+    // straddling a region boundary need to be classified again, along with the proxies which were reset or moved
+    class Cell {
+    public:
+        glm::ivec3 coord;
+        std::vector<ProxyID> proxies;
+        float maxRadius { 0.0f }; // grows until the cell empties, which keeps it conservative
+    };
+
+    void insertInCell(ProxyID id);
+    void removeFromCell(ProxyID id);
+    void markDirty(ProxyID id);
+    bool cellMayChangeRegion(const Cell& cell, const Views& prevViews) const;
+    uint8_t classify(const Proxy& proxy) const;
+
     // The database of proxies is protected for editing by a mutex
     mutable std::mutex _proxiesMutex;
     Proxy::Vector _proxies;
     std::vector<Owner> _owners;
 
+    std::unordered_map<CellKey, Cell> _cells;
+    std::vector<CellKey> _proxyCells;       // per proxy, the key of its cell
+    std::vector<uint32_t> _proxyCellSlots;  // per proxy, its position in the cell's list
+    std::vector<uint32_t> _proxyStamps;     // per proxy, the last stamp it was queued with
+    uint32_t _stamp { 0 };
+    std::vector<ProxyID> _dirtyProxies;
+    std::vector<ProxyID> _candidates;
+    std::vector<ProxyID> _lastChanges;
+
     Views _views;
+    Views _classifiedViews; // the views the current regions were classified against
 };
 
 using SpacePointer = std::shared_ptr<Space>;
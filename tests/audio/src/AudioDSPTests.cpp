@@ -0,0 +1,276 @@
+//
+//  AudioDSPTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioDSPTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <AudioLimiter.h>
+#include <AudioReverb.h>
+#include <AudioSRC.h>
+#include <CPUDetect.h>
+
+QTEST_MAIN(AudioDSPTests)
+
+static const float TWO_PI = 6.28318531f;
+static const int OUTPUT_SAMPLE_RATE = 48000;
+static const int NUM_INJECTORS = 16;
+
+// A chord with some noise on top, so no stage sees silence or a pure tone
+static std::vector<float> makeSignal(int numFrames, int sampleRate, float frequency) {
+    std::vector<float> signal(numFrames);
+    uint32_t seed = 1;
+    for (int i = 0; i < numFrames; i++) {
+        seed = seed * 1664525 + 1013904223;
+        float noise = (int32_t)seed * (1.0f / 2147483648.0f);
+        signal[i] = 0.4f * sinf(TWO_PI * frequency * i / sampleRate) +
+                    0.2f * sinf(TWO_PI * 1.5f * frequency * i / sampleRate) + 0.05f * noise;
+    }
+    return signal;
+}
+
+void AudioDSPTests::testReverbBlockSizeInvariance() {
+    const int numFrames = OUTPUT_SAMPLE_RATE;
+    auto left = makeSignal(numFrames, OUTPUT_SAMPLE_RATE, 440.0f);
+    auto right = makeSignal(numFrames, OUTPUT_SAMPLE_RATE, 330.0f);
+
+    // the reverb works in blocks internally, its output must not depend on how the caller chunks the audio
+    std::vector<float> expected[2];
+    for (int blockSize : { 1, 7, 240, 1000 }) {
+        AudioReverb reverb(OUTPUT_SAMPLE_RATE);
+        std::vector<float> output[2] = { std::vector<float>(numFrames), std::vector<float>(numFrames) };
+
+        for (int i = 0; i < numFrames; i += blockSize) {
+            int n = std::min(blockSize, numFrames - i);
+            float* inputs[2] = { &left[i], &right[i] };
+            float* outputs[2] = { &output[0][i], &output[1][i] };
+            reverb.render(inputs, outputs, n);
+        }
+
+        if (blockSize == 1) {
+            expected[0] = output[0];
+            expected[1] = output[1];
+        } else {
+            QCOMPARE(output[0], expected[0]);
+            QCOMPARE(output[1], expected[1]);
+        }
+    }
+}
+
+static float maxDifference(const std::vector<float>& a, const std::vector<float>& b, int numSamples) {
+    float difference = 0.0f;
+    for (int i = 0; i < numSamples; i++) {
+        difference = std::max(difference, std::abs(a[i] - b[i]));
+    }
+    return difference;
+}
+
+void AudioDSPTests::testReverbBlocksMatchFrames() {
+    const int numFrames = OUTPUT_SAMPLE_RATE;
+    auto left = makeSignal(numFrames, OUTPUT_SAMPLE_RATE, 440.0f);
+    auto right = makeSignal(numFrames, OUTPUT_SAMPLE_RATE, 330.0f);
+
+    // the default room, and a long tail with deep modulation
+    ReverbParameters parameters[2];
+    AudioReverb(OUTPUT_SAMPLE_RATE).getParameters(&parameters[0]);
+    parameters[1] = parameters[0];
+    parameters[1].reverbTime = 10.0f;
+    parameters[1].modDepth = 100.0f;
+
+    for (auto& p : parameters) {
+        AudioReverb blockReverb(OUTPUT_SAMPLE_RATE);
+        AudioReverb frameReverb(OUTPUT_SAMPLE_RATE);
+        blockReverb.setParameters(&p);
+        frameReverb.setParameters(&p);
+
+        std::vector<float> blockOutput[2] = { std::vector<float>(numFrames), std::vector<float>(numFrames) };
+        std::vector<float> frameOutput[2] = { std::vector<float>(numFrames), std::vector<float>(numFrames) };
+        float* inputs[2] = { left.data(), right.data() };
+        float* blockOutputs[2] = { blockOutput[0].data(), blockOutput[1].data() };
+        float* frameOutputs[2] = { frameOutput[0].data(), frameOutput[1].data() };
+        blockReverb.render(inputs, blockOutputs, numFrames);
+        frameReverb.renderFrames(inputs, frameOutputs, numFrames);
+
+        // the same network computed in the same order, so the output is bit-identical
+        QCOMPARE(blockOutput[0], frameOutput[0]);
+        QCOMPARE(blockOutput[1], frameOutput[1]);
+    }
+}
+
+void AudioDSPTests::testResamplerKernelsMatchReference() {
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+    // a kernel reads its filter's length past the last input frame
+    const int numFrames = 4800;
+    const int PADDING = 1024;
+    std::vector<float> signals[SRC_MAX_CHANNELS];
+    for (int c = 0; c < SRC_MAX_CHANNELS; c++) {
+        signals[c] = makeSignal(numFrames + PADDING, AudioConstants::SAMPLE_RATE, 220.0f * (c + 1));
+    }
+
+    using Kernel = std::function<int(AudioSRC&, float**, float**, int)>;
+    // for 1, 2 and 4 channels
+    struct Kernels {
+        const char* name;
+        bool isSupported;
+        Kernel filters[3];
+    };
+#define SRC_KERNELS(suffix) { \
+        [](AudioSRC& src, float** in, float** out, int n) { \
+            return src.multirateFilter1##suffix(in[0], out[0], n); }, \
+        [](AudioSRC& src, float** in, float** out, int n) { \
+            return src.multirateFilter2##suffix(in[0], in[1], out[0], out[1], n); }, \
+        [](AudioSRC& src, float** in, float** out, int n) { \
+            return src.multirateFilter4##suffix(in[0], in[1], in[2], in[3], out[0], out[1], out[2], out[3], n); } }
+
+    Kernels reference { "ref", true, SRC_KERNELS(_ref) };
+    Kernels kernels[] = {
+        { "SSE", true, SRC_KERNELS(_SSE) },
+        { "AVX2", cpuSupportsAVX2(), SRC_KERNELS(_AVX2) },
+        { "AVX512", cpuSupportsAVX512(), SRC_KERNELS(_AVX512) },
+    };
+#undef SRC_KERNELS
+
+    // each kernel runs on a resampler of its own, fed in uneven chunks so its phase carries across calls
+    auto run = [&](const Kernel& kernel, int inputRate, int outputRate, int numChannels,
+                   std::vector<float>* outputs) {
+        AudioSRC resampler(inputRate, outputRate, numChannels);
+        Q_ASSERT(resampler._numTaps <= PADDING);
+        int maxOutputFrames = resampler.getMaxOutput(numFrames) + 1;
+        for (int c = 0; c < numChannels; c++) {
+            outputs[c].assign(maxOutputFrames, 0.0f);
+        }
+        const int CHUNK_SIZES[] = { 1, 37, 256, 480, 1001 };
+        int outputFrames = 0;
+        for (int i = 0, chunk = 0; i < numFrames; chunk++) {
+            int n = std::min(CHUNK_SIZES[chunk % 5], numFrames - i);
+            float* in[SRC_MAX_CHANNELS];
+            float* out[SRC_MAX_CHANNELS];
+            for (int c = 0; c < numChannels; c++) {
+                in[c] = &signals[c][i];
+                out[c] = &outputs[c][outputFrames];
+            }
+            outputFrames += kernel(resampler, in, out, n);
+            i += n;
+        }
+        return outputFrames;
+    };
+
+    // upsampling and downsampling by rational factors, and an odd device rate which needs the irrational filter
+    const int RATES[][2] = { { 24000, 48000 }, { 48000, 24000 }, { 44100, 48000 }, { 24000, 44117 } };
+    const int CHANNELS[] = { 1, 2, 4 };
+    // the kernels only reorder the sums and may fuse their multiply-adds
+    const float TOLERANCE = 1.0e-5f;
+
+    for (const auto& rates : RATES) {
+        for (int k = 0; k < 3; k++) {
+            int numChannels = CHANNELS[k];
+            std::vector<float> expected[SRC_MAX_CHANNELS];
+            int numExpectedFrames = run(reference.filters[k], rates[0], rates[1], numChannels, expected);
+
+            for (const auto& candidate : kernels) {
+                if (!candidate.isSupported) {
+                    continue;
+                }
+                std::vector<float> output[SRC_MAX_CHANNELS];
+                int numOutputFrames = run(candidate.filters[k], rates[0], rates[1], numChannels, output);
+                QCOMPARE(numOutputFrames, numExpectedFrames);
+                for (int c = 0; c < numChannels; c++) {
+                    float difference = maxDifference(output[c], expected[c], numOutputFrames);
+                    QVERIFY2(difference < TOLERANCE, qPrintable(QString("%1 %2 to %3 Hz, %4 channels: %5")
+                        .arg(candidate.name).arg(rates[0]).arg(rates[1]).arg(numChannels).arg(difference)));
+                }
+            }
+        }
+    }
+#else
+    QSKIP("The SIMD resampler kernels are x86 only");
+#endif
+}
+
+void AudioDSPTests::benchmarkResampler() {
+    // received network audio upsampled to the device rate
+    const int inputFrames = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    auto left = makeSignal(AudioConstants::SAMPLE_RATE, AudioConstants::SAMPLE_RATE, 440.0f);
+    auto right = makeSignal(AudioConstants::SAMPLE_RATE, AudioConstants::SAMPLE_RATE, 330.0f);
+
+    AudioSRC resampler(AudioConstants::SAMPLE_RATE, OUTPUT_SAMPLE_RATE, AudioConstants::STEREO);
+    int maxOutputFrames = resampler.getMaxOutput(inputFrames);
+    std::vector<float> output[2] = { std::vector<float>(maxOutputFrames), std::vector<float>(maxOutputFrames) };
+
+    QBENCHMARK {
+        for (int i = 0; i + inputFrames <= AudioConstants::SAMPLE_RATE; i += inputFrames) {
+            float* inputs[2] = { &left[i], &right[i] };
+            float* outputs[2] = { output[0].data(), output[1].data() };
+            resampler.render(inputs, outputs, inputFrames);
+        }
+    }
+}
+
+void AudioDSPTests::benchmarkReverb() {
+    const int numFrames = OUTPUT_SAMPLE_RATE / 100;
+    auto left = makeSignal(OUTPUT_SAMPLE_RATE, OUTPUT_SAMPLE_RATE, 440.0f);
+    auto right = makeSignal(OUTPUT_SAMPLE_RATE, OUTPUT_SAMPLE_RATE, 330.0f);
+
+    AudioReverb reverb(OUTPUT_SAMPLE_RATE);
+    std::vector<float> output[2] = { std::vector<float>(numFrames), std::vector<float>(numFrames) };
+
+    QBENCHMARK {
+        for (int i = 0; i + numFrames <= OUTPUT_SAMPLE_RATE; i += numFrames) {
+            float* inputs[2] = { &left[i], &right[i] };
+            float* outputs[2] = { output[0].data(), output[1].data() };
+            reverb.render(inputs, outputs, numFrames);
+        }
+    }
+}
+
+void AudioDSPTests::benchmarkLimiter() {
+    // the interleaved stereo mix, limited back to int16_t
+    const int numFrames = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    auto signal = makeSignal(2 * AudioConstants::SAMPLE_RATE, AudioConstants::SAMPLE_RATE, 440.0f);
+    for (auto& sample : signal) {
+        sample *= 4.0f;    // hot enough to engage the limiter
+    }
+
+    AudioLimiter limiter(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    std::vector<int16_t> output(2 * numFrames);
+
+    QBENCHMARK {
+        for (int i = 0; i + numFrames <= AudioConstants::SAMPLE_RATE; i += numFrames) {
+            limiter.render(&signal[2 * i], output.data(), numFrames);
+        }
+    }
+}
+
+void AudioDSPTests::benchmarkInjectorMix() {
+    // spatializing local injectors into the network rate stereo mix
+    std::vector<int16_t> source(AudioConstants::SAMPLE_RATE);
+    auto signal = makeSignal(AudioConstants::SAMPLE_RATE, AudioConstants::SAMPLE_RATE, 440.0f);
+    for (int i = 0; i < AudioConstants::SAMPLE_RATE; i++) {
+        source[i] = (int16_t)(signal[i] * 32767.0f);
+    }
+
+    std::vector<AudioHRTF> hrtfs(NUM_INJECTORS);
+    std::vector<float> mix(2 * HRTF_BLOCK);
+
+    QBENCHMARK {
+        for (int i = 0; i + HRTF_BLOCK <= AudioConstants::SAMPLE_RATE; i += HRTF_BLOCK) {
+            std::fill(mix.begin(), mix.end(), 0.0f);
+            for (int j = 0; j < NUM_INJECTORS; j++) {
+                float azimuth = TWO_PI * j / NUM_INJECTORS;
+                hrtfs[j].render(&source[i], mix.data(), 0, azimuth, 1.0f + j, 1.0f, HRTF_BLOCK);
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  AudioDSPTests.h
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioDSPTests_h
+#define hifi_AudioDSPTests_h
+
+#include <QtTest/QtTest>
+
+// Each benchmark processes one second of audio per iteration, so the reported time is CPU per second of audio
+class AudioDSPTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testReverbBlockSizeInvariance();
+    void testReverbBlocksMatchFrames();
+    void testResamplerKernelsMatchReference();
+    void benchmarkResampler();
+    void benchmarkReverb();
+    void benchmarkLimiter();
+    void benchmarkInjectorMix();
+};
+
+#endif // hifi_AudioDSPTests_h
@@ -0,0 +1,346 @@
+//
+//  LocalInjectorTableTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LocalInjectorTableTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include <AbstractAudioInterface.h>
+#include <AudioConstants.h>
+#include <AudioReverb.h>
+#include <AudioSRC.h>
+#include <LocalInjectorTable.h>
+
+QTEST_MAIN(LocalInjectorTableTests)
+
+// Counts every allocation and release made by the process while enabled
+static std::atomic<bool> countAllocations { false };
+static std::atomic<int> numAllocations { 0 };
+
+static void countAllocation() {
+    if (countAllocations.load(std::memory_order_relaxed)) {
+        numAllocations++;
+    }
+}
+
+// Qt's containers allocate with malloc() and realloc() rather than new, so those are counted where they can be
+// replaced.  There new and delete are counted by the malloc() and free() they call.
+#if defined(__GLIBC__)
+#define COUNTS_MALLOC
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void __libc_free(void* pointer);
+
+void* malloc(size_t size) noexcept {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) noexcept {
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+void free(void* pointer) noexcept {
+    if (pointer) {
+        countAllocation();
+    }
+    __libc_free(pointer);
+}
+}
+#endif
+
+void* operator new(size_t size) {
+#ifndef COUNTS_MALLOC
+    countAllocation();
+#endif
+    void* result = malloc(size ? size : 1);
+    if (!result) {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void operator delete(void* pointer) noexcept {
+#ifndef COUNTS_MALLOC
+    if (pointer) {
+        countAllocation();
+    }
+#endif
+    free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+static const float TWO_PI = 6.28318531f;
+static const int FRAMES_TO_MIX = 100;
+
+// A second of a tone
+static AudioDataPointer makeTone() {
+    std::vector<int16_t> samples(AudioConstants::SAMPLE_RATE);
+    for (size_t i = 0; i < samples.size(); i++) {
+        samples[i] = (int16_t)(16000.0f * sinf(TWO_PI * 440.0f * i / AudioConstants::SAMPLE_RATE));
+    }
+    return AudioData::make((uint32_t)samples.size(), 1, samples.data());
+}
+
+static AudioInjectorPointer makeInjector(float volume = 1.0f) {
+    AudioInjectorOptions options;
+    options.volume = volume;
+    options.position = glm::vec3(1.0f, 0.0f, 0.0f);
+    return AudioInjectorPointer::create(makeTone(), options);
+}
+
+// Plays local injectors through a table of its own, as the audio client does
+class TestAudioInterface : public AbstractAudioInterface {
+public:
+    bool outputLocalInjector(const AudioInjectorPointer& injector) override {
+        table.add(injector);
+        return true;
+    }
+    AudioSolo& getAudioSolo() override { return _audioSolo; }
+
+    bool setIsStereoInput(bool stereo) override { return false; }
+    bool isStereoInput() override { return false; }
+    bool getLocalEcho() override { return false; }
+    void setLocalEcho(bool localEcho) override {}
+    void toggleLocalEcho() override {}
+    bool getServerEcho() override { return false; }
+    void setServerEcho(bool serverEcho) override {}
+    void toggleServerEcho() override {}
+
+    LocalInjectorTable table;
+
+private:
+    AudioSolo _audioSolo;
+};
+
+// An injector playing a tone locally, through the interface set with AudioInjector::setLocalAudioInterface
+static AudioInjectorPointer startInjector(AudioInjectorOptions options) {
+    options.localOnly = true;
+    auto injector = AudioInjectorPointer::create(makeTone(), options);
+    // restarting a finished injector injects it again, which hands it to the audio interface with a new buffer
+    injector->finish();
+    injector->restart();
+    return injector;
+}
+
+// Renders a tone through the voice's HRTF the way the client does, with the volume as the loudness
+static bool renderVoice(LocalInjectorTable::Voice& voice, float* mixBuffer) {
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        voice.buffer[i] = (int16_t)(16000.0f * sinf(TWO_PI * i / AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL));
+    }
+    voice.injector->getLocalHRTF().render(voice.buffer, mixBuffer, 1, 0.5f, 1.0f, voice.options.volume,
+                                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    voice.loudness.store(voice.options.volume, std::memory_order_relaxed);
+    return true;
+}
+
+void LocalInjectorTableTests::testMixDoesNotAllocate() {
+    TestAudioInterface audioInterface;
+    AudioInjector::setLocalAudioInterface(&audioInterface);
+    auto& table = audioInterface.table;
+
+    // every way a voice is rendered, each injector with one second of audio
+    std::vector<AudioInjectorPointer> injectors;
+    for (int i = 0; i < LocalInjectorTable::CAPACITY; i++) {
+        AudioInjectorOptions options;
+        options.positionSet = (i % 4 == 0) || (i % 4 == 3);
+        options.position = glm::vec3(1.0f, 0.0f, (float)i);
+        options.stereo = (i % 4 == 1);
+        options.ambisonic = (i % 4 == 3);
+        injectors.push_back(startInjector(options));
+    }
+    QCOMPARE(table.size(), LocalInjectorTable::CAPACITY);
+    table.update();
+
+    // what prepareLocalAudioInjectors() does with each network frame
+    LocalInjectorTable::Listener listener;
+    AudioReverb reverb(AudioConstants::SAMPLE_RATE);
+    AudioSRC resampler(AudioConstants::SAMPLE_RATE, 48000, AudioConstants::STEREO);
+    float mixBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    std::vector<float> outputBuffer(resampler.getMaxOutput(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) *
+                                    AudioConstants::STEREO);
+
+    numAllocations = 0;
+    countAllocations = true;
+    // the frame after the last one finishes every injector, which must not release them either
+    int numMixed = 0;
+    for (int frame = 0; frame <= FRAMES_TO_MIX; frame++) {
+        if (table.mixFrame(mixBuffer, listener)) {
+            reverb.render(mixBuffer, mixBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            resampler.render(mixBuffer, outputBuffer.data(), AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            numMixed++;
+        }
+    }
+    countAllocations = false;
+
+    QCOMPARE(numAllocations.load(), 0);
+    QCOMPARE(numMixed, FRAMES_TO_MIX + 1);
+    QVERIFY(!table.isPlaying());
+    QCOMPARE(table.update().size(), LocalInjectorTable::CAPACITY);
+    AudioInjector::setLocalAudioInterface(nullptr);
+}
+
+void LocalInjectorTableTests::testFinishedInjectorsReleased() {
+    LocalInjectorTable table;
+    auto first = makeInjector();
+    auto second = makeInjector();
+    table.add(first);
+    table.add(second);
+    QCOMPARE(table.size(), 2);
+    QVERIFY(table.isPlaying());
+
+    float mixBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] {};
+    table.mix([&](LocalInjectorTable::Voice& voice, bool isStolen) {
+        return renderVoice(voice, mixBuffer) && voice.injector != first;
+    });
+
+    // finished voices hold on to their injector until the other side releases it
+    QCOMPARE(table.size(), 2);
+    auto finished = table.update();
+    QCOMPARE(finished.size(), 1);
+    QCOMPARE(finished.front(), first);
+    QCOMPARE(table.size(), 1);
+    QVERIFY(table.isPlaying());
+
+    // a released injector can be played again
+    QVERIFY(table.add(first));
+    QCOMPARE(table.size(), 2);
+}
+
+void LocalInjectorTableTests::testQuietestVoiceStolen() {
+    LocalInjectorTable table;
+    std::vector<AudioInjectorPointer> injectors;
+    for (int i = 0; i < LocalInjectorTable::CAPACITY; i++) {
+        // the quietest injector is in the middle of the table
+        float volume = (i == LocalInjectorTable::CAPACITY / 2) ? 0.1f : 1.0f;
+        injectors.push_back(makeInjector(volume));
+        table.add(injectors.back());
+    }
+    table.update();
+
+    float mixBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] {};
+    auto render = [&](LocalInjectorTable::Voice& voice, bool isStolen) {
+        return renderVoice(voice, mixBuffer);
+    };
+    table.mix(render);
+
+    // the new injector waits for a voice
+    auto newInjector = makeInjector();
+    QVERIFY(table.add(newInjector));
+    QCOMPARE(table.size(), LocalInjectorTable::CAPACITY + 1);
+
+    std::vector<AudioInjectorPointer> stolen;
+    table.mix([&](LocalInjectorTable::Voice& voice, bool isStolen) {
+        if (isStolen) {
+            stolen.push_back(voice.injector);
+        }
+        return renderVoice(voice, mixBuffer);
+    });
+    QCOMPARE((int)stolen.size(), 1);
+    QCOMPARE(stolen.front(), injectors[LocalInjectorTable::CAPACITY / 2]);
+
+    auto finished = table.update();
+    QCOMPARE(finished.size(), 1);
+    QCOMPARE(finished.front(), stolen.front());
+    QCOMPARE(table.size(), LocalInjectorTable::CAPACITY);
+
+    bool isNewInjectorPlaying = false;
+    table.mix([&](LocalInjectorTable::Voice& voice, bool isStolen) {
+        isNewInjectorPlaying |= (voice.injector == newInjector);
+        return renderVoice(voice, mixBuffer);
+    });
+    QVERIFY(isNewInjectorPlaying);
+}
+
+void LocalInjectorTableTests::testStoppedVoiceFadesOut() {
+    TestAudioInterface audioInterface;
+    AudioInjector::setLocalAudioInterface(&audioInterface);
+    auto& table = audioInterface.table;
+    LocalInjectorTable::Listener listener;
+    float mixBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+
+    // the voices mixed without spatialization
+    for (bool isStereo : { false, true }) {
+        AudioInjectorOptions options;
+        options.positionSet = false;
+        options.stereo = isStereo;
+        auto injector = startInjector(options);
+        table.update();
+        QVERIFY(table.mixFrame(mixBuffer, listener));
+        QVERIFY(table.mixFrame(mixBuffer, listener));
+
+        // the voice keeps its own buffer, and fades out over the frame after the injector stops
+        injector->finish();
+        QVERIFY(table.update().empty());
+        QVERIFY(table.mixFrame(mixBuffer, listener));
+        float startPeak = 0.0f;
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO / 4; i++) {
+            startPeak = std::max(startPeak, std::abs(mixBuffer[i]));
+        }
+        QVERIFY(startPeak > 0.05f);
+        QVERIFY(std::abs(mixBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO - 1]) < 0.01f * startPeak);
+        QVERIFY(std::abs(mixBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO - 2]) < 0.01f * startPeak);
+
+        QVERIFY(!table.isPlaying());
+        auto finished = table.update();
+        QCOMPARE(finished.size(), 1);
+        QCOMPARE(finished.front(), injector);
+        QCOMPARE(table.size(), 0);
+    }
+    AudioInjector::setLocalAudioInterface(nullptr);
+}
+
+void LocalInjectorTableTests::testRestartedInjectorKeepsPlaying() {
+    TestAudioInterface audioInterface;
+    AudioInjector::setLocalAudioInterface(&audioInterface);
+    auto& table = audioInterface.table;
+    LocalInjectorTable::Listener listener;
+    float mixBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+
+    auto injector = startInjector(AudioInjectorOptions());
+    table.update();
+    QVERIFY(table.mixFrame(mixBuffer, listener));
+
+    // the old buffer fades out on its voice while the new one starts on another
+    injector->finish();
+    injector->restart();
+    QCOMPARE(table.size(), 2);
+    int numStolen = 0;
+    table.mix([&](LocalInjectorTable::Voice& voice, bool isStolen) {
+        numStolen += isStolen ? 1 : 0;
+        return true;
+    });
+    QCOMPARE(numStolen, 1);
+
+    // the injector isn't finished, only its old voice is
+    QVERIFY(table.update().empty());
+    QCOMPARE(table.size(), 1);
+    QVERIFY(table.isPlaying());
+    QVERIFY(!table.add(injector));
+    AudioInjector::setLocalAudioInterface(nullptr);
+}
@@ -0,0 +1,26 @@
+//
+//  LocalInjectorTableTests.h
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LocalInjectorTableTests_h
+#define hifi_LocalInjectorTableTests_h
+
+#include <QtTest/QtTest>
+
+class LocalInjectorTableTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testMixDoesNotAllocate();
+    void testFinishedInjectorsReleased();
+    void testQuietestVoiceStolen();
+    void testStoppedVoiceFadesOut();
+    void testRestartedInjectorKeepsPlaying();
+};
+
+#endif // hifi_LocalInjectorTableTests_h
@@ -0,0 +1,171 @@
+//
+//  SoundTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SoundTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QtEndian>
+
+#include <AudioSRC.h>
+#include <Sound.h>
+
+QTEST_MAIN(SoundTests)
+
+static const float TWO_PI = 6.28318531f;
+
+static std::vector<int16_t> makeTone(int sampleRate, int numChannels, float seconds) {
+    int numFrames = (int)(sampleRate * seconds);
+    std::vector<int16_t> samples(numFrames * numChannels);
+    for (int i = 0; i < numFrames; i++) {
+        for (int c = 0; c < numChannels; c++) {
+            float phase = TWO_PI * (440.0f + 110.0f * c) * i / sampleRate;
+            samples[i * numChannels + c] = (int16_t)(16000.0f * sinf(phase));
+        }
+    }
+    return samples;
+}
+
+static void appendLE32(QByteArray& data, quint32 value) {
+    value = qToLittleEndian(value);
+    data.append((const char*)&value, sizeof(value));
+}
+
+static void appendLE16(QByteArray& data, quint16 value) {
+    value = qToLittleEndian(value);
+    data.append((const char*)&value, sizeof(value));
+}
+
+static QByteArray makeWav(const std::vector<int16_t>& samples, int sampleRate, int numChannels) {
+    quint32 dataSize = (quint32)(samples.size() * sizeof(int16_t));
+    QByteArray wav;
+    wav.append("RIFF");
+    appendLE32(wav, 36 + dataSize);
+    wav.append("WAVE");
+    wav.append("fmt ");
+    appendLE32(wav, 16);
+    appendLE16(wav, 1);
+    appendLE16(wav, numChannels);
+    appendLE32(wav, sampleRate);
+    appendLE32(wav, sampleRate * numChannels * 2);
+    appendLE16(wav, numChannels * 2);
+    appendLE16(wav, 16);
+    wav.append("data");
+    appendLE32(wav, dataSize);
+    wav.append((const char*)samples.data(), dataSize);
+    return wav;
+}
+
+// Runs the processor on this thread, returning the sound it published and how much of it was decoded when it did
+static AudioDataPointer processSound(const QString& fileName, const QByteArray& data,
+                                     uint32_t* numSamplesAvailableWhenPlayable = nullptr) {
+    QSharedPointer<Sound> sound(new Sound(QUrl("file:///" + fileName)));
+    SoundProcessor processor(sound, data);
+
+    AudioDataPointer result;
+    QObject::connect(&processor, &SoundProcessor::onSuccess, [&](AudioDataPointer audioData) {
+        result = audioData;
+        if (numSamplesAvailableWhenPlayable) {
+            *numSamplesAvailableWhenPlayable = audioData->getNumSamplesAvailable();
+        }
+    });
+    processor.run();
+    return result;
+}
+
+void SoundTests::testWavAtMixerRate() {
+    auto samples = makeTone(AudioConstants::SAMPLE_RATE, 1, 0.5f);
+    auto audioData = processSound("tone.wav", makeWav(samples, AudioConstants::SAMPLE_RATE, 1));
+
+    QVERIFY(audioData);
+    QVERIFY(audioData->isComplete());
+    QCOMPARE(audioData->getNumChannels(), (uint32_t)1);
+    QCOMPARE(audioData->getNumSamples(), (uint32_t)samples.size());
+    QVERIFY(memcmp(audioData->data(), samples.data(), samples.size() * sizeof(int16_t)) == 0);
+}
+
+void SoundTests::testResampledWavMatchesWholeRender() {
+    const int SOURCE_RATE = 44100;
+    const int NUM_CHANNELS = 2;
+    auto samples = makeTone(SOURCE_RATE, NUM_CHANNELS, 3.0f);
+    auto audioData = processSound("tone.wav", makeWav(samples, SOURCE_RATE, NUM_CHANNELS));
+
+    // what resampling the whole sound in one call used to produce
+    int numSourceFrames = (int)samples.size() / NUM_CHANNELS;
+    AudioSRC resampler(SOURCE_RATE, AudioConstants::SAMPLE_RATE, NUM_CHANNELS);
+    std::vector<int16_t> expected(resampler.getMaxOutput(numSourceFrames) * NUM_CHANNELS);
+    int numExpectedFrames = resampler.render(samples.data(), expected.data(), numSourceFrames);
+
+    QVERIFY(audioData);
+    QVERIFY(audioData->isComplete());
+    QCOMPARE(audioData->getNumChannels(), (uint32_t)NUM_CHANNELS);
+    QVERIFY(audioData->getNumFrames() <= (uint32_t)numExpectedFrames);
+    QVERIFY(audioData->getNumFrames() + 1 >= (uint32_t)numExpectedFrames);
+    // decoding a block at a time only changes how the work is split, allow for rounding differences
+    int maxDifference = 0;
+    for (uint32_t i = 0; i < audioData->getNumSamples(); i++) {
+        maxDifference = std::max(maxDifference, std::abs(audioData->data()[i] - expected[i]));
+    }
+    QVERIFY(maxDifference <= 2);
+}
+
+void SoundTests::testPlayableBeforeDecoded() {
+    auto samples = makeTone(48000, 1, 10.0f);
+    uint32_t numSamplesAvailableWhenPlayable = 0;
+    auto audioData = processSound("long.wav", makeWav(samples, 48000, 1), &numSamplesAvailableWhenPlayable);
+
+    QVERIFY(audioData);
+    QVERIFY(numSamplesAvailableWhenPlayable > 0);
+    QVERIFY(numSamplesAvailableWhenPlayable < audioData->getNumSamples() / 10);
+    QVERIFY(audioData->isComplete());
+}
+
+void SoundTests::testWaitUntilComplete() {
+    auto samples = makeTone(44100, 2, 10.0f);
+    QSharedPointer<Sound> sound(new Sound(QUrl("file:///long.wav")));
+    SoundProcessor processor(sound, makeWav(samples, 44100, 2));
+
+    // the sound is handed out after its first block, while the rest is still decoding on the other thread
+    std::promise<AudioDataPointer> playable;
+    QObject::connect(&processor, &SoundProcessor::onSuccess, [&](AudioDataPointer audioData) {
+        playable.set_value(audioData);
+    });
+    std::thread decoder([&] { processor.run(); });
+
+    auto audioData = playable.get_future().get();
+    audioData->waitUntilComplete();
+    bool isComplete = audioData->isComplete();
+    decoder.join();
+
+    QVERIFY(isComplete);
+    // a complete sound returns straight away
+    audioData->waitUntilComplete();
+}
+
+void SoundTests::testTruncatedWav() {
+    auto samples = makeTone(AudioConstants::SAMPLE_RATE, 1, 0.5f);
+    auto wav = makeWav(samples, AudioConstants::SAMPLE_RATE, 1);
+    wav.chop(100);
+
+    QSharedPointer<Sound> sound(new Sound(QUrl("file:///truncated.wav")));
+    SoundProcessor processor(sound, wav);
+    bool failed = false;
+    bool succeeded = false;
+    QObject::connect(&processor, &SoundProcessor::onError, [&] { failed = true; });
+    QObject::connect(&processor, &SoundProcessor::onSuccess, [&] { succeeded = true; });
+    processor.run();
+
+    QVERIFY(failed);
+    QVERIFY(!succeeded);
+}
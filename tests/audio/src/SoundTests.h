@@ -0,0 +1,26 @@
+//
+//  SoundTests.h
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SoundTests_h
+#define hifi_SoundTests_h
+
+#include <QtTest/QtTest>
+
+class SoundTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testWavAtMixerRate();
+    void testResampledWavMatchesWholeRender();
+    void testPlayableBeforeDecoded();
+    void testWaitUntilComplete();
+    void testTruncatedWav();
+};
+
+#endif // hifi_SoundTests_h
@@ -0,0 +1,257 @@
+//
+//  PolyVoxChunksTests.cpp
+//  tests/entities-renderer/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunksTests.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <memory>
+#include <tuple>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+#include <PolyVoxChunks.h>
+#include <SharedUtil.h>
+
+#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
+#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
+#include <PolyVoxCore/Material.h>
+
+QTEST_MAIN(PolyVoxChunksTests)
+
+using Volume = PolyVox::SimpleVolume<uint8_t>;
+
+static std::shared_ptr<Volume> makeTerrain(int size) {
+    auto volume = std::make_shared<Volume>(PolyVox::Region(PolyVox::Vector3DInt32(0, 0, 0),
+                                                           PolyVox::Vector3DInt32(size - 1, size - 1, size - 1)));
+    volume->setBorderValue(255);
+    for (int z = 0; z < size; z++) {
+        for (int x = 0; x < size; x++) {
+            int height = size / 3 + (int)(4.0f * sinf(0.2f * x) + 4.0f * cosf(0.15f * z));
+            for (int y = 0; y < size; y++) {
+                volume->setVoxelAt(x, y, z, (y < height) ? 255 : 0);
+            }
+        }
+    }
+    return volume;
+}
+
+using TrianglePositions = std::array<std::tuple<int, int, int>, 3>;
+
+// the triangles of a mesh by vertex position, in a canonical order so that meshes built differently can be compared.
+// Positions are quantized, since the chunks add their offset after the extractor has interpolated a position.
+static std::vector<TrianglePositions> sortedTriangles(const std::vector<PolyVoxChunks::Vertex>& vertices,
+                                                      const std::vector<uint32_t>& indices) {
+    const float QUANTUM = 1.0f / 1024.0f;
+    std::vector<TrianglePositions> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        TrianglePositions triangle;
+        for (int j = 0; j < 3; j++) {
+            const PolyVox::Vector3DFloat& position = vertices[indices[i + j]].getPosition();
+            triangle[j] = std::make_tuple((int)roundf(position.getX() / QUANTUM), (int)roundf(position.getY() / QUANTUM),
+                                          (int)roundf(position.getZ() / QUANTUM));
+        }
+        // start from the smallest vertex, which keeps the winding
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+static std::vector<TrianglePositions> fullExtractionTriangles(Volume* volume, bool marchingCubes) {
+    PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+    if (marchingCubes) {
+        PolyVox::MarchingCubesSurfaceExtractor<Volume> surfaceExtractor(volume, volume->getEnclosingRegion(), &polyVoxMesh);
+        surfaceExtractor.execute();
+    } else {
+        PolyVox::CubicSurfaceExtractorWithNormals<Volume> surfaceExtractor(volume, volume->getEnclosingRegion(), &polyVoxMesh);
+        surfaceExtractor.execute();
+    }
+    return sortedTriangles(polyVoxMesh.getRawVertexData(), polyVoxMesh.getIndices());
+}
+
+static void compareWithFullExtraction(const PolyVoxChunks& chunks, Volume* volume, bool marchingCubes) {
+    std::vector<PolyVoxChunks::Vertex> vertices;
+    std::vector<uint32_t> indices;
+    chunks.getMesh(vertices, indices);
+    QVERIFY(indices.size() > 0);
+
+    auto triangles = sortedTriangles(vertices, indices);
+    auto expectedTriangles = fullExtractionTriangles(volume, marchingCubes);
+    QCOMPARE(triangles.size(), expectedTriangles.size());
+    QVERIFY(triangles == expectedTriangles);
+}
+
+static void setSphere(Volume* volume, PolyVoxChunks& chunks, const glm::ivec3& center, int radius, uint8_t value) {
+    for (int z = center.z - radius; z <= center.z + radius; z++) {
+        for (int y = center.y - radius; y <= center.y + radius; y++) {
+            for (int x = center.x - radius; x <= center.x + radius; x++) {
+                glm::ivec3 v(x, y, z);
+                if (glm::any(glm::lessThan(v, glm::ivec3(0))) || glm::any(glm::greaterThanEqual(v, chunks.getVolumeSize())) ||
+                    glm::distance(glm::vec3(v), glm::vec3(center)) > (float)radius) {
+                    continue;
+                }
+                volume->setVoxelAt(x, y, z, value);
+                chunks.markVoxelDirty(v);
+            }
+        }
+    }
+}
+
+static void verifyMatchesFullExtraction(bool marchingCubes) {
+    // not a multiple of the chunk size, so the last chunk along each axis is partial
+    const int SIZE = 40;
+    auto volume = makeTerrain(SIZE);
+
+    PolyVoxChunks chunks(glm::ivec3(SIZE), marchingCubes);
+    QCOMPARE(chunks.getNumDirtyChunks(), chunks.getNumChunks());
+    QCOMPARE(chunks.extractDirtyChunks(volume.get()), chunks.getNumChunks());
+    QCOMPARE(chunks.getNumDirtyChunks(), 0);
+
+    compareWithFullExtraction(chunks, volume.get(), marchingCubes);
+
+    std::vector<PolyVoxChunks::Vertex> vertices;
+    std::vector<uint32_t> indices;
+    chunks.getMesh(vertices, indices);
+    for (uint32_t index : indices) {
+        QVERIFY(index < vertices.size());
+    }
+    for (const auto& vertex : vertices) {
+        const PolyVox::Vector3DFloat& position = vertex.getPosition();
+        QVERIFY(position.getX() >= 0.0f && position.getX() <= (float)SIZE);
+        QVERIFY(position.getY() >= 0.0f && position.getY() <= (float)SIZE);
+        QVERIFY(position.getZ() >= 0.0f && position.getZ() <= (float)SIZE);
+    }
+}
+
+void PolyVoxChunksTests::testMarchingCubesMatchesFullExtraction() {
+    verifyMatchesFullExtraction(true);
+}
+
+void PolyVoxChunksTests::testCubicMatchesFullExtraction() {
+    verifyMatchesFullExtraction(false);
+}
+
+void PolyVoxChunksTests::testEditExtractsNearbyChunks() {
+    const int SIZE = 48;
+    auto volume = makeTerrain(SIZE);
+
+    PolyVoxChunks chunks(glm::ivec3(SIZE), true);
+    QCOMPARE(chunks.getNumChunks(), 27);
+    chunks.extractDirtyChunks(volume.get());
+
+    // a voxel well inside a chunk only touches that chunk
+    volume->setVoxelAt(24, 24, 24, 255);
+    chunks.markVoxelDirty(glm::ivec3(24, 24, 24));
+    QCOMPARE(chunks.getNumDirtyChunks(), 1);
+    QCOMPARE(chunks.extractDirtyChunks(volume.get()), 1);
+
+    // a voxel on a chunk corner touches the eight chunks around it
+    volume->setVoxelAt(16, 16, 16, 255);
+    chunks.markVoxelDirty(glm::ivec3(16, 16, 16));
+    QCOMPARE(chunks.getNumDirtyChunks(), 8);
+
+    setSphere(volume.get(), chunks, glm::ivec3(5, SIZE / 3, 40), 3, 0);
+    chunks.extractDirtyChunks(volume.get());
+    compareWithFullExtraction(chunks, volume.get(), true);
+}
+
+void PolyVoxChunksTests::testCollisionPoints() {
+    const int SIZE = 8;
+    auto volume = std::make_shared<Volume>(PolyVox::Region(PolyVox::Vector3DInt32(0, 0, 0),
+                                                           PolyVox::Vector3DInt32(SIZE - 1, SIZE - 1, SIZE - 1)));
+    volume->setBorderValue(255);
+
+    PolyVoxChunks chunks(glm::ivec3(SIZE), false);
+    setSphere(volume.get(), chunks, glm::ivec3(3), 0, 255);
+    chunks.extractDirtyChunks(volume.get());
+
+    ShapeInfo::PointCollection points;
+    AABox box;
+    chunks.getCollisionPoints(volume.get(), glm::mat4(), 0, glm::ivec3(SIZE), 0.5f, points, box);
+    QCOMPARE(points.size(), 1);
+    QCOMPARE(points[0].size(), 8);
+    QCOMPARE_WITH_ABS_ERROR(box.getDimensions(), glm::vec3(1.0f), 1e-5f);
+
+    // a 3x3x3 block has one voxel completely surrounded by others, which needs no hull
+    for (int z = 2; z <= 4; z++) {
+        for (int y = 2; y <= 4; y++) {
+            for (int x = 2; x <= 4; x++) {
+                volume->setVoxelAt(x, y, z, 255);
+                chunks.markVoxelDirty(glm::ivec3(x, y, z));
+            }
+        }
+    }
+    chunks.extractDirtyChunks(volume.get());
+    points.clear();
+    box.clear();
+    chunks.getCollisionPoints(volume.get(), glm::mat4(), 0, glm::ivec3(SIZE), 0.5f, points, box);
+    QCOMPARE(points.size(), 26);
+    QCOMPARE_WITH_ABS_ERROR(box.getDimensions(), glm::vec3(3.0f), 1e-5f);
+}
+
+#ifdef MANUAL_TEST
+void PolyVoxChunksTests::benchmark() {
+    // a full-size polyvox being carved by a script, one small sphere per edit
+    const int SIZE = 128;
+    const int NUM_EDITS = 100;
+    const int EDIT_RADIUS = 2;
+
+    for (bool marchingCubes : { true, false }) {
+        auto volume = makeTerrain(SIZE);
+        PolyVoxChunks chunks(glm::ivec3(SIZE), marchingCubes);
+        chunks.extractDirtyChunks(volume.get());
+
+        std::vector<PolyVoxChunks::Vertex> vertices;
+        std::vector<uint32_t> indices;
+        ShapeInfo::PointCollection points;
+        AABox box;
+        chunks.getMesh(vertices, indices);
+        chunks.getCollisionPoints(volume.get(), glm::mat4(), 0, glm::ivec3(SIZE), 0.5f, points, box);
+
+        std::vector<glm::ivec3> centers;
+        for (int i = 0; i < NUM_EDITS; i++) {
+            centers.push_back(glm::ivec3(randIntInRange(0, SIZE - 1), SIZE / 3, randIntInRange(0, SIZE - 1)));
+        }
+
+        // chunked: re-extract and re-collide only what the edit touched
+        uint64_t startTime = usecTimestampNow();
+        for (const auto& center : centers) {
+            setSphere(volume.get(), chunks, center, EDIT_RADIUS, 0);
+            chunks.extractDirtyChunks(volume.get());
+            chunks.getMesh(vertices, indices);
+            points.clear();
+            box.clear();
+            chunks.getCollisionPoints(volume.get(), glm::mat4(), 0, glm::ivec3(SIZE), 0.5f, points, box);
+        }
+        uint64_t chunkedTime = usecTimestampNow() - startTime;
+
+        // full: what a bake cost before the volume was chunked
+        startTime = usecTimestampNow();
+        for (const auto& center : centers) {
+            setSphere(volume.get(), chunks, center, EDIT_RADIUS, 255);
+            chunks.markAllDirty();
+            chunks.extractDirtyChunks(volume.get());
+            chunks.getMesh(vertices, indices);
+            points.clear();
+            box.clear();
+            chunks.getCollisionPoints(volume.get(), glm::mat4(), 0, glm::ivec3(SIZE), 0.5f, points, box);
+        }
+        uint64_t fullTime = usecTimestampNow() - startTime;
+
+        std::cout << (marchingCubes ? "marching cubes" : "cubic") << " " << SIZE << "^3:" << std::endl;
+        std::cout << "    chunked " << (float)NUM_EDITS * USECS_PER_SECOND / (float)chunkedTime << " edits/sec" << std::endl;
+        std::cout << "    full    " << (float)NUM_EDITS * USECS_PER_SECOND / (float)fullTime << " edits/sec" << std::endl;
+    }
+}
+#endif // MANUAL_TEST
@@ -0,0 +1,30 @@
+//
+//  PolyVoxChunksTests.h
+//  tests/entities-renderer/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunksTests_h
+#define hifi_PolyVoxChunksTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class PolyVoxChunksTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testMarchingCubesMatchesFullExtraction();
+    void testCubicMatchesFullExtraction();
+    void testEditExtractsNearbyChunks();
+    void testCollisionPoints();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_PolyVoxChunksTests_h
@@ -0,0 +1,127 @@
+//
+//  FrameRecordingTest.cpp
+//  tests/gpu/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameRecordingTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <gpu/Context.h>
+#include <gpu/null/NullBackend.h>
+
+QTEST_MAIN(FrameRecordingTest)
+
+static const int NUM_BATCHES = 32;
+
+void FrameRecordingTest::initTestCase() {
+    gpu::Context::init<gpu::null::Backend>();
+    _gpuContext = std::make_shared<gpu::Context>();
+}
+
+void FrameRecordingTest::cleanupTestCase() {
+    _gpuContext->shutdown();
+    _gpuContext.reset();
+}
+
+void FrameRecordingTest::testSubmissionOrder() {
+    std::vector<std::string> names;
+    for (int i = 0; i < NUM_BATCHES; i++) {
+        names.push_back("batch" + std::to_string(i));
+    }
+
+    _gpuContext->setParallelBatchRecording(true);
+    _gpuContext->beginFrame();
+    for (int i = 0; i < NUM_BATCHES; i++) {
+        auto record = [i](gpu::Batch& batch) {
+            // the early batches take the longest, so they finish recording last
+            std::this_thread::sleep_for(std::chrono::milliseconds((NUM_BATCHES - i) / 4));
+            for (int j = 0; j <= i; j++) {
+                batch._glUniform1f(j, (float)i);
+            }
+        };
+        // every few batches is recorded inline, as the passes which haven't moved to workers are
+        if (i % 4 == 0) {
+            gpu::doInBatch(names[i].c_str(), _gpuContext, record);
+        } else {
+            gpu::doInBatchAsync(names[i].c_str(), _gpuContext, record);
+        }
+    }
+    auto frame = _gpuContext->endFrame();
+
+    QCOMPARE((int)frame->batches.size(), NUM_BATCHES);
+    for (int i = 0; i < NUM_BATCHES; i++) {
+        const auto& batch = frame->batches[i];
+        QCOMPARE(batch->getName(), names[i]);
+        QCOMPARE((int)batch->_commands.size(), i + 1);
+    }
+    _gpuContext->consumeFrameUpdates(frame);
+}
+
+void FrameRecordingTest::testEndFrameWaitsForRecording() {
+    std::atomic<int> recorded { 0 };
+
+    _gpuContext->setParallelBatchRecording(true);
+    _gpuContext->beginFrame();
+    for (int i = 0; i < NUM_BATCHES; i++) {
+        gpu::doInBatchAsync("async", _gpuContext, [&recorded](gpu::Batch& batch) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            batch._glUniform1f(0, 1.0f);
+            recorded++;
+        });
+    }
+    auto frame = _gpuContext->endFrame();
+
+    QCOMPARE(recorded.load(), NUM_BATCHES);
+    for (const auto& batch : frame->batches) {
+        QCOMPARE((int)batch->_commands.size(), 1);
+    }
+    _gpuContext->consumeFrameUpdates(frame);
+}
+
+void FrameRecordingTest::testSerialRecording() {
+    auto renderThread = std::this_thread::get_id();
+    bool sameThread = true;
+
+    _gpuContext->setParallelBatchRecording(false);
+    _gpuContext->beginFrame();
+    for (int i = 0; i < NUM_BATCHES; i++) {
+        gpu::doInBatchAsync("serial", _gpuContext, [&](gpu::Batch& batch) {
+            sameThread = sameThread && (std::this_thread::get_id() == renderThread);
+            batch._glUniform1f(0, 1.0f);
+        });
+    }
+    auto frame = _gpuContext->endFrame();
+    _gpuContext->setParallelBatchRecording(true);
+
+    QVERIFY(sameThread);
+    QCOMPARE((int)frame->batches.size(), NUM_BATCHES);
+    _gpuContext->consumeFrameUpdates(frame);
+}
+
+// Exposes the protected copy constructor
+class CopiedContext : public gpu::Context {
+public:
+    CopiedContext(const gpu::Context& context) : gpu::Context(context) {}
+};
+
+void FrameRecordingTest::testCopiedContext() {
+    CopiedContext context(*_gpuContext);
+
+    context.beginFrame();
+    context.appendFrameBatchAsync("copied", [](gpu::Batch& batch) {
+        batch._glUniform1f(0, 1.0f);
+    });
+    auto frame = context.endFrame();
+
+    QCOMPARE((int)frame->batches.size(), 1);
+    QCOMPARE((int)frame->batches[0]->_commands.size(), 1);
+}
@@ -0,0 +1,30 @@
+//
+//  FrameRecordingTest.h
+//  tests/gpu/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+#include <gpu/Forward.h>
+
+class FrameRecordingTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testSubmissionOrder();
+    void testEndFrameWaitsForRecording();
+    void testSerialRecording();
+    void testCopiedContext();
+
+private:
+    gpu::ContextPointer _gpuContext;
+};
@@ -0,0 +1,286 @@
+//
+//  ImageTests.cpp
+//  tests/image/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ImageTests.h"
+
+#include <cmath>
+#include <iostream>
+
+#include <QBuffer>
+#include <QImageReader>
+
+#include <image/PixelConversion.h>
+#include <image/TextureProcessing.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(ImageTests)
+
+using namespace image;
+
+// Smooth gradients with some high frequency detail, so JPEG and PNG have something realistic to compress
+static QImage makeTestImage(int width, int height, bool withAlpha) {
+    QImage result(width, height, withAlpha ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+    for (int y = 0; y < height; y++) {
+        QRgb* line = reinterpret_cast<QRgb*>(result.scanLine(y));
+        for (int x = 0; x < width; x++) {
+            int red = (x * 255) / width;
+            int green = (y * 255) / height;
+            int blue = ((x ^ y) * 7) & 0xff;
+            int alpha = withAlpha ? ((x + y) & 0xff) : 255;
+            line[x] = qRgba(red, green, blue, alpha);
+        }
+    }
+    return result;
+}
+
+static QByteArray encode(const QImage& image, const char* format) {
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, format, 90);
+    return data;
+}
+
+static Image decode(const QByteArray& data, const std::string& filename, int maxNumPixels = 0) {
+    QByteArray copy = data;
+    QBuffer buffer(&copy);
+    return processRawImageData(buffer, filename, maxNumPixels);
+}
+
+static int encodeGammaWithPow(float value) {
+    return (int)(std::min(1.0f, std::pow(value, 1.0f / 2.2f)) * 255.0f);
+}
+
+void ImageTests::testCopyChannelToRed() {
+    // not a multiple of the vector width, so the scalar tail is covered too
+    const int NUM_PIXELS = 11;
+    std::vector<uint32_t> source;
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        source.push_back(qRgba(i * 3, i * 5 + 1, i * 7 + 2, 200 - i));
+    }
+
+    const ColorChannel CHANNELS[] = { ColorChannel::RED, ColorChannel::GREEN, ColorChannel::BLUE, ColorChannel::ALPHA };
+    for (auto channel : CHANNELS) {
+        std::vector<uint32_t> dest(NUM_PIXELS);
+        copyChannelToRed(source.data(), dest.data(), dest.size(), channel);
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            int expected = (channel == ColorChannel::RED) ? qRed(source[i]) :
+                           (channel == ColorChannel::GREEN) ? qGreen(source[i]) :
+                           (channel == ColorChannel::BLUE) ? qBlue(source[i]) : qAlpha(source[i]);
+            QCOMPARE(dest[i], (uint32_t)qRgba(expected, 0, 0, 255));
+        }
+    }
+
+    // in place
+    std::vector<uint32_t> pixels = source;
+    copyChannelToRed(pixels.data(), pixels.data(), pixels.size(), ColorChannel::BLUE);
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        QCOMPARE(pixels[i], (uint32_t)qRgba(qBlue(source[i]), 0, 0, 255));
+    }
+}
+
+void ImageTests::testGammaToLinear() {
+    std::vector<uint32_t> source;
+    for (int i = 0; i < 256; i++) {
+        source.push_back(qRgb(i, 255 - i, (i * 3) & 0xff));
+    }
+    std::vector<glm::vec3> dest(source.size());
+    convertGammaToLinear(source.data(), dest.data(), source.size());
+
+    for (size_t i = 0; i < source.size(); i++) {
+        QCOMPARE(dest[i].r, std::pow((float)qRed(source[i]) / 255.0f, 2.2f));
+        QCOMPARE(dest[i].g, std::pow((float)qGreen(source[i]) / 255.0f, 2.2f));
+        QCOMPARE(dest[i].b, std::pow((float)qBlue(source[i]) / 255.0f, 2.2f));
+    }
+}
+
+void ImageTests::testLinearToGamma() {
+    const int NUM_STEPS = 100000;
+    std::vector<glm::vec3> source;
+    for (int i = 0; i <= NUM_STEPS; i++) {
+        // a little past 1 to cover clamping
+        float value = 1.2f * (float)i / (float)NUM_STEPS;
+        source.push_back(glm::vec3(value, 1.2f - value, value * value));
+    }
+    std::vector<uint32_t> dest(source.size());
+    convertLinearToGamma(source.data(), dest.data(), source.size());
+
+    int numInexact = 0;
+    for (size_t i = 0; i < source.size(); i++) {
+        QCOMPARE(qAlpha(dest[i]), 255);
+        int components[] = { qRed(dest[i]), qGreen(dest[i]), qBlue(dest[i]) };
+        for (int c = 0; c < 3; c++) {
+            int expected = encodeGammaWithPow(source[i][c]);
+            // only values within rounding of a step boundary may land on the other side of it
+            QVERIFY(std::abs(components[c] - expected) <= 1);
+            numInexact += (components[c] != expected) ? 1 : 0;
+        }
+    }
+    QVERIFY(numInexact < (int)source.size() / 1000);
+
+    glm::vec3 extremes[] = { glm::vec3(-1.0f, 0.0f, 100.0f) };
+    uint32_t extremesDest;
+    convertLinearToGamma(extremes, &extremesDest, 1);
+    QCOMPARE(extremesDest, (uint32_t)qRgb(0, 0, 255));
+}
+
+void ImageTests::testDecodeMatchesQImage() {
+    struct Case {
+        bool withAlpha;
+        const char* format;
+        std::string filename;
+    };
+    const Case CASES[] = {
+        { true, "PNG", "test.png" },
+        { false, "PNG", "test.png" },
+        { false, "JPG", "test.jpg" },
+        // a wrong extension falls back to detecting the format from the content
+        { false, "JPG", "test.png?v=1" }
+    };
+
+    for (const auto& testCase : CASES) {
+        QByteArray data = encode(makeTestImage(67, 45, testCase.withAlpha), testCase.format);
+        Image image = decode(data, testCase.filename);
+        QImage reference = QImage::fromData(data).convertToFormat(QImage::Format_ARGB32);
+
+        QCOMPARE(image.getWidth(), (glm::uint32)reference.width());
+        QCOMPARE(image.getHeight(), (glm::uint32)reference.height());
+        for (int y = 0; y < reference.height(); y++) {
+            for (int x = 0; x < reference.width(); x++) {
+                QCOMPARE(image.getPackedPixel(x, y), reference.pixel(x, y));
+            }
+        }
+    }
+}
+
+void ImageTests::testDecodeScalesToMaxPixels() {
+    const int MAX_NUM_PIXELS = 128 * 64;
+    const char* FORMATS[] = { "JPG", "PNG" };
+    for (auto format : FORMATS) {
+        QByteArray data = encode(makeTestImage(1024, 512, false), format);
+        std::string filename = std::string("test.") + QString(format).toLower().toStdString();
+
+        Image image = decode(data, filename, MAX_NUM_PIXELS);
+        QCOMPARE(image.getWidth(), (glm::uint32)128);
+        QCOMPARE(image.getHeight(), (glm::uint32)64);
+
+        image = decode(data, filename);
+        QCOMPARE(image.getWidth(), (glm::uint32)1024);
+        QCOMPARE(image.getHeight(), (glm::uint32)512);
+    }
+}
+
+void ImageTests::testMapToRedChannel() {
+    QByteArray data = encode(makeTestImage(33, 17, false), "JPG");
+    QImage reference = QImage::fromData(data);
+
+    Image image = decode(data, "test.jpg");
+    mapToRedChannel(image, ColorChannel::GREEN);
+    QCOMPARE(image.getFormat(), Image::Format_ARGB32);
+    for (int y = 0; y < reference.height(); y++) {
+        for (int x = 0; x < reference.width(); x++) {
+            QCOMPARE(image.getPackedPixel(x, y), qRgba(qGreen(reference.pixel(x, y)), 0, 0, 255));
+        }
+    }
+}
+
+#ifdef MANUAL_TEST
+// What processImage did for a single channel texture before decoding and conversions were reworked
+static QImage decodeAndMapToRedChannelWithQImage(const QByteArray& data, const char* format) {
+    QByteArray copy = data;
+    QBuffer buffer(&copy);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader imageReader(&buffer, format);
+    QImage image = imageReader.read().convertToFormat(QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); y++) {
+        QRgb* pixel = reinterpret_cast<QRgb*>(image.scanLine(y));
+        QRgb* lineEnd = pixel + image.width();
+        for (; pixel < lineEnd; pixel++) {
+            *pixel = qRgba(qGreen(*pixel), 0, 0, 255);
+        }
+    }
+    return image;
+}
+
+void ImageTests::benchmark() {
+    const int SIZES[] = { 512, 1024, 2048 };
+    const int NUM_ITERATIONS = 10;
+
+    struct Entry {
+        const char* name;
+        const char* format;
+        bool withAlpha;
+    };
+    const Entry CORPUS[] = {
+        { "jpg", "JPG", false },
+        { "png", "PNG", false },
+        { "png alpha", "PNG", true }
+    };
+
+    for (int size : SIZES) {
+        for (const auto& entry : CORPUS) {
+            QByteArray data = encode(makeTestImage(size, size, entry.withAlpha), entry.format);
+            QByteArray extension = QByteArray(entry.format).toLower();
+            std::string filename = "test." + extension.toStdString();
+            float megapixels = (float)NUM_ITERATIONS * (float)(size * size) / 1.0e6f;
+
+            uint64_t startTime = usecTimestampNow();
+            for (int i = 0; i < NUM_ITERATIONS; i++) {
+                decodeAndMapToRedChannelWithQImage(data, extension.constData());
+            }
+            uint64_t previousTime = usecTimestampNow() - startTime;
+
+            startTime = usecTimestampNow();
+            for (int i = 0; i < NUM_ITERATIONS; i++) {
+                Image image = decode(data, filename);
+                mapToRedChannel(image, ColorChannel::GREEN);
+            }
+            uint64_t currentTime = usecTimestampNow() - startTime;
+
+            std::cout << entry.name << " " << size << "x" << size << ":" << std::endl;
+            std::cout << "    previous " << megapixels * USECS_PER_SECOND / (float)previousTime << " MP/sec" << std::endl;
+            std::cout << "    current  " << megapixels * USECS_PER_SECOND / (float)currentTime << " MP/sec" << std::endl;
+        }
+    }
+
+    // the conversions alone, on one 2048x2048 texture worth of pixels
+    const int NUM_PIXELS = 2048 * 2048;
+    std::vector<uint32_t> pixels(NUM_PIXELS);
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        pixels[i] = qRgb(i & 0xff, (i >> 8) & 0xff, (i >> 16) & 0xff);
+    }
+    std::vector<glm::vec3> colors(NUM_PIXELS);
+    float megapixels = (float)NUM_PIXELS / 1.0e6f;
+
+    uint64_t startTime = usecTimestampNow();
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        colors[i] = glm::vec3(std::pow(qRed(pixels[i]) / 255.0f, 2.2f), std::pow(qGreen(pixels[i]) / 255.0f, 2.2f),
+                              std::pow(qBlue(pixels[i]) / 255.0f, 2.2f));
+    }
+    uint64_t powTime = usecTimestampNow() - startTime;
+    startTime = usecTimestampNow();
+    convertGammaToLinear(pixels.data(), colors.data(), NUM_PIXELS);
+    uint64_t tableTime = usecTimestampNow() - startTime;
+    std::cout << "gamma to linear: pow " << megapixels * USECS_PER_SECOND / (float)powTime << " MP/sec, table "
+              << megapixels * USECS_PER_SECOND / (float)tableTime << " MP/sec" << std::endl;
+
+    startTime = usecTimestampNow();
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        pixels[i] = qRgb(encodeGammaWithPow(colors[i].r), encodeGammaWithPow(colors[i].g), encodeGammaWithPow(colors[i].b));
+    }
+    powTime = usecTimestampNow() - startTime;
+    startTime = usecTimestampNow();
+    convertLinearToGamma(colors.data(), pixels.data(), NUM_PIXELS);
+    tableTime = usecTimestampNow() - startTime;
+    std::cout << "linear to gamma: pow " << megapixels * USECS_PER_SECOND / (float)powTime << " MP/sec, table "
+              << megapixels * USECS_PER_SECOND / (float)tableTime << " MP/sec" << std::endl;
+}
+#endif // MANUAL_TEST
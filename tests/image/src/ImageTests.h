@@ -0,0 +1,31 @@
+//
+//  ImageTests.h
+//  tests/image/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ImageTests_h
+#define hifi_ImageTests_h
+
+#include <QtTest/QtTest>
+
+class ImageTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCopyChannelToRed();
+    void testGammaToLinear();
+    void testLinearToGamma();
+    void testDecodeMatchesQImage();
+    void testDecodeScalesToMaxPixels();
+    void testMapToRedChannel();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif
+};
+
+#endif // hifi_ImageTests_h
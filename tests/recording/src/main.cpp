@@ -119,10 +119,54 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+void testIndexedClip() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    auto otherFrameType = Frame::registerFrameType(OTHER_TEST_NAME);
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < 5000; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)(i * 10), QByteArray::number(i)));
+        if (i % 2 == 0) {
+            writeClip->addFrame(std::make_shared<Frame>(otherFrameType, (float)(i * 10 + 5), QByteArray::number(-i)));
+        }
+    }
+    Clip::toFile(fileName, writeClip);
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == writeClip->frameCount());
+    QVERIFY(readClip->duration() == writeClip->duration());
+
+    // Frames come back in recorded order across both types
+    readClip->seek(0);
+    writeClip->seek(0);
+    size_t count = 0;
+    for (auto readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(); readFrame && writeFrame;
+        readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(), ++count) {
+        QVERIFY(readFrame->type == writeFrame->type);
+        QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+        QVERIFY(readFrame->data == writeFrame->data);
+    }
+    QVERIFY(readClip->frameCount() == count);
+
+    // Seeking lands on the first frame at or after the time, whatever its type
+    readClip->seekFrameTime(20005);
+    writeClip->seekFrameTime(20005);
+    QVERIFY(readClip->positionFrameTime() == writeClip->positionFrameTime());
+    QVERIFY(readClip->peekFrameType() == writeClip->peekFrameType());
+    QVERIFY(readClip->peekFrame()->data == writeClip->peekFrame()->data);
+}
+
 int main(int, const char**) {
     setupHifiApplication("Recording Test");
 
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testIndexedClip();
 }
@@ -0,0 +1,69 @@
+//
+//  GzipTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipTests.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QUuid>
+
+#include <Gzip.h>
+
+QTEST_MAIN(GzipTests)
+
+static QByteArray makeEntityLikeText(int count) {
+    QByteArray text;
+    for (int i = 0; i < count; i++) {
+        text += QString("{ \"id\": \"{%1}\", \"type\": \"Box\", \"position\": { \"x\": %2, \"y\": 0, \"z\": %3 } },\n")
+            .arg(QUuid::createUuid().toString()).arg(i).arg(i * 7).toUtf8();
+    }
+    return text;
+}
+
+void GzipTests::testRoundTrip() {
+    QByteArray source = makeEntityLikeText(1000);
+    QByteArray compressed;
+    QVERIFY(gzip(source, compressed));
+    QVERIFY(compressed.size() < source.size());
+
+    QByteArray uncompressed;
+    QVERIFY(gunzip(compressed, uncompressed));
+    QCOMPARE(uncompressed, source);
+}
+
+void GzipTests::testWriterMatchesWholeBuffer() {
+    QByteArray source = makeEntityLikeText(5000);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    GzipWriter writer(buffer);
+    // pieces that don't line up with the internal chunk size
+    const int PIECE_SIZE = 1000;
+    for (int offset = 0; offset < source.size(); offset += PIECE_SIZE) {
+        QVERIFY(writer.write(source.mid(offset, PIECE_SIZE)));
+    }
+    QVERIFY(writer.finish());
+    QVERIFY(!writer.write(source));
+
+    QByteArray uncompressed;
+    QVERIFY(gunzip(buffer.data(), uncompressed));
+    QCOMPARE(uncompressed, source);
+}
+
+void GzipTests::testEmptyWriter() {
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    GzipWriter writer(buffer);
+    QVERIFY(writer.finish());
+    QVERIFY(buffer.size() > 0);
+
+    QByteArray uncompressed;
+    QVERIFY(gunzip(buffer.data(), uncompressed));
+    QVERIFY(uncompressed.isEmpty());
+}
@@ -0,0 +1,124 @@
+//
+//  LatencyHistogramTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LatencyHistogramTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <LatencyHistogram.h>
+
+QTEST_MAIN(LatencyHistogramTests)
+
+void LatencyHistogramTests::testEmpty() {
+    LatencyHistogram histogram;
+    QCOMPARE(histogram.getCount(), (uint64_t)0);
+    QCOMPARE(histogram.getMax(), (uint64_t)0);
+    QCOMPARE(histogram.getPercentile(0.5f), (uint64_t)0);
+    QCOMPARE(histogram.getPercentile(1.0f), (uint64_t)0);
+}
+
+void LatencyHistogramTests::testSmallValuesAreExact() {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10; value++) {
+        histogram.record(value);
+    }
+    QCOMPARE(histogram.getCount(), (uint64_t)10);
+    QCOMPARE(histogram.getMax(), (uint64_t)10);
+    QCOMPARE(histogram.getPercentile(0.0f), (uint64_t)1);
+    QCOMPARE(histogram.getPercentile(0.5f), (uint64_t)5);
+    QCOMPARE(histogram.getPercentile(0.9f), (uint64_t)9);
+    QCOMPARE(histogram.getPercentile(1.0f), (uint64_t)10);
+}
+
+void LatencyHistogramTests::testBuckets() {
+    // every value falls in a bucket that holds it, and the buckets are ordered and within range
+    int previousBucket = 0;
+    for (uint64_t value = 0; value < 1000000; value += 1 + value / 64) {
+        int bucket = LatencyHistogram::bucketForValue(value);
+        QVERIFY(bucket >= previousBucket);
+        QVERIFY(bucket < LatencyHistogram::NUM_BUCKETS);
+        QVERIFY(LatencyHistogram::highestValueInBucket(bucket) >= value);
+        if (bucket > 0) {
+            QVERIFY(LatencyHistogram::highestValueInBucket(bucket - 1) < value);
+        }
+        previousBucket = bucket;
+    }
+
+    // anything beyond 32 bits lands in the last bucket
+    QCOMPARE(LatencyHistogram::bucketForValue(UINT32_MAX), LatencyHistogram::NUM_BUCKETS - 1);
+    QCOMPARE(LatencyHistogram::bucketForValue((uint64_t)UINT32_MAX * 4), LatencyHistogram::NUM_BUCKETS - 1);
+    QCOMPARE(LatencyHistogram::highestValueInBucket(LatencyHistogram::NUM_BUCKETS - 1), (uint64_t)UINT32_MAX);
+}
+
+void LatencyHistogramTests::testPercentiles() {
+    std::mt19937 generator(42);
+    std::lognormal_distribution<double> distribution(8.0, 1.0);
+
+    LatencyHistogram histogram;
+    std::vector<uint64_t> values;
+    for (int i = 0; i < 10000; i++) {
+        uint64_t value = (uint64_t)distribution(generator);
+        values.push_back(value);
+        histogram.record(value);
+    }
+    std::sort(values.begin(), values.end());
+    QCOMPARE(histogram.getMax(), values.back());
+
+    for (float percentile : { 0.5f, 0.95f, 0.99f }) {
+        size_t rank = (size_t)std::ceil((double)percentile * values.size());
+        uint64_t exact = values[rank - 1];
+        uint64_t reported = histogram.getPercentile(percentile);
+        QVERIFY(reported >= exact);
+        QVERIFY(reported - exact <= exact / LatencyHistogram::SUB_BUCKETS);
+    }
+}
+
+void LatencyHistogramTests::testMerge() {
+    LatencyHistogram first;
+    LatencyHistogram second;
+    LatencyHistogram combined;
+    for (uint64_t value = 0; value < 5000; value += 7) {
+        first.record(value);
+        combined.record(value);
+    }
+    for (uint64_t value = 3; value < 90000; value += 101) {
+        second.record(value);
+        combined.record(value);
+    }
+
+    first.merge(second);
+    QCOMPARE(first.getCount(), combined.getCount());
+    QCOMPARE(first.getMax(), combined.getMax());
+    for (float percentile : { 0.1f, 0.5f, 0.95f, 0.99f }) {
+        QCOMPARE(first.getPercentile(percentile), combined.getPercentile(percentile));
+    }
+
+    first.reset();
+    QCOMPARE(first.getCount(), (uint64_t)0);
+    QCOMPARE(first.getPercentile(0.5f), (uint64_t)0);
+}
+
+void LatencyHistogramTests::testJson() {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100; value++) {
+        histogram.record(value * 100);
+    }
+
+    QJsonObject json = histogram.toJson();
+    QCOMPARE(json["count"].toInt(), 100);
+    QCOMPARE(json["max"].toInt(), 10000);
+    QVERIFY(json["p50"].toInt() >= 5000);
+    QVERIFY(json["p95"].toInt() >= json["p50"].toInt());
+    QVERIFY(json["p99"].toInt() >= json["p95"].toInt());
+    QVERIFY(json["p99"].toInt() <= json["max"].toInt());
+}
@@ -0,0 +1,109 @@
+//
+//  ReadEpochsTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReadEpochsTests.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ReadEpochs.h>
+
+QTEST_MAIN(ReadEpochsTests)
+
+void ReadEpochsTests::testGuardBlocksReclaim() {
+    uint64_t numReads = ReadEpochs::getNumReads();
+    uint64_t retiredEpoch;
+    {
+        ReadEpochs::ReadGuard guard;
+        retiredEpoch = ReadEpochs::retire();
+        QVERIFY(!ReadEpochs::canReclaim(retiredEpoch));
+    }
+    QVERIFY(ReadEpochs::canReclaim(retiredEpoch));
+    QCOMPARE(ReadEpochs::getNumReads(), numReads + 1);
+
+    // a guard entered after the retirement doesn't hold it back
+    ReadEpochs::ReadGuard guard;
+    QVERIFY(ReadEpochs::canReclaim(retiredEpoch));
+}
+
+void ReadEpochsTests::testNestedGuards() {
+    uint64_t numReads = ReadEpochs::getNumReads();
+    uint64_t retiredEpoch;
+    {
+        ReadEpochs::ReadGuard outer;
+        retiredEpoch = ReadEpochs::retire();
+        {
+            ReadEpochs::ReadGuard inner;
+        }
+        // the inner guard leaving doesn't end the outer one
+        QVERIFY(!ReadEpochs::canReclaim(retiredEpoch));
+    }
+    QVERIFY(ReadEpochs::canReclaim(retiredEpoch));
+    QCOMPARE(ReadEpochs::getNumReads(), numReads + 1);
+}
+
+void ReadEpochsTests::testConcurrentReaders() {
+    struct Value {
+        std::atomic<bool> isReclaimed { false };
+    };
+
+    // reclaimed values are flagged instead of deleted, so a reader can see that it was handed one
+    std::vector<std::unique_ptr<Value>> values;
+    values.emplace_back(new Value());
+    std::atomic<Value*> current { values.back().get() };
+
+    std::atomic<bool> isDone { false };
+    std::atomic<int> numReclaimedReads { 0 };
+    const int NUM_READERS = 4;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < NUM_READERS; i++) {
+        readers.emplace_back([&] {
+            while (!isDone.load()) {
+                ReadEpochs::ReadGuard guard;
+                auto value = current.load(std::memory_order_seq_cst);
+                for (int j = 0; j < 16; j++) {
+                    if (value->isReclaimed.load()) {
+                        numReclaimedReads++;
+                    }
+                }
+            }
+        });
+    }
+
+    const int NUM_PUBLISHES = 20000;
+    std::vector<std::pair<Value*, uint64_t>> retired;
+    int numReclaimed = 0;
+    for (int i = 0; i < NUM_PUBLISHES; i++) {
+        values.emplace_back(new Value());
+        auto previous = current.exchange(values.back().get(), std::memory_order_seq_cst);
+        retired.emplace_back(previous, ReadEpochs::retire());
+
+        for (auto it = retired.begin(); it != retired.end();) {
+            if (ReadEpochs::canReclaim(it->second)) {
+                it->first->isReclaimed.store(true);
+                numReclaimed++;
+                it = retired.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    isDone.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    QCOMPARE(numReclaimedReads.load(), 0);
+    QVERIFY(numReclaimed > 0);
+}
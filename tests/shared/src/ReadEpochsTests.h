@@ -0,0 +1,25 @@
+//
+//  ReadEpochsTests.h
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReadEpochsTests_h
+#define hifi_ReadEpochsTests_h
+
+#include <QtTest/QtTest>
+
+class ReadEpochsTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testGuardBlocksReclaim();
+    void testNestedGuards();
+    void testConcurrentReaders();
+};
+
+#endif // hifi_ReadEpochsTests_h
@@ -0,0 +1,240 @@
+//
+//  SkinningTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SkinningTests.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+#include <GLMHelpers.h>
+#include <SharedUtil.h>
+#include <glm/gtc/random.hpp>
+
+struct BlendshapeOffsetUnpacked {
+    glm::vec3 positionOffset;
+    glm::vec3 normalOffset;
+    glm::vec3 tangentOffset;
+};
+
+struct Blendshape {
+    std::vector<int> indices;
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> tangents;
+};
+
+QTEST_MAIN(SkinningTests)
+
+static void multiplyClusterMatrices_ref(const glm::mat4* jointMatrices, const glm::mat4* inverseBindMatrices,
+                                        glm::mat4* clusterMatrices, int size) {
+    for (int i = 0; i < size; i++) {
+        glm_mat4u_mul(jointMatrices[i], inverseBindMatrices[i], clusterMatrices[i]);
+    }
+}
+
+static void accumulateBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, const Blendshape& blendshape,
+                                            float vertexCoefficient, float normalCoefficient) {
+    for (int j = 0; j < (int)blendshape.indices.size(); ++j) {
+        int index = blendshape.indices.at(j);
+
+        auto& currentBlendshapeOffset = unpacked[index];
+        currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
+        currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
+        if (j < (int)blendshape.tangents.size()) {
+            currentBlendshapeOffset.tangentOffset += blendshape.tangents.at(j) * normalCoefficient;
+        }
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include <CPUDetect.h>
+
+void multiplyClusterMatrices_AVX2(const float (*jointMatrices)[16], const float (*inverseBindMatrices)[16],
+                                  float (*clusterMatrices)[16], int size);
+void accumulateBlendshapeOffsets_AVX2(float (*unpacked)[9], const int* indices, const float (*vertices)[3],
+                                      const float (*normals)[3], const float (*tangents)[3], int numTangents, int size,
+                                      float vertexCoefficient, float normalCoefficient);
+
+static void multiplyClusterMatrices(const glm::mat4* jointMatrices, const glm::mat4* inverseBindMatrices,
+                                    glm::mat4* clusterMatrices, int size) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    if (_cpuSupportsAVX2) {
+        multiplyClusterMatrices_AVX2((const float(*)[16])jointMatrices, (const float(*)[16])inverseBindMatrices,
+                                     (float(*)[16])clusterMatrices, size);
+    } else {
+        multiplyClusterMatrices_ref(jointMatrices, inverseBindMatrices, clusterMatrices, size);
+    }
+}
+
+static void accumulateBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, const Blendshape& blendshape,
+                                        float vertexCoefficient, float normalCoefficient) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    if (_cpuSupportsAVX2) {
+        accumulateBlendshapeOffsets_AVX2((float(*)[9])unpacked, blendshape.indices.data(),
+                                         (const float(*)[3])blendshape.vertices.data(),
+                                         (const float(*)[3])blendshape.normals.data(),
+                                         (const float(*)[3])blendshape.tangents.data(), (int)blendshape.tangents.size(),
+                                         (int)blendshape.indices.size(), vertexCoefficient, normalCoefficient);
+    } else {
+        accumulateBlendshapeOffsets_ref(unpacked, blendshape, vertexCoefficient, normalCoefficient);
+    }
+}
+
+#else   // portable reference code
+static auto& multiplyClusterMatrices = multiplyClusterMatrices_ref;
+static auto& accumulateBlendshapeOffsets = accumulateBlendshapeOffsets_ref;
+#endif
+
+static glm::mat4 randomTransform() {
+    glm::quat rotation = glm::normalize(glm::quat(glm::linearRand(glm::vec4(-1.0f), glm::vec4(1.0f))));
+    glm::vec3 translation = glm::linearRand(glm::vec3(-2.0f), glm::vec3(2.0f));
+    return createMatFromQuatAndPos(rotation, translation);
+}
+
+static Blendshape randomBlendshape(int numVertices, int numIndices, int numTangents) {
+    Blendshape blendshape;
+    for (int j = 0; j < numIndices; ++j) {
+        // sorted and unique, as the model loaders produce them
+        blendshape.indices.push_back((int)((int64_t)j * numVertices / numIndices));
+        blendshape.vertices.push_back(glm::linearRand(glm::vec3(-0.1f), glm::vec3(0.1f)));
+        blendshape.normals.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+        if (j < numTangents) {
+            blendshape.tangents.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+        }
+    }
+    return blendshape;
+}
+
+void SkinningTests::testClusterMatricesAVX2() {
+    const float EPSILON = 1.0e-4f;
+
+    for (int numClusters = 0; numClusters < 256; ++numClusters) {
+        std::vector<glm::mat4> jointMatrices(numClusters);
+        std::vector<glm::mat4> inverseBindMatrices(numClusters);
+        std::vector<glm::mat4> clusterMatrices1(numClusters);
+        std::vector<glm::mat4> clusterMatrices2(numClusters);
+        for (int i = 0; i < numClusters; ++i) {
+            jointMatrices[i] = randomTransform();
+            inverseBindMatrices[i] = glm::inverse(randomTransform());
+        }
+
+        // ref version
+        multiplyClusterMatrices_ref(jointMatrices.data(), inverseBindMatrices.data(), clusterMatrices1.data(), numClusters);
+
+        // AVX2 version, if supported by CPU
+        multiplyClusterMatrices(jointMatrices.data(), inverseBindMatrices.data(), clusterMatrices2.data(), numClusters);
+
+        // verify, allowing for FMA rounding differences
+        for (int i = 0; i < numClusters; ++i) {
+            QCOMPARE_WITH_ABS_ERROR(clusterMatrices2[i], clusterMatrices1[i], EPSILON);
+        }
+    }
+}
+
+void SkinningTests::testBlendshapeAccumulationAVX2() {
+    const float EPSILON = 1.0e-5f;
+    const int NUM_VERTICES = 1000;
+
+    for (int numIndices = 0; numIndices < NUM_VERTICES; numIndices += 37) {
+        // some meshes have tangents for only part of a blendshape
+        Blendshape blendshape = randomBlendshape(NUM_VERTICES, numIndices, numIndices / 2);
+
+        std::vector<BlendshapeOffsetUnpacked> unpacked1(NUM_VERTICES);
+        for (auto& offset : unpacked1) {
+            offset = {
+                glm::linearRand(glm::vec3(-0.1f), glm::vec3(0.1f)),
+                glm::linearRand(glm::vec3(-0.1f), glm::vec3(0.1f)),
+                glm::linearRand(glm::vec3(-0.1f), glm::vec3(0.1f)),
+            };
+        }
+        std::vector<BlendshapeOffsetUnpacked> unpacked2 = unpacked1;
+
+        // ref version
+        accumulateBlendshapeOffsets_ref(unpacked1.data(), blendshape, 0.7f, 0.007f);
+
+        // AVX2 version, if supported by CPU
+        accumulateBlendshapeOffsets(unpacked2.data(), blendshape, 0.7f, 0.007f);
+
+        // verify
+        for (int i = 0; i < NUM_VERTICES; ++i) {
+            QCOMPARE_WITH_ABS_ERROR(unpacked2[i].positionOffset, unpacked1[i].positionOffset, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(unpacked2[i].normalOffset, unpacked1[i].normalOffset, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(unpacked2[i].tangentOffset, unpacked1[i].tangentOffset, EPSILON);
+        }
+    }
+}
+
+#ifdef MANUAL_TEST
+void SkinningTests::benchmark() {
+    // roughly a typical avatar: a few skinned meshes, and a face mesh with a full set of blendshapes
+    const int NUM_MESHES = 4;
+    const int NUM_CLUSTERS_PER_MESH = 64;
+    const int NUM_FACE_VERTICES = 4000;
+    const int NUM_BLENDSHAPES = 50;
+    const int NUM_INDICES_PER_BLENDSHAPE = 800;
+    const int NUM_ITERATIONS = 1000;
+
+    std::vector<glm::mat4> jointMatrices(NUM_MESHES * NUM_CLUSTERS_PER_MESH);
+    std::vector<glm::mat4> inverseBindMatrices(jointMatrices.size());
+    std::vector<glm::mat4> clusterMatrices(jointMatrices.size());
+    for (size_t i = 0; i < jointMatrices.size(); ++i) {
+        jointMatrices[i] = randomTransform();
+        inverseBindMatrices[i] = glm::inverse(randomTransform());
+    }
+    std::vector<Blendshape> blendshapes;
+    for (int i = 0; i < NUM_BLENDSHAPES; ++i) {
+        blendshapes.push_back(randomBlendshape(NUM_FACE_VERTICES, NUM_INDICES_PER_BLENDSHAPE, NUM_INDICES_PER_BLENDSHAPE));
+    }
+    std::vector<BlendshapeOffsetUnpacked> unpacked(NUM_FACE_VERTICES);
+
+    auto runClusterMatrices = [&](bool useRef) {
+        uint64_t startTime = usecTimestampNow();
+        for (int k = 0; k < NUM_ITERATIONS; ++k) {
+            for (int m = 0; m < NUM_MESHES; ++m) {
+                int offset = m * NUM_CLUSTERS_PER_MESH;
+                if (useRef) {
+                    multiplyClusterMatrices_ref(&jointMatrices[offset], &inverseBindMatrices[offset], &clusterMatrices[offset], NUM_CLUSTERS_PER_MESH);
+                } else {
+                    multiplyClusterMatrices(&jointMatrices[offset], &inverseBindMatrices[offset], &clusterMatrices[offset], NUM_CLUSTERS_PER_MESH);
+                }
+            }
+        }
+        return (float)(usecTimestampNow() - startTime) / (float)NUM_ITERATIONS;
+    };
+
+    auto runBlendshapes = [&](bool useRef) {
+        uint64_t startTime = usecTimestampNow();
+        for (int k = 0; k < NUM_ITERATIONS; ++k) {
+            memset(unpacked.data(), 0, unpacked.size() * sizeof(BlendshapeOffsetUnpacked));
+            for (const auto& blendshape : blendshapes) {
+                if (useRef) {
+                    accumulateBlendshapeOffsets_ref(unpacked.data(), blendshape, 0.5f, 0.005f);
+                } else {
+                    accumulateBlendshapeOffsets(unpacked.data(), blendshape, 0.5f, 0.005f);
+                }
+            }
+        }
+        return (float)(usecTimestampNow() - startTime) / (float)NUM_ITERATIONS;
+    };
+
+    std::cout << "usecs per avatar model, ref / dispatched:" << std::endl;
+    std::cout << "    cluster matrices (" << jointMatrices.size() << " clusters): "
+              << runClusterMatrices(true) << " / " << runClusterMatrices(false) << std::endl;
+    std::cout << "    blendshapes (" << NUM_BLENDSHAPES << " x " << NUM_INDICES_PER_BLENDSHAPE << " offsets): "
+              << runBlendshapes(true) << " / " << runBlendshapes(false) << std::endl;
+}
+#endif // MANUAL_TEST
@@ -0,0 +1,28 @@
+//
+//  SkinningTests.h
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SkinningTests_h
+#define hifi_SkinningTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class SkinningTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testClusterMatricesAVX2();
+    void testBlendshapeAccumulationAVX2();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_SkinningTests_h
@@ -8,8 +8,14 @@
 
 #include "TraceTests.h"
 
+#include <thread>
+
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
 
 #include <Profile.h>
 
@@ -45,3 +51,164 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+static QJsonArray readJsonTrace(const QString& filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonArray();
+    }
+    return QJsonDocument::fromJson(file.readAll()).array();
+}
+
+static int countEvents(const QJsonArray& events, const QString& name, const QString& type) {
+    int count = 0;
+    for (const auto& event : events) {
+        auto object = event.toObject();
+        if (object["name"].toString() == name && object["ph"].toString() == type) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void TraceTests::testStreamingConversion() {
+    QTemporaryDir dir;
+    const QString traceFile = dir.filePath("stream.trace");
+    const QString jsonFile = dir.filePath("stream.json");
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startStreaming(traceFile);
+
+    const int NUM_THREADS = 4;
+    const int NUM_RANGES = 1000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; i++) {
+        threads.emplace_back([] {
+            PROFILE_SET_THREAD_NAME("StreamingThread")
+            for (int j = 0; j < NUM_RANGES; j++) {
+                PROFILE_RANGE_EX(test, "StreamedRange", 0xff0000ff, j)
+            }
+            PROFILE_COUNTER(test, "StreamedCounter", { { "value", 1 } })
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    tracer->stopTracing();
+    QCOMPARE(tracer->getDroppedEventCount(), (uint64_t)0);
+
+    QVERIFY(tracing::Tracer::convertToJson(traceFile, jsonFile));
+    auto events = readJsonTrace(jsonFile);
+    QCOMPARE(countEvents(events, "StreamedRange", "B"), NUM_THREADS * NUM_RANGES);
+    QCOMPARE(countEvents(events, "StreamedRange", "E"), NUM_THREADS * NUM_RANGES);
+    QCOMPARE(countEvents(events, "StreamedCounter", "C"), NUM_THREADS);
+    QCOMPARE(countEvents(events, "thread_name", "M"), NUM_THREADS);
+
+    QSet<qint64> threadIDs;
+    for (const auto& event : events) {
+        auto object = event.toObject();
+        if (object["name"].toString() == "StreamedRange" && object["ph"].toString() == "B") {
+            QVERIFY(object["args"].toObject().contains("nv_payload"));
+            QCOMPARE(object["cat"].toString(), QString("trace.test"));
+            threadIDs.insert((qint64)object["tid"].toDouble());
+        } else if (object["name"].toString() == "StreamedCounter") {
+            QCOMPARE(object["args"].toObject()["value"].toInt(), 1);
+        }
+    }
+    QCOMPARE(threadIDs.size(), NUM_THREADS);
+}
+
+// ids and JSON arguments are kept with their events rather than interned, both in memory and in streamed files
+void TraceTests::testUniqueEventStrings() {
+    QTemporaryDir dir;
+    const QString memoryFile = dir.filePath("unique.json");
+    const QString traceFile = dir.filePath("unique.trace");
+    const QString streamedFile = dir.filePath("unique-streamed.json");
+
+    const int NUM_EVENTS = 1000;
+    auto recordEvents = [] {
+        auto tracer = DependencyManager::get<tracing::Tracer>();
+        for (int i = 0; i < NUM_EVENTS; i++) {
+            tracer->traceEvent(trace_test(), "UniqueEvent", tracing::AsyncNestableInstant, QString("id-%1").arg(i),
+                               { { "label", QString("label-%1").arg(i) }, { "index", i } });
+        }
+    };
+    auto verifyEvents = [](const QJsonArray& events) {
+        QCOMPARE(countEvents(events, "UniqueEvent", "n"), NUM_EVENTS);
+        int next = 0;
+        for (const auto& event : events) {
+            auto object = event.toObject();
+            if (object["name"].toString() == "UniqueEvent") {
+                QCOMPARE(object["id"].toString(), QString("id-%1").arg(next));
+                QCOMPARE(object["args"].toObject()["label"].toString(), QString("label-%1").arg(next));
+                QCOMPARE(object["args"].toObject()["index"].toInt(), next);
+                next++;
+            }
+        }
+    };
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startTracing();
+    recordEvents();
+    tracer->stopTracing();
+    tracer->serialize(memoryFile);
+    verifyEvents(readJsonTrace(memoryFile));
+
+    tracer->startStreaming(traceFile);
+    recordEvents();
+    tracer->stopTracing();
+    QVERIFY(tracing::Tracer::convertToJson(traceFile, streamedFile));
+    verifyEvents(readJsonTrace(streamedFile));
+}
+
+void TraceTests::testFlightRecorderKeepsRecentEvents() {
+    QTemporaryDir dir;
+    const QString jsonFile = dir.filePath("flight.json");
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startFlightRecorder(1.0f);
+    // an event from before the recording window
+    int64_t oldTimestamp = tracing::Tracer::now() - (int64_t)(2 * USECS_PER_SECOND);
+    tracer->traceEvent(trace_test(), "OldEvent", tracing::DurationBegin, oldTimestamp);
+    tracer->traceEvent(trace_test(), "OldEvent", tracing::DurationEnd, oldTimestamp + 1);
+    {
+        PROFILE_RANGE(test, "RecentEvent")
+    }
+    tracer->flush();
+
+    QVERIFY(tracer->dumpFlightRecorder(jsonFile));
+    auto events = readJsonTrace(jsonFile);
+    QCOMPARE(countEvents(events, "OldEvent", "B"), 0);
+    QCOMPARE(countEvents(events, "RecentEvent", "B"), 1);
+    QCOMPARE(countEvents(events, "RecentEvent", "E"), 1);
+
+    // the recorder keeps running after a dump
+    QVERIFY(tracer->isEnabled());
+    tracer->stopTracing();
+}
+
+void TraceTests::testFlightRecorderDumpsOnSpike() {
+    QTemporaryDir dir;
+    const QString traceFile = dir.filePath("spike.trace");
+    const QString jsonFile = dir.filePath("spike.json");
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startFlightRecorder(1.0f, 10.0f, traceFile);
+    {
+        PROFILE_RANGE(test, "SpikeFrame")
+    }
+
+    // frames under the threshold don't dump
+    tracer->reportFrameTime(5 * USECS_PER_MSEC);
+    tracer->flush();
+    QVERIFY(!QFile::exists(traceFile));
+
+    tracer->reportFrameTime(50 * USECS_PER_MSEC);
+    tracer->flush();
+    QVERIFY(QFile::exists(traceFile));
+    tracer->stopTracing();
+
+    QVERIFY(tracing::Tracer::convertToJson(traceFile, jsonFile));
+    auto events = readJsonTrace(jsonFile);
+    QCOMPARE(countEvents(events, "SpikeFrame", "B"), 1);
+}
@@ -15,6 +15,10 @@ class TraceTests : public QObject {
     Q_OBJECT
 private slots:
     void testTraceSerialization();
+    void testStreamingConversion();
+    void testUniqueEventStrings();
+    void testFlightRecorderKeepsRecentEvents();
+    void testFlightRecorderDumpsOnSpike();
 };
 
 #endif // hifi_TraceTests_h
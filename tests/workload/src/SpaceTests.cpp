@@ -11,6 +11,7 @@
 
 #include "SpaceTests.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include <workload/Space.h>
@@ -18,89 +19,130 @@
 #include <SharedUtil.h>
 
 
-const float INV_SQRT_3 = 1.0f / sqrtf(3.0f);
-
 QTEST_MAIN(SpaceTests)
 
+using Changes = std::vector<workload::Space::Change>;
+
+const float WORLD_WIDTH = 1000.0f;
+const float MIN_RADIUS = 1.0f;
+const float MAX_RADIUS = 100.0f;
+
+static workload::View makeView(const glm::vec3& center, float near, float mid, float far) {
+    workload::View view;
+    view.origin = center;
+    view.regions[workload::Region::R1] = workload::Sphere(center, near);
+    view.regions[workload::Region::R2] = workload::Sphere(center, mid);
+    view.regions[workload::Region::R3] = workload::Sphere(center, far);
+    return view;
+}
+
+static void processTransaction(workload::Space& space, const workload::Transaction& transaction) {
+    space.enqueueTransaction(transaction);
+    space.enqueueFrame();
+    space.processTransactionQueue();
+}
+
+// The region of a sphere as a full pass over every view would find it
+static uint8_t computeRegion(const workload::Views& views, const workload::Sphere& sphere) {
+    uint8_t region = workload::Region::R4;
+    for (const auto& view : views) {
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = sphere.w + view.regions[k].w;
+            glm::vec3 offset = glm::vec3(sphere) - glm::vec3(view.regions[k]);
+            if (glm::dot(offset, offset) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
+        }
+    }
+    return region;
+}
+
+static float randomFloat() {
+    return 2.0f * ((float)rand() / (float)RAND_MAX) - 1.0f;
+}
+
+static glm::vec3 randomVec3() {
+    return glm::vec3(randomFloat(), randomFloat(), randomFloat());
+}
+
+static void generateSpheres(uint32_t numProxies, std::vector<workload::Sphere>& spheres) {
+    spheres.reserve(numProxies);
+    for (uint32_t i = 0; i < numProxies; ++i) {
+        float radius = MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * 0.5f * (randomFloat() + 1.0f);
+        spheres.push_back(workload::Sphere(WORLD_WIDTH * randomVec3(), radius));
+    }
+}
+
 void SpaceTests::testOverlaps() {
     workload::Space space;
-    using Changes = std::vector<workload::Space::Change>;
-    using Views = std::vector<workload::Space::View>;
 
     glm::vec3 viewCenter(0.0f, 0.0f, 0.0f);
     float near = 1.0f;
     float mid = 2.0f;
     float far = 3.0f;
 
-    Views views;
-    views.push_back(workload::Space::View(viewCenter, near, mid, far));
+    workload::Views views;
+    views.push_back(makeView(viewCenter, near, mid, far));
     space.setViews(views);
 
-    int32_t proxyId = 0;
     const float DELTA = 0.001f;
     float proxyRadius = 0.5f;
     glm::vec3 proxyPosition = viewCenter + glm::vec3(0.0f, 0.0f, far + proxyRadius + DELTA);
-    workload::Space::Sphere proxySphere(proxyPosition, proxyRadius);
+    workload::Sphere proxySphere(proxyPosition, proxyRadius);
+    workload::ProxyID proxyId = space.allocateID();
 
     { // create very_far proxy
-        proxyId = space.createProxy(proxySphere);
+        workload::Transaction transaction;
+        transaction.reset(proxyId, proxySphere, workload::Owner());
+        processTransaction(space, transaction);
         QVERIFY(space.getNumObjects() == 1);
 
-        Changes changes;
-        space.categorizeAndGetChanges(changes);
-        QVERIFY(changes.size() == 0);
-    }
-
-    { // move proxy far
-        float newRadius = 1.0f;
-        glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, far + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_FAR);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_UNKNOWN);
+        QVERIFY(changes[0].region == workload::Region::R4);
+        QVERIFY(changes[0].prevRegion == workload::Region::UNKNOWN);
+
+        // nothing moved
+        changes.clear();
+        space.categorizeAndGetChanges(changes);
+        QVERIFY(changes.size() == 0);
     }
 
-    { // move proxy mid
+    const float distances[] = { far, mid, near };
+    const uint8_t regions[] = { workload::Region::R3, workload::Region::R2, workload::Region::R1 };
+    for (int i = 0; i < 3; ++i) { // move proxy far, then mid, then near
         float newRadius = 1.0f;
-        glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, mid + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+        glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, distances[i] + newRadius - DELTA);
+        workload::Transaction transaction;
+        transaction.update(proxyId, workload::Sphere(newPosition, newRadius));
+        processTransaction(space, transaction);
+
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_MIDDLE);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_FAR);
+        QVERIFY(changes[0].region == regions[i]);
+        QVERIFY(changes[0].prevRegion == (i == 0 ? workload::Region::R4 : regions[i - 1]));
     }
 
-    { // move proxy near
-        float newRadius = 1.0f;
-        glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, near + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+    { // move the view away, the proxy is far again
+        views[0] = makeView(viewCenter - glm::vec3(0.0f, 0.0f, mid), near, mid, far);
+        space.setViews(views);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
-        QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_NEAR);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_MIDDLE);
+        QVERIFY(changes[0].region == workload::Region::R3);
+        QVERIFY(changes[0].prevRegion == workload::Region::R1);
     }
 
     { // delete proxy
         // NOTE: atm deleting a proxy doesn't result in a "Change"
-        std::vector<int32_t> deadProxies;
-        deadProxies.push_back(proxyId);
-        space.deleteProxies(deadProxies);
+        workload::Transaction transaction;
+        transaction.remove(proxyId);
+        processTransaction(space, transaction);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 0);
@@ -108,171 +150,169 @@ void SpaceTests::testOverlaps() {
     }
 }
 
-#ifdef MANUAL_TEST
+void SpaceTests::testMovingViewsMatchFullClassification() {
+    // the space only re-evaluates the proxies near region boundaries or which moved,
+    // which must give the same regions and changes as classifying every proxy every frame
+    const uint32_t NUM_PROXIES = 5000;
+    const int NUM_FRAMES = 20;
+    srand(1);
 
-const float WORLD_WIDTH = 1000.0f;
-const float MIN_RADIUS = 1.0f;
-const float MAX_RADIUS = 100.0f;
+    workload::Space space;
+    std::vector<workload::Sphere> spheres;
+    generateSpheres(NUM_PROXIES, spheres);
+
+    std::vector<workload::ProxyID> ids;
+    workload::Transaction transaction;
+    for (const auto& sphere : spheres) {
+        ids.push_back(space.allocateID());
+        transaction.reset(ids.back(), sphere, workload::Owner());
+    }
+    processTransaction(space, transaction);
+
+    std::vector<uint8_t> expectedRegions(NUM_PROXIES, workload::Region::UNKNOWN);
+    glm::vec3 viewCenter(0.0f);
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        // walk the view, grow one of them some frames and add a second view half way through
+        viewCenter += 10.0f * randomVec3();
+        workload::Views views;
+        float scale = (frame % 3 == 0) ? 1.5f : 1.0f;
+        views.push_back(makeView(viewCenter, 50.0f * scale, 150.0f * scale, 300.0f * scale));
+        if (frame >= NUM_FRAMES / 2) {
+            views.push_back(makeView(-viewCenter, 40.0f, 80.0f, 200.0f));
+        }
+        space.setViews(views);
 
-float randomFloat() {
-    return 2.0f * ((float)rand() / (float)RAND_MAX) - 1.0f;
-}
+        // move a few proxies, some of them across cells
+        workload::Transaction moves;
+        for (uint32_t i = frame; i < NUM_PROXIES; i += 97) {
+            spheres[i] += workload::Sphere(20.0f * randomVec3(), 0.0f);
+            moves.update(ids[i], spheres[i]);
+        }
+        processTransaction(space, moves);
 
-glm::vec3 randomVec3() {
-    glm::vec3 v(randomFloat(), randomFloat(), randomFloat());
-    return v;
-}
+        Changes changes;
+        space.categorizeAndGetChanges(changes);
 
-void generateSpheres(uint32_t numProxies, std::vector<workload::Space::Sphere>& spheres) {
-    spheres.reserve(numProxies);
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        workload::Space::Sphere sphere(
-                WORLD_WIDTH * randomFloat(),
-                WORLD_WIDTH * randomFloat(),
-                WORLD_WIDTH * randomFloat(),
-                (MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS)) * randomFloat());
-        spheres.push_back(sphere);
-    }
-}
+        Changes expectedChanges;
+        for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+            uint8_t region = computeRegion(views, spheres[i]);
+            if (region != expectedRegions[i]) {
+                expectedChanges.push_back(workload::Space::Change(ids[i], region, expectedRegions[i]));
+                expectedRegions[i] = region;
+            }
+            QCOMPARE(space.getRegion(ids[i]), region);
+        }
 
-void generatePositions(uint32_t numProxies, std::vector<glm::vec3>& positions) {
-    positions.reserve(numProxies);
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        positions.push_back(WORLD_WIDTH * randomVec3());
+        QCOMPARE(changes.size(), expectedChanges.size());
+        for (size_t i = 0; i < changes.size(); ++i) {
+            QCOMPARE(changes[i].proxyId, expectedChanges[i].proxyId);
+            QCOMPARE(changes[i].region, expectedChanges[i].region);
+            QCOMPARE(changes[i].prevRegion, expectedChanges[i].prevRegion);
+        }
     }
 }
 
-void generateRadiuses(uint32_t numRadiuses, std::vector<float>& radiuses) {
-    radiuses.reserve(numRadiuses);
-    for (uint32_t i = 0; i < numRadiuses; ++i) {
-        radiuses.push_back(MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * randomFloat());
-    }
-}
+#ifdef MANUAL_TEST
 
 void SpaceTests::benchmark() {
-    uint32_t numProxies[] = { 100, 1000, 10000, 100000 };
+    uint32_t numProxies[] = { 1000, 10000, 50000, 100000 };
     uint32_t numTests = 4;
+    const int NUM_FRAMES = 100;
     std::vector<uint64_t> timeToAddAll;
+    std::vector<uint64_t> timeToClassifyAll;
     std::vector<uint64_t> timeToMoveView;
-    std::vector<uint64_t> timeToMoveProxies;
     std::vector<uint64_t> timeToRemoveAll;
     for (uint32_t i = 0; i < numTests; ++i) {
 
         workload::Space space;
 
-        { // build the views
-            std::vector<glm::vec3> viewPositions;
-            viewPositions.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-            viewPositions.push_back(glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH));
-            float radius0 = 0.25f * WORLD_WIDTH;
-            float radius1 = 0.50f * WORLD_WIDTH;
-            float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
-            space.setViews(views);
-        }
-
         // build the proxies
         uint32_t n = numProxies[i];
-        std::vector<workload::Space::Sphere> proxySpheres;
+        std::vector<workload::Sphere> proxySpheres;
         generateSpheres(n, proxySpheres);
-        std::vector<int32_t> proxyKeys;
+        std::vector<workload::ProxyID> proxyKeys;
         proxyKeys.reserve(n);
 
         // measure time to put proxies in the space
         uint64_t startTime = usecTimestampNow();
+        workload::Transaction transaction;
         for (uint32_t j = 0; j < n; ++j) {
-            int32_t key = space.createProxy(proxySpheres[j]);
-            proxyKeys.push_back(key);
+            proxyKeys.push_back(space.allocateID());
+            transaction.reset(proxyKeys.back(), proxySpheres[j], workload::Owner());
         }
+        processTransaction(space, transaction);
         uint64_t usec = usecTimestampNow() - startTime;
         timeToAddAll.push_back(usec);
 
-        {
-            // build the views
-            std::vector<glm::vec3> viewPositions;
-            viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f));
-            viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f + 0.1f * WORLD_WIDTH));
-            float radius0 = 0.25f * WORLD_WIDTH;
-            float radius1 = 0.50f * WORLD_WIDTH;
-            float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
-            space.setViews(views);
-        }
-
-        // measure time to categorizeAndGetChanges everything
+        // measure time for the first categorizeAndGetChanges, which has to look at everything
+        glm::vec3 viewCenter(1.0f, 2.0f, 3.0f);
+        float radius0 = 0.05f * WORLD_WIDTH;
+        float radius1 = 0.10f * WORLD_WIDTH;
+        float radius2 = 0.25f * WORLD_WIDTH;
+        workload::Views views;
+        views.push_back(makeView(viewCenter, radius0, radius1, radius2));
+        space.setViews(views);
         std::vector<workload::Space::Change> changes;
         startTime = usecTimestampNow();
         space.categorizeAndGetChanges(changes);
         usec = usecTimestampNow() - startTime;
-        timeToMoveView.push_back(usec);
-
-        // move every 10th proxy around
-        const float proxySpeed = 1.0f;
-        std::vector<workload::Space::Sphere> newSpheres;
-        uint32_t numMovingProxies = n / 10;
-        uint32_t jstep = n / numMovingProxies;
-        uint32_t maxJ = numMovingProxies * jstep - 1;
-        glm::vec3 direction;
-        for (uint32_t j = 0; j < maxJ - jstep; j += jstep) {
-            glm::vec3 position = (glm::vec3)proxySpheres[j];
-            glm::vec3 destination = (glm::vec3)proxySpheres[j + jstep];
-            direction = glm::normalize(destination - position);
-            glm::vec3 newPosition = position + proxySpeed * direction;
-            newSpheres.push_back(workload::Space::Sphere(newPosition, proxySpheres[j].w));
-        }
-        glm::vec3 position = (glm::vec3)proxySpheres[maxJ = jstep];
-        glm::vec3 destination = (glm::vec3)proxySpheres[0];
-        direction = glm::normalize(destination - position);
-        direction = position + proxySpeed * direction;
-        newSpheres.push_back(workload::Space::Sphere(direction, proxySpheres[0].w));
-        uint32_t k = 0;
-        startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < maxJ; j += jstep) {
-            space.updateProxy(proxyKeys[j], newSpheres[k++]);
+        timeToClassifyAll.push_back(usec);
+
+        // measure the average frame of a walking view with every 100th proxy moving
+        usec = 0;
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            viewCenter += glm::vec3(1.0f, 0.0f, 0.0f);
+            views[0] = makeView(viewCenter, radius0, radius1, radius2);
+
+            workload::Transaction moves;
+            for (uint32_t j = frame; j < n; j += 100) {
+                proxySpheres[j] += workload::Sphere(randomVec3(), 0.0f);
+                moves.update(proxyKeys[j], proxySpheres[j]);
+            }
+
+            startTime = usecTimestampNow();
+            space.setViews(views);
+            processTransaction(space, moves);
+            changes.clear();
+            space.categorizeAndGetChanges(changes);
+            usec += usecTimestampNow() - startTime;
         }
-        changes.clear();
-        space.categorizeAndGetChanges(changes);
-        usec = usecTimestampNow() - startTime;
-        timeToMoveProxies.push_back(usec);
+        timeToMoveView.push_back(usec / NUM_FRAMES);
 
         // measure time to remove proxies from space
         startTime = usecTimestampNow();
+        transaction.clear();
         for (uint32_t j = 0; j < n; ++j) {
-            space.deleteProxy(proxyKeys[j]);
+            transaction.remove(proxyKeys[j]);
         }
+        processTransaction(space, transaction);
         usec = usecTimestampNow() - startTime;
         timeToRemoveAll.push_back(usec);
     }
 
     std::cout << "[numProxies, timeToAddAll] = [" << std::endl;
     for (uint32_t i = 0; i < timeToAddAll.size(); ++i) {
-        uint32_t n = numProxies[i];
-        std::cout << "    " << n << ", " << timeToAddAll[i] << std::endl;
+        std::cout << "    " << numProxies[i] << ", " << timeToAddAll[i] << std::endl;
     }
     std::cout << "];" << std::endl;
 
-    std::cout << "[numProxies, timeToMoveView] = [" << std::endl;
-    for (uint32_t i = 0; i < timeToMoveView.size(); ++i) {
-        uint32_t n = numProxies[i];
-        std::cout << "    " << n << ", " << timeToMoveView[i] << std::endl;
+    std::cout << "[numProxies, timeToClassifyAll, proxies/sec] = [" << std::endl;
+    for (uint32_t i = 0; i < timeToClassifyAll.size(); ++i) {
+        std::cout << "    " << numProxies[i] << ", " << timeToClassifyAll[i] << ", "
+            << (float)numProxies[i] * USECS_PER_SECOND / (float)std::max(timeToClassifyAll[i], (uint64_t)1) << std::endl;
     }
     std::cout << "];" << std::endl;
 
-    std::cout << "[numProxies, timeToMoveProxies] = [" << std::endl;
-    for (uint32_t i = 0; i < timeToMoveProxies.size(); ++i) {
-        uint32_t n = numProxies[i];
-        std::cout << "    " << n << "/10, " << timeToMoveProxies[i] << std::endl;
+    std::cout << "[numProxies, timeToMoveView per frame, proxies/sec] = [" << std::endl;
+    for (uint32_t i = 0; i < timeToMoveView.size(); ++i) {
+        std::cout << "    " << numProxies[i] << ", " << timeToMoveView[i] << ", "
+            << (float)numProxies[i] * USECS_PER_SECOND / (float)std::max(timeToMoveView[i], (uint64_t)1) << std::endl;
     }
     std::cout << "];" << std::endl;
 
     std::cout << "[numProxies, timeToRemoveAll] = [" << std::endl;
     for (uint32_t i = 0; i < timeToRemoveAll.size(); ++i) {
-        uint32_t n = numProxies[i];
-        std::cout << "    " << n << ", " << timeToRemoveAll[i] << std::endl;
+        std::cout << "    " << numProxies[i] << ", " << timeToRemoveAll[i] << std::endl;
     }
     std::cout << "];" << std::endl;
 }
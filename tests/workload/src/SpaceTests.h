@@ -21,6 +21,7 @@ class SpaceTests : public QObject {
 
 private slots:
     void testOverlaps();
+    void testMovingViewsMatchFullClassification();
 #ifdef MANUAL_TEST
     void benchmark();
 #endif // MANUAL_TEST
@@ -0,0 +1,351 @@
+//
+//  LoadAgent.cpp
+//  tools/load-generator/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LoadAgent.h"
+
+#include <QFile>
+#include <QJsonArray>
+
+#include <AudioConstants.h>
+#include <ClientTraitsHandler.h>
+#include <ConicalViewFrustum.h>
+#include <DependencyManager.h>
+#include <EntityItemProperties.h>
+#include <GLMHelpers.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+#include <plugins/PluginManager.h>
+
+static const int AVATAR_UPDATE_INTERVAL_MSECS = 1000 / 45;
+static const int OCTREE_QUERY_INTERVAL_MSECS = 1000;
+static const int ENTITY_EDIT_INTERVAL_MSECS = 200;
+static const int STATS_SAMPLE_INTERVAL_MSECS = 1000;
+
+// agents spread out over a square of this size around the origin, and wander within a circle around their start
+static const float SPAWN_AREA_SIZE = 40.0f;
+static const float WANDER_RADIUS = 4.0f;
+static const float WALK_SPEED = 1.2f; // meters per second
+
+// the number of joints animated on each avatar; enough to exercise the mixer's joint culling and packing
+static const int NUM_SIMULATED_JOINTS = 60;
+
+SimulatedAvatar::SimulatedAvatar() {
+    _clientTraitsHandler.reset(new ClientTraitsHandler(this));
+}
+
+int SimulatedAvatar::sendAvatarDataPacket(bool sendAll) {
+    int bytesSent = 0;
+    if (getIdentityDataChanged()) {
+        bytesSent += sendIdentityPacket();
+    }
+    bytesSent += _clientTraitsHandler->sendChangedTraitsToMixer();
+    bytesSent += AvatarData::sendAvatarDataPacket(sendAll);
+    return bytesSent;
+}
+
+LoadAgent::LoadAgent(const Options& options, QObject* parent) :
+    QObject(parent),
+    _options(options),
+    _avatar(std::make_shared<SimulatedAvatar>())
+{
+    auto nodeList = DependencyManager::get<NodeList>();
+    connect(nodeList.data(), &NodeList::nodeActivated, this, &LoadAgent::nodeActivated);
+    connect(nodeList.data(), &NodeList::uuidChanged, this, [this](const QUuid& sessionUUID) {
+        _avatar->setSessionUUID(sessionUUID);
+    });
+    nodeList->getPacketReceiver().registerListener(PacketType::SelectedAudioFormat, this, "handleSelectedAudioFormat");
+
+    // place each agent deterministically so runs are comparable
+    qsrand((uint)(_options.index + 1));
+    _origin = glm::vec3(randFloatInRange(-SPAWN_AREA_SIZE, SPAWN_AREA_SIZE) / 2.0f, 0.0f,
+                        randFloatInRange(-SPAWN_AREA_SIZE, SPAWN_AREA_SIZE) / 2.0f);
+    _walkTarget = _origin;
+    _avatar->setWorldPosition(_origin);
+    _avatar->setSessionDisplayName(QString("load-agent-%1").arg(_options.index));
+    _avatar->setDisplayName(QString("load-agent-%1").arg(_options.index));
+    _avatar->setSkeletonModelURL(QUrl());
+
+    if (_options.sendAudio) {
+        loadAudio();
+    }
+
+    _octreeQuery.setMaxQueryPacketsPerSecond(DEFAULT_MAX_OCTREE_PPS);
+
+    _entityEditSender.setPacketsPerSecond(DEFAULT_MAX_OCTREE_PPS);
+    _entityEditSender.initialize(true);
+
+    connect(&_avatarTimer, &QTimer::timeout, this, &LoadAgent::simulateAvatar);
+    connect(&_audioTimer, &QTimer::timeout, this, &LoadAgent::sendAudioFrame);
+    connect(&_queryTimer, &QTimer::timeout, this, &LoadAgent::sendOctreeQuery);
+    connect(&_entityTimer, &QTimer::timeout, this, &LoadAgent::sendEntityEdit);
+    connect(&_statsTimer, &QTimer::timeout, this, &LoadAgent::sampleStats);
+    _audioTimer.setTimerType(Qt::PreciseTimer);
+    _avatarTimer.setTimerType(Qt::PreciseTimer);
+
+    _startUsecs = usecTimestampNow();
+    _lastSimulationUsecs = _startUsecs;
+    _avatarTimer.start(AVATAR_UPDATE_INTERVAL_MSECS);
+    _statsTimer.start(STATS_SAMPLE_INTERVAL_MSECS);
+    if (_options.sendOctreeQueries) {
+        _queryTimer.start(OCTREE_QUERY_INTERVAL_MSECS);
+    }
+    QTimer::singleShot(_options.durationSecs * MSECS_PER_SECOND, this, &LoadAgent::stop);
+}
+
+LoadAgent::~LoadAgent() {
+    _entityEditSender.terminate();
+    if (_codec && _encoder) {
+        _codec->releaseEncoder(_encoder);
+        _encoder = nullptr;
+    }
+}
+
+void LoadAgent::loadAudio() {
+    if (!_options.audioFile.isEmpty()) {
+        // raw 16-bit mono PCM at the network sample rate
+        QFile file(_options.audioFile);
+        if (file.open(QIODevice::ReadOnly)) {
+            _audioLoop = file.readAll();
+            _audioLoop.truncate(_audioLoop.size() - (_audioLoop.size() % AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL));
+        } else {
+            qWarning() << "Could not open audio file" << _options.audioFile << "- falling back to a generated tone";
+        }
+    }
+
+    if (_audioLoop.isEmpty()) {
+        // a one second tone with a slow tremolo, pitched per agent, so the mixer never sees a silent stream
+        const int numSamples = AudioConstants::SAMPLE_RATE;
+        const float frequency = 220.0f + 20.0f * (_options.index % 16);
+        const float TREMOLO_HZ = 2.0f;
+        const float AMPLITUDE = 0.25f * AudioConstants::MAX_SAMPLE_VALUE;
+        _audioLoop.resize(numSamples * AudioConstants::SAMPLE_SIZE);
+        auto samples = reinterpret_cast<int16_t*>(_audioLoop.data());
+        for (int i = 0; i < numSamples; i++) {
+            float t = (float)i / AudioConstants::SAMPLE_RATE;
+            float envelope = 0.5f + 0.5f * sinf(TWO_PI * TREMOLO_HZ * t);
+            samples[i] = (int16_t)(AMPLITUDE * envelope * sinf(TWO_PI * frequency * t));
+        }
+    }
+}
+
+void LoadAgent::nodeActivated(SharedNodePointer node) {
+    if (node->getType() == NodeType::AudioMixer && _options.sendAudio) {
+        negotiateAudioFormat();
+    } else if (node->getType() == NodeType::AvatarMixer) {
+        _avatar->markIdentityDataChanged();
+    } else if (node->getType() == NodeType::EntityServer && _options.sendEntityEdits) {
+        _entityTimer.start(ENTITY_EDIT_INTERVAL_MSECS);
+    }
+}
+
+void LoadAgent::negotiateAudioFormat() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto negotiateFormatPacket = NLPacket::create(PacketType::NegotiateAudioFormat);
+    auto codecPlugins = PluginManager::getInstance()->getCodecPlugins();
+    quint8 numberOfCodecs = (quint8)codecPlugins.size();
+    negotiateFormatPacket->writePrimitive(numberOfCodecs);
+    for (auto& plugin : codecPlugins) {
+        negotiateFormatPacket->writeString(plugin->getName());
+    }
+
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (audioMixer) {
+        nodeList->sendPacket(std::move(negotiateFormatPacket), *audioMixer);
+    }
+}
+
+void LoadAgent::handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message) {
+    selectAudioFormat(message->readString());
+}
+
+void LoadAgent::selectAudioFormat(const QString& selectedCodecName) {
+    _selectedCodecName = selectedCodecName;
+
+    if (_codec && _encoder) {
+        _codec->releaseEncoder(_encoder);
+        _encoder = nullptr;
+        _codec = nullptr;
+    }
+
+    auto codecPlugins = PluginManager::getInstance()->getCodecPlugins();
+    for (auto& plugin : codecPlugins) {
+        if (_selectedCodecName == plugin->getName()) {
+            _codec = plugin;
+            _encoder = plugin->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
+            break;
+        }
+    }
+
+    if (!_audioTimer.isActive()) {
+        _audioTimer.start(AudioConstants::NETWORK_FRAME_MSECS);
+    }
+}
+
+void LoadAgent::simulateAvatar() {
+    quint64 now = usecTimestampNow();
+    float deltaTime = (float)(now - _lastSimulationUsecs) / USECS_PER_SECOND;
+    float elapsed = (float)(now - _startUsecs) / USECS_PER_SECOND;
+    _lastSimulationUsecs = now;
+
+    // wander between random points around the spawn location
+    glm::vec3 position = _avatar->getWorldPosition();
+    glm::vec3 toTarget = _walkTarget - position;
+    float distance = glm::length(toTarget);
+    if (distance < 0.1f) {
+        _walkTarget = _origin + glm::vec3(randFloatInRange(-WANDER_RADIUS, WANDER_RADIUS), 0.0f,
+                                          randFloatInRange(-WANDER_RADIUS, WANDER_RADIUS));
+    } else {
+        glm::vec3 direction = toTarget / distance;
+        position += direction * glm::min(distance, WALK_SPEED * deltaTime);
+        _avatar->setWorldPosition(position);
+        _avatar->setWorldOrientation(rotationBetween(Vectors::FRONT, direction));
+    }
+
+    // swing every joint a little so the mixer has fresh joint data to cull and pack each frame
+    for (int i = 0; i < NUM_SIMULATED_JOINTS; i++) {
+        float angle = 0.3f * sinf(elapsed * 2.0f + (float)i * 0.7f);
+        _avatar->setJointData(i, glm::angleAxis(angle, Vectors::UNIT_X), glm::vec3(0.0f, 0.1f, 0.0f));
+    }
+
+    _avatarBytesSent += _avatar->sendAvatarDataPacket();
+    _avatarPacketsSent++;
+}
+
+void LoadAgent::sendAudioFrame() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (!audioMixer || !audioMixer->getActiveSocket() || _audioLoop.isEmpty()) {
+        return;
+    }
+
+    QByteArray decodedFrame = QByteArray::fromRawData(_audioLoop.constData() + _audioLoopOffset,
+                                                      AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL);
+    _audioLoopOffset = (_audioLoopOffset + AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL) % _audioLoop.size();
+
+    auto audioPacket = NLPacket::create(PacketType::MicrophoneAudioNoEcho);
+    audioPacket->writePrimitive(_audioSequenceNumber++);
+    audioPacket->writeString(_selectedCodecName);
+
+    // mono, positioned at the avatar
+    audioPacket->writePrimitive((quint8)0);
+    glm::vec3 position = _avatar->getWorldPosition();
+    audioPacket->writePrimitive(position);
+    audioPacket->writePrimitive(_avatar->getWorldOrientation());
+    audioPacket->writePrimitive(position);
+    audioPacket->writePrimitive(glm::vec3(0.0f));
+
+    if (_encoder) {
+        _encoder->encode(decodedFrame, _encodedFrame);
+        audioPacket->write(_encodedFrame.constData(), _encodedFrame.size());
+    } else {
+        audioPacket->write(decodedFrame.constData(), decodedFrame.size());
+    }
+
+    nodeList->sendUnreliablePacket(*audioPacket, *audioMixer);
+    _audioFramesSent++;
+}
+
+void LoadAgent::sendOctreeQuery() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer entityServer = nodeList->soloNodeOfType(NodeType::EntityServer);
+    if (!entityServer || !entityServer->getActiveSocket()) {
+        return;
+    }
+
+    ViewFrustum view;
+    view.setPosition(_avatar->getWorldPosition());
+    view.setOrientation(_avatar->getWorldOrientation());
+    view.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, DEFAULT_ASPECT_RATIO, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+    view.calculate();
+    _octreeQuery.setConicalViews({ ConicalViewFrustum(view) });
+
+    auto queryPacket = NLPacket::create(PacketType::EntityQuery);
+    auto packetData = reinterpret_cast<unsigned char*>(queryPacket->getPayload());
+    queryPacket->setPayloadSize(_octreeQuery.getBroadcastData(packetData));
+    nodeList->sendUnreliablePacket(*queryPacket, *entityServer);
+    _octreeQueriesSent++;
+
+    // the avatar-mixer also wants to know what we can see
+    SharedNodePointer avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (avatarMixer && avatarMixer->getActiveSocket()) {
+        auto avatarQueryPacket = NLPacket::create(PacketType::AvatarQuery);
+        auto destinationBuffer = reinterpret_cast<unsigned char*>(avatarQueryPacket->getPayload());
+        auto bufferStart = destinationBuffer;
+        uint8_t numFrustums = 1;
+        memcpy(destinationBuffer, &numFrustums, sizeof(numFrustums));
+        destinationBuffer += sizeof(numFrustums);
+        destinationBuffer += ConicalViewFrustum(view).serialize(destinationBuffer);
+        avatarQueryPacket->setPayloadSize(destinationBuffer - bufferStart);
+        nodeList->sendUnreliablePacket(*avatarQueryPacket, *avatarMixer);
+    }
+}
+
+void LoadAgent::sendEntityEdit() {
+    const float ENTITY_LIFETIME_SECS = 60.0f;
+    const glm::vec3 ENTITY_OFFSET { 0.0f, 2.0f, 0.0f };
+
+    EntityItemProperties properties;
+    PacketType packetType = PacketType::EntityEdit;
+    if (_entityID.isNull()) {
+        _entityID = EntityItemID(QUuid::createUuid());
+        packetType = PacketType::EntityAdd;
+        properties.setType(EntityTypes::Box);
+        properties.setDimensions(glm::vec3(0.25f));
+        properties.setLifetime(ENTITY_LIFETIME_SECS);
+    }
+    properties.setPosition(_avatar->getWorldPosition() + ENTITY_OFFSET);
+    properties.setRotation(_avatar->getWorldOrientation());
+
+    _entityEditSender.queueEditEntityMessage(packetType, nullptr, _entityID, properties);
+    _entityEditSender.releaseQueuedMessages();
+    _entityEditsSent++;
+}
+
+void LoadAgent::sampleStats() {
+    // LimitedNodeList samples its connection stats once a second, so each sample covers one second
+    auto nodeList = DependencyManager::get<NodeList>();
+    _inboundKilobits += nodeList->getInboundKbps();
+    _outboundKilobits += nodeList->getOutboundKbps();
+    _statsSamples++;
+}
+
+void LoadAgent::stop() {
+    _avatarTimer.stop();
+    _audioTimer.stop();
+    _queryTimer.stop();
+    _entityTimer.stop();
+    _statsTimer.stop();
+
+    if (!_entityID.isNull()) {
+        _entityEditSender.queueEraseEntityMessage(_entityID);
+        _entityEditSender.releaseQueuedMessages();
+    }
+
+    float seconds = (float)(usecTimestampNow() - _startUsecs) / USECS_PER_SECOND;
+
+    QJsonObject summary;
+    summary["index"] = _options.index;
+    summary["session_id"] = uuidStringWithoutCurlyBraces(DependencyManager::get<NodeList>()->getSessionUUID());
+    summary["seconds"] = seconds;
+    summary["codec"] = _selectedCodecName;
+    summary["avatar_packets_sent"] = _avatarPacketsSent;
+    summary["avatar_bytes_sent"] = _avatarBytesSent;
+    summary["audio_frames_sent"] = _audioFramesSent;
+    summary["entity_edits_sent"] = _entityEditsSent;
+    summary["octree_queries_sent"] = _octreeQueriesSent;
+    summary["bytes_received"] = (qint64)(_inboundKilobits * BYTES_PER_KILOBYTE / BITS_IN_BYTE);
+    summary["bytes_sent"] = (qint64)(_outboundKilobits * BYTES_PER_KILOBYTE / BITS_IN_BYTE);
+    summary["avg_inbound_kbps"] = _statsSamples > 0 ? _inboundKilobits / _statsSamples : 0.0;
+    summary["avg_outbound_kbps"] = _statsSamples > 0 ? _outboundKilobits / _statsSamples : 0.0;
+
+    emit finished(summary);
+}
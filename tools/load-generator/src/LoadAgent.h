@@ -0,0 +1,108 @@
+//
+//  LoadAgent.h
+//  tools/load-generator/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LoadAgent_h
+#define hifi_LoadAgent_h
+
+#include <QObject>
+#include <QJsonObject>
+#include <QTimer>
+
+#include <AvatarData.h>
+#include <EntityEditPacketSender.h>
+#include <EntityItemID.h>
+#include <Node.h>
+#include <OctreeQuery.h>
+#include <ReceivedMessage.h>
+#include <plugins/CodecPlugin.h>
+
+// A lightweight stand-in for the ScriptableAvatar an Agent would own: it only knows how to
+// report its identity and traits and to send avatar data, without a rig or script engine.
+class SimulatedAvatar : public AvatarData {
+public:
+    SimulatedAvatar();
+
+    int sendAvatarDataPacket(bool sendAll = false) override;
+};
+
+// One simulated client: connects to the domain as an Agent, walks an avatar around with
+// animated joints, streams a looping audio clip through the negotiated codec, edits an entity
+// and queries the entity-server, then reports what it sent and received.
+class LoadAgent : public QObject {
+    Q_OBJECT
+public:
+    struct Options {
+        int index { 0 };
+        int durationSecs { 60 };
+        bool sendAudio { true };
+        bool sendEntityEdits { true };
+        bool sendOctreeQueries { true };
+        QString audioFile;
+    };
+
+    LoadAgent(const Options& options, QObject* parent = nullptr);
+    ~LoadAgent();
+
+signals:
+    void finished(QJsonObject summary);
+
+private slots:
+    void nodeActivated(SharedNodePointer node);
+    void handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message);
+
+    void simulateAvatar();
+    void sendAudioFrame();
+    void sendOctreeQuery();
+    void sendEntityEdit();
+    void sampleStats();
+    void stop();
+
+private:
+    void negotiateAudioFormat();
+    void selectAudioFormat(const QString& selectedCodecName);
+    void loadAudio();
+
+    Options _options;
+
+    std::shared_ptr<SimulatedAvatar> _avatar;
+    glm::vec3 _origin;
+    glm::vec3 _walkTarget;
+    quint64 _startUsecs { 0 };
+    quint64 _lastSimulationUsecs { 0 };
+
+    QTimer _avatarTimer;
+    QTimer _audioTimer;
+    QTimer _queryTimer;
+    QTimer _entityTimer;
+    QTimer _statsTimer;
+
+    QByteArray _audioLoop;
+    int _audioLoopOffset { 0 };
+    quint16 _audioSequenceNumber { 0 };
+    QString _selectedCodecName;
+    CodecPluginPointer _codec;
+    Encoder* _encoder { nullptr };
+    QByteArray _encodedFrame;
+
+    OctreeQuery _octreeQuery;
+    EntityEditPacketSender _entityEditSender;
+    EntityItemID _entityID;
+
+    int _avatarPacketsSent { 0 };
+    qint64 _avatarBytesSent { 0 };
+    int _audioFramesSent { 0 };
+    int _entityEditsSent { 0 };
+    int _octreeQueriesSent { 0 };
+    double _inboundKilobits { 0.0 };
+    double _outboundKilobits { 0.0 };
+    int _statsSamples { 0 };
+};
+
+#endif // hifi_LoadAgent_h
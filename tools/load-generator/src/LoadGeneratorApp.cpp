@@ -0,0 +1,489 @@
+//
+//  LoadGeneratorApp.cpp
+//  tools/load-generator/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LoadGeneratorApp.h"
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QTextStream>
+
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <DomainHandler.h>
+#include <NetworkLogging.h>
+#include <NumericalConstants.h>
+#include <SharedLogging.h>
+#include <plugins/PluginManager.h>
+
+static const QString AGENT_SUMMARY_PREFIX = "LOAD_AGENT_SUMMARY ";
+static const int MIXER_STATS_SAMPLE_INTERVAL_MSECS = 2000;
+
+// extra time given to the agents to connect and to report back before the controller gives up on them
+static const int AGENT_GRACE_PERIOD_MSECS = 15 * MSECS_PER_SECOND;
+
+// the stats, wherever they appear in a mixer's stats object, that are summarized in the report
+static const QStringList SUMMARIZED_MIXER_STATS = {
+    "throttling_ratio",
+    "trailing_mix_ratio",
+    "broadcast_loop_rate",
+    "us_per_frame_trailing",
+    "us_per_mix_trailing",
+    "us_per_packets_trailing",
+    "inbound_kbps",
+    "outbound_kbps",
+    "inbound_pps",
+    "outbound_pps"
+};
+
+static const QStringList SAMPLED_NODE_TYPES = { "audio-mixer", "avatar-mixer", "entity-server" };
+
+static bool findStat(const QJsonObject& object, const QString& key, double& value) {
+    auto it = object.find(key);
+    if (it != object.end() && it.value().isDouble()) {
+        value = it.value().toDouble();
+        return true;
+    }
+    for (auto child = object.begin(); child != object.end(); ++child) {
+        if (child.value().isObject() && findStat(child.value().toObject(), key, value)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool findObject(const QJsonObject& object, const QString& key, QJsonObject& value) {
+    auto it = object.find(key);
+    if (it != object.end() && it.value().isObject()) {
+        value = it.value().toObject();
+        return true;
+    }
+    for (auto child = object.begin(); child != object.end(); ++child) {
+        if (child.value().isObject() && findObject(child.value().toObject(), key, value)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+LoadGeneratorApp::LoadGeneratorApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv),
+    _domainServerHTTPPort(DOMAIN_SERVER_HTTP_PORT)
+{
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Mixer load generator");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption verboseOutput("v", "verbose output");
+    parser.addOption(verboseOutput);
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address", "127.0.0.1:40103");
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption httpPortOption("http-port", "domain-server HTTP port, for mixer stats",
+                                            QString::number(DOMAIN_SERVER_HTTP_PORT));
+    parser.addOption(httpPortOption);
+
+    const QCommandLineOption numAgentsOption("n", "number of simulated agents", "count", "10");
+    parser.addOption(numAgentsOption);
+
+    const QCommandLineOption durationOption("t", "seconds each agent stays connected", "seconds", "60");
+    parser.addOption(durationOption);
+
+    const QCommandLineOption spawnIntervalOption("spawn-interval", "milliseconds between agent launches", "msecs", "50");
+    parser.addOption(spawnIntervalOption);
+
+    const QCommandLineOption reportOption("o", "path of the JSON report", "load-report.json", "load-report.json");
+    parser.addOption(reportOption);
+
+    const QCommandLineOption audioFileOption("audio-file", "raw 24kHz 16-bit mono PCM to loop", "file.raw");
+    parser.addOption(audioFileOption);
+
+    const QCommandLineOption noAudioOption("no-audio", "don't stream audio");
+    parser.addOption(noAudioOption);
+
+    const QCommandLineOption noEntitiesOption("no-entities", "don't edit entities");
+    parser.addOption(noEntitiesOption);
+
+    const QCommandLineOption noQueriesOption("no-queries", "don't send octree queries");
+    parser.addOption(noQueriesOption);
+
+    // used by the controller to launch its agents
+    QCommandLineOption agentOption("agent", "run as a single simulated agent", "index");
+    agentOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(agentOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _verbose = parser.isSet(verboseOutput);
+    if (!_verbose) {
+        QLoggingCategory::setFilterRules("qt.network.ssl.warning=false");
+
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtWarningMsg, false);
+
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtWarningMsg, false);
+    }
+
+    _domainServerAddress = "127.0.0.1:40103";
+    if (parser.isSet(domainAddressOption)) {
+        _domainServerAddress = parser.value(domainAddressOption);
+    }
+    _domainServerHostname = _domainServerAddress.section(':', 0, 0);
+    if (parser.isSet(httpPortOption)) {
+        _domainServerHTTPPort = (quint16)parser.value(httpPortOption).toUInt();
+    }
+
+    _numAgents = std::max(1, parser.value(numAgentsOption).toInt());
+    _durationSecs = std::max(1, parser.value(durationOption).toInt());
+    _spawnIntervalMsecs = std::max(0, parser.value(spawnIntervalOption).toInt());
+    _reportPath = parser.value(reportOption);
+
+    _agentOptions.durationSecs = _durationSecs;
+    _agentOptions.sendAudio = !parser.isSet(noAudioOption);
+    _agentOptions.sendEntityEdits = !parser.isSet(noEntitiesOption);
+    _agentOptions.sendOctreeQueries = !parser.isSet(noQueriesOption);
+    _agentOptions.audioFile = parser.value(audioFileOption);
+
+    if (parser.isSet(agentOption)) {
+        _isAgent = true;
+        _agentOptions.index = parser.value(agentOption).toInt();
+        startAgent();
+    } else {
+        startController();
+    }
+}
+
+LoadGeneratorApp::~LoadGeneratorApp() {
+}
+
+QStringList LoadGeneratorApp::agentArguments(int index) const {
+    QStringList arguments { "--agent", QString::number(index), "-d", _domainServerAddress, "-t", QString::number(_durationSecs) };
+    if (!_agentOptions.sendAudio) {
+        arguments << "--no-audio";
+    }
+    if (!_agentOptions.sendEntityEdits) {
+        arguments << "--no-entities";
+    }
+    if (!_agentOptions.sendOctreeQueries) {
+        arguments << "--no-queries";
+    }
+    if (!_agentOptions.audioFile.isEmpty()) {
+        arguments << "--audio-file" << _agentOptions.audioFile;
+    }
+    if (_verbose) {
+        arguments << "-v";
+    }
+    return arguments;
+}
+
+void LoadGeneratorApp::startController() {
+    qInfo() << "Spawning" << _numAgents << "agents against" << _domainServerAddress << "for" << _durationSecs << "seconds";
+
+    _startUsecs = usecTimestampNow();
+    _networkAccessManager = new QNetworkAccessManager(this);
+    _agentProcesses.reserve(_numAgents);
+
+    connect(&_sampleTimer, &QTimer::timeout, this, &LoadGeneratorApp::sampleMixerStats);
+    _sampleTimer.start(MIXER_STATS_SAMPLE_INTERVAL_MSECS);
+
+    spawnNextAgent();
+
+    // don't wait forever on agents that failed to connect or hung
+    int spawnMsecs = _numAgents * _spawnIntervalMsecs;
+    QTimer::singleShot(spawnMsecs + _durationSecs * MSECS_PER_SECOND + AGENT_GRACE_PERIOD_MSECS, this, [this] {
+        if (_numAgentsRunning > 0) {
+            qWarning() << _numAgentsRunning << "agents did not finish in time";
+            _numAgentsTimedOut = _numAgentsRunning;
+            for (auto process : _agentProcesses) {
+                process->kill();
+            }
+            // report on the agents that did finish, rather than waiting on the killed ones
+            completeRun();
+        }
+    });
+}
+
+void LoadGeneratorApp::spawnNextAgent() {
+    int index = (int)_agentProcesses.size();
+    if (index >= _numAgents) {
+        return;
+    }
+
+    auto process = new QProcess(this);
+    process->setProcessChannelMode(_verbose ? QProcess::ForwardedErrorChannel : QProcess::SeparateChannels);
+    connect(process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, [this, index](int exitCode, QProcess::ExitStatus exitStatus) {
+        agentFinished(index, exitStatus == QProcess::NormalExit ? exitCode : -1);
+    });
+    // an agent that never started never finishes either
+    connect(process, &QProcess::errorOccurred, this, [this, index](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            agentFailedToStart(index);
+        }
+    });
+    _agentProcesses.push_back(process);
+    _numAgentsRunning++;
+    process->start(QCoreApplication::applicationFilePath(), agentArguments(index));
+
+    QTimer::singleShot(_spawnIntervalMsecs, this, &LoadGeneratorApp::spawnNextAgent);
+}
+
+void LoadGeneratorApp::agentFinished(int index, int exitCode) {
+    auto process = _agentProcesses[index];
+    bool reported = false;
+    for (const QByteArray& line : process->readAllStandardOutput().split('\n')) {
+        if (line.startsWith(AGENT_SUMMARY_PREFIX.toUtf8())) {
+            auto document = QJsonDocument::fromJson(line.mid(AGENT_SUMMARY_PREFIX.length()));
+            _agentSummaries.append(document.object());
+            reported = true;
+        }
+    }
+    if (!reported) {
+        qWarning() << "Agent" << index << "exited with code" << exitCode << "without a summary";
+    }
+
+    agentStopped();
+}
+
+void LoadGeneratorApp::agentFailedToStart(int index) {
+    qWarning() << "Agent" << index << "failed to start:" << _agentProcesses[index]->errorString();
+    _numAgentsFailedToStart++;
+
+    agentStopped();
+}
+
+void LoadGeneratorApp::agentStopped() {
+    _numAgentsRunning--;
+    if (_numAgentsRunning == 0 && (int)_agentProcesses.size() == _numAgents) {
+        completeRun();
+    }
+}
+
+void LoadGeneratorApp::completeRun() {
+    // the timeout and the last agent to stop can both get here
+    if (_isComplete) {
+        return;
+    }
+    _isComplete = true;
+
+    _sampleTimer.stop();
+    writeReport();
+    finish(0);
+}
+
+void LoadGeneratorApp::sampleMixerStats() {
+    QUrl baseURL;
+    baseURL.setScheme("http");
+    baseURL.setHost(_domainServerHostname);
+    baseURL.setPort(_domainServerHTTPPort);
+
+    QUrl nodesURL = baseURL;
+    nodesURL.setPath("/nodes.json");
+    QNetworkReply* nodesReply = _networkAccessManager->get(QNetworkRequest(nodesURL));
+    connect(nodesReply, &QNetworkReply::finished, this, [this, nodesReply, baseURL] {
+        nodesReply->deleteLater();
+        if (nodesReply->error() != QNetworkReply::NoError) {
+            qWarning() << "Could not fetch nodes from the domain-server:" << nodesReply->errorString();
+            return;
+        }
+
+        float elapsed = (float)(usecTimestampNow() - _startUsecs) / USECS_PER_SECOND;
+        auto nodes = QJsonDocument::fromJson(nodesReply->readAll()).object()["nodes"].toArray();
+        for (const auto& nodeValue : nodes) {
+            auto node = nodeValue.toObject();
+            QString type = node["type"].toString();
+            if (!SAMPLED_NODE_TYPES.contains(type)) {
+                continue;
+            }
+
+            QUrl statsURL = baseURL;
+            statsURL.setPath(QString("/nodes/%1.json").arg(node["uuid"].toString()));
+            QNetworkReply* statsReply = _networkAccessManager->get(QNetworkRequest(statsURL));
+            connect(statsReply, &QNetworkReply::finished, this, [this, statsReply, type, elapsed] {
+                statsReply->deleteLater();
+                if (statsReply->error() != QNetworkReply::NoError) {
+                    return;
+                }
+                QJsonObject sample;
+                sample["seconds"] = elapsed;
+                sample["stats"] = QJsonDocument::fromJson(statsReply->readAll()).object();
+                _mixerSamples[type].append(sample);
+            });
+        }
+    });
+}
+
+void LoadGeneratorApp::writeReport() {
+    QJsonObject report;
+    report["domain"] = _domainServerAddress;
+    report["agents"] = _numAgents;
+    report["duration_secs"] = _durationSecs;
+    report["audio"] = _agentOptions.sendAudio;
+    report["entity_edits"] = _agentOptions.sendEntityEdits;
+    report["octree_queries"] = _agentOptions.sendOctreeQueries;
+
+    // summarize each server over the samples taken while every agent was connected
+    QJsonObject mixers;
+    for (auto it = _mixerSamples.begin(); it != _mixerSamples.end(); ++it) {
+        QJsonObject summary;
+        for (const auto& key : SUMMARIZED_MIXER_STATS) {
+            double sum = 0.0;
+            double max = 0.0;
+            int count = 0;
+            for (const auto& sampleValue : it.value()) {
+                double value;
+                if (findStat(sampleValue.toObject()["stats"].toObject(), key, value)) {
+                    sum += value;
+                    max = count == 0 ? value : std::max(max, value);
+                    count++;
+                }
+            }
+            if (count > 0) {
+                summary[key] = QJsonObject { { "avg", sum / count }, { "max", max } };
+            }
+        }
+
+        // the frame time percentiles, over the samples' histograms
+        double sumP50 = 0.0;
+        double maxP99 = 0.0;
+        double maxFrame = 0.0;
+        int numHistograms = 0;
+        for (const auto& sampleValue : it.value()) {
+            QJsonObject frameTimes;
+            if (findObject(sampleValue.toObject()["stats"].toObject(), "frame_us", frameTimes) &&
+                frameTimes["count"].toDouble() > 0.0) {
+                sumP50 += frameTimes["p50"].toDouble();
+                maxP99 = std::max(maxP99, frameTimes["p99"].toDouble());
+                maxFrame = std::max(maxFrame, frameTimes["max"].toDouble());
+                numHistograms++;
+            }
+        }
+        if (numHistograms > 0) {
+            summary["frame_us"] = QJsonObject { { "avg_p50", sumP50 / numHistograms }, { "max_p99", maxP99 }, { "max", maxFrame } };
+        }
+
+        if (summary.contains("outbound_kbps") && !_agentSummaries.isEmpty()) {
+            double outboundKbps = summary["outbound_kbps"].toObject()["avg"].toDouble();
+            summary["outbound_bytes_per_client_per_sec"] = outboundKbps * BYTES_PER_KILOBIT / _agentSummaries.size();
+        }
+
+        mixers[it.key()] = QJsonObject { { "summary", summary }, { "samples", it.value() } };
+    }
+    report["mixers"] = mixers;
+
+    // totals across the simulated clients
+    double receivedBytes = 0.0;
+    double sentBytes = 0.0;
+    for (const auto& summaryValue : _agentSummaries) {
+        auto summary = summaryValue.toObject();
+        receivedBytes += summary["bytes_received"].toDouble();
+        sentBytes += summary["bytes_sent"].toDouble();
+    }
+    int numReported = _agentSummaries.size();
+    report["clients_reported"] = numReported;
+    report["clients_failed_to_start"] = _numAgentsFailedToStart;
+    report["clients_timed_out"] = _numAgentsTimedOut;
+    report["avg_bytes_received_per_client"] = numReported > 0 ? receivedBytes / numReported : 0.0;
+    report["avg_bytes_sent_per_client"] = numReported > 0 ? sentBytes / numReported : 0.0;
+    report["clients"] = _agentSummaries;
+
+    QFile reportFile(_reportPath);
+    if (reportFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        reportFile.write(QJsonDocument(report).toJson());
+        qInfo() << "Wrote report to" << _reportPath;
+    } else {
+        qCritical() << "Could not write report to" << _reportPath;
+    }
+}
+
+void LoadGeneratorApp::startAgent() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+
+    DependencyManager::set<AccountManager>(false, [&]{ return QString("Mozilla/5.0 (HighFidelityLoadGenerator)"); });
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+    if (_agentOptions.sendAudio) {
+        DependencyManager::set<PluginManager>()->instantiate();
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // setup a timer for domain-server check ins
+    QTimer* domainCheckInTimer = new QTimer(nodeList.data());
+    connect(domainCheckInTimer, &QTimer::timeout, nodeList.data(), &NodeList::sendDomainServerCheckIn);
+    domainCheckInTimer->start(DOMAIN_SERVER_CHECK_IN_MSECS);
+
+    // start the nodeThread so its event loop is running
+    // (must happen after the checkin timer is created with the nodelist as it's parent)
+    nodeList->startThread();
+
+    NodeSet interestSet;
+    interestSet << NodeType::AvatarMixer;
+    if (_agentOptions.sendAudio) {
+        interestSet << NodeType::AudioMixer;
+    }
+    if (_agentOptions.sendEntityEdits || _agentOptions.sendOctreeQueries) {
+        interestSet << NodeType::EntityServer;
+    }
+    nodeList->addSetOfNodeTypesToNodeInterestSet(interestSet);
+
+    _agent = new LoadAgent(_agentOptions, this);
+    connect(_agent, &LoadAgent::finished, this, &LoadGeneratorApp::agentSummaryReady);
+
+    DependencyManager::get<AddressManager>()->handleLookupString(_domainServerAddress, false);
+}
+
+void LoadGeneratorApp::agentSummaryReady(QJsonObject summary) {
+    QTextStream(stdout) << AGENT_SUMMARY_PREFIX << QJsonDocument(summary).toJson(QJsonDocument::Compact) << endl;
+
+    // give the final erase and kill packets a moment to go out
+    const int FLUSH_MSECS = 250;
+    QTimer::singleShot(FLUSH_MSECS, this, [this] { finish(0); });
+}
+
+void LoadGeneratorApp::finish(int exitCode) {
+    if (_isAgent) {
+        delete _agent;
+        _agent = nullptr;
+
+        auto nodeList = DependencyManager::get<NodeList>();
+
+        // send the domain a disconnect packet, force stoppage of domain-server check-ins
+        nodeList->getDomainHandler().disconnect("Finishing");
+        nodeList->setIsShuttingDown(true);
+
+        // tell the packet receiver we're shutting down, so it can drop packets
+        nodeList->getPacketReceiver().setShouldDropPackets(true);
+
+        // remove the NodeList from the DependencyManager
+        DependencyManager::destroy<NodeList>();
+        DependencyManager::destroy<PluginManager>();
+    }
+
+    QCoreApplication::exit(exitCode);
+}
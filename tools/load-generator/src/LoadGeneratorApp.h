@@ -0,0 +1,79 @@
+//
+//  LoadGeneratorApp.h
+//  tools/load-generator/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LoadGeneratorApp_h
+#define hifi_LoadGeneratorApp_h
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QProcess>
+#include <QTimer>
+
+#include <NodeList.h>
+
+#include "LoadAgent.h"
+
+// Puts a crowd of simulated clients into a local domain and writes a JSON report of how the
+// mixers coped.  The controller process spawns one lightweight agent process per simulated
+// client (NodeList is a per-process singleton, so each client needs its own process) and polls
+// the domain-server's node stats pages for the mixers' frame timings while the agents run.
+class LoadGeneratorApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    LoadGeneratorApp(int argc, char* argv[]);
+    ~LoadGeneratorApp();
+
+private slots:
+    void spawnNextAgent();
+    void agentFinished(int index, int exitCode);
+    void sampleMixerStats();
+    void agentSummaryReady(QJsonObject summary);
+
+private:
+    void startController();
+    void startAgent();
+    void agentFailedToStart(int index);
+    void agentStopped();
+    void completeRun();
+    void writeReport();
+    void finish(int exitCode);
+
+    QStringList agentArguments(int index) const;
+
+    bool _isAgent { false };
+    bool _verbose { false };
+    QString _domainServerAddress;
+    QString _domainServerHostname;
+    quint16 _domainServerHTTPPort;
+    int _numAgents { 1 };
+    int _durationSecs { 60 };
+    int _spawnIntervalMsecs { 50 };
+    QString _reportPath;
+    LoadAgent::Options _agentOptions;
+
+    // controller state
+    std::vector<QProcess*> _agentProcesses;
+    QJsonArray _agentSummaries;
+    int _numAgentsRunning { 0 };
+    int _numAgentsFailedToStart { 0 };
+    int _numAgentsTimedOut { 0 };
+    bool _isComplete { false };
+    QTimer _sampleTimer;
+    QNetworkAccessManager* _networkAccessManager { nullptr };
+    QHash<QString, QJsonArray> _mixerSamples;
+    quint64 _startUsecs { 0 };
+
+    // agent state
+    LoadAgent* _agent { nullptr };
+};
+
+#endif // hifi_LoadGeneratorApp_h
@@ -0,0 +1,119 @@
+//
+//  ModelBenchApp.cpp
+//  tools/model-bench/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelBenchApp.h"
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+#include <DependencyManager.h>
+#include <ResourceManager.h>
+#include <ResourceRequestObserver.h>
+#include <StatTracker.h>
+#include <FBXSerializer.h>
+#include <GLTFSerializer.h>
+#include <OBJSerializer.h>
+#include <hfm/ModelFormatRegistry.h>
+#include <model-baker/Baker.h>
+
+ModelBenchApp::ModelBenchApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless model loading benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption iterationsOption("n", "number of times each model is loaded", "iterations", "10");
+    parser.addOption(iterationsOption);
+
+    parser.addPositionalArgument("models", "FBX, glTF, GLB or OBJ files to load", "model [model...]");
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption) || parser.positionalArguments().isEmpty()) {
+        parser.showHelp();
+        return;
+    }
+
+    int iterations = std::max(1, parser.value(iterationsOption).toInt());
+
+    DependencyManager::set<StatTracker>();
+    DependencyManager::set<ResourceManager>(false);
+    DependencyManager::set<ResourceRequestObserver>();
+    {
+        auto modelFormatRegistry = DependencyManager::set<ModelFormatRegistry>();
+        modelFormatRegistry->addFormat(FBXSerializer());
+        modelFormatRegistry->addFormat(OBJSerializer());
+        modelFormatRegistry->addFormat(GLTFSerializer());
+    }
+
+    qInfo().noquote() << "model, meshes, parse ms, bake ms, total ms";
+    foreach (const QString& filename, parser.positionalArguments()) {
+        if (!benchmarkModel(filename, iterations)) {
+            _returnCode = 2;
+        }
+    }
+
+    DependencyManager::get<ResourceManager>()->cleanup();
+}
+
+ModelBenchApp::~ModelBenchApp() {
+}
+
+bool ModelBenchApp::benchmarkModel(const QString& filename, int iterations) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open file " << filename;
+        return false;
+    }
+    hifi::ByteArray data = file.readAll();
+    hifi::URL url = hifi::URL::fromLocalFile(QFileInfo(filename).absoluteFilePath());
+
+    quint64 parseNsecs = 0;
+    quint64 bakeNsecs = 0;
+    int numMeshes = 0;
+    QElapsedTimer timer;
+    for (int i = 0; i < iterations; i++) {
+        // serializers keep state between reads, so every iteration parses with a fresh one, as ModelLoader does
+        auto serializer = DependencyManager::get<ModelFormatRegistry>()->getSerializerForMediaType(data, url, "");
+        if (!serializer) {
+            qCritical() << "Unrecognized model format " << filename;
+            return false;
+        }
+
+        timer.start();
+        hfm::Model::Pointer hfmModel = serializer->read(data, hifi::VariantHash(), url);
+        parseNsecs += timer.nsecsElapsed();
+        if (!hfmModel) {
+            qCritical() << "Failed to parse " << filename;
+            return false;
+        }
+        numMeshes = hfmModel->meshes.size();
+
+        timer.start();
+        baker::Baker modelBaker(hfmModel, hifi::VariantHash(), hifi::URL());
+        modelBaker.run();
+        bakeNsecs += timer.nsecsElapsed();
+    }
+
+    const double NSECS_PER_MSEC = 1.0e6;
+    double parseMsecs = (double)parseNsecs / (NSECS_PER_MSEC * iterations);
+    double bakeMsecs = (double)bakeNsecs / (NSECS_PER_MSEC * iterations);
+    qInfo().noquote() << QString("%1, %2, %3, %4, %5").arg(QFileInfo(filename).fileName()).arg(numMeshes)
+        .arg(parseMsecs, 0, 'f', 2).arg(bakeMsecs, 0, 'f', 2).arg(parseMsecs + bakeMsecs, 0, 'f', 2);
+    return true;
+}
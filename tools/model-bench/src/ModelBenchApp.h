@@ -0,0 +1,30 @@
+//
+//  ModelBenchApp.h
+//  tools/model-bench/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelBenchApp_h
+#define hifi_ModelBenchApp_h
+
+#include <QCoreApplication>
+
+class ModelBenchApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    ModelBenchApp(int argc, char* argv[]);
+    ~ModelBenchApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    bool benchmarkModel(const QString& filename, int iterations);
+
+    int _returnCode { 0 };
+};
+
+#endif //hifi_ModelBenchApp_h
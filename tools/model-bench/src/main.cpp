@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/model-bench/src
+//
+//  Copyright 2020 Project Athena
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "ModelBenchApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Model Bench");
+
+    ModelBenchApp app(argc, argv);
+    return app.getReturnCode();
+}